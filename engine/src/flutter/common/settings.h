@@ -89,6 +89,9 @@ using Mappings = std::vector<std::unique_ptr<const fml::Mapping>>;
 using MappingsCallback = std::function<Mappings(void)>;
 
 using FrameRasterizedCallback = std::function<void(const FrameTiming&)>;
+using FrameDiscardedCallback =
+    std::function<void(fml::TimePoint /* vsync start */,
+                       bool /* will retry */)>;
 
 class DartIsolate;
 
@@ -318,6 +321,17 @@ struct Settings {
   LogMessageCallback log_message_callback;
   bool enable_software_rendering = false;
   bool skia_deterministic_rendering_on_cpu = false;
+  // Share rasterized display lists between the raster caches of a shell and
+  // the shells spawned from it, so that identical content is only rasterized
+  // once. Only applies to the Skia backend.
+  bool enable_shared_raster_cache = false;
+  // Postpone the start of each frame within its vsync interval based on the
+  // measured duration of recent frames, so that the frame handles the input
+  // events delivered in the meantime.
+  bool enable_predictive_frame_scheduling = false;
+  // Merge the pointer data packets received within one vsync into a single
+  // packet instead of dispatching each of them to the framework.
+  bool enable_pointer_event_coalescing = false;
   bool verbose_logging = false;
   std::string log_tag = "flutter";
 
@@ -338,6 +352,12 @@ struct Settings {
   // soon as a frame is rasterized.
   FrameRasterizedCallback frame_rasterized_callback;
 
+  // Callback invoked on the UI thread when a frame begun by a vsync ends
+  // without a layer tree to rasterize, with the vsync start time of the frame.
+  // The flag is set if the frame was not built because the pipeline was full,
+  // in which case it begins again at the next vsync.
+  FrameDiscardedCallback frame_discarded_callback;
+
   // This data will be available to the isolate immediately on launch via the
   // PlatformDispatcher.getPersistentIsolateData callback. This is meant for
   // information that the isolate cannot request asynchronously (platform
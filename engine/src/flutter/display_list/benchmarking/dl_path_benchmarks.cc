@@ -0,0 +1,102 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/benchmarking/benchmarking.h"
+
+#include "flutter/display_list/geometry/dl_path.h"
+#include "flutter/display_list/geometry/dl_path_builder.h"
+#include "flutter/fml/logging.h"
+#include "third_party/skia/include/core/SkContourMeasure.h"
+#include "third_party/skia/include/core/SkPathBuilder.h"
+
+namespace flutter {
+
+namespace {
+
+// A wavy stroke made of |count| cubics, like the path of an animated line
+// chart or a hand drawn underline.
+DlPath MakeLongCubicPath(int count) {
+  DlPathBuilder builder;
+  builder.MoveTo({0, 0});
+  for (int i = 0; i < count; i++) {
+    const DlScalar x = i * 30.0f;
+    builder.CubicCurveTo({x + 10, -20}, {x + 20, 20}, {x + 30, 0});
+  }
+  return builder.TakePath();
+}
+
+// The start and end distances of 10 long dashes with 5 long gaps.
+std::vector<SkScalar> MakeDashIntervals(SkScalar length) {
+  std::vector<SkScalar> intervals;
+  for (SkScalar start = 0; start < length; start += 15) {
+    intervals.push_back(start);
+    intervals.push_back(start + 10);
+  }
+  return intervals;
+}
+
+}  // namespace
+
+// Measures a path and dashes it every frame, the way dashed and animated
+// strokes use Path.computeMetrics and PathMetric.extractPath: each frame
+// measures the path from scratch and extracts every dash into its own path.
+static void BM_PathDashUncached(benchmark::State& state) {
+  DlPath path = MakeLongCubicPath(state.range(0));
+  for (auto _ : state) {
+    SkContourMeasureIter iter(path.GetSkPath(), false);
+    sk_sp<SkContourMeasure> measure = iter.next();
+    FML_CHECK(measure);
+    std::vector<SkScalar> intervals = MakeDashIntervals(measure->length());
+    SkPathBuilder dashes;
+    for (size_t i = 0; i < intervals.size(); i += 2) {
+      SkPathBuilder dash;
+      measure->getSegment(intervals[i], intervals[i + 1], &dash, true);
+      dashes.addPath(dash.detach());
+    }
+    benchmark::DoNotOptimize(dashes.detach());
+  }
+}
+
+// The same as BM_PathDashUncached with the contour measures cached on the
+// path and all the dashes extracted into one path in a single call.
+static void BM_PathDashCached(benchmark::State& state) {
+  DlPath path = MakeLongCubicPath(state.range(0));
+  for (auto _ : state) {
+    sk_sp<SkContourMeasure> measure = path.GetContourMeasures(false)->Get(0);
+    FML_CHECK(measure);
+    std::vector<SkScalar> intervals = MakeDashIntervals(measure->length());
+    SkPathBuilder dashes;
+    for (size_t i = 0; i < intervals.size(); i += 2) {
+      measure->getSegment(intervals[i], intervals[i + 1], &dashes, true);
+    }
+    benchmark::DoNotOptimize(dashes.detach());
+  }
+}
+
+// Measures a new path every iteration, which is the cost the first frame
+// that measures a path pays with or without the cache.
+static void BM_PathMeasure(benchmark::State& state) {
+  const int count = state.range(0);
+  for (auto _ : state) {
+    state.PauseTiming();
+    DlPath path = MakeLongCubicPath(count);
+    state.ResumeTiming();
+    benchmark::DoNotOptimize(path.GetContourMeasures(false)->Get(0));
+  }
+}
+
+BENCHMARK(BM_PathDashUncached)
+    ->RangeMultiplier(4)
+    ->Range(16, 1024)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_PathDashCached)
+    ->RangeMultiplier(4)
+    ->Range(16, 1024)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_PathMeasure)
+    ->RangeMultiplier(4)
+    ->Range(16, 1024)
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace flutter
@@ -0,0 +1,32 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/geometry/dl_contour_measures.h"
+
+namespace flutter {
+
+DlContourMeasures::DlContourMeasures(const SkPath& path, bool force_closed)
+    : iter_(path, force_closed) {}
+
+DlContourMeasures::~DlContourMeasures() = default;
+
+sk_sp<SkContourMeasure> DlContourMeasures::Get(size_t index) {
+  std::scoped_lock lock(mutex_);
+  while (!done_ && measures_.size() <= index) {
+    sk_sp<SkContourMeasure> measure = iter_.next();
+    if (!measure) {
+      done_ = true;
+      break;
+    }
+    measures_.push_back(std::move(measure));
+  }
+  return index < measures_.size() ? measures_[index] : nullptr;
+}
+
+size_t DlContourMeasures::GetMeasuredCount() const {
+  std::scoped_lock lock(mutex_);
+  return measures_.size();
+}
+
+}  // namespace flutter
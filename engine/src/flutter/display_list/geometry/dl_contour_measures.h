@@ -0,0 +1,57 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_DISPLAY_LIST_GEOMETRY_DL_CONTOUR_MEASURES_H_
+#define FLUTTER_DISPLAY_LIST_GEOMETRY_DL_CONTOUR_MEASURES_H_
+
+#include <mutex>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/third_party/skia/include/core/SkContourMeasure.h"
+#include "flutter/third_party/skia/include/core/SkPath.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      The lengths and segment tables of the contours of a path,
+///             measured as they are first requested.
+///
+///             An instance is shared by all the copies of a |DlPath| so that
+///             paths which are measured repeatedly, such as the paths of
+///             dashed or animated strokes, are only measured once.
+///
+///             This class is thread safe.
+///
+class DlContourMeasures {
+ public:
+  DlContourMeasures(const SkPath& path, bool force_closed);
+
+  ~DlContourMeasures();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the measure of the contour at |index|, measuring the
+  ///             contours before it first if they were not measured yet.
+  ///
+  /// @return     The measure, or nullptr if the path has no contour at
+  ///             |index|. Contours of zero length are skipped, as they are by
+  ///             |SkContourMeasureIter|.
+  ///
+  sk_sp<SkContourMeasure> Get(size_t index);
+
+  /// The number of contours measured so far.
+  size_t GetMeasuredCount() const;
+
+ private:
+  mutable std::mutex mutex_;
+  SkContourMeasureIter iter_;
+  std::vector<sk_sp<SkContourMeasure>> measures_;
+  bool done_ = false;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DlContourMeasures);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_DISPLAY_LIST_GEOMETRY_DL_CONTOUR_MEASURES_H_
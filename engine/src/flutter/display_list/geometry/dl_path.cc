@@ -181,6 +181,18 @@ void DlPath::WillRenderSkPath() const {
   }
 }
 
+std::shared_ptr<DlContourMeasures> DlPath::GetContourMeasures(
+    bool force_closed) const {
+  std::scoped_lock lock(data_->contour_measures_mutex);
+  std::shared_ptr<DlContourMeasures>& measures =
+      data_->contour_measures[force_closed ? 1 : 0];
+  if (!measures) {
+    measures =
+        std::make_shared<DlContourMeasures>(data_->sk_path, force_closed);
+  }
+  return measures;
+}
+
 [[nodiscard]] DlPath DlPath::WithOffset(const DlPoint offset) const {
   if (offset.IsZero()) {
     return *this;
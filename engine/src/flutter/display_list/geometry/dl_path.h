@@ -6,7 +6,10 @@
 #define FLUTTER_DISPLAY_LIST_GEOMETRY_DL_PATH_H_
 
 #include <functional>
+#include <memory>
+#include <mutex>
 
+#include "flutter/display_list/geometry/dl_contour_measures.h"
 #include "flutter/display_list/geometry/dl_geometry_types.h"
 #include "flutter/impeller/geometry/path_source.h"
 #include "flutter/third_party/skia/include/core/SkPath.h"
@@ -88,6 +91,11 @@ class DlPath : public impeller::PathSource {
 
   bool Contains(const DlPoint point) const;
 
+  /// The measures of the contours of this path, shared by all copies of it
+  /// and computed incrementally as they are first requested.
+  std::shared_ptr<DlContourMeasures> GetContourMeasures(
+      bool force_closed) const;
+
   DlRect GetBounds() const override;
   DlPathFillType GetFillType() const override;
 
@@ -106,6 +114,10 @@ class DlPath : public impeller::PathSource {
 
     SkPath sk_path;
     uint32_t render_count = 0u;
+
+    std::mutex contour_measures_mutex;
+    // Indexed by whether the contours are measured as if they were closed.
+    std::shared_ptr<DlContourMeasures> contour_measures[2];
   };
 
   std::shared_ptr<Data> data_;
@@ -816,6 +816,47 @@ TEST(DisplayListPath, DispatchImplicitMoveAfterClosePathBuilder) {
   TestPathDispatchImplicitMoveAfterClose(path_builder.TakePath());
 }
 
+TEST(DisplayListPath, ContourMeasuresAreSharedByCopies) {
+  DlPathBuilder builder;
+  builder.MoveTo({0, 0});
+  builder.LineTo({0, 10});
+  builder.MoveTo({20, 0});
+  builder.LineTo({20, 5});
+  DlPath path = builder.TakePath();
+  DlPath copy = path;
+
+  std::shared_ptr<DlContourMeasures> measures = path.GetContourMeasures(false);
+  EXPECT_EQ(measures, copy.GetContourMeasures(false));
+  EXPECT_NE(measures, path.GetContourMeasures(true));
+  EXPECT_NE(measures, path.WithOffset({1, 1}).GetContourMeasures(false));
+}
+
+TEST(DisplayListPath, ContourMeasuresAreComputedIncrementally) {
+  DlPathBuilder builder;
+  builder.MoveTo({0, 0});
+  builder.LineTo({0, 10});
+  builder.MoveTo({20, 0});
+  builder.LineTo({20, 5});
+  std::shared_ptr<DlContourMeasures> open_measures =
+      builder.CopyPath().GetContourMeasures(false);
+  std::shared_ptr<DlContourMeasures> closed_measures =
+      builder.TakePath().GetContourMeasures(true);
+
+  EXPECT_EQ(open_measures->GetMeasuredCount(), 0u);
+  ASSERT_NE(open_measures->Get(0), nullptr);
+  EXPECT_EQ(open_measures->GetMeasuredCount(), 1u);
+  EXPECT_FLOAT_EQ(open_measures->Get(0)->length(), 10.0f);
+  EXPECT_FALSE(open_measures->Get(0)->isClosed());
+  ASSERT_NE(open_measures->Get(1), nullptr);
+  EXPECT_FLOAT_EQ(open_measures->Get(1)->length(), 5.0f);
+  EXPECT_EQ(open_measures->Get(2), nullptr);
+  EXPECT_EQ(open_measures->GetMeasuredCount(), 2u);
+
+  ASSERT_NE(closed_measures->Get(0), nullptr);
+  EXPECT_FLOAT_EQ(closed_measures->Get(0)->length(), 20.0f);
+  EXPECT_TRUE(closed_measures->Get(0)->isClosed());
+}
+
 #ifndef NDEBUG
 // Tests that verify we don't try to use inverse path modes as they aren't
 // supported by either Flutter public APIs or Impeller
@@ -119,8 +119,11 @@ RasterStatus CompositorContext::ScopedFrame::Raster(
 
   std::optional<DlRect> clip_rect;
   if (frame_damage) {
+    fml::TimePoint diff_start = fml::TimePoint::Now();
     clip_rect = frame_damage->ComputeClipRect(layer_tree, !ignore_raster_cache,
                                               !gr_context_);
+    AddPhaseDuration(FrameTimingsRecorder::Phase::kDiff,
+                     fml::TimePoint::Now() - diff_start);
 
     if (aiks_context_ &&
         !ShouldPerformPartialRepaint(clip_rect, layer_tree.frame_size())) {
@@ -129,8 +132,11 @@ RasterStatus CompositorContext::ScopedFrame::Raster(
     }
   }
 
+  fml::TimePoint preroll_start = fml::TimePoint::Now();
   bool root_needs_readback = layer_tree.Preroll(
       *this, ignore_raster_cache, clip_rect ? *clip_rect : kGiantRect);
+  AddPhaseDuration(FrameTimingsRecorder::Phase::kPreroll,
+                   fml::TimePoint::Now() - preroll_start);
   bool needs_save_layer = root_needs_readback && !surface_supports_readback();
   PostPrerollResult post_preroll_result = PostPrerollResult::kSuccess;
   if (view_embedder_ && raster_thread_merger_) {
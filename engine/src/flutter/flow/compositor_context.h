@@ -5,6 +5,7 @@
 #ifndef FLUTTER_FLOW_COMPOSITOR_CONTEXT_H_
 #define FLUTTER_FLOW_COMPOSITOR_CONTEXT_H_
 
+#include <array>
 #include <memory>
 #include <string>
 
@@ -12,6 +13,7 @@
 #include "flutter/common/macros.h"
 #include "flutter/flow/diff_context.h"
 #include "flutter/flow/embedded_views.h"
+#include "flutter/flow/frame_timings.h"
 #include "flutter/flow/raster_cache.h"
 #include "flutter/flow/stopwatch.h"
 #include "flutter/fml/macros.h"
@@ -138,6 +140,17 @@ class CompositorContext {
                                 bool ignore_raster_cache,
                                 FrameDamage* frame_damage);
 
+    // Time spent in each phase of rasterization by this frame so far.
+    fml::TimeDelta GetPhaseDuration(FrameTimingsRecorder::Phase phase) const {
+      return phase_durations_[static_cast<size_t>(phase)];
+    }
+
+    void AddPhaseDuration(FrameTimingsRecorder::Phase phase,
+                          fml::TimeDelta duration) {
+      phase_durations_[static_cast<size_t>(phase)] =
+          phase_durations_[static_cast<size_t>(phase)] + duration;
+    }
+
    private:
     void PaintLayerTreeSkia(flutter::LayerTree& layer_tree,
                             std::optional<DlRect> clip_rect,
@@ -157,6 +170,8 @@ class CompositorContext {
     const bool instrumentation_enabled_;
     const bool surface_supports_readback_;
     fml::RefPtr<fml::RasterThreadMerger> raster_thread_merger_;
+    std::array<fml::TimeDelta, FrameTimingsRecorder::kPhaseCount>
+        phase_durations_ = {};
 
     FML_DISALLOW_COPY_AND_ASSIGN(ScopedFrame);
   };
@@ -0,0 +1,132 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/frame_timing_stats.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "flutter/fml/logging.h"
+
+namespace flutter {
+
+FrameDurationHistogram::FrameDurationHistogram() {
+  Reset();
+}
+
+void FrameDurationHistogram::Add(fml::TimeDelta duration) {
+  int64_t micros = std::max<int64_t>(duration.ToMicroseconds(), 0);
+  size_t index = std::min(static_cast<size_t>(micros / kBucketMicros),
+                          kBucketCount);
+  buckets_[index]++;
+  sample_count_++;
+}
+
+fml::TimeDelta FrameDurationHistogram::GetPercentile(double percentile) const {
+  if (sample_count_ == 0) {
+    return fml::TimeDelta::Zero();
+  }
+  uint64_t rank = static_cast<uint64_t>(
+      std::ceil(sample_count_ * std::clamp(percentile, 0.0, 100.0) / 100.0));
+  rank = std::max<uint64_t>(rank, 1);
+  uint64_t seen = 0;
+  for (size_t i = 0; i < buckets_.size(); i++) {
+    seen += buckets_[i];
+    if (seen >= rank) {
+      return fml::TimeDelta::FromMicroseconds(
+          static_cast<int64_t>(std::min(i + 1, kBucketCount)) * kBucketMicros);
+    }
+  }
+  FML_UNREACHABLE();
+}
+
+void FrameDurationHistogram::Reset() {
+  buckets_.fill(0);
+  sample_count_ = 0;
+}
+
+FrameTimingStats::FrameTimingStats() = default;
+
+FrameTimingStats::~FrameTimingStats() = default;
+
+const char* FrameTimingStats::GetAttributionPhaseName(size_t index) {
+  FML_DCHECK(index < kAttributionPhaseCount);
+  if (index == kBuildPhase) {
+    return "build";
+  }
+  return FrameTimingsRecorder::PhaseToString(
+      static_cast<FrameTimingsRecorder::Phase>(index - 1));
+}
+
+void FrameTimingStats::AddFrame(const FrameTimingsRecorder& recorder) {
+  recorder.AssertInState(FrameTimingsRecorder::State::kRasterEnd);
+
+  const fml::TimeDelta build = recorder.GetBuildDuration();
+  const fml::TimeDelta raster =
+      recorder.GetRasterEndTime() - recorder.GetRasterStartTime();
+  const fml::TimeDelta total =
+      recorder.GetRasterEndTime() - recorder.GetVsyncStartTime();
+  const bool missed =
+      recorder.GetRasterEndTime() > recorder.GetVsyncTargetTime();
+
+  std::array<fml::TimeDelta, kAttributionPhaseCount> phases;
+  if (missed) {
+    phases[kBuildPhase] = build;
+    for (size_t i = 0; i < FrameTimingsRecorder::kPhaseCount; i++) {
+      auto phase = static_cast<FrameTimingsRecorder::Phase>(i);
+      phases[GetAttributionPhaseIndex(phase)] =
+          recorder.GetPhaseDuration(phase);
+    }
+  }
+
+  std::scoped_lock lock(mutex_);
+  build_histogram_.Add(build);
+  raster_histogram_.Add(raster);
+  total_histogram_.Add(total);
+  if (!missed) {
+    return;
+  }
+  missed_frame_count_++;
+  size_t dominant = 0;
+  for (size_t i = 0; i < kAttributionPhaseCount; i++) {
+    missed_phase_time_[i] = missed_phase_time_[i] + phases[i];
+    if (phases[i] > phases[dominant]) {
+      dominant = i;
+    }
+  }
+  missed_phase_count_[dominant]++;
+}
+
+FrameTimingStats::Snapshot FrameTimingStats::GetSnapshot() const {
+  auto percentiles = [](const FrameDurationHistogram& histogram) {
+    return Percentiles{
+        .p50 = histogram.GetPercentile(50),
+        .p90 = histogram.GetPercentile(90),
+        .p99 = histogram.GetPercentile(99),
+    };
+  };
+
+  std::scoped_lock lock(mutex_);
+  Snapshot snapshot;
+  snapshot.frame_count = total_histogram_.GetSampleCount();
+  snapshot.missed_frame_count = missed_frame_count_;
+  snapshot.build = percentiles(build_histogram_);
+  snapshot.raster = percentiles(raster_histogram_);
+  snapshot.total = percentiles(total_histogram_);
+  snapshot.missed_phase_time = missed_phase_time_;
+  snapshot.missed_phase_count = missed_phase_count_;
+  return snapshot;
+}
+
+void FrameTimingStats::Reset() {
+  std::scoped_lock lock(mutex_);
+  missed_frame_count_ = 0;
+  build_histogram_.Reset();
+  raster_histogram_.Reset();
+  total_histogram_.Reset();
+  missed_phase_time_.fill(fml::TimeDelta::Zero());
+  missed_phase_count_.fill(0);
+}
+
+}  // namespace flutter
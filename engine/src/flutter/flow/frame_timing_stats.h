@@ -0,0 +1,118 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_FRAME_TIMING_STATS_H_
+#define FLUTTER_FLOW_FRAME_TIMING_STATS_H_
+
+#include <array>
+#include <cstdint>
+#include <mutex>
+
+#include "flutter/flow/frame_timings.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// A histogram of durations with fixed 100us buckets up to 250ms, used to
+/// compute approximate percentiles without keeping every sample.
+///
+class FrameDurationHistogram {
+ public:
+  static constexpr int64_t kBucketMicros = 100;
+  static constexpr size_t kBucketCount = 2500;
+
+  FrameDurationHistogram();
+
+  void Add(fml::TimeDelta duration);
+
+  /// Returns the smallest bucket boundary that at least |percentile| percent
+  /// of the samples fall below, or zero if there are no samples.
+  fml::TimeDelta GetPercentile(double percentile) const;
+
+  uint64_t GetSampleCount() const { return sample_count_; }
+
+  void Reset();
+
+ private:
+  // The last bucket collects all samples that exceed the histogram range.
+  std::array<uint32_t, kBucketCount + 1> buckets_;
+  uint64_t sample_count_ = 0;
+};
+
+//------------------------------------------------------------------------------
+/// Aggregates the timings of rasterized frames into build, raster and total
+/// latency histograms and attributes the time spent in frames that missed
+/// their vsync target to the phases of the frame pipeline.
+///
+/// This class is thread safe. Frames are added on the raster thread and the
+/// statistics may be read from any thread.
+///
+class FrameTimingStats {
+ public:
+  /// The phases a missed frame is attributed to. The UI thread build phase
+  /// is followed by the rasterization phases of |FrameTimingsRecorder|.
+  static constexpr size_t kBuildPhase = 0;
+  static constexpr size_t kAttributionPhaseCount =
+      FrameTimingsRecorder::kPhaseCount + 1;
+
+  struct Percentiles {
+    fml::TimeDelta p50;
+    fml::TimeDelta p90;
+    fml::TimeDelta p99;
+  };
+
+  struct Snapshot {
+    uint64_t frame_count = 0;
+    uint64_t missed_frame_count = 0;
+    /// Time between the start and end of the frame build on the UI thread.
+    Percentiles build;
+    /// Time between the start and end of the frame rasterization.
+    Percentiles raster;
+    /// Time between the vsync that started the frame and the end of its
+    /// rasterization.
+    Percentiles total;
+    /// The total time spent in each phase across all missed frames, indexed
+    /// by |GetAttributionPhaseIndex|.
+    std::array<fml::TimeDelta, kAttributionPhaseCount> missed_phase_time = {};
+    /// The number of missed frames in which each phase was the most expensive
+    /// phase, indexed by |GetAttributionPhaseIndex|.
+    std::array<uint64_t, kAttributionPhaseCount> missed_phase_count = {};
+  };
+
+  FrameTimingStats();
+
+  ~FrameTimingStats();
+
+  static constexpr size_t GetAttributionPhaseIndex(
+      FrameTimingsRecorder::Phase phase) {
+    return static_cast<size_t>(phase) + 1;
+  }
+
+  /// Returns a human readable name for an attribution phase index.
+  static const char* GetAttributionPhaseName(size_t index);
+
+  /// Adds a frame that has reached the `kRasterEnd` state.
+  void AddFrame(const FrameTimingsRecorder& recorder);
+
+  Snapshot GetSnapshot() const;
+
+  void Reset();
+
+ private:
+  mutable std::mutex mutex_;
+  uint64_t missed_frame_count_ = 0;
+  FrameDurationHistogram build_histogram_;
+  FrameDurationHistogram raster_histogram_;
+  FrameDurationHistogram total_histogram_;
+  std::array<fml::TimeDelta, kAttributionPhaseCount> missed_phase_time_ = {};
+  std::array<uint64_t, kAttributionPhaseCount> missed_phase_count_ = {};
+
+  FML_DISALLOW_COPY_AND_ASSIGN(FrameTimingStats);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_FRAME_TIMING_STATS_H_
@@ -0,0 +1,139 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/frame_timing_stats.h"
+
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+using Phase = FrameTimingsRecorder::Phase;
+
+// Records a frame that has finished rasterizing now. Frames whose vsync
+// target is in the past are treated as missed.
+std::unique_ptr<FrameTimingsRecorder> MakeFrame(
+    fml::TimeDelta build,
+    fml::TimeDelta raster,
+    bool missed,
+    std::initializer_list<std::pair<Phase, fml::TimeDelta>> phases = {}) {
+  auto recorder = std::make_unique<FrameTimingsRecorder>();
+  const auto raster_start = fml::TimePoint::Now() - raster;
+  const auto build_start = raster_start - build;
+  const auto vsync_target = missed
+                                ? raster_start
+                                : raster_start + fml::TimeDelta::FromSeconds(1);
+  recorder->RecordVsync(build_start, vsync_target);
+  recorder->RecordBuildStart(build_start);
+  recorder->RecordBuildEnd(raster_start);
+  recorder->RecordRasterStart(raster_start);
+  for (const auto& [phase, duration] : phases) {
+    recorder->RecordPhaseDuration(phase, duration);
+  }
+  recorder->RecordRasterEnd();
+  return recorder;
+}
+
+}  // namespace
+
+TEST(FrameDurationHistogramTest, EmptyHistogramHasZeroPercentiles) {
+  FrameDurationHistogram histogram;
+  EXPECT_EQ(histogram.GetSampleCount(), 0u);
+  EXPECT_EQ(histogram.GetPercentile(50), fml::TimeDelta::Zero());
+}
+
+TEST(FrameDurationHistogramTest, ComputesPercentiles) {
+  FrameDurationHistogram histogram;
+  for (int i = 1; i <= 100; i++) {
+    histogram.Add(fml::TimeDelta::FromMilliseconds(i));
+  }
+  EXPECT_EQ(histogram.GetSampleCount(), 100u);
+  // Samples on a bucket boundary fall into the next bucket.
+  EXPECT_EQ(histogram.GetPercentile(50),
+            fml::TimeDelta::FromMicroseconds(50100));
+  EXPECT_EQ(histogram.GetPercentile(90),
+            fml::TimeDelta::FromMicroseconds(90100));
+  EXPECT_EQ(histogram.GetPercentile(99),
+            fml::TimeDelta::FromMicroseconds(99100));
+}
+
+TEST(FrameDurationHistogramTest, ClampsLongDurations) {
+  FrameDurationHistogram histogram;
+  histogram.Add(fml::TimeDelta::FromSeconds(10));
+  EXPECT_EQ(histogram.GetPercentile(100),
+            fml::TimeDelta::FromMilliseconds(250));
+}
+
+TEST(FrameTimingStatsTest, CountsFramesAndMissedFrames) {
+  FrameTimingStats stats;
+  stats.AddFrame(*MakeFrame(fml::TimeDelta::FromMilliseconds(4),
+                            fml::TimeDelta::FromMilliseconds(6), false));
+  stats.AddFrame(*MakeFrame(fml::TimeDelta::FromMilliseconds(4),
+                            fml::TimeDelta::FromMilliseconds(6), true));
+
+  FrameTimingStats::Snapshot snapshot = stats.GetSnapshot();
+  EXPECT_EQ(snapshot.frame_count, 2u);
+  EXPECT_EQ(snapshot.missed_frame_count, 1u);
+  EXPECT_GE(snapshot.build.p50, fml::TimeDelta::FromMilliseconds(4));
+  EXPECT_GE(snapshot.raster.p50, fml::TimeDelta::FromMilliseconds(6));
+  EXPECT_GE(snapshot.total.p50, fml::TimeDelta::FromMilliseconds(10));
+
+  stats.Reset();
+  snapshot = stats.GetSnapshot();
+  EXPECT_EQ(snapshot.frame_count, 0u);
+  EXPECT_EQ(snapshot.missed_frame_count, 0u);
+}
+
+TEST(FrameTimingStatsTest, AttributesMissedFramesToPhases) {
+  FrameTimingStats stats;
+  // Frames that are on time are not attributed.
+  stats.AddFrame(*MakeFrame(fml::TimeDelta::FromMilliseconds(1),
+                            fml::TimeDelta::FromMilliseconds(30), false,
+                            {{Phase::kPaint,
+                              fml::TimeDelta::FromMilliseconds(30)}}));
+  stats.AddFrame(*MakeFrame(fml::TimeDelta::FromMilliseconds(1),
+                            fml::TimeDelta::FromMilliseconds(20), true,
+                            {
+                                {Phase::kPreroll,
+                                 fml::TimeDelta::FromMilliseconds(2)},
+                                {Phase::kRasterCache,
+                                 fml::TimeDelta::FromMilliseconds(15)},
+                                {Phase::kPaint,
+                                 fml::TimeDelta::FromMilliseconds(3)},
+                            }));
+  stats.AddFrame(*MakeFrame(fml::TimeDelta::FromMilliseconds(25),
+                            fml::TimeDelta::FromMilliseconds(2), true,
+                            {{Phase::kSubmit,
+                              fml::TimeDelta::FromMilliseconds(2)}}));
+
+  FrameTimingStats::Snapshot snapshot = stats.GetSnapshot();
+  EXPECT_EQ(snapshot.missed_frame_count, 2u);
+
+  const size_t raster_cache =
+      FrameTimingStats::GetAttributionPhaseIndex(Phase::kRasterCache);
+  const size_t paint =
+      FrameTimingStats::GetAttributionPhaseIndex(Phase::kPaint);
+  const size_t build = FrameTimingStats::kBuildPhase;
+  EXPECT_EQ(snapshot.missed_phase_count[raster_cache], 1u);
+  EXPECT_EQ(snapshot.missed_phase_count[build], 1u);
+  EXPECT_EQ(snapshot.missed_phase_count[paint], 0u);
+  EXPECT_EQ(snapshot.missed_phase_time[raster_cache],
+            fml::TimeDelta::FromMilliseconds(15));
+  EXPECT_EQ(snapshot.missed_phase_time[paint],
+            fml::TimeDelta::FromMilliseconds(3));
+  EXPECT_EQ(snapshot.missed_phase_time[build],
+            fml::TimeDelta::FromMilliseconds(26));
+
+  EXPECT_STREQ(FrameTimingStats::GetAttributionPhaseName(build), "build");
+  EXPECT_STREQ(FrameTimingStats::GetAttributionPhaseName(raster_cache),
+               "raster_cache");
+}
+
+}  // namespace testing
+}  // namespace flutter
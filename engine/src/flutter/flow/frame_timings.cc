@@ -38,6 +38,24 @@ const char* StateToString(FrameTimingsRecorder::State state) {
 
 }  // namespace
 
+const char* FrameTimingsRecorder::PhaseToString(Phase phase) {
+  switch (phase) {
+    case Phase::kDiff:
+      return "diff";
+    case Phase::kPreroll:
+      return "preroll";
+    case Phase::kRasterCache:
+      return "raster_cache";
+    case Phase::kPaint:
+      return "paint";
+    case Phase::kSubmit:
+      return "submit";
+    case Phase::kCount:
+      break;
+  }
+  FML_UNREACHABLE();
+}
+
 std::atomic<uint64_t> FrameTimingsRecorder::frame_number_gen_ = {1};
 
 FrameTimingsRecorder::FrameTimingsRecorder()
@@ -199,6 +217,21 @@ fml::Status FrameTimingsRecorder::RecordRasterStartImpl(
   return fml::Status();
 }
 
+void FrameTimingsRecorder::RecordPhaseDuration(Phase phase,
+                                               fml::TimeDelta duration) {
+  std::scoped_lock state_lock(state_mutex_);
+  FML_DCHECK(state_ == State::kRasterStart);
+  FML_DCHECK(phase < Phase::kCount);
+  phase_durations_[static_cast<size_t>(phase)] =
+      phase_durations_[static_cast<size_t>(phase)] + duration;
+}
+
+fml::TimeDelta FrameTimingsRecorder::GetPhaseDuration(Phase phase) const {
+  std::scoped_lock state_lock(state_mutex_);
+  FML_DCHECK(phase < Phase::kCount);
+  return phase_durations_[static_cast<size_t>(phase)];
+}
+
 FrameTiming FrameTimingsRecorder::RecordRasterEnd(const RasterCache* cache) {
   std::scoped_lock state_lock(state_mutex_);
   FML_DCHECK(state_ == State::kRasterStart);
@@ -259,6 +292,7 @@ std::unique_ptr<FrameTimingsRecorder> FrameTimingsRecorder::CloneUntil(
 
   if (state >= State::kRasterStart) {
     recorder->raster_start_ = raster_start_;
+    recorder->phase_durations_ = phase_durations_;
   }
 
   if (state >= State::kRasterEnd) {
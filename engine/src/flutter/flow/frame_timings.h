@@ -5,6 +5,7 @@
 #ifndef FLUTTER_FLOW_FRAME_TIMINGS_H_
 #define FLUTTER_FLOW_FRAME_TIMINGS_H_
 
+#include <array>
 #include <mutex>
 
 #include "flutter/common/settings.h"
@@ -41,6 +42,23 @@ class FrameTimingsRecorder {
     kRasterEnd,
   };
 
+  /// The phases of rasterization that are timed individually so that the
+  /// cost of a slow frame can be attributed.
+  // After adding an item to this enum, modify PhaseToString accordingly.
+  enum class Phase : uint32_t {
+    kDiff,
+    kPreroll,
+    kRasterCache,
+    kPaint,
+    kSubmit,
+    kCount,
+  };
+
+  static constexpr size_t kPhaseCount = static_cast<size_t>(Phase::kCount);
+
+  /// Returns a human readable name for the phase.
+  static const char* PhaseToString(Phase phase);
+
   /// Default constructor, initializes the recorder with State::kUninitialized.
   FrameTimingsRecorder();
 
@@ -99,6 +117,14 @@ class FrameTimingsRecorder {
   /// Records a raster start event.
   void RecordRasterStart(fml::TimePoint raster_start);
 
+  /// Adds time spent in a phase of rasterization. May be called any number
+  /// of times between the raster start and raster end events, durations of
+  /// the same phase accumulate (e.g. when multiple views are drawn).
+  void RecordPhaseDuration(Phase phase, fml::TimeDelta duration);
+
+  /// Total time recorded for |phase| by `RecordPhaseDuration`.
+  fml::TimeDelta GetPhaseDuration(Phase phase) const;
+
   /// Clones the recorder until (and including) the specified state.
   std::unique_ptr<FrameTimingsRecorder> CloneUntil(State state);
 
@@ -153,6 +179,8 @@ class FrameTimingsRecorder {
   fml::TimePoint raster_end_;
   fml::TimePoint raster_end_wall_time_;
 
+  std::array<fml::TimeDelta, kPhaseCount> phase_durations_ = {};
+
   size_t layer_cache_count_;
   size_t layer_cache_bytes_;
   size_t picture_cache_count_;
@@ -0,0 +1,127 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/layer_flatten_cache.h"
+
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/flow/layers/layer.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+LayerFlattenCache::LayerFlattenCache() = default;
+
+LayerFlattenCache::~LayerFlattenCache() = default;
+
+void LayerFlattenCache::BeginFlatten(
+    const GrDirectContext* gr_context,
+    const impeller::AiksContext* aiks_context) {
+  if (gr_context != gr_context_ || aiks_context != aiks_context_) {
+    Clear();
+    gr_context_ = gr_context;
+    aiks_context_ = aiks_context;
+  }
+  generation_++;
+}
+
+void LayerFlattenCache::EndFlatten() {
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    if (it->second.generation != generation_) {
+      it = entries_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+bool LayerFlattenCache::TryPaint(PaintContext& context, const Layer& layer) {
+  if (!layer.as_container_layer() || layer.subtree_has_platform_view() ||
+      layer.subtree_has_texture_layer()) {
+    return false;
+  }
+  // Inherited color and image filters can only be applied by the layers
+  // themselves, but inherited opacity can be applied to the cached
+  // DisplayList as a whole.
+  const LayerStateStack& state_stack = context.state_stack;
+  if (state_stack.outstanding_color_filter() ||
+      state_stack.outstanding_image_filter()) {
+    return false;
+  }
+
+  auto found = entries_.find(layer.unique_id());
+  sk_sp<DisplayList> display_list;
+  if (found != entries_.end()) {
+    MarkUsed(found->second);
+    display_list = found->second.display_list;
+  } else {
+    std::vector<uint64_t> nested_ids;
+    display_list = Record(context, layer, &nested_ids);
+    entries_[layer.unique_id()] = {
+        .display_list = display_list,
+        .generation = generation_,
+        .nested_ids = std::move(nested_ids),
+    };
+  }
+  if (recording_nested_ids_) {
+    recording_nested_ids_->push_back(layer.unique_id());
+  }
+
+  DlScalar opacity = state_stack.outstanding_opacity();
+  if (opacity < SK_Scalar1 && !display_list->can_apply_group_opacity()) {
+    return false;
+  }
+  context.canvas->DrawDisplayList(display_list, opacity);
+  return true;
+}
+
+void LayerFlattenCache::Clear() {
+  entries_.clear();
+}
+
+void LayerFlattenCache::MarkUsed(Entry& entry) {
+  entry.generation = generation_;
+  for (uint64_t id : entry.nested_ids) {
+    auto found = entries_.find(id);
+    if (found != entries_.end()) {
+      MarkUsed(found->second);
+    }
+  }
+}
+
+sk_sp<DisplayList> LayerFlattenCache::Record(
+    PaintContext& context,
+    const Layer& layer,
+    std::vector<uint64_t>* nested_ids) {
+  TRACE_EVENT0("flutter", "LayerFlattenCache::Record");
+  std::vector<uint64_t>* outer_nested_ids = recording_nested_ids_;
+  recording_nested_ids_ = nested_ids;
+  DisplayListBuilder builder;
+  LayerStateStack state_stack;
+  state_stack.set_delegate(&builder);
+  PaintContext layer_context = {
+      // clang-format off
+      .state_stack                   = state_stack,
+      .canvas                        = &builder,
+      .gr_context                    = context.gr_context,
+      .dst_color_space               = context.dst_color_space,
+      .view_embedder                 = nullptr,
+      .raster_time                   = context.raster_time,
+      .ui_time                       = context.ui_time,
+      .texture_registry              = context.texture_registry,
+#if !SLIMPELLER
+      .raster_cache                  = nullptr,
+#endif  //  !SLIMPELLER
+      .impeller_enabled              = context.impeller_enabled,
+      .aiks_context                  = context.aiks_context,
+      .flatten_cache                 = this,
+      // clang-format on
+  };
+  if (layer.needs_painting(layer_context)) {
+    layer.Paint(layer_context);
+  }
+  recording_nested_ids_ = outer_nested_ids;
+  return builder.Build();
+}
+
+}  // namespace flutter
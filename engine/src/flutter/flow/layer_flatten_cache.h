@@ -0,0 +1,100 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_LAYER_FLATTEN_CACHE_H_
+#define FLUTTER_FLOW_LAYER_FLATTEN_CACHE_H_
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "flutter/display_list/display_list.h"
+#include "flutter/fml/macros.h"
+
+class GrDirectContext;
+
+namespace impeller {
+class AiksContext;
+}  // namespace impeller
+
+namespace flutter {
+
+class Layer;
+struct PaintContext;
+
+//------------------------------------------------------------------------------
+/// Remembers the DisplayList recorded for each container layer the last time
+/// a |LayerTree| was flattened so that subsequent calls to
+/// |LayerTree::Flatten| only record the subtrees that changed.
+///
+/// Layers are immutable once they have been submitted to the raster thread,
+/// and the framework allocates a new layer whenever the content of a
+/// subtree changes, so the |Layer::unique_id| of a container identifies the
+/// content of its entire subtree. Subtrees that contain texture layers or
+/// platform views produce different results on every frame and are never
+/// cached.
+///
+/// Entries that were not used by the most recent flatten are discarded at
+/// the end of that flatten. Using an entry also uses the entries of the
+/// subtrees nested in it, so that they stay available to trees that retain
+/// only the nested subtrees.
+///
+/// This class is not thread safe and must only be used on the raster thread.
+///
+class LayerFlattenCache {
+ public:
+  LayerFlattenCache();
+
+  ~LayerFlattenCache();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Prepares the cache for a new flatten with the given contexts.
+  ///             Entries recorded for different contexts are discarded.
+  void BeginFlatten(const GrDirectContext* gr_context,
+                    const impeller::AiksContext* aiks_context);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Discards all entries that were not used since the last call
+  ///             to |BeginFlatten|.
+  void EndFlatten();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Paints |layer| into |context| by drawing its cached
+  ///             DisplayList, recording the DisplayList first if necessary.
+  ///
+  /// @return     false if |layer| cannot be painted from the cache, in which
+  ///             case the caller must paint it as usual.
+  bool TryPaint(PaintContext& context, const Layer& layer);
+
+  void Clear();
+
+  size_t GetEntryCount() const { return entries_.size(); }
+
+ private:
+  struct Entry {
+    sk_sp<DisplayList> display_list;
+    uint64_t generation;
+    // The layers with entries that are drawn by |display_list|.
+    std::vector<uint64_t> nested_ids;
+  };
+
+  sk_sp<DisplayList> Record(PaintContext& context,
+                            const Layer& layer,
+                            std::vector<uint64_t>* nested_ids);
+
+  void MarkUsed(Entry& entry);
+
+  std::unordered_map<uint64_t, Entry> entries_;
+  // The nested layers of the entry being recorded, if any.
+  std::vector<uint64_t>* recording_nested_ids_ = nullptr;
+  uint64_t generation_ = 0;
+  const GrDirectContext* gr_context_ = nullptr;
+  const impeller::AiksContext* aiks_context_ = nullptr;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(LayerFlattenCache);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_LAYER_FLATTEN_CACHE_H_
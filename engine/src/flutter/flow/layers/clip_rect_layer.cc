@@ -13,6 +13,12 @@ const DlRect ClipRectLayer::clip_shape_bounds() const {
   return clip_shape();
 }
 
+const DlRect ClipRectLayer::clip_shape_inner_bounds() const {
+  // Anti-aliased edges are only fully opaque on integer coordinates.
+  return clip_behavior() == Clip::kHardEdge ? clip_shape()
+                                            : DlRect::RoundIn(clip_shape());
+}
+
 void ClipRectLayer::ApplyClip(LayerStateStack::MutatorContext& mutator) const {
   mutator.clipRect(clip_shape(), clip_behavior() != Clip::kHardEdge);
 }
@@ -15,6 +15,7 @@ class ClipRectLayer : public ClipShapeLayer<DlRect> {
 
  protected:
   const DlRect clip_shape_bounds() const override;
+  const DlRect clip_shape_inner_bounds() const override;
 
   void ApplyClip(LayerStateStack::MutatorContext& mutator) const override;
   void PushClipToEmbeddedNativeViewMutatorStack(
@@ -68,6 +68,8 @@ class ClipShapeLayer : public CacheableContainerLayer {
     PrerollChildren(context, &child_paint_bounds);
     set_paint_bounds(
         child_paint_bounds.IntersectionOrEmpty(clip_shape_bounds()));
+    set_opaque_bounds(
+        child_opaque_bounds().IntersectionOrEmpty(clip_shape_inner_bounds()));
 
     // If we use a SaveLayer then we can accept opacity on behalf
     // of our children and apply it in the saveLayer.
@@ -111,6 +113,10 @@ class ClipShapeLayer : public CacheableContainerLayer {
 
  protected:
   virtual const DlRect clip_shape_bounds() const = 0;
+  // A rectangle inside of which the clip does not affect the opacity of
+  // the children. Shapes that are not rectangles report an empty rectangle
+  // and never propagate the opaque bounds of their children.
+  virtual const DlRect clip_shape_inner_bounds() const { return DlRect(); }
   virtual void ApplyClip(LayerStateStack::MutatorContext& mutator) const = 0;
   virtual void PushClipToEmbeddedNativeViewMutatorStack(
       ExternalViewEmbedder* view_embedder) const = 0;
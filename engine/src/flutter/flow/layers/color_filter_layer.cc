@@ -45,6 +45,8 @@ void ColorFilterLayer::Preroll(PrerollContext* context) {
 #endif  //  !SLIMPELLER
 
   ContainerLayer::Preroll(context);
+  // The filter may change the alpha of the children.
+  set_opaque_bounds(DlRect());
 
   // Our saveLayer would apply any outstanding opacity or any outstanding
   // image filter before it applies our color filter, but that is in the
@@ -4,8 +4,11 @@
 
 #include "flutter/flow/layers/container_layer.h"
 
+#include <algorithm>
 #include <optional>
 
+#include "flutter/flow/layer_flatten_cache.h"
+
 namespace flutter {
 
 ContainerLayer::ContainerLayer() {}
@@ -111,6 +114,7 @@ void ContainerLayer::Preroll(PrerollContext* context) {
   DlRect child_paint_bounds;
   PrerollChildren(context, &child_paint_bounds);
   set_paint_bounds(child_paint_bounds);
+  set_opaque_bounds(child_opaque_bounds());
 }
 
 void ContainerLayer::Paint(PaintContext& context) const {
@@ -129,6 +133,9 @@ void ContainerLayer::PrerollChildren(PrerollContext* context,
   bool child_has_platform_view = false;
   bool child_has_texture_layer = false;
   bool all_renderable_state_flags = LayerStateStack::kCallerCanApplyAnything;
+  bool surface_needs_readback = context->surface_needs_readback;
+  std::vector<bool> child_reads_back;
+  child_reads_back.reserve(layers_.size());
 
   for (auto& layer : layers_) {
     // Reset context->has_platform_view and context->has_texture_layer to false
@@ -141,8 +148,16 @@ void ContainerLayer::PrerollChildren(PrerollContext* context,
     // opt-in to applying state attributes during its |Preroll|
     context->renderable_state_flags = 0;
 
+    // Track readback per child so that content below a layer that reads
+    // back the surface is never treated as occluded.
+    context->surface_needs_readback = false;
+
     layer->Preroll(context);
 
+    child_reads_back.push_back(context->surface_needs_readback);
+    surface_needs_readback =
+        surface_needs_readback || context->surface_needs_readback;
+
     all_renderable_state_flags &= context->renderable_state_flags;
     if (child_paint_bounds->IntersectsWithRect(layer->paint_bounds())) {
       // This will allow inheritance by a linear sequence of non-overlapping
@@ -158,14 +173,72 @@ void ContainerLayer::PrerollChildren(PrerollContext* context,
         child_has_texture_layer || context->has_texture_layer;
   }
 
+  MarkOccludedChildren(context, child_reads_back);
+
+  context->surface_needs_readback = surface_needs_readback;
   context->has_platform_view = child_has_platform_view;
   context->has_texture_layer = child_has_texture_layer;
   context->renderable_state_flags = all_renderable_state_flags;
   set_subtree_has_platform_view(child_has_platform_view);
+  set_subtree_has_texture_layer(child_has_texture_layer);
   set_children_renderable_state_flags(all_renderable_state_flags);
   set_child_paint_bounds(*child_paint_bounds);
 }
 
+void ContainerLayer::MarkOccludedChildren(
+    PrerollContext* context,
+    const std::vector<bool>& child_reads_back) {
+  FML_DCHECK(child_reads_back.size() == layers_.size());
+
+  // Walk the children from the top-most (painted last) to the bottom-most,
+  // collecting the largest opaque bounds seen so far. A child that is
+  // entirely contained in the opaque bounds of a child painted after it
+  // would be overwritten and does not need to be painted.
+  std::vector<DlRect> occluders;
+  child_opaque_bounds_ = DlRect();
+  for (size_t i = layers_.size(); i-- > 0;) {
+    Layer* layer = layers_[i].get();
+    bool occluded = false;
+    if (!layer->subtree_has_platform_view() && !layer->is_empty()) {
+      for (const DlRect& occluder : occluders) {
+        if (occluder.Contains(layer->paint_bounds())) {
+          occluded = true;
+          break;
+        }
+      }
+    }
+    layer->set_occluded(occluded);
+    if (occluded) {
+      context->occluded_layer_count++;
+      continue;
+    }
+
+    if (child_reads_back[i]) {
+      // This child may read back (and spread) the content below it, so
+      // nothing below may be skipped.
+      occluders.clear();
+    }
+
+    const DlRect& opaque_bounds = layer->opaque_bounds();
+    if (opaque_bounds.IsEmpty()) {
+      continue;
+    }
+    if (opaque_bounds.Area() > child_opaque_bounds_.Area()) {
+      child_opaque_bounds_ = opaque_bounds;
+    }
+    if (occluders.size() < kMaxOccluders) {
+      occluders.push_back(opaque_bounds);
+    } else {
+      auto smallest = std::min_element(
+          occluders.begin(), occluders.end(),
+          [](const DlRect& a, const DlRect& b) { return a.Area() < b.Area(); });
+      if (smallest->Area() < opaque_bounds.Area()) {
+        *smallest = opaque_bounds;
+      }
+    }
+  }
+}
+
 void ContainerLayer::PaintChildren(PaintContext& context) const {
   // We can no longer call FML_DCHECK here on the needs_painting(context)
   // condition as that test is only valid for the PaintContext that
@@ -181,7 +254,11 @@ void ContainerLayer::PaintChildren(PaintContext& context) const {
   // Intentionally not tracing here as there should be no self-time
   // and the trace event on this common function has a small overhead.
   for (auto& layer : layers_) {
-    if (layer->needs_painting(context)) {
+    if (!layer->occluded() && layer->needs_painting(context)) {
+      if (context.flatten_cache &&
+          context.flatten_cache->TryPaint(context, *layer)) {
+        continue;
+      }
       layer->Paint(context);
     }
   }
@@ -37,6 +37,10 @@ class ContainerLayer : public Layer {
     child_paint_bounds_ = bounds;
   }
 
+  // The largest of the opaque bounds of the children, as determined during
+  // PrerollChildren().
+  const DlRect& child_opaque_bounds() const { return child_opaque_bounds_; }
+
   int children_renderable_state_flags() const {
     return children_renderable_state_flags_;
   }
@@ -48,8 +52,16 @@ class ContainerLayer : public Layer {
   void PrerollChildren(PrerollContext* context, DlRect* child_paint_bounds);
 
  private:
+  // The number of opaque bounds of later children that each child is
+  // checked against when determining occlusion.
+  static constexpr size_t kMaxOccluders = 4;
+
+  void MarkOccludedChildren(PrerollContext* context,
+                            const std::vector<bool>& child_reads_back);
+
   std::vector<std::shared_ptr<Layer>> layers_;
   DlRect child_paint_bounds_;
+  DlRect child_opaque_bounds_;
   int children_renderable_state_flags_ = 0;
 
   FML_DISALLOW_COPY_AND_ASSIGN(ContainerLayer);
@@ -4,6 +4,8 @@
 
 #include "flutter/flow/layers/container_layer.h"
 
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/flow/layers/display_list_layer.h"
 #include "flutter/flow/layers/layer.h"
 #include "flutter/flow/layers/layer_tree.h"
 #include "flutter/flow/testing/diff_context_test.h"
@@ -549,6 +551,140 @@ TEST_F(ContainerLayerTest, CollectionCacheableLayer) {
             static_cast<const unsigned long>(2));
 }
 
+namespace {
+
+std::shared_ptr<DisplayListLayer> MakeRectLayer(const DlRect& rect,
+                                                const DlPaint& paint) {
+  DisplayListBuilder builder;
+  builder.DrawRect(rect, paint);
+  return std::make_shared<DisplayListLayer>(DlPoint(), builder.Build(), false,
+                                            false);
+}
+
+}  // namespace
+
+TEST_F(ContainerLayerTest, ChildCoveredByOpaqueSiblingIsNotPainted) {
+  const DlRect bottom_rect = DlRect::MakeLTRB(10, 10, 40, 40);
+  const DlRect top_rect = DlRect::MakeLTRB(0, 0, 50, 50);
+  auto bottom_layer = MakeRectLayer(bottom_rect, DlPaint(DlColor::kRed()));
+  auto top_layer = MakeRectLayer(top_rect, DlPaint(DlColor::kBlue()));
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(bottom_layer);
+  layer->Add(top_layer);
+
+  layer->Preroll(preroll_context());
+  EXPECT_TRUE(bottom_layer->occluded());
+  EXPECT_FALSE(top_layer->occluded());
+  EXPECT_EQ(top_layer->opaque_bounds(), top_rect);
+  EXPECT_EQ(layer->opaque_bounds(), top_rect);
+  EXPECT_EQ(preroll_context()->occluded_layer_count, 1u);
+  EXPECT_EQ(layer->paint_bounds(), top_rect);
+
+  layer->Paint(display_list_paint_context());
+  DisplayListBuilder expected_builder;
+  /* (Container)layer::Paint */ {
+    /* top_layer::Paint */ {
+      expected_builder.Save();
+      expected_builder.Translate(0, 0);
+      expected_builder.DrawDisplayList(sk_ref_sp(top_layer->display_list()));
+      expected_builder.Restore();
+    }
+  }
+  EXPECT_TRUE(DisplayListsEQ_Verbose(display_list(), expected_builder.Build()));
+}
+
+TEST_F(ContainerLayerTest, TranslucentSiblingDoesNotOcclude) {
+  auto bottom_layer = MakeRectLayer(DlRect::MakeLTRB(10, 10, 40, 40),
+                                    DlPaint(DlColor::kRed()));
+  auto top_layer = MakeRectLayer(DlRect::MakeLTRB(0, 0, 50, 50),
+                                 DlPaint(DlColor::kBlue().withAlpha(0x7f)));
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(bottom_layer);
+  layer->Add(top_layer);
+
+  layer->Preroll(preroll_context());
+  EXPECT_FALSE(bottom_layer->occluded());
+  EXPECT_FALSE(top_layer->occluded());
+  EXPECT_TRUE(layer->opaque_bounds().IsEmpty());
+  EXPECT_EQ(preroll_context()->occluded_layer_count, 0u);
+}
+
+TEST_F(ContainerLayerTest, PartiallyCoveredChildIsNotOccluded) {
+  auto bottom_layer = MakeRectLayer(DlRect::MakeLTRB(10, 10, 60, 60),
+                                    DlPaint(DlColor::kRed()));
+  auto top_layer = MakeRectLayer(DlRect::MakeLTRB(0, 0, 50, 50),
+                                 DlPaint(DlColor::kBlue()));
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(bottom_layer);
+  layer->Add(top_layer);
+
+  layer->Preroll(preroll_context());
+  EXPECT_FALSE(bottom_layer->occluded());
+  EXPECT_EQ(preroll_context()->occluded_layer_count, 0u);
+}
+
+TEST_F(ContainerLayerTest, ReadbackLayerPreventsOcclusion) {
+  auto bottom_layer = MakeRectLayer(DlRect::MakeLTRB(10, 10, 40, 40),
+                                    DlPaint(DlColor::kRed()));
+  auto readback_layer = std::make_shared<MockLayer>(
+      DlPath::MakeRectLTRB(60, 60, 70, 70), DlPaint(DlColor::kGreen()));
+  readback_layer->set_fake_reads_surface(true);
+  auto top_layer = MakeRectLayer(DlRect::MakeLTRB(0, 0, 50, 50),
+                                 DlPaint(DlColor::kBlue()));
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(bottom_layer);
+  layer->Add(readback_layer);
+  layer->Add(top_layer);
+
+  layer->Preroll(preroll_context());
+  EXPECT_TRUE(preroll_context()->surface_needs_readback);
+  EXPECT_FALSE(readback_layer->occluded());
+  EXPECT_FALSE(bottom_layer->occluded());
+  EXPECT_EQ(preroll_context()->occluded_layer_count, 0u);
+}
+
+TEST_F(ContainerLayerTest, OccludedReadbackLayerIsSkipped) {
+  auto bottom_layer = MakeRectLayer(DlRect::MakeLTRB(10, 10, 40, 40),
+                                    DlPaint(DlColor::kRed()));
+  auto readback_layer = std::make_shared<MockLayer>(
+      DlPath::MakeRectLTRB(20, 20, 30, 30), DlPaint(DlColor::kGreen()));
+  readback_layer->set_fake_reads_surface(true);
+  auto top_layer = MakeRectLayer(DlRect::MakeLTRB(0, 0, 50, 50),
+                                 DlPaint(DlColor::kBlue()));
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(bottom_layer);
+  layer->Add(readback_layer);
+  layer->Add(top_layer);
+
+  layer->Preroll(preroll_context());
+  // The readback layer is hidden and never painted, so it cannot observe
+  // the layer below it either.
+  EXPECT_TRUE(readback_layer->occluded());
+  EXPECT_TRUE(bottom_layer->occluded());
+  EXPECT_EQ(preroll_context()->occluded_layer_count, 2u);
+}
+
+TEST_F(ContainerLayerTest, ReadbackLayerAboveKeepsLowerLayersVisible) {
+  auto bottom_layer = MakeRectLayer(DlRect::MakeLTRB(10, 10, 40, 40),
+                                    DlPaint(DlColor::kRed()));
+  auto middle_layer = MakeRectLayer(DlRect::MakeLTRB(0, 0, 50, 50),
+                                    DlPaint(DlColor::kBlue()));
+  auto readback_layer = std::make_shared<MockLayer>(
+      DlPath::MakeRectLTRB(0, 0, 100, 100), DlPaint(DlColor::kGreen()));
+  readback_layer->set_fake_reads_surface(true);
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(bottom_layer);
+  layer->Add(middle_layer);
+  layer->Add(readback_layer);
+
+  layer->Preroll(preroll_context());
+  // The readback layer only reads what is painted, it does not change what
+  // the opaque middle layer hides.
+  EXPECT_TRUE(bottom_layer->occluded());
+  EXPECT_FALSE(middle_layer->occluded());
+  EXPECT_FALSE(readback_layer->occluded());
+}
+
 using ContainerLayerDiffTest = DiffContextTest;
 
 // Insert PictureLayer amongst container layers
@@ -9,6 +9,7 @@
 #include "flutter/display_list/dl_builder.h"
 #include "flutter/flow/layers/cacheable_layer.h"
 #include "flutter/flow/layers/offscreen_surface.h"
+#include "flutter/flow/opaque_bounds_spy.h"
 #include "flutter/flow/raster_cache.h"
 #include "flutter/flow/raster_cache_util.h"
 
@@ -104,6 +105,12 @@ void DisplayListLayer::Preroll(PrerollContext* context) {
     context->renderable_state_flags = LayerStateStack::kCallerCanApplyOpacity;
   }
   set_paint_bounds(bounds_);
+
+  if (!opaque_bounds_.has_value()) {
+    opaque_bounds_ =
+        OpaqueBoundsSpy::ComputeOpaqueBounds(*disp_list).Shift(offset_);
+  }
+  set_opaque_bounds(opaque_bounds_.value());
 }
 
 void DisplayListLayer::Paint(PaintContext& context) const {
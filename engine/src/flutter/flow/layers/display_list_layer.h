@@ -6,6 +6,7 @@
 #define FLUTTER_FLOW_LAYERS_DISPLAY_LIST_LAYER_H_
 
 #include <memory>
+#include <optional>
 
 #include "flutter/common/macros.h"
 #include "flutter/display_list/display_list.h"
@@ -55,6 +56,8 @@ class DisplayListLayer : public Layer {
 
   DlPoint offset_;
   DlRect bounds_;
+  // Computed on first Preroll, see |OpaqueBoundsSpy|.
+  std::optional<DlRect> opaque_bounds_;
 
   sk_sp<DisplayList> display_list_;
 
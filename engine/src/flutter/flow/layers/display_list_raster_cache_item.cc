@@ -168,6 +168,7 @@ bool DisplayListRasterCacheItem::TryToPrepareRasterCache(
       .matrix             = transformation_matrix_,
       .logical_rect       = bounds,
       .flow_type          = flow_type,
+      .display_list       = display_list_,
       // clang-format on
   };
   return context.raster_cache->UpdateCacheEntry(
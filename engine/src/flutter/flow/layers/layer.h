@@ -33,6 +33,7 @@ class MockLayer;
 
 class ContainerLayer;
 class DisplayListLayer;
+class LayerFlattenCache;
 class PerformanceOverlayLayer;
 class TextureLayer;
 class RasterCacheItem;
@@ -73,6 +74,10 @@ struct PrerollContext {
   int renderable_state_flags = 0;
 
   std::vector<RasterCacheItem*>* raster_cached_entries;
+
+  // The number of layers that were found to be hidden behind the opaque
+  // bounds of a sibling during Preroll and will be skipped during Paint.
+  size_t occluded_layer_count = 0;
 };
 
 struct PaintContext {
@@ -106,6 +111,11 @@ struct PaintContext {
 
   bool impeller_enabled = false;
   impeller::AiksContext* aiks_context;
+
+  // When non-null, the layer tree is being flattened into a DisplayList and
+  // unchanged subtrees may be painted from the DisplayLists recorded for
+  // them by a previous flatten.
+  LayerFlattenCache* flatten_cache = nullptr;
 };
 
 // Represents a single composited layer. Created on the UI thread but then
@@ -189,6 +199,11 @@ class Layer {
     subtree_has_platform_view_ = value;
   }
 
+  bool subtree_has_texture_layer() const { return subtree_has_texture_layer_; }
+  void set_subtree_has_texture_layer(bool value) {
+    subtree_has_texture_layer_ = value;
+  }
+
   // Returns the paint bounds in the layer's local coordinate system
   // as determined during Preroll().  The bounds should include any
   // transform, clip or distortions performed by the layer itself,
@@ -213,6 +228,25 @@ class Layer {
   // Determines if the layer has any content.
   bool is_empty() const { return paint_bounds_.IsEmpty(); }
 
+  // Returns a rect in the same coordinate system as |paint_bounds| that
+  // is known to be covered with fully opaque content once the layer has
+  // been painted, as determined during Preroll(). An empty rect means that
+  // the layer makes no such guarantee, which is the default.
+  const DlRect& opaque_bounds() const { return opaque_bounds_; }
+
+  // Layers that can guarantee opaque content must set the opaque bounds
+  // during every Preroll(). A ContainerLayer will skip painting any of its
+  // children that are entirely hidden by the opaque bounds of a child that
+  // is painted after them.
+  void set_opaque_bounds(const DlRect& opaque_bounds) {
+    opaque_bounds_ = opaque_bounds;
+  }
+
+  // Whether the parent of this layer determined during Preroll() that the
+  // layer is hidden behind the opaque bounds of one of its siblings.
+  bool occluded() const { return occluded_; }
+  void set_occluded(bool occluded) { occluded_ = occluded; }
+
   // Determines if the Paint() method is necessary based on the properties
   // of the indicated PaintContext object.
   bool needs_painting(PaintContext& context) const {
@@ -253,9 +287,12 @@ class Layer {
 
  private:
   DlRect paint_bounds_;
+  DlRect opaque_bounds_;
   uint64_t unique_id_;
   uint64_t original_layer_id_;
   bool subtree_has_platform_view_ = false;
+  bool subtree_has_texture_layer_ = false;
+  bool occluded_ = false;
 
   static uint64_t NextUniqueID();
 
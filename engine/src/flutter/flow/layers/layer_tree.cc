@@ -7,6 +7,7 @@
 #include "flutter/display_list/skia/dl_sk_canvas.h"
 #include "flutter/flow/embedded_views.h"
 #include "flutter/flow/frame_timings.h"
+#include "flutter/flow/layer_flatten_cache.h"
 #include "flutter/flow/layers/layer.h"
 #include "flutter/flow/paint_utils.h"
 #include "flutter/flow/raster_cache.h"
@@ -60,6 +61,12 @@ bool LayerTree::Preroll(CompositorContext::ScopedFrame& frame,
 
   root_layer_->Preroll(&context);
 
+  occluded_layer_count_ = context.occluded_layer_count;
+#if !FLUTTER_RELEASE
+  FML_TRACE_COUNTER("flutter", "LayerTree", reinterpret_cast<int64_t>(this),
+                    "OccludedLayers", occluded_layer_count_);
+#endif  // !FLUTTER_RELEASE
+
   return context.surface_needs_readback;
 }
 
@@ -134,21 +141,28 @@ void LayerTree::Paint(CompositorContext::ScopedFrame& frame,
 
 #if !SLIMPELLER
   if (cache) {
+    fml::TimePoint raster_cache_start = fml::TimePoint::Now();
     cache->EvictUnusedCacheEntries();
     TryToRasterCache(raster_cache_items_, &context, ignore_raster_cache);
+    frame.AddPhaseDuration(FrameTimingsRecorder::Phase::kRasterCache,
+                           fml::TimePoint::Now() - raster_cache_start);
   }
 #endif  //  !SLIMPELLER
 
+  fml::TimePoint paint_start = fml::TimePoint::Now();
   if (root_layer_->needs_painting(context)) {
     root_layer_->Paint(context);
   }
+  frame.AddPhaseDuration(FrameTimingsRecorder::Phase::kPaint,
+                         fml::TimePoint::Now() - paint_start);
 }
 
 sk_sp<DisplayList> LayerTree::Flatten(
     const DlRect& bounds,
     const std::shared_ptr<TextureRegistry>& texture_registry,
     GrDirectContext* gr_context,
-    impeller::AiksContext* aiks_context) {
+    impeller::AiksContext* aiks_context,
+    LayerFlattenCache* flatten_cache) {
   TRACE_EVENT0("flutter", "LayerTree::Flatten");
 
   DisplayListBuilder builder(bounds);
@@ -191,9 +205,14 @@ sk_sp<DisplayList> LayerTree::Flatten(
 #endif  //  !SLIMPELLER
       .impeller_enabled              = !!aiks_context,
       .aiks_context                  = aiks_context,
+      .flatten_cache                 = flatten_cache,
       // clang-format on
   };
 
+  if (flatten_cache) {
+    flatten_cache->BeginFlatten(gr_context, aiks_context);
+  }
+
   // Even if we don't have a root layer, we still need to create an empty
   // picture.
   if (root_layer_) {
@@ -205,6 +224,10 @@ sk_sp<DisplayList> LayerTree::Flatten(
     }
   }
 
+  if (flatten_cache) {
+    flatten_cache->EndFlatten();
+  }
+
   return builder.Build();
 }
 
@@ -45,11 +45,16 @@ class LayerTree {
   void Paint(CompositorContext::ScopedFrame& frame,
              bool ignore_raster_cache = false) const;
 
+  // Records the layer tree into a DisplayList. When a |flatten_cache| is
+  // provided, subtrees that were already flattened by a previous call with
+  // the same cache are drawn from the cached DisplayLists instead of being
+  // recorded again.
   sk_sp<DisplayList> Flatten(
       const DlRect& bounds,
       const std::shared_ptr<TextureRegistry>& texture_registry = nullptr,
       GrDirectContext* gr_context = nullptr,
-      impeller::AiksContext* aiks_context = nullptr);
+      impeller::AiksContext* aiks_context = nullptr,
+      LayerFlattenCache* flatten_cache = nullptr);
 
   Layer* root_layer() const { return root_layer_.get(); }
   const DlISize& frame_size() const { return frame_size_; }
@@ -57,6 +62,10 @@ class LayerTree {
   const PaintRegionMap& paint_region_map() const { return paint_region_map_; }
   PaintRegionMap& paint_region_map() { return paint_region_map_; }
 
+  // The number of layers that the last Preroll found to be hidden behind
+  // opaque siblings. These layers are not painted.
+  size_t occluded_layer_count() const { return occluded_layer_count_; }
+
  private:
   std::shared_ptr<Layer> root_layer_;
   DlISize frame_size_;  // Physical pixels.
@@ -65,6 +74,8 @@ class LayerTree {
 
   std::vector<RasterCacheItem*> raster_cache_items_;
 
+  size_t occluded_layer_count_ = 0;
+
   FML_DISALLOW_COPY_AND_ASSIGN(LayerTree);
 };
 
@@ -6,6 +6,7 @@
 #include "flutter/flow/layers/layer_tree.h"
 
 #include "flutter/flow/compositor_context.h"
+#include "flutter/flow/layer_flatten_cache.h"
 #include "flutter/flow/layers/container_layer.h"
 #include "flutter/flow/raster_cache.h"
 #include "flutter/flow/testing/mock_layer.h"
@@ -316,5 +317,113 @@ TEST_F(LayerTreeTest, FlattenInitializesContexts) {
                       /*gr_context=*/nullptr, fake_aiks);
 }
 
+TEST_F(LayerTreeTest, FlattenCacheOnlyRecordsChangedSubtrees) {
+  auto retained_leaf = std::make_shared<MockFlattenLayer>();
+  auto retained_container = std::make_shared<ContainerLayer>();
+  retained_container->Add(retained_leaf);
+  auto replaced_leaf = std::make_shared<MockFlattenLayer>();
+  auto replaced_container = std::make_shared<ContainerLayer>();
+  replaced_container->Add(replaced_leaf);
+
+  auto root = std::make_shared<ContainerLayer>();
+  root->Add(retained_container);
+  root->Add(replaced_container);
+  auto layer_tree = BuildLayerTree(root);
+
+  LayerFlattenCache cache;
+  EXPECT_CALL(*retained_leaf, Paint(::testing::_)).Times(1);
+  EXPECT_CALL(*replaced_leaf, Paint(::testing::_)).Times(1);
+  layer_tree->Flatten(DlRect::MakeWH(100, 100), nullptr, nullptr, nullptr,
+                      &cache);
+  EXPECT_EQ(cache.GetEntryCount(), 2u);
+
+  // Flattening the same tree again does not paint any of the leaves.
+  layer_tree->Flatten(DlRect::MakeWH(100, 100), nullptr, nullptr, nullptr,
+                      &cache);
+  EXPECT_EQ(cache.GetEntryCount(), 2u);
+
+  // A new tree that retains one of the subtrees only records the new one.
+  auto new_leaf = std::make_shared<MockFlattenLayer>();
+  auto new_container = std::make_shared<ContainerLayer>();
+  new_container->Add(new_leaf);
+  auto new_root = std::make_shared<ContainerLayer>();
+  new_root->Add(retained_container);
+  new_root->Add(new_container);
+  auto new_layer_tree = BuildLayerTree(new_root);
+
+  EXPECT_CALL(*new_leaf, Paint(::testing::_)).Times(1);
+  new_layer_tree->Flatten(DlRect::MakeWH(100, 100), nullptr, nullptr, nullptr,
+                          &cache);
+  // The entry for the subtree that is no longer in use has been dropped.
+  EXPECT_EQ(cache.GetEntryCount(), 2u);
+}
+
+TEST_F(LayerTreeTest, FlattenCacheKeepsNestedSubtreesOfCachedSubtrees) {
+  auto inner_leaf = std::make_shared<MockFlattenLayer>();
+  auto inner_container = std::make_shared<ContainerLayer>();
+  inner_container->Add(inner_leaf);
+  auto outer_container = std::make_shared<ContainerLayer>();
+  outer_container->Add(inner_container);
+  auto root = std::make_shared<ContainerLayer>();
+  root->Add(outer_container);
+
+  LayerFlattenCache cache;
+  EXPECT_CALL(*inner_leaf, Paint(::testing::_)).Times(1);
+  BuildLayerTree(root)->Flatten(DlRect::MakeWH(100, 100), nullptr, nullptr,
+                                nullptr, &cache);
+  EXPECT_EQ(cache.GetEntryCount(), 2u);
+
+  // The outer subtree is drawn from the cache, which keeps the entry of the
+  // inner subtree as well.
+  BuildLayerTree(root)->Flatten(DlRect::MakeWH(100, 100), nullptr, nullptr,
+                                nullptr, &cache);
+  EXPECT_EQ(cache.GetEntryCount(), 2u);
+
+  // A new outer subtree that retains the inner subtree does not record the
+  // inner subtree again.
+  auto new_outer_container = std::make_shared<ContainerLayer>();
+  new_outer_container->Add(inner_container);
+  auto new_root = std::make_shared<ContainerLayer>();
+  new_root->Add(new_outer_container);
+  BuildLayerTree(new_root)->Flatten(DlRect::MakeWH(100, 100), nullptr,
+                                    nullptr, nullptr, &cache);
+  EXPECT_EQ(cache.GetEntryCount(), 2u);
+}
+
+TEST_F(LayerTreeTest, FlattenCacheIsClearedWhenContextChanges) {
+  auto leaf = std::make_shared<MockFlattenLayer>();
+  auto container = std::make_shared<ContainerLayer>();
+  container->Add(leaf);
+  auto root = std::make_shared<ContainerLayer>();
+  root->Add(container);
+  auto layer_tree = BuildLayerTree(root);
+
+  LayerFlattenCache cache;
+  EXPECT_CALL(*leaf, Paint(::testing::_)).Times(2);
+  layer_tree->Flatten(DlRect::MakeWH(100, 100), nullptr, nullptr, nullptr,
+                      &cache);
+  auto fake_aiks = reinterpret_cast<impeller::AiksContext*>(0x1234);
+  layer_tree->Flatten(DlRect::MakeWH(100, 100), nullptr, nullptr, fake_aiks,
+                      &cache);
+  EXPECT_EQ(cache.GetEntryCount(), 1u);
+}
+
+TEST_F(LayerTreeTest, FlattenCacheSkipsSubtreesWithTextures) {
+  auto texture_leaf =
+      std::make_shared<MockLayer>(DlPath::MakeRectLTRB(0, 0, 10, 10));
+  texture_leaf->set_fake_has_texture_layer(true);
+  auto container = std::make_shared<ContainerLayer>();
+  container->Add(texture_leaf);
+  auto root = std::make_shared<ContainerLayer>();
+  root->Add(container);
+  auto layer_tree = BuildLayerTree(root);
+
+  LayerFlattenCache cache;
+  layer_tree->Flatten(DlRect::MakeWH(100, 100), nullptr, nullptr, nullptr,
+                      &cache);
+  EXPECT_TRUE(container->subtree_has_texture_layer());
+  EXPECT_EQ(cache.GetEntryCount(), 0u);
+}
+
 }  // namespace testing
 }  // namespace flutter
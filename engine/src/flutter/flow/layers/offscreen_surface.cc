@@ -11,6 +11,7 @@
 #include "third_party/skia/include/core/SkImage.h"
 #include "third_party/skia/include/core/SkImageInfo.h"
 #include "third_party/skia/include/core/SkPixmap.h"
+#include "third_party/skia/include/core/SkStream.h"
 #include "third_party/skia/include/encode/SkPngEncoder.h"
 #include "third_party/skia/include/gpu/ganesh/GrDirectContext.h"
 #include "third_party/skia/include/gpu/ganesh/SkSurfaceGanesh.h"
@@ -33,39 +34,48 @@ static sk_sp<SkSurface> CreateSnapshotSurface(GrDirectContext* surface_context,
   return SkSurfaces::Raster(image_info);
 }
 
+/// Encodes the pixels as PNG, streaming the encoded rows into the returned
+/// buffer.
+static sk_sp<SkData> EncodePng(const SkPixmap& pixmap) {
+  SkDynamicMemoryWStream stream;
+  if (!SkPngEncoder::Encode(&stream, pixmap, {})) {
+    FML_LOG(ERROR) << "Screenshot: unable to encode PNG";
+    return nullptr;
+  }
+  return stream.detachAsData();
+}
+
 /// Returns a buffer containing a snapshot of the surface.
 ///
 /// If compressed is true the data is encoded as PNG.
+///
+/// The pixels are read straight from the surface, without creating an
+/// intermediate image snapshot. Raster surfaces are encoded in place and
+/// GPU surfaces are read back directly into the buffer that is returned (or
+/// encoded).
 static sk_sp<SkData> GetRasterData(const sk_sp<SkSurface>& offscreen_surface,
                                    bool compressed) {
-  // Prepare an image from the surface, this image may potentially be on th GPU.
-  auto potentially_gpu_snapshot = offscreen_surface->makeImageSnapshot();
-  if (!potentially_gpu_snapshot) {
-    FML_LOG(ERROR) << "Screenshot: unable to make image screenshot";
-    return nullptr;
+  SkPixmap pixmap;
+  if (offscreen_surface->peekPixels(&pixmap)) {
+    if (compressed) {
+      return EncodePng(pixmap);
+    }
+    return SkData::MakeWithCopy(pixmap.addr(), pixmap.computeByteSize());
   }
 
-  // Copy the GPU image snapshot into CPU memory.
+  // The surface is on the GPU, copy it into CPU memory.
   // TODO (https://github.com/flutter/flutter/issues/13498)
-  auto cpu_snapshot = potentially_gpu_snapshot->makeRasterImage(nullptr);
-  if (!cpu_snapshot) {
-    FML_LOG(ERROR) << "Screenshot: unable to make raster image";
+  const SkImageInfo& info = offscreen_surface->imageInfo();
+  sk_sp<SkData> data = SkData::MakeUninitialized(info.computeMinByteSize());
+  SkPixmap readback(info, data->writable_data(), info.minRowBytes());
+  if (!offscreen_surface->readPixels(readback, 0, 0)) {
+    FML_LOG(ERROR) << "Screenshot: unable to read surface pixels";
     return nullptr;
   }
-
-  // If the caller want the pixels to be compressed, there is a Skia utility to
-  // compress to PNG. Use that.
   if (compressed) {
-    return SkPngEncoder::Encode(nullptr, cpu_snapshot.get(), {});
-  }
-
-  // Copy it into a bitmap and return the same.
-  SkPixmap pixmap;
-  if (!cpu_snapshot->peekPixels(&pixmap)) {
-    FML_LOG(ERROR) << "Screenshot: unable to obtain bitmap pixels";
-    return nullptr;
+    return EncodePng(readback);
   }
-  return SkData::MakeWithCopy(pixmap.addr32(), pixmap.computeByteSize());
+  return data;
 }
 
 OffscreenSurface::OffscreenSurface(GrDirectContext* surface_context,
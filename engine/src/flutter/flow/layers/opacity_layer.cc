@@ -57,6 +57,9 @@ void OpacityLayer::Preroll(PrerollContext* context) {
   context->renderable_state_flags |= LayerStateStack::kCallerCanApplyOpacity;
 
   set_paint_bounds(paint_bounds().Shift(offset_));
+  set_opaque_bounds(alpha_ == 0xFF
+                        ? child_opaque_bounds().Shift(offset_)
+                        : DlRect());
 
 #if !SLIMPELLER
   if (children_can_accept_opacity()) {
@@ -42,6 +42,8 @@ void ShaderMaskLayer::Preroll(PrerollContext* context) {
                               context->state_stack.matrix());
 #endif  //  !SLIMPELLER
   ContainerLayer::Preroll(context);
+  // The mask can make any part of the children translucent.
+  set_opaque_bounds(DlRect());
   // We always paint with a saveLayer (or a cached rendering),
   // so we can always apply opacity in any of those cases.
   context->renderable_state_flags = kSaveLayerRenderFlags;
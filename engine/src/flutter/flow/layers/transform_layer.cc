@@ -40,6 +40,15 @@ void TransformLayer::Preroll(PrerollContext* context) {
 
   child_paint_bounds = child_paint_bounds.TransformAndClipBounds(transform_);
   set_paint_bounds(child_paint_bounds);
+
+  // Only axis aligned transforms map an opaque rectangle to a rectangle.
+  if (transform_.IsAligned2D() && transform_.IsInvertible() &&
+      !child_opaque_bounds().IsEmpty()) {
+    set_opaque_bounds(DlRect::RoundIn(
+        child_opaque_bounds().TransformAndClipBounds(transform_)));
+  } else {
+    set_opaque_bounds(DlRect());
+  }
 }
 
 void TransformLayer::Paint(PaintContext& context) const {
@@ -0,0 +1,214 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/opaque_bounds_spy.h"
+
+#include "flutter/display_list/effects/dl_color_source.h"
+
+namespace flutter {
+
+OpaqueBoundsSpy::OpaqueBoundsSpy() {
+  state_stack_.emplace_back();
+}
+
+DlRect OpaqueBoundsSpy::GetOpaqueBounds(const DlRect& bounds) const {
+  if (may_erase_ || opaque_bounds_.IsEmpty()) {
+    return DlRect();
+  }
+  DlRect opaque_bounds =
+      DlRect::RoundIn(opaque_bounds_.IntersectionOrEmpty(bounds));
+  return opaque_bounds.IsEmpty() ? DlRect() : opaque_bounds;
+}
+
+DlRect OpaqueBoundsSpy::ComputeOpaqueBounds(const DisplayList& display_list) {
+  OpaqueBoundsSpy spy;
+  display_list.Dispatch(spy);
+  return spy.GetOpaqueBounds(display_list.GetBounds());
+}
+
+bool OpaqueBoundsSpy::PaintIsOpaque() const {
+  if (style_ != DlDrawStyle::kFill || has_color_filter_ || has_image_filter_ ||
+      has_mask_filter_) {
+    return false;
+  }
+  if (has_color_source_) {
+    // The paint alpha still modulates the shader.
+    return color_source_is_opaque_ && color_.isOpaque();
+  }
+  return color_.isOpaque();
+}
+
+bool OpaqueBoundsSpy::DrawsUnclippedToDestination() const {
+  const State& state = state_stack_.back();
+  return !state.is_layer && !state.is_clipped &&
+         state.matrix.IsAligned2D() && state.matrix.IsInvertible();
+}
+
+void OpaqueBoundsSpy::AccumulateOpaqueRect(const DlRect& device_rect) {
+  if (device_rect.Area() > opaque_bounds_.Area()) {
+    opaque_bounds_ = device_rect;
+  }
+}
+
+void OpaqueBoundsSpy::setDrawStyle(DlDrawStyle style) {
+  style_ = style;
+}
+void OpaqueBoundsSpy::setColor(DlColor color) {
+  color_ = color;
+}
+void OpaqueBoundsSpy::setBlendMode(DlBlendMode mode) {
+  // Blend modes other than kSrcOver can reduce the alpha of the destination.
+  // The attribute is not scoped by save/restore so there is no cheap way to
+  // know which operations it applies to, give up entirely.
+  if (mode != DlBlendMode::kSrcOver) {
+    may_erase_ = true;
+  }
+}
+void OpaqueBoundsSpy::setColorSource(const DlColorSource* source) {
+  has_color_source_ = source != nullptr;
+  color_source_is_opaque_ = source == nullptr || source->is_opaque();
+}
+void OpaqueBoundsSpy::setImageFilter(const DlImageFilter* filter) {
+  has_image_filter_ = filter != nullptr;
+}
+void OpaqueBoundsSpy::setColorFilter(const DlColorFilter* filter) {
+  has_color_filter_ = filter != nullptr;
+}
+void OpaqueBoundsSpy::setMaskFilter(const DlMaskFilter* filter) {
+  has_mask_filter_ = filter != nullptr;
+}
+
+void OpaqueBoundsSpy::translate(DlScalar tx, DlScalar ty) {
+  DlMatrix& matrix = state_stack_.back().matrix;
+  matrix = matrix.Translate({tx, ty});
+}
+void OpaqueBoundsSpy::scale(DlScalar sx, DlScalar sy) {
+  DlMatrix& matrix = state_stack_.back().matrix;
+  matrix = matrix.Scale({sx, sy, 1.0f});
+}
+void OpaqueBoundsSpy::rotate(DlScalar degrees) {
+  DlMatrix& matrix = state_stack_.back().matrix;
+  matrix = matrix * DlMatrix::MakeRotationZ(DlDegrees(degrees));
+}
+void OpaqueBoundsSpy::skew(DlScalar sx, DlScalar sy) {
+  DlMatrix& matrix = state_stack_.back().matrix;
+  matrix = matrix * DlMatrix::MakeSkew(sx, sy);
+}
+// clang-format off
+void OpaqueBoundsSpy::transform2DAffine(
+    DlScalar mxx, DlScalar mxy, DlScalar mxt,
+    DlScalar myx, DlScalar myy, DlScalar myt) {
+  DlMatrix& matrix = state_stack_.back().matrix;
+  matrix = matrix * DlMatrix::MakeRow(
+      mxx,  mxy, 0.0f,  mxt,
+      myx,  myy, 0.0f,  myt,
+     0.0f, 0.0f, 1.0f, 0.0f,
+     0.0f, 0.0f, 0.0f, 1.0f
+  );
+}
+void OpaqueBoundsSpy::transformFullPerspective(
+    DlScalar mxx, DlScalar mxy, DlScalar mxz, DlScalar mxt,
+    DlScalar myx, DlScalar myy, DlScalar myz, DlScalar myt,
+    DlScalar mzx, DlScalar mzy, DlScalar mzz, DlScalar mzt,
+    DlScalar mwx, DlScalar mwy, DlScalar mwz, DlScalar mwt) {
+  DlMatrix& matrix = state_stack_.back().matrix;
+  matrix = matrix * DlMatrix::MakeRow(
+      mxx, mxy, mxz, mxt,
+      myx, myy, myz, myt,
+      mzx, mzy, mzz, mzt,
+      mwx, mwy, mwz, mwt
+  );
+}
+// clang-format on
+void OpaqueBoundsSpy::transformReset() {
+  state_stack_.back().matrix = DlMatrix();
+}
+
+// Non-rectangular clips cannot be described by a single inner rectangle and
+// rectangular clips are rare at the root of a layer's DisplayList, so any
+// clip simply stops draws at the current save level from contributing.
+void OpaqueBoundsSpy::clipRect(const DlRect& rect,
+                               DlClipOp clip_op,
+                               bool is_aa) {
+  state_stack_.back().is_clipped = true;
+}
+void OpaqueBoundsSpy::clipOval(const DlRect& bounds,
+                               DlClipOp clip_op,
+                               bool is_aa) {
+  state_stack_.back().is_clipped = true;
+}
+void OpaqueBoundsSpy::clipRoundRect(const DlRoundRect& rrect,
+                                    DlClipOp clip_op,
+                                    bool is_aa) {
+  state_stack_.back().is_clipped = true;
+}
+void OpaqueBoundsSpy::clipRoundSuperellipse(const DlRoundSuperellipse& rse,
+                                            DlClipOp clip_op,
+                                            bool is_aa) {
+  state_stack_.back().is_clipped = true;
+}
+void OpaqueBoundsSpy::clipPath(const DlPath& path,
+                               DlClipOp clip_op,
+                               bool is_aa) {
+  state_stack_.back().is_clipped = true;
+}
+
+void OpaqueBoundsSpy::save() {
+  state_stack_.push_back(state_stack_.back());
+}
+void OpaqueBoundsSpy::saveLayer(const DlRect& bounds,
+                                const SaveLayerOptions options,
+                                const DlImageFilter* backdrop,
+                                std::optional<int64_t> backdrop_id) {
+  // The content of the layer is composited with the layer's attributes
+  // (opacity, filters) and cannot be assumed to be opaque, but it is
+  // composited with kSrcOver unless a blend mode was set, which
+  // |setBlendMode| already accounts for.
+  state_stack_.push_back(state_stack_.back());
+  state_stack_.back().is_layer = true;
+}
+void OpaqueBoundsSpy::restore() {
+  if (state_stack_.size() > 1) {
+    state_stack_.pop_back();
+  }
+}
+
+void OpaqueBoundsSpy::drawColor(DlColor color, DlBlendMode mode) {
+  bool opaque = color.isOpaque() &&
+                (mode == DlBlendMode::kSrcOver || mode == DlBlendMode::kSrc);
+  if (!opaque) {
+    if (mode != DlBlendMode::kSrcOver && !state_stack_.back().is_layer) {
+      may_erase_ = true;
+    }
+    return;
+  }
+  if (DrawsUnclippedToDestination()) {
+    AccumulateOpaqueRect(DlRect::MakeMaximum());
+  }
+}
+void OpaqueBoundsSpy::drawPaint() {
+  if (PaintIsOpaque() && DrawsUnclippedToDestination()) {
+    AccumulateOpaqueRect(DlRect::MakeMaximum());
+  }
+}
+void OpaqueBoundsSpy::drawRect(const DlRect& rect) {
+  if (PaintIsOpaque() && DrawsUnclippedToDestination()) {
+    AccumulateOpaqueRect(
+        rect.GetPositive().TransformBounds(state_stack_.back().matrix));
+  }
+}
+void OpaqueBoundsSpy::drawDisplayList(const sk_sp<DisplayList> display_list,
+                                      DlScalar opacity) {
+  // A nested DisplayList drawn with full opacity renders its operations
+  // directly to the destination with whatever blend modes it uses.
+  if (opacity >= SK_Scalar1 && !state_stack_.back().is_layer) {
+    OpaqueBoundsSpy nested;
+    display_list->Dispatch(nested);
+    if (nested.may_erase_) {
+      may_erase_ = true;
+    }
+  }
+}
+
+}  // namespace flutter
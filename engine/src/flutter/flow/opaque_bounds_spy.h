@@ -0,0 +1,134 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_OPAQUE_BOUNDS_SPY_H_
+#define FLUTTER_FLOW_OPAQUE_BOUNDS_SPY_H_
+
+#include <vector>
+
+#include "flutter/display_list/display_list.h"
+#include "flutter/display_list/dl_op_receiver.h"
+#include "flutter/display_list/utils/dl_receiver_utils.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// Receives the drawing commands of a DisplayList to find a rectangle that
+/// is guaranteed to be covered with fully opaque pixels once the DisplayList
+/// has been rendered.
+///
+/// The analysis is intentionally conservative. Only opaque, unclipped
+/// drawColor, drawPaint and drawRect calls that are not nested in a
+/// saveLayer and are drawn with an axis aligned transform contribute to the
+/// opaque bounds, and any blend mode that could reduce the alpha of the
+/// destination discards them again.
+///
+/// ```
+///    OpaqueBoundsSpy spy;
+///    display_list->Dispatch(spy);
+///    DlRect opaque_bounds = spy.GetOpaqueBounds(display_list->GetBounds());
+/// ```
+///
+class OpaqueBoundsSpy final : public virtual DlOpReceiver,
+                              private IgnoreDrawDispatchHelper {
+ public:
+  OpaqueBoundsSpy();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the opaque bounds of the dispatched operations,
+  ///             limited to |bounds| and rounded in to integer coordinates so
+  ///             that anti-aliased edges are never considered opaque. Returns
+  ///             an empty rect if no opaque bounds could be determined.
+  DlRect GetOpaqueBounds(const DlRect& bounds) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Convenience method that dispatches |display_list| to a new
+  ///             spy and returns the opaque bounds within its bounds.
+  static DlRect ComputeOpaqueBounds(const DisplayList& display_list);
+
+ private:
+  void setAntiAlias(bool aa) override {}
+  void setInvertColors(bool invert) override {}
+  void setStrokeCap(DlStrokeCap cap) override {}
+  void setStrokeJoin(DlStrokeJoin join) override {}
+  void setStrokeWidth(float width) override {}
+  void setStrokeMiter(float limit) override {}
+  void setDrawStyle(DlDrawStyle style) override;
+  void setColor(DlColor color) override;
+  void setBlendMode(DlBlendMode mode) override;
+  void setColorSource(const DlColorSource* source) override;
+  void setImageFilter(const DlImageFilter* filter) override;
+  void setColorFilter(const DlColorFilter* filter) override;
+  void setMaskFilter(const DlMaskFilter* filter) override;
+
+  void translate(DlScalar tx, DlScalar ty) override;
+  void scale(DlScalar sx, DlScalar sy) override;
+  void rotate(DlScalar degrees) override;
+  void skew(DlScalar sx, DlScalar sy) override;
+  // clang-format off
+  void transform2DAffine(DlScalar mxx, DlScalar mxy, DlScalar mxt,
+                         DlScalar myx, DlScalar myy, DlScalar myt) override;
+  void transformFullPerspective(
+      DlScalar mxx, DlScalar mxy, DlScalar mxz, DlScalar mxt,
+      DlScalar myx, DlScalar myy, DlScalar myz, DlScalar myt,
+      DlScalar mzx, DlScalar mzy, DlScalar mzz, DlScalar mzt,
+      DlScalar mwx, DlScalar mwy, DlScalar mwz, DlScalar mwt) override;
+  // clang-format on
+  void transformReset() override;
+
+  void clipRect(const DlRect& rect, DlClipOp clip_op, bool is_aa) override;
+  void clipOval(const DlRect& bounds, DlClipOp clip_op, bool is_aa) override;
+  void clipRoundRect(const DlRoundRect& rrect,
+                     DlClipOp clip_op,
+                     bool is_aa) override;
+  void clipRoundSuperellipse(const DlRoundSuperellipse& rse,
+                             DlClipOp clip_op,
+                             bool is_aa) override;
+  void clipPath(const DlPath& path, DlClipOp clip_op, bool is_aa) override;
+
+  void save() override;
+  void saveLayer(const DlRect& bounds,
+                 const SaveLayerOptions options,
+                 const DlImageFilter* backdrop,
+                 std::optional<int64_t> backdrop_id) override;
+  void restore() override;
+  void drawColor(DlColor color, DlBlendMode mode) override;
+  void drawPaint() override;
+  void drawRect(const DlRect& rect) override;
+  void drawDisplayList(const sk_sp<DisplayList> display_list,
+                       DlScalar opacity = SK_Scalar1) override;
+
+  struct State {
+    DlMatrix matrix;
+    bool is_clipped = false;
+    bool is_layer = false;
+  };
+
+  // Whether the current attributes fill shapes with fully opaque pixels.
+  bool PaintIsOpaque() const;
+
+  // Whether draws at the current save level render directly to the
+  // destination without a clip.
+  bool DrawsUnclippedToDestination() const;
+
+  void AccumulateOpaqueRect(const DlRect& device_rect);
+
+  std::vector<State> state_stack_;
+  DlColor color_ = DlColor::kBlack();
+  DlDrawStyle style_ = DlDrawStyle::kFill;
+  bool has_color_source_ = false;
+  bool color_source_is_opaque_ = true;
+  bool has_color_filter_ = false;
+  bool has_image_filter_ = false;
+  bool has_mask_filter_ = false;
+
+  DlRect opaque_bounds_;
+  // Set when an operation was seen that may reduce the alpha of pixels that
+  // are already opaque.
+  bool may_erase_ = false;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_OPAQUE_BOUNDS_SPY_H_
@@ -0,0 +1,128 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/opaque_bounds_spy.h"
+
+#include "flutter/display_list/dl_builder.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+TEST(OpaqueBoundsSpy, EmptyDisplayList) {
+  DisplayListBuilder builder;
+  auto dl = builder.Build();
+  EXPECT_TRUE(OpaqueBoundsSpy::ComputeOpaqueBounds(*dl).IsEmpty());
+}
+
+TEST(OpaqueBoundsSpy, OpaqueRect) {
+  DisplayListBuilder builder;
+  builder.DrawRect(DlRect::MakeLTRB(10, 10, 50, 50), DlPaint());
+  auto dl = builder.Build();
+  EXPECT_EQ(OpaqueBoundsSpy::ComputeOpaqueBounds(*dl),
+            DlRect::MakeLTRB(10, 10, 50, 50));
+}
+
+TEST(OpaqueBoundsSpy, FractionalRectIsRoundedIn) {
+  DisplayListBuilder builder;
+  builder.DrawRect(DlRect::MakeLTRB(10.5f, 10.5f, 49.5f, 49.5f), DlPaint());
+  auto dl = builder.Build();
+  EXPECT_EQ(OpaqueBoundsSpy::ComputeOpaqueBounds(*dl),
+            DlRect::MakeLTRB(11, 11, 49, 49));
+}
+
+TEST(OpaqueBoundsSpy, LargestOpaqueRectWins) {
+  DisplayListBuilder builder;
+  builder.DrawRect(DlRect::MakeLTRB(0, 0, 10, 10), DlPaint());
+  builder.DrawRect(DlRect::MakeLTRB(20, 20, 60, 60), DlPaint());
+  builder.DrawRect(DlRect::MakeLTRB(70, 70, 80, 80), DlPaint());
+  auto dl = builder.Build();
+  EXPECT_EQ(OpaqueBoundsSpy::ComputeOpaqueBounds(*dl),
+            DlRect::MakeLTRB(20, 20, 60, 60));
+}
+
+TEST(OpaqueBoundsSpy, TranslucentRectIsNotOpaque) {
+  DisplayListBuilder builder;
+  builder.DrawRect(DlRect::MakeLTRB(10, 10, 50, 50),
+                   DlPaint(DlColor::kBlue().withAlpha(0x7f)));
+  auto dl = builder.Build();
+  EXPECT_TRUE(OpaqueBoundsSpy::ComputeOpaqueBounds(*dl).IsEmpty());
+}
+
+TEST(OpaqueBoundsSpy, StrokedRectIsNotOpaque) {
+  DisplayListBuilder builder;
+  builder.DrawRect(DlRect::MakeLTRB(10, 10, 50, 50),
+                   DlPaint().setDrawStyle(DlDrawStyle::kStroke));
+  auto dl = builder.Build();
+  EXPECT_TRUE(OpaqueBoundsSpy::ComputeOpaqueBounds(*dl).IsEmpty());
+}
+
+TEST(OpaqueBoundsSpy, ClippedRectIsNotOpaque) {
+  DisplayListBuilder builder;
+  builder.ClipRect(DlRect::MakeLTRB(0, 0, 30, 30));
+  builder.DrawRect(DlRect::MakeLTRB(10, 10, 50, 50), DlPaint());
+  auto dl = builder.Build();
+  EXPECT_TRUE(OpaqueBoundsSpy::ComputeOpaqueBounds(*dl).IsEmpty());
+}
+
+TEST(OpaqueBoundsSpy, ClipIsScopedBySaveRestore) {
+  DisplayListBuilder builder;
+  builder.Save();
+  builder.ClipRect(DlRect::MakeLTRB(0, 0, 30, 30));
+  builder.DrawRect(DlRect::MakeLTRB(0, 0, 100, 100), DlPaint());
+  builder.Restore();
+  builder.DrawRect(DlRect::MakeLTRB(10, 10, 50, 50), DlPaint());
+  auto dl = builder.Build();
+  EXPECT_EQ(OpaqueBoundsSpy::ComputeOpaqueBounds(*dl),
+            DlRect::MakeLTRB(10, 10, 50, 50));
+}
+
+TEST(OpaqueBoundsSpy, SaveLayerContentIsNotOpaque) {
+  DisplayListBuilder builder;
+  builder.SaveLayer(std::nullopt, nullptr);
+  builder.DrawRect(DlRect::MakeLTRB(10, 10, 50, 50), DlPaint());
+  builder.Restore();
+  auto dl = builder.Build();
+  EXPECT_TRUE(OpaqueBoundsSpy::ComputeOpaqueBounds(*dl).IsEmpty());
+}
+
+TEST(OpaqueBoundsSpy, NonSrcOverBlendModeDiscardsOpaqueBounds) {
+  DisplayListBuilder builder;
+  builder.DrawRect(DlRect::MakeLTRB(10, 10, 50, 50), DlPaint());
+  builder.DrawRect(DlRect::MakeLTRB(20, 20, 30, 30),
+                   DlPaint().setBlendMode(DlBlendMode::kClear));
+  auto dl = builder.Build();
+  EXPECT_TRUE(OpaqueBoundsSpy::ComputeOpaqueBounds(*dl).IsEmpty());
+}
+
+TEST(OpaqueBoundsSpy, ScaleAndTranslateAreApplied) {
+  DisplayListBuilder builder;
+  builder.Translate(5, 5);
+  builder.Scale(2, 2);
+  builder.DrawRect(DlRect::MakeLTRB(10, 10, 20, 20), DlPaint());
+  auto dl = builder.Build();
+  EXPECT_EQ(OpaqueBoundsSpy::ComputeOpaqueBounds(*dl),
+            DlRect::MakeLTRB(25, 25, 45, 45));
+}
+
+TEST(OpaqueBoundsSpy, RotatedRectIsNotOpaque) {
+  DisplayListBuilder builder;
+  builder.Rotate(45);
+  builder.DrawRect(DlRect::MakeLTRB(10, 10, 50, 50), DlPaint());
+  auto dl = builder.Build();
+  EXPECT_TRUE(OpaqueBoundsSpy::ComputeOpaqueBounds(*dl).IsEmpty());
+}
+
+TEST(OpaqueBoundsSpy, OpaqueDrawColorCoversBounds) {
+  DisplayListBuilder builder(DlRect::MakeWH(100, 100));
+  builder.DrawColor(DlColor::kRed(), DlBlendMode::kSrcOver);
+  builder.DrawRect(DlRect::MakeLTRB(10, 10, 50, 50),
+                   DlPaint(DlColor::kBlue().withAlpha(0x7f)));
+  auto dl = builder.Build();
+  EXPECT_EQ(OpaqueBoundsSpy::ComputeOpaqueBounds(*dl),
+            DlRect::MakeWH(100, 100));
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -124,10 +124,29 @@ bool RasterCache::UpdateCacheEntry(
   RasterCacheKey key = RasterCacheKey(id, raster_cache_context.matrix);
   Entry& entry = cache_[key];
   if (!entry.image) {
+    const sk_sp<DisplayList>& display_list = raster_cache_context.display_list;
+    bool use_shared_cache =
+        shared_cache_ && display_list && !checkerboard_images_;
+    if (use_shared_cache) {
+      entry.image =
+          shared_cache_->Lookup(*display_list, raster_cache_context.matrix,
+                                raster_cache_context.gr_context);
+      if (entry.image != nullptr) {
+        // Shared images were not rasterized by this cache and do not count
+        // against the per frame limit.
+        entry.shared = true;
+        return true;
+      }
+    }
     void (*func)(DlCanvas*, const DlRect& rect) = DrawCheckerboard;
     entry.image = Rasterize(raster_cache_context, std::move(rtree),
                             render_function, func);
     if (entry.image != nullptr) {
+      if (use_shared_cache) {
+        shared_cache_->Store(display_list, raster_cache_context.matrix,
+                             raster_cache_context.gr_context, entry.image,
+                             this);
+      }
       switch (id.type()) {
         case RasterCacheKeyType::kDisplayList: {
           display_list_cached_this_frame_++;
@@ -207,6 +226,10 @@ void RasterCache::UpdateMetrics() {
       RasterCacheMetrics& metrics = GetMetricsForKind(it->first.kind());
       metrics.in_use_count++;
       metrics.in_use_bytes += entry.image->image_bytes();
+      if (entry.shared) {
+        metrics.shared_count++;
+        metrics.shared_bytes += entry.image->image_bytes();
+      }
     }
     entry.encountered_this_frame = false;
   }
@@ -239,6 +262,13 @@ void RasterCache::EndFrame() {
 
 void RasterCache::Clear() {
   cache_.clear();
+  if (shared_cache_) {
+    // Clearing usually means the rendering context went away, in which case
+    // the images this cache rasterized are no longer usable either. The
+    // entries of the other users of the shared cache are left alone; images
+    // this cache obtained from them stay alive for as long as they use them.
+    shared_cache_->ClearOwnedBy(this);
+  }
   picture_metrics_ = {};
   layer_metrics_ = {};
 }
@@ -275,7 +305,10 @@ void RasterCache::TraceStatsToTimeline() const {
       "LayerCount", layer_metrics_.total_count(),                          //
       "LayerMBytes", layer_metrics_.total_bytes() / kMegaByteSizeInBytes,  //
       "PictureCount", picture_metrics_.total_count(),                      //
-      "PictureMBytes", picture_metrics_.total_bytes() / kMegaByteSizeInBytes);
+      "PictureMBytes", picture_metrics_.total_bytes() / kMegaByteSizeInBytes,
+      "SharedPictureCount", picture_metrics_.shared_count,  //
+      "SharedPictureMBytes",
+      picture_metrics_.shared_bytes / kMegaByteSizeInBytes);
 
 #endif  // !FLUTTER_RELEASE
 }
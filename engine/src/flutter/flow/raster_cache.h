@@ -14,6 +14,7 @@
 #include "flutter/display_list/geometry/dl_geometry_conversions.h"
 #include "flutter/flow/raster_cache_key.h"
 #include "flutter/flow/raster_cache_util.h"
+#include "flutter/flow/shared_raster_cache.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/fml/trace_event.h"
@@ -81,6 +82,19 @@ struct RasterCacheMetrics {
    */
   size_t in_use_bytes = 0;
 
+  /**
+   * The number of cache entries used in this frame whose images were
+   * obtained from the |SharedRasterCache| instead of being rasterized by
+   * this cache.
+   */
+  size_t shared_count = 0;
+
+  /**
+   * The size of all of the images used in this frame that were obtained
+   * from the |SharedRasterCache|, i.e. the memory saved by deduplication.
+   */
+  size_t shared_bytes = 0;
+
   /**
    * The total cache entries that had images during this frame.
    */
@@ -124,6 +138,9 @@ class RasterCache {
     const SkMatrix& matrix;
     const SkRect& logical_rect;
     const char* flow_type;
+    // The display list rendered by the render function, if any. Only used to
+    // share the rasterized result through the |SharedRasterCache|.
+    sk_sp<DisplayList> display_list = nullptr;
   };
   struct CacheInfo {
     const size_t accesses_since_visible;
@@ -169,6 +186,19 @@ class RasterCache {
 
   void Clear();
 
+  /**
+   * @brief Use |shared_cache| to look up and publish rasterized display
+   * lists so that other raster caches attached to the same store (e.g. those
+   * of spawned shells) can reuse them. Passing nullptr detaches this cache.
+   */
+  void SetSharedCache(std::shared_ptr<SharedRasterCache> shared_cache) {
+    shared_cache_ = std::move(shared_cache);
+  }
+
+  const std::shared_ptr<SharedRasterCache>& shared_cache() const {
+    return shared_cache_;
+  }
+
   const RasterCacheMetrics& picture_metrics() const { return picture_metrics_; }
   const RasterCacheMetrics& layer_metrics() const { return layer_metrics_; }
 
@@ -252,7 +282,9 @@ class RasterCache {
     bool encountered_this_frame = false;
     bool visible_this_frame = false;
     size_t accesses_since_visible = 0;
-    std::unique_ptr<RasterCacheResult> image;
+    // Set if |image| came from the |SharedRasterCache|.
+    bool shared = false;
+    std::shared_ptr<RasterCacheResult> image;
   };
 
   void UpdateMetrics();
@@ -266,6 +298,7 @@ class RasterCache {
   RasterCacheMetrics picture_metrics_;
   mutable RasterCacheKey::Map<Entry> cache_;
   bool checkerboard_images_ = false;
+  std::shared_ptr<SharedRasterCache> shared_cache_;
 
   void TraceStatsToTimeline() const;
 
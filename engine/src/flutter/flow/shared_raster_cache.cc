@@ -0,0 +1,143 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#if !SLIMPELLER
+
+#include "flutter/flow/shared_raster_cache.h"
+
+#include <string_view>
+
+#include "flutter/flow/raster_cache.h"
+#include "flutter/fml/hash_combine.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+SharedRasterCache::SharedRasterCache(size_t max_bytes)
+    : max_bytes_(max_bytes) {}
+
+SharedRasterCache::~SharedRasterCache() = default;
+
+uint64_t SharedRasterCache::ComputeContentHash(
+    const DisplayList& display_list) {
+  // The op storage is zero-filled on allocation so identical sequences of
+  // ops produce identical bytes. Ops that refer to attribute objects (images,
+  // shaders, nested display lists) store pointers and will only hash equal
+  // when they share those objects, which only ever costs a cache miss.
+  const DisplayListStorage& storage = display_list.GetStorage();
+  std::string_view bytes(reinterpret_cast<const char*>(storage.base()),
+                         storage.size());
+  const DlRect& bounds = display_list.GetBounds();
+  return fml::HashCombine(std::hash<std::string_view>{}(bytes),
+                          display_list.op_count(), bounds.GetLeft(),
+                          bounds.GetTop(), bounds.GetRight(),
+                          bounds.GetBottom());
+}
+
+RasterCacheKey SharedRasterCache::MakeKey(const DisplayList& display_list,
+                                          const SkMatrix& matrix,
+                                          const GrDirectContext* gr_context) {
+  uint64_t id = fml::HashCombine(ComputeContentHash(display_list),
+                                 reinterpret_cast<uintptr_t>(gr_context));
+  return RasterCacheKey(id, RasterCacheKeyType::kDisplayList, matrix);
+}
+
+std::shared_ptr<RasterCacheResult> SharedRasterCache::Lookup(
+    const DisplayList& display_list,
+    const SkMatrix& matrix,
+    const GrDirectContext* gr_context) {
+  TRACE_EVENT0("flutter", "SharedRasterCache::Lookup");
+  RasterCacheKey key = MakeKey(display_list, matrix, gr_context);
+
+  std::scoped_lock lock(mutex_);
+  auto found = index_.find(key);
+  if (found == index_.end()) {
+    return nullptr;
+  }
+  EntryList::iterator it = found->second;
+  if (it->gr_context != gr_context ||
+      !it->display_list->Equals(&display_list)) {
+    // Hash collision, treat it as a miss.
+    return nullptr;
+  }
+  entries_.splice(entries_.begin(), entries_, it);
+  return it->result;
+}
+
+void SharedRasterCache::Store(const sk_sp<DisplayList>& display_list,
+                              const SkMatrix& matrix,
+                              const GrDirectContext* gr_context,
+                              std::shared_ptr<RasterCacheResult> result,
+                              const RasterCache* owner) {
+  if (!display_list || !result) {
+    return;
+  }
+  RasterCacheKey key = MakeKey(*display_list, matrix, gr_context);
+  size_t bytes = result->image_bytes();
+  if (bytes > max_bytes_) {
+    return;
+  }
+
+  std::scoped_lock lock(mutex_);
+  auto found = index_.find(key);
+  if (found != index_.end()) {
+    EraseLocked(found->second);
+  }
+  entries_.push_front({
+      .key = key,
+      .display_list = display_list,
+      .gr_context = gr_context,
+      .result = std::move(result),
+      .owner = owner,
+      .bytes = bytes,
+  });
+  index_.emplace(key, entries_.begin());
+  byte_size_ += bytes;
+  EvictLocked();
+}
+
+void SharedRasterCache::Clear() {
+  std::scoped_lock lock(mutex_);
+  index_.clear();
+  entries_.clear();
+  byte_size_ = 0;
+}
+
+void SharedRasterCache::ClearOwnedBy(const RasterCache* owner) {
+  std::scoped_lock lock(mutex_);
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    auto next = std::next(it);
+    if (it->owner == owner) {
+      EraseLocked(it);
+    }
+    it = next;
+  }
+}
+
+size_t SharedRasterCache::GetEntryCount() const {
+  std::scoped_lock lock(mutex_);
+  return entries_.size();
+}
+
+size_t SharedRasterCache::GetByteSize() const {
+  std::scoped_lock lock(mutex_);
+  return byte_size_;
+}
+
+void SharedRasterCache::EraseLocked(EntryList::iterator it) {
+  FML_DCHECK(byte_size_ >= it->bytes);
+  byte_size_ -= it->bytes;
+  index_.erase(it->key);
+  entries_.erase(it);
+}
+
+void SharedRasterCache::EvictLocked() {
+  while (byte_size_ > max_bytes_ && !entries_.empty()) {
+    EraseLocked(std::prev(entries_.end()));
+  }
+}
+
+}  // namespace flutter
+
+#endif  //  !SLIMPELLER
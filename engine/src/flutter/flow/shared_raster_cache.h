@@ -0,0 +1,130 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_SHARED_RASTER_CACHE_H_
+#define FLUTTER_FLOW_SHARED_RASTER_CACHE_H_
+
+#if !SLIMPELLER
+
+#include <list>
+#include <memory>
+#include <mutex>
+
+#include "flutter/display_list/display_list.h"
+#include "flutter/flow/raster_cache_key.h"
+#include "flutter/fml/macros.h"
+#include "third_party/skia/include/core/SkMatrix.h"
+
+class GrDirectContext;
+
+namespace flutter {
+
+class RasterCache;
+class RasterCacheResult;
+
+/**
+ * SharedRasterCache is an opt-in store of rasterized DisplayLists that can be
+ * consulted by several |RasterCache| instances, e.g. the raster caches of a
+ * shell and of the shells spawned from it via |Shell::Spawn|.
+ *
+ * Unlike the per-engine |RasterCache|, which keys display list entries by
+ * |DisplayList::unique_id|, entries here are keyed by a hash of the
+ * DisplayList contents, the rendering matrix and the |GrDirectContext| the
+ * image was rendered with. A hash hit is confirmed with |DisplayList::Equals|
+ * before the cached image is handed out, so identical content recorded by
+ * different engines is only rasterized once.
+ *
+ * All methods may be called from any thread. The entries are retained in
+ * least-recently-used order and are evicted once the sum of their image
+ * sizes exceeds |max_bytes|. Evicting an entry only drops the reference held
+ * by this store; a |RasterCache| that is still drawing the image keeps it
+ * alive until the entry is evicted from that cache as well.
+ */
+class SharedRasterCache {
+ public:
+  static constexpr size_t kDefaultMaxBytes = 64 * 1024 * 1024;
+
+  explicit SharedRasterCache(size_t max_bytes = kDefaultMaxBytes);
+
+  ~SharedRasterCache();
+
+  /**
+   * @brief Return a previously rasterized image of |display_list| drawn
+   * with |matrix| on |gr_context|, or nullptr if no such image is stored.
+   */
+  std::shared_ptr<RasterCacheResult> Lookup(
+      const DisplayList& display_list,
+      const SkMatrix& matrix,
+      const GrDirectContext* gr_context);
+
+  /**
+   * @brief Make |result| available to other users of this store. Storing
+   * may evict the least recently used entries to stay within the budget.
+   *
+   * |owner| identifies the |RasterCache| that rasterized |result|, see
+   * |ClearOwnedBy|.
+   */
+  void Store(const sk_sp<DisplayList>& display_list,
+             const SkMatrix& matrix,
+             const GrDirectContext* gr_context,
+             std::shared_ptr<RasterCacheResult> result,
+             const RasterCache* owner = nullptr);
+
+  void Clear();
+
+  /**
+   * @brief Remove the entries stored by |owner|. The entries of the other
+   * users of this store are kept.
+   */
+  void ClearOwnedBy(const RasterCache* owner);
+
+  size_t GetEntryCount() const;
+
+  size_t GetByteSize() const;
+
+  size_t max_bytes() const { return max_bytes_; }
+
+  /**
+   * @brief The hash of the recorded operations of |display_list|.
+   *
+   * DisplayLists with equal contents (as determined by
+   * |DisplayList::Equals|) that reference the same attribute objects produce
+   * the same hash.
+   */
+  static uint64_t ComputeContentHash(const DisplayList& display_list);
+
+ private:
+  struct Entry {
+    RasterCacheKey key;
+    sk_sp<DisplayList> display_list;
+    const GrDirectContext* gr_context;
+    std::shared_ptr<RasterCacheResult> result;
+    const RasterCache* owner;
+    size_t bytes;
+  };
+  using EntryList = std::list<Entry>;
+
+  static RasterCacheKey MakeKey(const DisplayList& display_list,
+                                const SkMatrix& matrix,
+                                const GrDirectContext* gr_context);
+
+  void EraseLocked(EntryList::iterator it);
+
+  void EvictLocked();
+
+  const size_t max_bytes_;
+  mutable std::mutex mutex_;
+  // Most recently used entries are at the front.
+  EntryList entries_;
+  RasterCacheKey::Map<EntryList::iterator> index_;
+  size_t byte_size_ = 0;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(SharedRasterCache);
+};
+
+}  // namespace flutter
+
+#endif  //  !SLIMPELLER
+
+#endif  // FLUTTER_FLOW_SHARED_RASTER_CACHE_H_
@@ -0,0 +1,177 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/shared_raster_cache.h"
+
+#include "flutter/display_list/testing/dl_test_snippets.h"
+#include "flutter/flow/layers/display_list_raster_cache_item.h"
+#include "flutter/flow/raster_cache.h"
+#include "flutter/flow/testing/mock_raster_cache.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+std::shared_ptr<RasterCacheResult> MakeResult(int width, int height) {
+  return std::make_shared<MockRasterCacheResult>(
+      SkRect::MakeWH(width, height));
+}
+
+// Rasterizes |display_list| into |cache| by prerolling it until it is cached.
+bool Populate(RasterCache& cache,
+              const sk_sp<DisplayList>& display_list,
+              size_t threshold) {
+  DlMatrix matrix;
+  DisplayListBuilder dummy_canvas(1000, 1000);
+
+  LayerStateStack preroll_state_stack;
+  preroll_state_stack.set_preroll_delegate(kGiantRect, matrix);
+  LayerStateStack paint_state_stack;
+  paint_state_stack.set_delegate(&dummy_canvas);
+
+  FixedRefreshRateStopwatch raster_time;
+  FixedRefreshRateStopwatch ui_time;
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder(
+      preroll_state_stack, &cache, &raster_time, &ui_time);
+  PaintContextHolder paint_context_holder = GetSamplePaintContextHolder(
+      paint_state_stack, &cache, &raster_time, &ui_time);
+  auto& preroll_context = preroll_context_holder.preroll_context;
+  auto& paint_context = paint_context_holder.paint_context;
+
+  DisplayListRasterCacheItem item(display_list, SkPoint(), true, false);
+  bool cached = false;
+  for (size_t i = 0; i <= threshold; i++) {
+    cache.BeginFrame();
+    cached = RasterCacheItemPrerollAndTryToRasterCache(
+        item, preroll_context, paint_context, matrix);
+    cache.EndFrame();
+  }
+  return cached;
+}
+
+}  // namespace
+
+TEST(SharedRasterCache, ContentHashMatchesForEqualDisplayLists) {
+  auto display_list_1 = GetSampleDisplayList();
+  auto display_list_2 = GetSampleDisplayList();
+  auto display_list_3 = GetSampleDisplayList(3);
+
+  ASSERT_NE(display_list_1->unique_id(), display_list_2->unique_id());
+  EXPECT_EQ(SharedRasterCache::ComputeContentHash(*display_list_1),
+            SharedRasterCache::ComputeContentHash(*display_list_2));
+  EXPECT_NE(SharedRasterCache::ComputeContentHash(*display_list_1),
+            SharedRasterCache::ComputeContentHash(*display_list_3));
+}
+
+TEST(SharedRasterCache, LookupFindsEqualContent) {
+  SharedRasterCache cache;
+  auto display_list_1 = GetSampleDisplayList();
+  auto display_list_2 = GetSampleDisplayList();
+  auto result = MakeResult(80, 80);
+
+  cache.Store(display_list_1, SkMatrix::I(), nullptr, result);
+  EXPECT_EQ(cache.GetEntryCount(), 1u);
+  EXPECT_EQ(cache.GetByteSize(), static_cast<size_t>(result->image_bytes()));
+
+  EXPECT_EQ(cache.Lookup(*display_list_2, SkMatrix::I(), nullptr), result);
+}
+
+TEST(SharedRasterCache, LookupMissesOnDifferentMatrixOrContext) {
+  SharedRasterCache cache;
+  auto display_list = GetSampleDisplayList();
+  cache.Store(display_list, SkMatrix::I(), nullptr, MakeResult(80, 80));
+
+  EXPECT_EQ(cache.Lookup(*display_list, SkMatrix::Scale(2, 2), nullptr),
+            nullptr);
+  auto* fake_context = reinterpret_cast<const GrDirectContext*>(0x1);
+  EXPECT_EQ(cache.Lookup(*display_list, SkMatrix::I(), fake_context), nullptr);
+  EXPECT_EQ(cache.Lookup(*GetSampleDisplayList(3), SkMatrix::I(), nullptr),
+            nullptr);
+}
+
+TEST(SharedRasterCache, EvictsLeastRecentlyUsedEntriesOverBudget) {
+  auto result_1 = MakeResult(10, 10);
+  auto result_2 = MakeResult(10, 10);
+  auto result_3 = MakeResult(10, 10);
+  size_t entry_bytes = result_1->image_bytes();
+  SharedRasterCache cache(entry_bytes * 2);
+
+  auto display_list_1 = GetSampleDisplayList(1);
+  auto display_list_2 = GetSampleDisplayList(2);
+  auto display_list_3 = GetSampleDisplayList(3);
+
+  cache.Store(display_list_1, SkMatrix::I(), nullptr, result_1);
+  cache.Store(display_list_2, SkMatrix::I(), nullptr, result_2);
+  // Touch the first entry so that the second one is the oldest.
+  EXPECT_EQ(cache.Lookup(*display_list_1, SkMatrix::I(), nullptr), result_1);
+  cache.Store(display_list_3, SkMatrix::I(), nullptr, result_3);
+
+  EXPECT_EQ(cache.GetEntryCount(), 2u);
+  EXPECT_EQ(cache.GetByteSize(), entry_bytes * 2);
+  EXPECT_EQ(cache.Lookup(*display_list_1, SkMatrix::I(), nullptr), result_1);
+  EXPECT_EQ(cache.Lookup(*display_list_2, SkMatrix::I(), nullptr), nullptr);
+  EXPECT_EQ(cache.Lookup(*display_list_3, SkMatrix::I(), nullptr), result_3);
+}
+
+TEST(SharedRasterCache, DoesNotStoreResultsLargerThanBudget) {
+  SharedRasterCache cache(16);
+  cache.Store(GetSampleDisplayList(), SkMatrix::I(), nullptr,
+              MakeResult(80, 80));
+  EXPECT_EQ(cache.GetEntryCount(), 0u);
+  EXPECT_EQ(cache.GetByteSize(), 0u);
+}
+
+TEST(SharedRasterCache, RasterCachesShareEqualDisplayLists) {
+  auto shared_cache = std::make_shared<SharedRasterCache>();
+  size_t threshold = 1;
+  flutter::RasterCache cache_1(threshold);
+  flutter::RasterCache cache_2(threshold);
+  cache_1.SetSharedCache(shared_cache);
+  cache_2.SetSharedCache(shared_cache);
+
+  ASSERT_TRUE(Populate(cache_1, GetSampleDisplayList(), threshold));
+  EXPECT_EQ(cache_1.picture_metrics().total_count(), 1u);
+  EXPECT_EQ(cache_1.picture_metrics().shared_count, 0u);
+  EXPECT_EQ(shared_cache->GetEntryCount(), 1u);
+
+  // An equal display list recorded separately reuses the shared image.
+  ASSERT_TRUE(Populate(cache_2, GetSampleDisplayList(), threshold));
+  EXPECT_EQ(cache_2.picture_metrics().total_count(), 1u);
+  EXPECT_EQ(cache_2.picture_metrics().shared_count, 1u);
+  EXPECT_EQ(cache_2.picture_metrics().shared_bytes,
+            cache_1.picture_metrics().total_bytes());
+  EXPECT_EQ(shared_cache->GetEntryCount(), 1u);
+}
+
+TEST(SharedRasterCache, ClearingARasterCacheKeepsEntriesOfOthers) {
+  auto shared_cache = std::make_shared<SharedRasterCache>();
+  size_t threshold = 1;
+  flutter::RasterCache cache_1(threshold);
+  flutter::RasterCache cache_2(threshold);
+  cache_1.SetSharedCache(shared_cache);
+  cache_2.SetSharedCache(shared_cache);
+
+  ASSERT_TRUE(Populate(cache_1, GetSampleDisplayList(), threshold));
+  ASSERT_TRUE(Populate(cache_2, GetSampleDisplayList(3), threshold));
+  ASSERT_EQ(shared_cache->GetEntryCount(), 2u);
+
+  // Only the entry rasterized by cache_1 is removed from the shared cache.
+  cache_1.Clear();
+  EXPECT_EQ(shared_cache->GetEntryCount(), 1u);
+
+  flutter::RasterCache cache_3(threshold);
+  cache_3.SetSharedCache(shared_cache);
+  ASSERT_TRUE(Populate(cache_3, GetSampleDisplayList(3), threshold));
+  EXPECT_EQ(cache_3.picture_metrics().shared_count, 1u);
+
+  flutter::RasterCache cache_4(threshold);
+  cache_4.SetSharedCache(shared_cache);
+  ASSERT_TRUE(Populate(cache_4, GetSampleDisplayList(), threshold));
+  EXPECT_EQ(cache_4.picture_metrics().shared_count, 0u);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -97,6 +97,7 @@ typedef CanvasPath Path;
   V(NativeStringAttribute::initLocaleStringAttribute)              \
   V(NativeStringAttribute::initSpellOutStringAttribute)            \
   V(NativeSemanticsFlags::initSemanticsFlags)                      \
+  V(Paragraph::LayoutAll)                                          \
   V(PlatformConfigurationNativeApi::DefaultRouteName)              \
   V(PlatformConfigurationNativeApi::ScheduleFrame)                 \
   V(PlatformConfigurationNativeApi::EndWarmUpFrame)                \
@@ -250,6 +251,7 @@ typedef CanvasPath Path;
   V(PathMeasure, getLength)                      \
   V(PathMeasure, getPosTan)                      \
   V(PathMeasure, getSegment)                     \
+  V(PathMeasure, getSegments)                    \
   V(PathMeasure, isClosed)                       \
   V(PathMeasure, nextContour)                    \
   V(Path, addArc)                                \
@@ -3724,6 +3724,24 @@ class PathMetric {
     return _measure.extractPath(contourIndex, start, end, startWithMoveTo: startWithMoveTo);
   }
 
+  /// Returns a single path containing the segments between each pair of
+  /// distances in `intervals`, which lists the start and end of the first
+  /// segment, then those of the second segment, and so on.
+  ///
+  /// This is equivalent to calling [extractPath] for each pair and adding
+  /// the results to one path, but extracts all the segments in one call, for
+  /// example to dash a stroke.
+  ///
+  /// The distances are clamped to legal values (0..[length]). Each segment
+  /// begins with a moveTo if `startWithMoveTo` is true, and is otherwise
+  /// connected to the end of the previous segment.
+  Path extractPathSegments(List<double> intervals, {bool startWithMoveTo = true}) {
+    if (intervals.length.isOdd) {
+      throw ArgumentError('intervals must list a start and an end distance for each segment.');
+    }
+    return _measure.extractPathSegments(contourIndex, intervals, startWithMoveTo: startWithMoveTo);
+  }
+
   @override
   String toString() =>
       'PathMetric(length: $length, isClosed: $isClosed, contourIndex: $contourIndex)';
@@ -3786,6 +3804,35 @@ base class _PathMeasure extends NativeFieldWrapperClass1 {
     bool startWithMoveTo,
   );
 
+  Path extractPathSegments(
+    int contourIndex,
+    List<double> intervals, {
+    bool startWithMoveTo = true,
+  }) {
+    assert(
+      contourIndex <= currentContourIndex,
+      'Iterator must be advanced before index $contourIndex can be used.',
+    );
+    final path = _NativePath._();
+    _extractPathSegments(
+      path,
+      contourIndex,
+      intervals is Float32List ? intervals : Float32List.fromList(intervals),
+      startWithMoveTo,
+    );
+    return path;
+  }
+
+  @Native<Void Function(Pointer<Void>, Handle, Int32, Handle, Bool)>(
+    symbol: 'PathMeasure::getSegments',
+  )
+  external void _extractPathSegments(
+    Path outPath,
+    int contourIndex,
+    Float32List intervals,
+    bool startWithMoveTo,
+  );
+
   bool isClosed(int contourIndex) {
     assert(
       contourIndex <= currentContourIndex,
@@ -8236,6 +8283,7 @@ base class _NativeCanvas extends NativeFieldWrapperClass1 implements Canvas {
     assert(!nativeParagraph.debugDisposed);
     assert(_offsetIsValid(offset));
     assert(!nativeParagraph._needsLayout);
+    nativeParagraph._checkLayoutNotPending();
     nativeParagraph._paint(this, offset.dx, offset.dy);
   }
 
@@ -26,7 +26,7 @@ class Codec : public RefCountedDartWrappable<Codec> {
 
   virtual Dart_Handle getNextFrame(Dart_Handle callback_handle) = 0;
 
-  void dispose();
+  virtual void dispose();
 };
 
 }  // namespace flutter
@@ -180,7 +180,9 @@ void DlDeferredImageGPUImpeller::ImageWrapper::SnapshotDisplayList(
           display_list = layer_tree->Flatten(
               DlRect::MakeWH(wrapper->size_.width, wrapper->size_.height),
               snapshot_delegate->GetTextureRegistry(),
-              /*gr_context=*/nullptr, aiks_context.get());
+              /*gr_context=*/nullptr, aiks_context.get(),
+              snapshot_delegate->GetLayerFlattenCache(
+                  SnapshotDelegate::FlattenCacheUser::kDeferredImage));
         }
 
         auto texture = snapshot_delegate->MakeImpellerSnapshotSync(
@@ -167,11 +167,15 @@ void DlDeferredImageGPUSkia::ImageWrapper::SnapshotDisplayList(
           return;
         }
         if (layer_tree) {
+          LayerFlattenCache* flatten_cache =
+              snapshot_delegate->GetLayerFlattenCache(
+                  SnapshotDelegate::FlattenCacheUser::kDeferredImage);
           auto display_list =
               layer_tree->Flatten(DlRect::MakeWH(wrapper->image_info_.width(),
                                                  wrapper->image_info_.height()),
                                   snapshot_delegate->GetTextureRegistry(),
-                                  snapshot_delegate->GetGrContext());
+                                  snapshot_delegate->GetGrContext(),
+                                  /*aiks_context=*/nullptr, flatten_cache);
           wrapper->display_list_ = std::move(display_list);
         }
         auto result = snapshot_delegate->MakeSkiaGpuImage(
@@ -0,0 +1,142 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/image_decode_scheduler.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+ImageDecodeScheduler::Reservation::Reservation(
+    std::shared_ptr<ImageDecodeScheduler> scheduler,
+    size_t bytes)
+    : scheduler_(std::move(scheduler)), bytes_(bytes) {}
+
+ImageDecodeScheduler::Reservation::~Reservation() {
+  scheduler_->Release(bytes_);
+}
+
+ImageDecodeScheduler::ImageDecodeScheduler(
+    std::shared_ptr<fml::BasicTaskRunner> task_runner,
+    size_t max_in_flight_bytes)
+    : task_runner_(std::move(task_runner)),
+      max_in_flight_bytes_(max_in_flight_bytes) {}
+
+// A decode is only left pending while another one is in flight, and in
+// flight decodes keep the scheduler alive through their reservations.
+ImageDecodeScheduler::~ImageDecodeScheduler() = default;
+
+void ImageDecodeScheduler::Schedule(
+    size_t decoded_bytes,
+    std::shared_ptr<const std::atomic<bool>> cancelled,
+    Task task,
+    fml::closure on_cancelled) {
+  FML_DCHECK(task);
+  {
+    std::scoped_lock lock(mutex_);
+    pending_decodes_.push_back({
+        .bytes = decoded_bytes,
+        .cancelled = std::move(cancelled),
+        .task = std::move(task),
+        .on_cancelled = std::move(on_cancelled),
+        .schedule_time = fml::TimePoint::Now(),
+    });
+  }
+  StartPendingDecodes();
+}
+
+ImageDecodeScheduler::Metrics ImageDecodeScheduler::GetMetrics() const {
+  std::scoped_lock lock(mutex_);
+  return {
+      .pending_decodes = pending_decodes_.size(),
+      .in_flight_decodes = in_flight_decodes_,
+      .in_flight_bytes = in_flight_bytes_,
+      .peak_in_flight_bytes = peak_in_flight_bytes_,
+      .started_decodes = started_decodes_,
+      .cancelled_decodes = cancelled_decodes_,
+      .average_queue_latency =
+          started_decodes_ == 0
+              ? fml::TimeDelta::Zero()
+              : total_queue_latency_ / static_cast<int64_t>(started_decodes_),
+      .max_queue_latency = max_queue_latency_,
+  };
+}
+
+void ImageDecodeScheduler::Release(size_t bytes) {
+  {
+    std::scoped_lock lock(mutex_);
+    FML_DCHECK(in_flight_decodes_ > 0);
+    FML_DCHECK(in_flight_bytes_ >= bytes);
+    in_flight_decodes_--;
+    in_flight_bytes_ -= bytes;
+  }
+  StartPendingDecodes();
+}
+
+void ImageDecodeScheduler::StartPendingDecodes() {
+  std::vector<fml::closure> cancelled_callbacks;
+  std::vector<PendingDecode> started_decodes;
+  {
+    std::scoped_lock lock(mutex_);
+    for (auto it = pending_decodes_.begin(); it != pending_decodes_.end();) {
+      if (it->cancelled && it->cancelled->load()) {
+        cancelled_callbacks.push_back(std::move(it->on_cancelled));
+        it = pending_decodes_.erase(it);
+        cancelled_decodes_++;
+      } else {
+        ++it;
+      }
+    }
+
+    const fml::TimePoint now = fml::TimePoint::Now();
+    while (!pending_decodes_.empty()) {
+      PendingDecode& decode = pending_decodes_.back();
+      // Always let one decode through, even if it is larger than the budget
+      // on its own.
+      if (in_flight_decodes_ > 0 &&
+          in_flight_bytes_ + decode.bytes > max_in_flight_bytes_) {
+        break;
+      }
+      in_flight_decodes_++;
+      in_flight_bytes_ += decode.bytes;
+      peak_in_flight_bytes_ = std::max(peak_in_flight_bytes_, in_flight_bytes_);
+      const fml::TimeDelta queue_latency = now - decode.schedule_time;
+      total_queue_latency_ = total_queue_latency_ + queue_latency;
+      max_queue_latency_ = std::max(max_queue_latency_, queue_latency);
+      started_decodes_++;
+      started_decodes.push_back(std::move(decode));
+      pending_decodes_.pop_back();
+    }
+
+    TraceCountersLocked();
+  }
+
+  for (const fml::closure& callback : cancelled_callbacks) {
+    if (callback) {
+      callback();
+    }
+  }
+  for (PendingDecode& decode : started_decodes) {
+    auto reservation = std::shared_ptr<Reservation>(
+        new Reservation(shared_from_this(), decode.bytes));
+    task_runner_->PostTask(
+        [task = std::move(decode.task), reservation = std::move(reservation)] {
+          task(reservation);
+        });
+  }
+}
+
+void ImageDecodeScheduler::TraceCountersLocked() {
+  FML_TRACE_COUNTER("flutter", "ImageDecodeScheduler",
+                    reinterpret_cast<int64_t>(this),  // Trace Counter ID
+                    "PendingDecodes", pending_decodes_.size(),
+                    "InFlightDecodes", in_flight_decodes_,
+                    "InFlightBytes", in_flight_bytes_);
+}
+
+}  // namespace flutter
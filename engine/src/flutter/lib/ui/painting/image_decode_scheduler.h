@@ -0,0 +1,131 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_PAINTING_IMAGE_DECODE_SCHEDULER_H_
+#define FLUTTER_LIB_UI_PAINTING_IMAGE_DECODE_SCHEDULER_H_
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+#include "flutter/fml/closure.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/task_runner.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Admits image decodes onto a worker task runner while keeping
+///             the memory of the decoded images that are in flight under a
+///             budget.
+///
+///             Decodes that do not fit the budget wait in a queue. The most
+///             recently scheduled decode is started first, since it is the
+///             most likely to be for an image that is still on screen.
+///             Decodes whose owner lost interest in the result before they
+///             started are dropped.
+///
+///             This class is thread safe.
+///
+class ImageDecodeScheduler
+    : public std::enable_shared_from_this<ImageDecodeScheduler> {
+ public:
+  static constexpr size_t kDefaultMaxInFlightBytes = 128 << 20;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Accounts for the memory of a started decode until it is
+  ///             collected, at which point queued decodes may start.
+  ///
+  class Reservation {
+   public:
+    ~Reservation();
+
+   private:
+    friend ImageDecodeScheduler;
+
+    Reservation(std::shared_ptr<ImageDecodeScheduler> scheduler, size_t bytes);
+
+    const std::shared_ptr<ImageDecodeScheduler> scheduler_;
+    const size_t bytes_;
+
+    FML_DISALLOW_COPY_AND_ASSIGN(Reservation);
+  };
+
+  /// A decode job. It runs on the worker task runner and should keep the
+  /// reservation alive for as long as it holds on to the decoded pixels.
+  using Task = std::function<void(std::shared_ptr<Reservation>)>;
+
+  struct Metrics {
+    size_t pending_decodes = 0;
+    size_t in_flight_decodes = 0;
+    size_t in_flight_bytes = 0;
+    size_t peak_in_flight_bytes = 0;
+    size_t started_decodes = 0;
+    size_t cancelled_decodes = 0;
+    /// The time decodes spent in the queue before they were started.
+    fml::TimeDelta average_queue_latency;
+    fml::TimeDelta max_queue_latency;
+  };
+
+  ImageDecodeScheduler(std::shared_ptr<fml::BasicTaskRunner> task_runner,
+                       size_t max_in_flight_bytes = kDefaultMaxInFlightBytes);
+
+  ~ImageDecodeScheduler();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Schedule a decode.
+  ///
+  /// @param[in]  decoded_bytes  An estimate of the memory the decode holds
+  ///                            while it is in flight. A decode that is
+  ///                            larger than the budget runs on its own.
+  /// @param[in]  cancelled      An optional flag that is set once the result
+  ///                            of the decode is no longer needed.
+  /// @param[in]  task           The decode job.
+  /// @param[in]  on_cancelled   Invoked instead of `task` if the decode was
+  ///                            cancelled before it started.
+  ///
+  void Schedule(size_t decoded_bytes,
+                std::shared_ptr<const std::atomic<bool>> cancelled,
+                Task task,
+                fml::closure on_cancelled);
+
+  Metrics GetMetrics() const;
+
+ private:
+  struct PendingDecode {
+    size_t bytes = 0;
+    std::shared_ptr<const std::atomic<bool>> cancelled;
+    Task task;
+    fml::closure on_cancelled;
+    fml::TimePoint schedule_time;
+  };
+
+  const std::shared_ptr<fml::BasicTaskRunner> task_runner_;
+  const size_t max_in_flight_bytes_;
+  mutable std::mutex mutex_;
+  std::deque<PendingDecode> pending_decodes_;
+  size_t in_flight_decodes_ = 0;
+  size_t in_flight_bytes_ = 0;
+  size_t peak_in_flight_bytes_ = 0;
+  size_t started_decodes_ = 0;
+  size_t cancelled_decodes_ = 0;
+  fml::TimeDelta total_queue_latency_;
+  fml::TimeDelta max_queue_latency_;
+
+  void Release(size_t bytes);
+
+  void StartPendingDecodes();
+
+  void TraceCountersLocked();
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ImageDecodeScheduler);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_PAINTING_IMAGE_DECODE_SCHEDULER_H_
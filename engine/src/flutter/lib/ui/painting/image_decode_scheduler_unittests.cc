@@ -0,0 +1,149 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/image_decode_scheduler.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+// Holds posted tasks until the test runs them.
+class ManualTaskRunner : public fml::BasicTaskRunner {
+ public:
+  void PostTask(const fml::closure& task) override { tasks_.push_back(task); }
+
+  void RunTasks() {
+    std::vector<fml::closure> tasks;
+    tasks.swap(tasks_);
+    for (const fml::closure& task : tasks) {
+      task();
+    }
+  }
+
+ private:
+  std::vector<fml::closure> tasks_;
+};
+
+using Reservation = std::shared_ptr<ImageDecodeScheduler::Reservation>;
+
+// Schedules a decode that records its id and holds on to its reservation
+// until the test drops it.
+void ScheduleDecode(ImageDecodeScheduler& scheduler,
+                    size_t bytes,
+                    int id,
+                    std::vector<int>& decoded,
+                    std::vector<Reservation>& reservations,
+                    std::shared_ptr<std::atomic<bool>> cancelled = nullptr,
+                    std::vector<int>* cancelled_ids = nullptr) {
+  scheduler.Schedule(
+      bytes, std::move(cancelled),
+      [id, &decoded, &reservations](const Reservation& reservation) {
+        decoded.push_back(id);
+        reservations.push_back(reservation);
+      },
+      [id, cancelled_ids]() {
+        if (cancelled_ids) {
+          cancelled_ids->push_back(id);
+        }
+      });
+}
+
+}  // namespace
+
+TEST(ImageDecodeSchedulerTest, CapsInFlightBytes) {
+  auto runner = std::make_shared<ManualTaskRunner>();
+  auto scheduler = std::make_shared<ImageDecodeScheduler>(runner, 100);
+  std::vector<int> decoded;
+  std::vector<Reservation> reservations;
+
+  ScheduleDecode(*scheduler, 60, 1, decoded, reservations);
+  ScheduleDecode(*scheduler, 60, 2, decoded, reservations);
+  runner->RunTasks();
+  EXPECT_EQ(decoded, std::vector<int>({1}));
+
+  ImageDecodeScheduler::Metrics metrics = scheduler->GetMetrics();
+  EXPECT_EQ(metrics.pending_decodes, 1u);
+  EXPECT_EQ(metrics.in_flight_decodes, 1u);
+  EXPECT_EQ(metrics.in_flight_bytes, 60u);
+
+  // Finishing the first decode makes room for the second.
+  reservations.clear();
+  runner->RunTasks();
+  EXPECT_EQ(decoded, std::vector<int>({1, 2}));
+
+  reservations.clear();
+  metrics = scheduler->GetMetrics();
+  EXPECT_EQ(metrics.pending_decodes, 0u);
+  EXPECT_EQ(metrics.in_flight_decodes, 0u);
+  EXPECT_EQ(metrics.in_flight_bytes, 0u);
+  EXPECT_EQ(metrics.peak_in_flight_bytes, 60u);
+  EXPECT_EQ(metrics.started_decodes, 2u);
+}
+
+TEST(ImageDecodeSchedulerTest, StartsDecodesLargerThanTheBudgetAlone) {
+  auto runner = std::make_shared<ManualTaskRunner>();
+  auto scheduler = std::make_shared<ImageDecodeScheduler>(runner, 100);
+  std::vector<int> decoded;
+  std::vector<Reservation> reservations;
+
+  ScheduleDecode(*scheduler, 500, 1, decoded, reservations);
+  ScheduleDecode(*scheduler, 10, 2, decoded, reservations);
+  runner->RunTasks();
+  EXPECT_EQ(decoded, std::vector<int>({1}));
+
+  reservations.clear();
+  runner->RunTasks();
+  EXPECT_EQ(decoded, std::vector<int>({1, 2}));
+}
+
+TEST(ImageDecodeSchedulerTest, StartsMostRecentDecodeFirst) {
+  auto runner = std::make_shared<ManualTaskRunner>();
+  auto scheduler = std::make_shared<ImageDecodeScheduler>(runner, 100);
+  std::vector<int> decoded;
+  std::vector<Reservation> reservations;
+
+  ScheduleDecode(*scheduler, 100, 1, decoded, reservations);
+  ScheduleDecode(*scheduler, 100, 2, decoded, reservations);
+  ScheduleDecode(*scheduler, 100, 3, decoded, reservations);
+  runner->RunTasks();
+  reservations.clear();
+  runner->RunTasks();
+  reservations.clear();
+  runner->RunTasks();
+  EXPECT_EQ(decoded, std::vector<int>({1, 3, 2}));
+}
+
+TEST(ImageDecodeSchedulerTest, SkipsCancelledDecodes) {
+  auto runner = std::make_shared<ManualTaskRunner>();
+  auto scheduler = std::make_shared<ImageDecodeScheduler>(runner, 100);
+  std::vector<int> decoded;
+  std::vector<int> cancelled_ids;
+  std::vector<Reservation> reservations;
+  auto cancelled = std::make_shared<std::atomic<bool>>(false);
+
+  ScheduleDecode(*scheduler, 100, 1, decoded, reservations);
+  ScheduleDecode(*scheduler, 100, 2, decoded, reservations, cancelled,
+                 &cancelled_ids);
+  runner->RunTasks();
+  EXPECT_EQ(scheduler->GetMetrics().pending_decodes, 1u);
+
+  cancelled->store(true);
+  reservations.clear();
+  runner->RunTasks();
+  EXPECT_EQ(decoded, std::vector<int>({1}));
+  EXPECT_EQ(cancelled_ids, std::vector<int>({2}));
+
+  ImageDecodeScheduler::Metrics metrics = scheduler->GetMetrics();
+  EXPECT_EQ(metrics.pending_decodes, 0u);
+  EXPECT_EQ(metrics.cancelled_decodes, 1u);
+  EXPECT_EQ(metrics.started_decodes, 1u);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -47,6 +47,8 @@ ImageDecoder::ImageDecoder(
     : runners_(runners),
       concurrent_task_runner_(std::move(concurrent_task_runner)),
       io_manager_(std::move(io_manager)),
+      decode_scheduler_(
+          std::make_shared<ImageDecodeScheduler>(concurrent_task_runner_)),
       weak_factory_(this) {
   FML_DCHECK(runners_.IsValid());
   FML_DCHECK(runners_.GetUITaskRunner()->RunsTasksOnCurrentThread())
@@ -59,4 +61,27 @@ fml::TaskRunnerAffineWeakPtr<ImageDecoder> ImageDecoder::GetWeakPtr() const {
   return weak_factory_.GetWeakPtr();
 }
 
+const std::shared_ptr<ImageDecodeScheduler>& ImageDecoder::GetDecodeScheduler()
+    const {
+  return decode_scheduler_;
+}
+
+size_t ImageDecoder::EstimateDecodedBytes(const ImageDescriptor& descriptor,
+                                          const Options& options) {
+  // The decoded pixels are at most the size of the target, which defaults to
+  // the size of the image. Compressed images may decode to a larger
+  // intermediate first, but that is short lived.
+  const size_t width = options.target_width > 0
+                           ? options.target_width
+                           : static_cast<size_t>(descriptor.width());
+  const size_t height = options.target_height > 0
+                            ? options.target_height
+                            : static_cast<size_t>(descriptor.height());
+  const size_t bytes_per_pixel =
+      descriptor.is_compressed()
+          ? 4
+          : static_cast<size_t>(descriptor.bytesPerPixel());
+  return width * height * bytes_per_pixel;
+}
+
 }  // namespace flutter
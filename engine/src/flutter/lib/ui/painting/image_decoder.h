@@ -5,13 +5,16 @@
 #ifndef FLUTTER_LIB_UI_PAINTING_IMAGE_DECODER_H_
 #define FLUTTER_LIB_UI_PAINTING_IMAGE_DECODER_H_
 
+#include <atomic>
 #include <memory>
+#include <optional>
 
 #include "flutter/common/settings.h"
 #include "flutter/common/task_runners.h"
 #include "flutter/display_list/image/dl_image.h"
 #include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/lib/ui/io_manager.h"
+#include "flutter/lib/ui/painting/image_decode_scheduler.h"
 #include "flutter/lib/ui/painting/image_descriptor.h"
 
 namespace flutter {
@@ -47,6 +50,14 @@ class ImageDecoder {
     uint32_t target_width = 0;
     uint32_t target_height = 0;
     TargetPixelFormat target_format = TargetPixelFormat::kDontCare;
+    /// The region of the image to decode, in the coordinates of the
+    /// oriented source image. The target size applies to the region. Only
+    /// compressed images are supported, and only by the Impeller decoder.
+    std::optional<SkIRect> target_subset;
+    /// Set by the caller once it no longer needs the result. If the decode
+    /// has not started by then, it is skipped and the callback receives a
+    /// null image.
+    std::shared_ptr<const std::atomic<bool>> cancelled;
   };
 
   // Takes an image descriptor and returns a handle to a texture resident on the
@@ -60,16 +71,26 @@ class ImageDecoder {
 
   fml::TaskRunnerAffineWeakPtr<ImageDecoder> GetWeakPtr() const;
 
+  // The scheduler that admits decodes onto the concurrent task runner. Its
+  // metrics describe the decodes queued and in flight on this decoder.
+  const std::shared_ptr<ImageDecodeScheduler>& GetDecodeScheduler() const;
+
  protected:
   TaskRunners runners_;
   std::shared_ptr<fml::ConcurrentTaskRunner> concurrent_task_runner_;
   fml::WeakPtr<IOManager> io_manager_;
+  std::shared_ptr<ImageDecodeScheduler> decode_scheduler_;
 
   ImageDecoder(
       const TaskRunners& runners,
       std::shared_ptr<fml::ConcurrentTaskRunner> concurrent_task_runner,
       fml::WeakPtr<IOManager> io_manager);
 
+  // An estimate of the memory held by the decoded pixels of an image while
+  // it is decoded and uploaded.
+  static size_t EstimateDecodedBytes(const ImageDescriptor& descriptor,
+                                     const Options& options);
+
  private:
   fml::TaskRunnerAffineWeakPtrFactory<ImageDecoder> weak_factory_;
 
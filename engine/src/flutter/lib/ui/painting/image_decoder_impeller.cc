@@ -4,8 +4,12 @@
 
 #include "flutter/lib/ui/painting/image_decoder_impeller.h"
 
+#include <algorithm>
 #include <format>
+#include <iterator>
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "flutter/fml/closure.h"
 #include "flutter/fml/make_copyable.h"
@@ -29,6 +33,7 @@
 #include "third_party/skia/include/core/SkPixelRef.h"
 #include "third_party/skia/include/core/SkPixmap.h"
 #include "third_party/skia/include/core/SkPoint.h"
+#include "third_party/skia/include/core/SkRect.h"
 #include "third_party/skia/include/core/SkSize.h"
 
 namespace flutter {
@@ -162,6 +167,7 @@ absl::StatusOr<DecodedBitmap> DecodeToBitmap(
     ImageDescriptor* descriptor,
     const SkImageInfo& image_info,
     const SkImageInfo& base_image_info,
+    const std::optional<SkIRect>& subset,
     const std::shared_ptr<impeller::Allocator>& allocator) {
   std::shared_ptr<SkBitmap> bitmap = std::make_shared<SkBitmap>();
   bitmap->setInfo(image_info);
@@ -175,7 +181,11 @@ absl::StatusOr<DecodedBitmap> DecodeToBitmap(
       FML_DLOG(ERROR) << error;
       return absl::InvalidArgumentError(error);
     }
-    if (!descriptor->get_pixels(bitmap->pixmap())) {
+    const bool decoded =
+        subset.has_value()
+            ? descriptor->get_subset_pixels(bitmap->pixmap(), subset.value())
+            : descriptor->get_pixels(bitmap->pixmap());
+    if (!decoded) {
       std::string error = "Could not decompress image.";
       FML_DLOG(ERROR) << error;
       return absl::InvalidArgumentError(error);
@@ -314,7 +324,9 @@ ImageDecoderImpeller::ImageDecoderImpeller(
     const std::shared_ptr<fml::SyncSwitch>& gpu_disabled_switch)
     : ImageDecoder(runners, std::move(concurrent_task_runner), io_manager),
       wide_gamut_enabled_(wide_gamut_enabled),
-      gpu_disabled_switch_(gpu_disabled_switch) {
+      gpu_disabled_switch_(gpu_disabled_switch),
+      upload_queue_(std::make_shared<UploadQueue>(runners.GetIOTaskRunner(),
+                                                  gpu_disabled_switch)) {
   std::promise<std::shared_ptr<impeller::Context>> context_promise;
   context_ = context_promise.get_future();
   runners_.GetIOTaskRunner()->PostTask(fml::MakeCopyable(
@@ -344,8 +356,19 @@ ImageDecoderImpeller::DecompressTexture(
     return absl::InvalidArgumentError(decode_error);
   }
 
-  const SkISize source_size = SkISize::Make(descriptor->image_info().width,
-                                            descriptor->image_info().height);
+  SkISize source_size = SkISize::Make(descriptor->image_info().width,
+                                      descriptor->image_info().height);
+  if (options.target_subset.has_value()) {
+    const SkIRect& subset = options.target_subset.value();
+    if (!descriptor->is_compressed() || subset.isEmpty() ||
+        !SkIRect::MakeSize(source_size).contains(subset)) {
+      std::string decode_error = "Invalid subset for image decompression.";
+      FML_DLOG(ERROR) << decode_error;
+      return absl::InvalidArgumentError(decode_error);
+    }
+    // Only the subset is decoded, so it is the source for all sizing below.
+    source_size = subset.size();
+  }
   const SkISize target_size =
       SkISize::Make(std::min(max_texture_size.width,
                              static_cast<int64_t>(options.target_width)),
@@ -380,7 +403,13 @@ ImageDecoderImpeller::DecompressTexture(
   }
 
   SkISize decode_size = source_size;
-  if (descriptor->is_compressed()) {
+  if (options.target_subset.has_value()) {
+    // Subsets are scaled by the generator while decoding, so there is no
+    // need to allocate more than the target size.
+    decode_size =
+        SkISize::Make(std::min(source_size.width(), target_size.width()),
+                      std::min(source_size.height(), target_size.height()));
+  } else if (descriptor->is_compressed()) {
     decode_size = descriptor->get_scaled_dimensions(std::max(
         static_cast<float>(target_size.width()) / source_size.width(),
         static_cast<float>(target_size.height()) / source_size.height()));
@@ -403,8 +432,9 @@ ImageDecoderImpeller::DecompressTexture(
     return absl::InvalidArgumentError(decode_error);
   }
 
-  absl::StatusOr<DecodedBitmap> decoded = DecodeToBitmap(
-      descriptor, image_info.value(), base_image_info, allocator);
+  absl::StatusOr<DecodedBitmap> decoded =
+      DecodeToBitmap(descriptor, image_info.value(), base_image_info,
+                     options.target_subset, allocator);
   if (!decoded.ok()) {
     return decoded.status();
   }
@@ -418,9 +448,12 @@ ImageDecoderImpeller::DecompressTexture(
   std::shared_ptr<ImpellerAllocator> bitmap_allocator =
       premultiplied->allocator;
 
-  if (source_size.width() > max_texture_size.width ||
-      source_size.height() > max_texture_size.height ||
-      !capabilities->SupportsTextureToTextureBlits()) {
+  // Decode-time scaling may already have produced the target size, in which
+  // case there is nothing left to resize.
+  if (bitmap->dimensions() != target_size &&
+      (bitmap->width() > max_texture_size.width ||
+       bitmap->height() > max_texture_size.height ||
+       !capabilities->SupportsTextureToTextureBlits())) {
     return ResizeOnCpu(bitmap, target_size, allocator);
   }
 
@@ -450,87 +483,129 @@ ImageDecoderImpeller::DecompressTexture(
 }
 
 // static
-std::pair<sk_sp<DlImage>, std::string>
-ImageDecoderImpeller::UnsafeUploadTextureToPrivate(
+std::vector<std::pair<sk_sp<DlImage>, std::string>>
+ImageDecoderImpeller::UnsafeUploadTexturesToPrivate(
     const std::shared_ptr<impeller::Context>& context,
-    const std::shared_ptr<impeller::DeviceBuffer>& buffer,
-    const ImageDecoderImpeller::ImageInfo& image_info,
-    const std::optional<SkImageInfo>& resize_info) {
-  impeller::TextureDescriptor texture_descriptor;
-  texture_descriptor.storage_mode = impeller::StorageMode::kDevicePrivate;
-  texture_descriptor.format = image_info.format;
-  texture_descriptor.size = {image_info.size.width, image_info.size.height};
-  texture_descriptor.mip_count = texture_descriptor.size.MipCount();
-  if (context->GetBackendType() == impeller::Context::BackendType::kMetal &&
-      resize_info.has_value()) {
-    // The MPS used to resize images on iOS does not require mip generation.
-    // Remove mip count if we are resizing the image on the GPU.
-    texture_descriptor.mip_count = 1;
-  }
-
-  auto dest_texture =
-      context->GetResourceAllocator()->CreateTexture(texture_descriptor);
-  if (!dest_texture) {
-    std::string decode_error("Could not create Impeller texture.");
+    const std::vector<PendingUpload>& uploads) {
+  std::vector<std::pair<sk_sp<DlImage>, std::string>> results(uploads.size());
+  auto fail_uploads = [&results](const std::string& decode_error) {
     FML_DLOG(ERROR) << decode_error;
-    return std::make_pair(nullptr, decode_error);
-  }
+    for (auto& result : results) {
+      if (result.second.empty()) {
+        result = std::make_pair(nullptr, decode_error);
+      }
+    }
+    return std::move(results);
+  };
 
-  dest_texture->SetLabel(
-      std::format("ui.Image({})", static_cast<const void*>(dest_texture.get()))
-          .c_str());
+  const bool is_metal =
+      context->GetBackendType() == impeller::Context::BackendType::kMetal;
+  const std::shared_ptr<impeller::Allocator> allocator =
+      context->GetResourceAllocator();
+
+  // The textures the buffers are copied into, and the textures they are
+  // resized into if they are resized on the GPU. A null texture marks an
+  // upload that already failed.
+  std::vector<std::shared_ptr<impeller::Texture>> dest_textures(
+      uploads.size());
+  std::vector<std::shared_ptr<impeller::Texture>> resize_textures(
+      uploads.size());
+  size_t valid_uploads = 0;
+  for (size_t i = 0; i < uploads.size(); i++) {
+    const ImageInfo& image_info = uploads[i].image_info;
+    const std::optional<SkImageInfo>& resize_info = uploads[i].resize_info;
+
+    impeller::TextureDescriptor texture_descriptor;
+    texture_descriptor.storage_mode = impeller::StorageMode::kDevicePrivate;
+    texture_descriptor.format = image_info.format;
+    texture_descriptor.size = {image_info.size.width, image_info.size.height};
+    texture_descriptor.mip_count = texture_descriptor.size.MipCount();
+    if (is_metal && resize_info.has_value()) {
+      // The MPS used to resize images on iOS does not require mip generation.
+      // Remove mip count if we are resizing the image on the GPU.
+      texture_descriptor.mip_count = 1;
+    }
+
+    auto dest_texture = allocator->CreateTexture(texture_descriptor);
+    if (!dest_texture) {
+      std::string decode_error("Could not create Impeller texture.");
+      FML_DLOG(ERROR) << decode_error;
+      results[i] = std::make_pair(nullptr, decode_error);
+      continue;
+    }
+
+    dest_texture->SetLabel(
+        std::format("ui.Image({})",
+                    static_cast<const void*>(dest_texture.get()))
+            .c_str());
+
+    if (resize_info.has_value()) {
+      impeller::TextureDescriptor resize_desc;
+      resize_desc.storage_mode = impeller::StorageMode::kDevicePrivate;
+      resize_desc.format = image_info.format;
+      resize_desc.size = {resize_info->width(), resize_info->height()};
+      resize_desc.mip_count = resize_desc.size.MipCount();
+      resize_desc.usage = impeller::TextureUsage::kShaderRead;
+      if (is_metal) {
+        // Resizing requires a MPS on Metal platforms.
+        resize_desc.usage |= impeller::TextureUsage::kShaderWrite;
+        resize_desc.compression_type = impeller::CompressionType::kLossless;
+      }
+      auto resize_texture = allocator->CreateTexture(resize_desc);
+      if (!resize_texture) {
+        std::string decode_error("Could not create resized Impeller texture.");
+        FML_DLOG(ERROR) << decode_error;
+        results[i] = std::make_pair(nullptr, decode_error);
+        continue;
+      }
+      resize_textures[i] = std::move(resize_texture);
+    }
+
+    dest_textures[i] = std::move(dest_texture);
+    valid_uploads++;
+  }
+  if (valid_uploads == 0) {
+    return results;
+  }
 
   auto command_buffer = context->CreateCommandBuffer();
   if (!command_buffer) {
-    std::string decode_error(
+    return fail_uploads(
         "Could not create command buffer for mipmap generation.");
-    FML_DLOG(ERROR) << decode_error;
-    return std::make_pair(nullptr, decode_error);
   }
   command_buffer->SetLabel("Mipmap Command Buffer");
 
   auto blit_pass = command_buffer->CreateBlitPass();
   if (!blit_pass) {
-    std::string decode_error(
-        "Could not create blit pass for mipmap generation.");
-    FML_DLOG(ERROR) << decode_error;
-    return std::make_pair(nullptr, decode_error);
+    return fail_uploads("Could not create blit pass for mipmap generation.");
   }
   blit_pass->SetLabel("Mipmap Blit Pass");
-  blit_pass->AddCopy(impeller::DeviceBuffer::AsBufferView(buffer),
-                     dest_texture);
-  if (texture_descriptor.mip_count > 1) {
-    blit_pass->GenerateMipmap(dest_texture);
-  }
-
-  std::shared_ptr<impeller::Texture> result_texture = dest_texture;
-  if (resize_info.has_value()) {
-    impeller::TextureDescriptor resize_desc;
-    resize_desc.storage_mode = impeller::StorageMode::kDevicePrivate;
-    resize_desc.format = image_info.format;
-    resize_desc.size = {resize_info->width(), resize_info->height()};
-    resize_desc.mip_count = resize_desc.size.MipCount();
-    resize_desc.usage = impeller::TextureUsage::kShaderRead;
-    if (context->GetBackendType() == impeller::Context::BackendType::kMetal) {
-      // Resizing requires a MPS on Metal platforms.
-      resize_desc.usage |= impeller::TextureUsage::kShaderWrite;
-      resize_desc.compression_type = impeller::CompressionType::kLossless;
+
+  // Copy every image before generating any mipmaps, so that the backends can
+  // batch the transfers and the mipmap generation of the images separately.
+  for (size_t i = 0; i < uploads.size(); i++) {
+    if (dest_textures[i]) {
+      blit_pass->AddCopy(
+          impeller::DeviceBuffer::AsBufferView(uploads[i].buffer),
+          dest_textures[i]);
     }
-    auto resize_texture =
-        context->GetResourceAllocator()->CreateTexture(resize_desc);
-    if (!resize_texture) {
-      std::string decode_error("Could not create resized Impeller texture.");
-      FML_DLOG(ERROR) << decode_error;
-      return std::make_pair(nullptr, decode_error);
+  }
+  for (const auto& dest_texture : dest_textures) {
+    if (dest_texture && dest_texture->GetTextureDescriptor().mip_count > 1) {
+      blit_pass->GenerateMipmap(dest_texture);
     }
-
-    blit_pass->ResizeTexture(/*source=*/dest_texture,
-                             /*destination=*/resize_texture);
-    if (resize_desc.mip_count > 1) {
-      blit_pass->GenerateMipmap(resize_texture);
+  }
+  for (size_t i = 0; i < uploads.size(); i++) {
+    if (dest_textures[i] && resize_textures[i]) {
+      blit_pass->ResizeTexture(/*source=*/dest_textures[i],
+                               /*destination=*/resize_textures[i]);
+    }
+  }
+  for (size_t i = 0; i < uploads.size(); i++) {
+    if (dest_textures[i] && resize_textures[i] &&
+        resize_textures[i]->GetTextureDescriptor().mip_count > 1) {
+      blit_pass->GenerateMipmap(resize_textures[i]);
     }
-
-    result_texture = std::move(resize_texture);
   }
   blit_pass->EncodeCommands();
   {
@@ -544,24 +619,35 @@ ImageDecoderImpeller::UnsafeUploadTextureToPrivate(
               }
             });
     if (!submit_result.status.ok()) {
-      std::string decode_error(
-          "Failed to submit image decoding command buffer.");
-      FML_DLOG(ERROR) << decode_error;
-      return std::make_pair(nullptr, decode_error);
+      return fail_uploads("Failed to submit image decoding command buffer.");
     }
 
     if (submit_result.scheduling_receipt) {
-      // UploadTextureToPrivate calls this method while holding the shared side
-      // of the GPU SyncSwitch. Registering before returning ensures that a
-      // concurrent disable transition cannot pass the switch's unique lock and
-      // miss a committed upload.
+      // UploadTexturesToPrivate calls this method while holding the shared
+      // side of the GPU SyncSwitch. Registering before returning ensures that
+      // a concurrent disable transition cannot pass the switch's unique lock
+      // and miss a committed upload.
       context->TrackPendingImageUpload(submit_result.scheduling_receipt);
     }
   }
 
   // Flush the pending command buffer to ensure that its output becomes visible
   // to the raster thread.
-  if (context->AddTrackingFence(result_texture)) {
+  bool tracked_all_textures = true;
+  for (size_t i = 0; i < uploads.size(); i++) {
+    if (!dest_textures[i]) {
+      continue;
+    }
+    std::shared_ptr<impeller::Texture> result_texture =
+        resize_textures[i] ? std::move(resize_textures[i])
+                           : std::move(dest_textures[i]);
+    tracked_all_textures =
+        context->AddTrackingFence(result_texture) && tracked_all_textures;
+    results[i] = std::make_pair(
+        impeller::DlImageImpeller::Make(std::move(result_texture)),
+        std::string());
+  }
+  if (tracked_all_textures) {
     command_buffer->WaitUntilScheduled();
   } else {
     command_buffer->WaitUntilCompleted();
@@ -569,9 +655,7 @@ ImageDecoderImpeller::UnsafeUploadTextureToPrivate(
 
   context->DisposeThreadLocalCachedResources();
 
-  return std::make_pair(
-      impeller::DlImageImpeller::Make(std::move(result_texture)),
-      std::string());
+  return results;
 }
 
 void ImageDecoderImpeller::UploadTextureToPrivate(
@@ -581,43 +665,121 @@ void ImageDecoderImpeller::UploadTextureToPrivate(
     const ImageDecoderImpeller::ImageInfo& image_info,
     const std::optional<SkImageInfo>& resize_info,
     const std::shared_ptr<const fml::SyncSwitch>& gpu_disabled_switch) {
-  TRACE_EVENT0("impeller", __FUNCTION__);
+  std::vector<PendingUpload> uploads;
+  uploads.push_back({
+      .result = std::move(result),
+      .buffer = buffer,
+      .image_info = image_info,
+      .resize_info = resize_info,
+  });
+  UploadTexturesToPrivate(std::move(uploads), context, gpu_disabled_switch);
+}
+
+void ImageDecoderImpeller::UploadTexturesToPrivate(
+    std::vector<PendingUpload> uploads,
+    const std::shared_ptr<impeller::Context>& context,
+    const std::shared_ptr<const fml::SyncSwitch>& gpu_disabled_switch) {
+  const std::string upload_count = std::to_string(uploads.size());
+  TRACE_EVENT1("impeller", __FUNCTION__, "uploads", upload_count.c_str());
   if (!context) {
-    result(nullptr, "No Impeller context is available");
+    for (auto& upload : uploads) {
+      upload.result(nullptr, "No Impeller context is available");
+    }
     return;
   }
-  if (!buffer) {
-    result(nullptr, "No Impeller device buffer is available");
+  auto valid_uploads = std::make_shared<std::vector<PendingUpload>>();
+  valid_uploads->reserve(uploads.size());
+  for (auto& upload : uploads) {
+    if (!upload.buffer) {
+      upload.result(nullptr, "No Impeller device buffer is available");
+      continue;
+    }
+    valid_uploads->push_back(std::move(upload));
+  }
+  if (valid_uploads->empty()) {
     return;
   }
 
+  auto upload_and_invoke_results = [context, valid_uploads]() {
+    std::vector<std::pair<sk_sp<DlImage>, std::string>> results =
+        UnsafeUploadTexturesToPrivate(context, *valid_uploads);
+    for (size_t i = 0; i < valid_uploads->size(); i++) {
+      (*valid_uploads)[i].result(results[i].first, results[i].second);
+    }
+  };
+
   gpu_disabled_switch->Execute(
       fml::SyncSwitch::Handlers()
-          .SetIfFalse([&result, context, buffer, image_info, resize_info] {
-            sk_sp<DlImage> image;
-            std::string decode_error;
-            std::tie(image, decode_error) = UnsafeUploadTextureToPrivate(
-                context, buffer, image_info, resize_info);
-            result(image, decode_error);
-          })
-          .SetIfTrue([&result, context, buffer, image_info, resize_info] {
-            auto result_ptr = std::make_shared<ImageResult>(std::move(result));
-            context->StoreTaskForGPU(
-                [result_ptr, context, buffer, image_info, resize_info]() {
-                  sk_sp<DlImage> image;
-                  std::string decode_error;
-                  std::tie(image, decode_error) = UnsafeUploadTextureToPrivate(
-                      context, buffer, image_info, resize_info);
-                  (*result_ptr)(image, decode_error);
-                },
-                [result_ptr]() {
-                  (*result_ptr)(
-                      nullptr,
-                      "Image upload failed due to loss of GPU access.");
-                });
+          .SetIfFalse(upload_and_invoke_results)
+          .SetIfTrue([&upload_and_invoke_results, context, valid_uploads] {
+            context->StoreTaskForGPU(upload_and_invoke_results,
+                                     [valid_uploads]() {
+                                       for (auto& upload : *valid_uploads) {
+                                         upload.result(
+                                             nullptr,
+                                             "Image upload failed due to loss "
+                                             "of GPU access.");
+                                       }
+                                     });
           }));
 }
 
+ImageDecoderImpeller::UploadQueue::UploadQueue(
+    fml::RefPtr<fml::TaskRunner> io_runner,
+    std::shared_ptr<const fml::SyncSwitch> gpu_disabled_switch)
+    : io_runner_(std::move(io_runner)),
+      gpu_disabled_switch_(std::move(gpu_disabled_switch)) {}
+
+ImageDecoderImpeller::UploadQueue::~UploadQueue() = default;
+
+void ImageDecoderImpeller::UploadQueue::Enqueue(
+    const std::shared_ptr<impeller::Context>& context,
+    PendingUpload upload) {
+  std::scoped_lock lock(mutex_);
+  FML_DCHECK(!context_ || context_ == context);
+  context_ = context;
+  pending_.push_back(std::move(upload));
+  if (flush_scheduled_) {
+    return;
+  }
+  flush_scheduled_ = true;
+  // The queue outlives the decoder until every upload is flushed, so that
+  // every result is invoked.
+  io_runner_->PostTask([queue = shared_from_this()]() { queue->Flush(); });
+}
+
+ImageDecoderImpeller::UploadQueue::Stats
+ImageDecoderImpeller::UploadQueue::GetStats() const {
+  std::scoped_lock lock(mutex_);
+  return stats_;
+}
+
+void ImageDecoderImpeller::UploadQueue::Flush() {
+  FML_DCHECK(io_runner_->RunsTasksOnCurrentThread());
+  std::vector<PendingUpload> batch;
+  std::shared_ptr<impeller::Context> context;
+  {
+    std::scoped_lock lock(mutex_);
+    if (pending_.size() > kMaxBatchSize) {
+      batch.reserve(kMaxBatchSize);
+      std::move(pending_.begin(), pending_.begin() + kMaxBatchSize,
+                std::back_inserter(batch));
+      pending_.erase(pending_.begin(), pending_.begin() + kMaxBatchSize);
+      // Leave the IO task runner to other work before the next batch.
+      io_runner_->PostTask([queue = shared_from_this()]() { queue->Flush(); });
+    } else {
+      batch = std::move(pending_);
+      pending_.clear();
+      flush_scheduled_ = false;
+    }
+    context = context_;
+    stats_.uploads += batch.size();
+    stats_.batches++;
+    stats_.max_batch_size = std::max(stats_.max_batch_size, batch.size());
+  }
+  UploadTexturesToPrivate(std::move(batch), context, gpu_disabled_switch_);
+}
+
 std::pair<sk_sp<DlImage>, std::string>
 ImageDecoderImpeller::UploadTextureToStorage(
     const std::shared_ptr<impeller::Context>& context,
@@ -695,14 +857,16 @@ void ImageDecoderImpeller::Decode(fml::RefPtr<ImageDescriptor> descriptor,
     });
   };
 
-  concurrent_task_runner_->PostTask(
+  decode_scheduler_->Schedule(
+      EstimateDecodedBytes(*descriptor, options), options.cancelled,
       [raw_descriptor,            //
        context = context_.get(),  //
        options,
-       io_runner = runners_.GetIOTaskRunner(),  //
+       upload_queue = upload_queue_,  //
        result,
-       wide_gamut_enabled = wide_gamut_enabled_,  //
-       gpu_disabled_switch = gpu_disabled_switch_]() {
+       wide_gamut_enabled = wide_gamut_enabled_](
+          const std::shared_ptr<ImageDecodeScheduler::Reservation>&
+              reservation) {
 #if FML_OS_IOS_SIMULATOR
         // No-op backend.
         if (!context) {
@@ -728,23 +892,22 @@ void ImageDecoderImpeller::Decode(fml::RefPtr<ImageDescriptor> descriptor,
           return;
         }
 
-        auto upload_texture_and_invoke_result = [result, context, bitmap_result,
-                                                 gpu_disabled_switch]() {
-          UploadTextureToPrivate(result, context,               //
-                                 bitmap_result->device_buffer,  //
-                                 bitmap_result->image_info,     //
-                                 bitmap_result->resize_info,    //
-                                 gpu_disabled_switch            //
-          );
+        // The reservation is held until the decoded pixels are uploaded.
+        // Uploads are batched on the IO task runner, which also keeps them
+        // off of the worker threads on GLES, where they are not threadsafe.
+        PendingUpload upload = {
+            .result =
+                [result, reservation](sk_sp<DlImage> image,
+                                      std::string decode_error) {
+                  result(std::move(image), std::move(decode_error));
+                },
+            .buffer = bitmap_result->device_buffer,
+            .image_info = bitmap_result->image_info,
+            .resize_info = bitmap_result->resize_info,
         };
-        // The I/O image uploads are not threadsafe on GLES.
-        if (context->GetBackendType() ==
-            impeller::Context::BackendType::kOpenGLES) {
-          io_runner->PostTask(upload_texture_and_invoke_result);
-        } else {
-          upload_texture_and_invoke_result();
-        }
-      });
+        upload_queue->Enqueue(context, std::move(upload));
+      },
+      [result]() { result(nullptr, "Image decode was cancelled."); });
 }
 
 ImpellerAllocator::ImpellerAllocator(
@@ -6,8 +6,11 @@
 #define FLUTTER_LIB_UI_PAINTING_IMAGE_DECODER_IMPELLER_H_
 
 #include <future>
+#include <mutex>
+#include <vector>
 
 #include "flutter/fml/macros.h"
+#include "flutter/fml/task_runner.h"
 #include "flutter/lib/ui/painting/image_decoder.h"
 #include "impeller/core/formats.h"
 #include "impeller/geometry/size.h"
@@ -94,6 +97,76 @@ class ImageDecoderImpeller final : public ImageDecoder {
       const std::optional<SkImageInfo>& resize_info,
       const std::shared_ptr<const fml::SyncSwitch>& gpu_disabled_switch);
 
+  /// An image waiting to be copied into a device private texture.
+  struct PendingUpload {
+    /// Accepts the DlImage and any encoding error messages.
+    ImageResult result;
+    /// A host buffer containing the image to be uploaded.
+    std::shared_ptr<impeller::DeviceBuffer> buffer;
+    ImageInfo image_info;
+    std::optional<SkImageInfo> resize_info;
+  };
+
+  /// @brief Create device private textures for a batch of host buffers.
+  ///
+  ///        All of the images are copied, resized and have their mipmaps
+  ///        generated in a single blit pass of a single command buffer, which
+  ///        is submitted once. The result of every upload is invoked, in
+  ///        order, before this returns or once the GPU becomes available.
+  ///
+  /// @param uploads    The images to upload.
+  /// @param context    The Impeller graphics context.
+  /// @param gpu_disabled_switch Whether the GPU is available command encoding.
+  static void UploadTexturesToPrivate(
+      std::vector<PendingUpload> uploads,
+      const std::shared_ptr<impeller::Context>& context,
+      const std::shared_ptr<const fml::SyncSwitch>& gpu_disabled_switch);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Coalesces the uploads of images that finish decoding close
+  ///             together into batches, which are uploaded on the IO task
+  ///             runner by `UploadTexturesToPrivate`.
+  ///
+  ///             The first upload that is enqueued posts a task to the IO task
+  ///             runner. Every upload enqueued before that task runs is part
+  ///             of the same batch, up to `kMaxBatchSize` uploads.
+  ///
+  ///             This class is thread safe.
+  ///
+  class UploadQueue : public std::enable_shared_from_this<UploadQueue> {
+   public:
+    static constexpr size_t kMaxBatchSize = 128;
+
+    struct Stats {
+      size_t uploads = 0;
+      size_t batches = 0;
+      size_t max_batch_size = 0;
+    };
+
+    UploadQueue(fml::RefPtr<fml::TaskRunner> io_runner,
+                std::shared_ptr<const fml::SyncSwitch> gpu_disabled_switch);
+
+    ~UploadQueue();
+
+    void Enqueue(const std::shared_ptr<impeller::Context>& context,
+                 PendingUpload upload);
+
+    Stats GetStats() const;
+
+   private:
+    const fml::RefPtr<fml::TaskRunner> io_runner_;
+    const std::shared_ptr<const fml::SyncSwitch> gpu_disabled_switch_;
+    mutable std::mutex mutex_;
+    std::shared_ptr<impeller::Context> context_;
+    std::vector<PendingUpload> pending_;
+    bool flush_scheduled_ = false;
+    Stats stats_;
+
+    void Flush();
+
+    FML_DISALLOW_COPY_AND_ASSIGN(UploadQueue);
+  };
+
   /// @brief Create a texture from the provided bitmap.
   /// @param context     The Impeller graphics context.
   /// @param bitmap      A bitmap containg the image to be uploaded.
@@ -110,13 +183,13 @@ class ImageDecoderImpeller final : public ImageDecoder {
   /// or not it is supported).
   const bool wide_gamut_enabled_;
   std::shared_ptr<fml::SyncSwitch> gpu_disabled_switch_;
+  std::shared_ptr<UploadQueue> upload_queue_;
 
   /// Only call this method if the GPU is available.
-  static std::pair<sk_sp<DlImage>, std::string> UnsafeUploadTextureToPrivate(
+  static std::vector<std::pair<sk_sp<DlImage>, std::string>>
+  UnsafeUploadTexturesToPrivate(
       const std::shared_ptr<impeller::Context>& context,
-      const std::shared_ptr<impeller::DeviceBuffer>& buffer,
-      const ImageInfo& image_info,
-      const std::optional<SkImageInfo>& resize_info);
+      const std::vector<PendingUpload>& uploads);
 
   FML_DISALLOW_COPY_AND_ASSIGN(ImageDecoderImpeller);
 };
@@ -3,9 +3,12 @@
 // found in the LICENSE file.
 
 #include "flutter/lib/ui/painting/image_decoder_no_gl_unittests.h"
+#include <atomic>
 #include <memory>
 
 #include "flutter/fml/endianness.h"
+#include "flutter/fml/thread.h"
+#include "flutter/testing/post_task_sync.h"
 #include "impeller/renderer/capabilities.h"
 
 #if IMPELLER_SUPPORTS_RENDERING
@@ -153,6 +156,126 @@ TEST(ImageDecoderNoGLTest, ImpellerUploadTracksSchedulingReceipt) {
 #endif  // IMPELLER_SUPPORTS_RENDERING
 }
 
+#if IMPELLER_SUPPORTS_RENDERING
+namespace {
+
+// Expects the uploads of `upload_count` 4x4 images to be encoded into a single
+// blit pass of a single command buffer that is submitted once.
+void ExpectBatchedUploads(
+    const std::shared_ptr<impeller::testing::MockImpellerContext>& context,
+    size_t upload_count) {
+  using ::impeller::testing::MockBlitPass;
+  using ::impeller::testing::MockCommandBuffer;
+  using ::impeller::testing::MockCommandQueue;
+  using ::testing::_;
+  using ::testing::Return;
+
+  auto allocator = std::make_shared<impeller::TestImpellerAllocator>();
+  auto command_buffer = std::make_shared<MockCommandBuffer>(context);
+  auto blit_pass = std::make_shared<MockBlitPass>();
+  auto command_queue = std::make_shared<MockCommandQueue>();
+
+  EXPECT_CALL(*context, GetBackendType)
+      .WillOnce(Return(impeller::Context::BackendType::kVulkan));
+  EXPECT_CALL(*context, GetResourceAllocator).WillOnce(Return(allocator));
+  EXPECT_CALL(*context, CreateCommandBuffer).WillOnce(Return(command_buffer));
+  EXPECT_CALL(*context, GetCommandQueue).WillOnce(Return(command_queue));
+  EXPECT_CALL(*command_buffer, SetLabel(_));
+  EXPECT_CALL(*command_buffer, OnCreateBlitPass).WillOnce(Return(blit_pass));
+  EXPECT_CALL(*command_buffer, OnWaitUntilCompleted);
+  EXPECT_CALL(*blit_pass, IsValid).WillRepeatedly(Return(true));
+  EXPECT_CALL(*blit_pass, OnSetLabel(_)).Times(::testing::AnyNumber());
+  EXPECT_CALL(*blit_pass, OnCopyBufferToTextureCommand(_, _, _, _, _, _, _))
+      .Times(upload_count)
+      .WillRepeatedly(Return(true));
+  EXPECT_CALL(*blit_pass, OnGenerateMipmapCommand(_, _))
+      .Times(upload_count)
+      .WillRepeatedly(Return(true));
+  EXPECT_CALL(*blit_pass, EncodeCommands).WillOnce(Return(true));
+  EXPECT_CALL(*command_queue, SubmitWithReceipt(_, _))
+      .WillOnce([](const std::shared_ptr<impeller::CommandBuffer>&,
+                   const impeller::CommandQueue::CompletionCallback&) {
+        return impeller::CommandQueue::SubmitResult{.status = fml::Status()};
+      });
+}
+
+ImageDecoderImpeller::PendingUpload MakePendingUpload(
+    ImageDecoder::ImageResult result) {
+  impeller::DeviceBufferDescriptor buffer_descriptor;
+  buffer_descriptor.size = 4u * 4u * 4u;
+  return {
+      .result = std::move(result),
+      .buffer = std::make_shared<impeller::TestImpellerDeviceBuffer>(
+          buffer_descriptor),
+      .image_info = {.size = impeller::ISize(4, 4),
+                     .format = impeller::PixelFormat::kR8G8B8A8UNormInt},
+  };
+}
+
+}  // namespace
+#endif  // IMPELLER_SUPPORTS_RENDERING
+
+TEST(ImageDecoderNoGLTest, ImpellerUploadsBatchIntoOneSubmission) {
+#if !IMPELLER_SUPPORTS_RENDERING
+  GTEST_SKIP() << "Test only supported with Impeller rendering.";
+#else
+  auto context = std::make_shared<impeller::testing::MockImpellerContext>();
+  ExpectBatchedUploads(context, 3);
+
+  std::vector<sk_sp<DlImage>> images;
+  std::vector<ImageDecoderImpeller::PendingUpload> uploads;
+  for (int i = 0; i < 3; i++) {
+    uploads.push_back(MakePendingUpload(
+        [&images](const sk_sp<DlImage>& image, const std::string& error) {
+          EXPECT_TRUE(error.empty());
+          images.push_back(image);
+        }));
+  }
+  ImageDecoderImpeller::UploadTexturesToPrivate(
+      std::move(uploads), context, std::make_shared<fml::SyncSwitch>(false));
+
+  ASSERT_EQ(images.size(), 3u);
+  for (const auto& image : images) {
+    ASSERT_NE(image, nullptr);
+    EXPECT_EQ(image->GetSize(), DlISize(4, 4));
+  }
+#endif  // IMPELLER_SUPPORTS_RENDERING
+}
+
+TEST(ImageDecoderNoGLTest, ImpellerUploadQueueBatchesUploadsOfOneTask) {
+#if !IMPELLER_SUPPORTS_RENDERING
+  GTEST_SKIP() << "Test only supported with Impeller rendering.";
+#else
+  auto context = std::make_shared<impeller::testing::MockImpellerContext>();
+  ExpectBatchedUploads(context, 3);
+
+  fml::Thread io_thread("io");
+  auto queue = std::make_shared<ImageDecoderImpeller::UploadQueue>(
+      io_thread.GetTaskRunner(), std::make_shared<fml::SyncSwitch>(false));
+  std::atomic<size_t> uploaded_images = 0;
+  PostTaskSync(io_thread.GetTaskRunner(), [&]() {
+    // Images finishing their decodes while the IO thread is busy are
+    // uploaded together.
+    for (int i = 0; i < 3; i++) {
+      queue->Enqueue(context,
+                     MakePendingUpload([&uploaded_images](
+                                           const sk_sp<DlImage>& image,
+                                           const std::string& error) {
+                       EXPECT_NE(image, nullptr);
+                       uploaded_images++;
+                     }));
+    }
+  });
+  PostTaskSync(io_thread.GetTaskRunner(), [] {});
+
+  EXPECT_EQ(uploaded_images, 3u);
+  ImageDecoderImpeller::UploadQueue::Stats stats = queue->GetStats();
+  EXPECT_EQ(stats.uploads, 3u);
+  EXPECT_EQ(stats.batches, 1u);
+  EXPECT_EQ(stats.max_batch_size, 3u);
+#endif  // IMPELLER_SUPPORTS_RENDERING
+}
+
 TEST(ImageDecoderNoGLTest, ImpellerWideGamutDisplayP3) {
 #if defined(OS_FUCHSIA)
   GTEST_SKIP() << "Fuchsia can't load the test fixtures.";
@@ -267,7 +267,8 @@ void ImageDecoderSkia::Decode(fml::RefPtr<ImageDescriptor> descriptor_ref_ptr,
     return;
   }
 
-  concurrent_task_runner_->PostTask(
+  decode_scheduler_->Schedule(
+      EstimateDecodedBytes(*raw_descriptor, options), options.cancelled,
       fml::MakeCopyable([raw_descriptor,                          //
                          io_manager = io_manager_,                //
                          io_runner = runners_.GetIOTaskRunner(),  //
@@ -275,7 +276,8 @@ void ImageDecoderSkia::Decode(fml::RefPtr<ImageDescriptor> descriptor_ref_ptr,
                          target_width = options.target_width,     //
                          target_height = options.target_height,   //
                          flow = std::move(flow)                   //
-  ]() mutable {
+  ](const std::shared_ptr<ImageDecodeScheduler::Reservation>&
+                             reservation) mutable {
         // Step 1: Decompress the image.
         // On Worker.
 
@@ -298,7 +300,9 @@ void ImageDecoderSkia::Decode(fml::RefPtr<ImageDescriptor> descriptor_ref_ptr,
         // Step 2: Update the image to the GPU.
         // On IO Thread.
 
+        // The reservation is held until the decoded pixels are uploaded.
         io_runner->PostTask(fml::MakeCopyable([io_manager, decompressed, result,
+                                               reservation,
                                                flow =
                                                    std::move(flow)]() mutable {
           if (!io_manager) {
@@ -328,7 +332,10 @@ void ImageDecoderSkia::Decode(fml::RefPtr<ImageDescriptor> descriptor_ref_ptr,
           // Finally, all done.
           result(std::move(uploaded), std::move(flow));
         }));
-      }));
+      }),
+      [result]() {
+        result({}, fml::tracing::TraceFlow("ImageDecodeCancelled"));
+      });
 }
 
 }  // namespace flutter
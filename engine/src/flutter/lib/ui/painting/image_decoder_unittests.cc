@@ -34,6 +34,7 @@
 #include "third_party/skia/include/core/SkData.h"
 #include "third_party/skia/include/core/SkImage.h"
 #include "third_party/skia/include/core/SkImageInfo.h"
+#include "third_party/skia/include/core/SkRect.h"
 #include "third_party/skia/include/core/SkSize.h"
 #include "third_party/skia/include/encode/SkPngEncoder.h"
 
@@ -969,6 +970,86 @@ TEST(ImageDecoderTest, VerifySubpixelDecodingPreservesExifOrientation) {
   ASSERT_EQ(200, image->height());
 }
 
+namespace {
+
+// Encodes a 100x100 PNG whose left half is red and right half is blue.
+sk_sp<SkData> MakeSplitColorPng() {
+  SkBitmap bitmap;
+  bitmap.allocPixels(SkImageInfo::MakeN32Premul(100, 100));
+  bitmap.erase(SK_ColorRED, SkIRect::MakeWH(50, 100));
+  bitmap.erase(SK_ColorBLUE, SkIRect::MakeXYWH(50, 0, 50, 100));
+  return SkPngEncoder::Encode(nullptr,
+                              SkImages::RasterFromBitmap(bitmap).get(), {});
+}
+
+}  // namespace
+
+TEST(ImageDecoderTest, CanDecodeImageSubset) {
+  ImageGeneratorRegistry registry;
+  std::shared_ptr<ImageGenerator> generator =
+      registry.CreateCompatibleGenerator(MakeSplitColorPng());
+  ASSERT_TRUE(generator);
+
+  SkBitmap bitmap;
+  bitmap.allocPixels(generator->GetInfo().makeWH(10, 20));
+  ASSERT_TRUE(generator->GetSubsetPixels(bitmap.info(), bitmap.getPixels(),
+                                         bitmap.rowBytes(),
+                                         SkIRect::MakeXYWH(50, 0, 50, 100)));
+  EXPECT_EQ(bitmap.getColor(0, 0), SK_ColorBLUE);
+  EXPECT_EQ(bitmap.getColor(9, 19), SK_ColorBLUE);
+
+  // Subsets that are not contained in the image are rejected.
+  EXPECT_FALSE(generator->GetSubsetPixels(bitmap.info(), bitmap.getPixels(),
+                                          bitmap.rowBytes(),
+                                          SkIRect::MakeXYWH(60, 0, 50, 100)));
+}
+
+TEST_F(ImageDecoderFixtureTest, ImpellerDecodesSubsetAtTargetSize) {
+  ImageGeneratorRegistry registry;
+  std::shared_ptr<ImageGenerator> generator =
+      registry.CreateCompatibleGenerator(MakeSplitColorPng());
+  ASSERT_TRUE(generator);
+  auto descriptor = fml::MakeRefCounted<ImageDescriptor>(MakeSplitColorPng(),
+                                                         std::move(generator));
+
+#if IMPELLER_SUPPORTS_RENDERING
+  std::shared_ptr<impeller::Capabilities> capabilities =
+      impeller::CapabilitiesBuilder()
+          .SetSupportsTextureToTextureBlits(true)
+          .Build();
+  std::shared_ptr<impeller::Allocator> allocator =
+      std::make_shared<impeller::TestImpellerAllocator>();
+  absl::StatusOr<ImageDecoderImpeller::DecompressResult> result =
+      ImageDecoderImpeller::DecompressTexture(
+          descriptor.get(),
+          {.target_width = 10,
+           .target_height = 20,
+           .target_subset = SkIRect::MakeXYWH(50, 0, 50, 100)},
+          {1000, 1000},
+          /*supports_wide_gamut=*/false, capabilities, allocator);
+  ASSERT_TRUE(result.ok());
+  // The subset is decoded straight to the target size, so nothing is left to
+  // resize on the GPU.
+  EXPECT_EQ(result->image_info.size.width, 10);
+  EXPECT_EQ(result->image_info.size.height, 20);
+  EXPECT_FALSE(result->resize_info.has_value());
+  ASSERT_EQ(result->image_info.format,
+            impeller::PixelFormat::kR8G8B8A8UNormInt);
+  const uint32_t* pixel_ptr =
+      reinterpret_cast<const uint32_t*>(result->device_buffer->OnGetContents());
+  EXPECT_EQ(*pixel_ptr, (uint32_t)0xFFFF0000);
+
+  auto invalid_result = ImageDecoderImpeller::DecompressTexture(
+      descriptor.get(),
+      {.target_width = 10,
+       .target_height = 20,
+       .target_subset = SkIRect::MakeXYWH(50, 50, 50, 100)},
+      {1000, 1000},
+      /*supports_wide_gamut=*/false, capabilities, allocator);
+  EXPECT_FALSE(invalid_result.ok());
+#endif  // IMPELLER_SUPPORTS_RENDERING
+}
+
 TEST_F(ImageDecoderFixtureTest,
        MultiFrameCodecCanBeCollectedBeforeIOTasksFinish) {
   // This test verifies that the MultiFrameCodec safely shares state between
@@ -1052,6 +1133,74 @@ TEST_F(ImageDecoderFixtureTest,
   PostTaskSync(runners.GetIOTaskRunner(), [&]() { io_manager.reset(); });
 }
 
+TEST_F(ImageDecoderFixtureTest, MultiFrameCodecCachesFramesOfShortLoops) {
+  auto settings = CreateSettingsForFixture();
+  auto vm_ref = DartVMRef::Create(settings);
+
+  auto gif_mapping = flutter::testing::OpenFixtureAsSkData("hello_loop_2.gif");
+  ASSERT_TRUE(gif_mapping);
+
+  ImageGeneratorRegistry registry;
+  std::shared_ptr<ImageGenerator> gif_generator =
+      registry.CreateCompatibleGenerator(gif_mapping);
+  ASSERT_TRUE(gif_generator);
+  const int frame_count = gif_generator->GetFrameCount();
+  ASSERT_GT(frame_count, 1);
+
+  fml::AutoResetWaitableEvent frame_latch;
+  AddNativeCallback("ValidateFrameCallback",
+                    CREATE_NATIVE_ENTRY([&](Dart_NativeArguments args) {
+                      frame_latch.Signal();
+                    }));
+
+  TaskRunners runners(GetCurrentTestName(),         // label
+                      CreateNewThread("platform"),  // platform
+                      CreateNewThread("raster"),    // raster
+                      CreateNewThread("ui"),        // ui
+                      CreateNewThread("io")         // io
+  );
+
+  std::unique_ptr<TestIOManager> io_manager;
+  PostTaskSync(runners.GetIOTaskRunner(), [&]() {
+    io_manager = std::make_unique<TestIOManager>(runners.GetIOTaskRunner());
+  });
+
+  auto isolate = RunDartCodeInIsolate(vm_ref, settings, runners, "main", {},
+                                      GetDefaultKernelFilePath(),
+                                      io_manager->GetWeakIOManager());
+
+  fml::RefPtr<MultiFrameCodec> codec;
+  PostTaskSync(runners.GetUITaskRunner(), [&]() {
+    codec = fml::MakeRefCounted<MultiFrameCodec>(std::move(gif_generator));
+  });
+
+  // The first loop is decoded and the second one is served from the cache.
+  for (int i = 0; i < frame_count * 2; i++) {
+    PostTaskSync(runners.GetUITaskRunner(), [&]() {
+      EXPECT_TRUE(isolate->RunInIsolateScope([&]() -> bool {
+        Dart_Handle closure = Dart_GetField(
+            Dart_RootLibrary(), Dart_NewStringFromCString("frameCallback"));
+        if (Dart_IsError(closure) || !Dart_IsClosure(closure)) {
+          return false;
+        }
+        codec->getNextFrame(closure);
+        return true;
+      }));
+    });
+    frame_latch.Wait();
+  }
+
+  MultiFrameCodec::DecodeStats stats = codec->GetDecodeStats();
+  EXPECT_EQ(stats.decode_ahead_hits + stats.decode_misses,
+            static_cast<size_t>(frame_count));
+  EXPECT_EQ(stats.cache_hits, static_cast<size_t>(frame_count));
+  EXPECT_GT(stats.cache_bytes, 0u);
+  EXPECT_EQ(stats.decode_ahead_bytes, 0u);
+
+  PostTaskSync(runners.GetUITaskRunner(), [&]() { codec = nullptr; });
+  PostTaskSync(runners.GetIOTaskRunner(), [&]() { io_manager.reset(); });
+}
+
 TEST_F(ImageDecoderFixtureTest, NullCheckBuffer) {
   auto context = std::make_shared<impeller::TestImpellerContext>();
   auto allocator = ImpellerAllocator(context->GetResourceAllocator());
@@ -218,6 +218,13 @@ bool ImageDescriptor::get_pixels(const SkPixmap& pixmap) const {
                                pixmap.rowBytes());
 }
 
+bool ImageDescriptor::get_subset_pixels(const SkPixmap& pixmap,
+                                        const SkIRect& subset) const {
+  FML_DCHECK(generator_);
+  return generator_->GetSubsetPixels(pixmap.info(), pixmap.writable_addr(),
+                                     pixmap.rowBytes(), subset);
+}
+
 int ImageDescriptor::bytesPerPixel() const {
   switch (image_info_.format) {
     case kUnknown:
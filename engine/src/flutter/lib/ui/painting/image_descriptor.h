@@ -18,6 +18,7 @@
 #include "third_party/skia/include/core/SkImage.h"
 #include "third_party/skia/include/core/SkImageInfo.h"
 #include "third_party/skia/include/core/SkPixmap.h"
+#include "third_party/skia/include/core/SkRect.h"
 #include "third_party/skia/include/core/SkSize.h"
 #include "third_party/tonic/dart_library_natives.h"
 
@@ -126,6 +127,10 @@ class ImageDescriptor : public RefCountedDartWrappable<ImageDescriptor> {
   ///         orientation tag, if applicable.
   bool get_pixels(const SkPixmap& pixmap) const;
 
+  /// @brief  Gets the pixels of `subset`, in the coordinates of the
+  ///         EXIF-oriented image, scaled to the dimensions of `pixmap`.
+  bool get_subset_pixels(const SkPixmap& pixmap, const SkIRect& subset) const;
+
   void dispose() {
     buffer_.reset();
     generator_.reset();
@@ -4,6 +4,7 @@
 
 #include "flutter/lib/ui/painting/image_generator.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "flutter/fml/logging.h"
@@ -11,6 +12,7 @@
 #include "third_party/skia/include/codec/SkPixmapUtils.h"
 #include "third_party/skia/include/core/SkBitmap.h"
 #include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkSamplingOptions.h"
 
 namespace flutter {
 
@@ -35,6 +37,51 @@ sk_sp<SkImage> ImageGenerator::GetImage() {
   return SkImages::RasterFromBitmap(bitmap);
 }
 
+bool ImageGenerator::GetSubsetPixels(const SkImageInfo& info,
+                                     void* pixels,
+                                     size_t row_bytes,
+                                     const SkIRect& subset) {
+  const SkImageInfo& full_info = GetInfo();
+  if (subset.isEmpty() || !full_info.bounds().contains(subset)) {
+    return false;
+  }
+
+  // Decode the whole image at the smallest size the decoder supports that
+  // still covers the requested resolution of the subset.
+  const SkISize decode_size = GetScaledDimensions(
+      std::max(static_cast<float>(info.width()) / subset.width(),
+               static_cast<float>(info.height()) / subset.height()));
+  SkBitmap bitmap;
+  if (!bitmap.tryAllocPixels(info.makeDimensions(decode_size))) {
+    FML_DLOG(ERROR) << "Failed to allocate memory for bitmap of size "
+                    << info.makeDimensions(decode_size).computeMinByteSize()
+                    << "B";
+    return false;
+  }
+  const auto& pixmap = bitmap.pixmap();
+  if (!GetPixels(pixmap.info(), pixmap.writable_addr(), pixmap.rowBytes())) {
+    FML_DLOG(ERROR) << "Failed to get pixels for image subset.";
+    return false;
+  }
+
+  const float scale_x =
+      static_cast<float>(decode_size.width()) / full_info.width();
+  const float scale_y =
+      static_cast<float>(decode_size.height()) / full_info.height();
+  SkIRect decoded_subset =
+      SkRect::MakeLTRB(subset.left() * scale_x, subset.top() * scale_y,
+                       subset.right() * scale_x, subset.bottom() * scale_y)
+          .roundOut();
+  SkPixmap decoded_region;
+  if (!decoded_subset.intersect(pixmap.bounds()) ||
+      !pixmap.extractSubset(&decoded_region, decoded_subset)) {
+    return false;
+  }
+  return decoded_region.scalePixels(
+      SkPixmap(info, pixels, row_bytes),
+      SkSamplingOptions(SkFilterMode::kLinear, SkMipmapMode::kNone));
+}
+
 BuiltinSkiaImageGenerator::~BuiltinSkiaImageGenerator() = default;
 
 BuiltinSkiaImageGenerator::BuiltinSkiaImageGenerator(
@@ -188,6 +235,30 @@ bool BuiltinSkiaCodecImageGenerator::GetPixels(
   return SkPixmapUtils::Orient(output_pixmap, temp_pixmap, origin);
 }
 
+bool BuiltinSkiaCodecImageGenerator::GetSubsetPixels(const SkImageInfo& info,
+                                                     void* pixels,
+                                                     size_t row_bytes,
+                                                     const SkIRect& subset) {
+  // Codecs that support subsets (currently only WebP) decode the region
+  // directly at the requested scale. The subset is in the coordinates of the
+  // oriented image, so only images that need no re-orientation qualify.
+  SkIRect codec_subset = subset;
+  if (codec_->getOrigin() == kTopLeft_SkEncodedOrigin &&
+      image_info_.bounds().contains(subset) &&
+      codec_->getValidSubset(&codec_subset) && codec_subset == subset) {
+    SkCodec::Options options;
+    options.fSubset = &codec_subset;
+    SkCodec::Result result =
+        codec_->getPixels(info, pixels, row_bytes, &options);
+    if (result == SkCodec::kSuccess) {
+      return true;
+    }
+    FML_DLOG(WARNING) << "codec could not get subset pixels. "
+                      << SkCodec::ResultToString(result);
+  }
+  return ImageGenerator::GetSubsetPixels(info, pixels, row_bytes, subset);
+}
+
 std::unique_ptr<ImageGenerator> BuiltinSkiaCodecImageGenerator::MakeFromData(
     sk_sp<SkData> data) {
   auto codec = SkCodec::MakeFromData(std::move(data));
@@ -13,6 +13,7 @@
 #include "third_party/skia/include/core/SkImage.h"
 #include "third_party/skia/include/core/SkImageGenerator.h"
 #include "third_party/skia/include/core/SkImageInfo.h"
+#include "third_party/skia/include/core/SkRect.h"
 #include "third_party/skia/include/core/SkSize.h"
 
 namespace flutter {
@@ -135,6 +136,29 @@ class ImageGenerator {
       unsigned int frame_index = 0,
       std::optional<unsigned int> prior_frame = std::nullopt) = 0;
 
+  /// @brief      Decode a region of the first frame of the image into a given
+  ///             buffer, scaled to the dimensions of `info`.
+  /// @param[in]  info       The desired size and color info of the decoded
+  ///                        region.
+  /// @param[in]  pixels     The location where the raw decoded image data
+  ///                        should be written.
+  /// @param[in]  row_bytes  The total number of bytes that should make up a
+  ///                        single row of decoded image data.
+  /// @param[in]  subset     The region of the image to decode, in the
+  ///                        coordinates of `GetInfo`. Must be non-empty and
+  ///                        contained in the bounds of the image.
+  /// @return     True if the region was successfully decoded.
+  /// @note       The default implementation decodes the whole image at the
+  ///             closest size returned by `GetScaledDimensions` and then
+  ///             scales the region into the output buffer. Implementations
+  ///             that can decode a region directly should override this to
+  ///             avoid allocating the rest of the image.
+  /// @see        `GetPixels`
+  virtual bool GetSubsetPixels(const SkImageInfo& info,
+                               void* pixels,
+                               size_t row_bytes,
+                               const SkIRect& subset);
+
   /// @brief   Creates an `SkImage` based on the current `ImageInfo` of this
   ///          `ImageGenerator`.
   /// @return  A new `SkImage` containing the decoded image data.
@@ -212,6 +236,12 @@ class BuiltinSkiaCodecImageGenerator : public ImageGenerator {
       unsigned int frame_index = 0,
       std::optional<unsigned int> prior_frame = std::nullopt) override;
 
+  // |ImageGenerator|
+  bool GetSubsetPixels(const SkImageInfo& info,
+                       void* pixels,
+                       size_t row_bytes,
+                       const SkIRect& subset) override;
+
   static std::unique_ptr<ImageGenerator> MakeFromData(sk_sp<SkData> data);
 
  private:
@@ -101,16 +101,9 @@ Dart_Handle ImmutableBuffer::initFromAsset(Dart_Handle raw_buffer_handle,
       [asset_name = std::move(asset_name),
        asset_manager = std::move(asset_manager),
        ui_task_runner = std::move(ui_task_runner), ui_task] {
-        std::unique_ptr<fml::Mapping> mapping =
-            asset_manager->GetAsMapping(asset_name);
-
-        sk_sp<SkData> sk_data;
-        size_t buffer_size = 0;
-        if (mapping != nullptr) {
-          buffer_size = mapping->GetSize();
-          const void* bytes = static_cast<const void*>(mapping->GetMapping());
-          sk_data = MakeSkDataWithCopy(bytes, buffer_size);
-        }
+        sk_sp<SkData> sk_data =
+            MakeSkDataFromMapping(asset_manager->GetAsMapping(asset_name));
+        size_t buffer_size = sk_data ? sk_data->size() : 0;
         ui_task_runner->PostTask(
             [sk_data = std::move(sk_data), ui_task = ui_task, buffer_size]() {
               ui_task(sk_data, buffer_size);
@@ -175,12 +168,10 @@ Dart_Handle ImmutableBuffer::initFromFile(Dart_Handle raw_buffer_handle,
             file_path.c_str(), false, fml::FilePermission::kRead));
 
         sk_sp<SkData> sk_data;
-        size_t buffer_size = 0;
         if (mapping->IsValid()) {
-          buffer_size = mapping->GetSize();
-          const void* bytes = static_cast<const void*>(mapping->GetMapping());
-          sk_data = MakeSkDataWithCopy(bytes, buffer_size);
+          sk_data = MakeSkDataFromMapping(std::move(mapping));
         }
+        size_t buffer_size = sk_data ? sk_data->size() : 0;
         ui_task_runner->PostTask(
             [sk_data = std::move(sk_data), ui_task = ui_task, buffer_size]() {
               ui_task(sk_data, buffer_size);
@@ -189,6 +180,27 @@ Dart_Handle ImmutableBuffer::initFromFile(Dart_Handle raw_buffer_handle,
   return Dart_Null();
 }
 
+sk_sp<SkData> ImmutableBuffer::MakeSkDataFromMapping(
+    std::unique_ptr<fml::Mapping> mapping) {
+  if (mapping == nullptr) {
+    return nullptr;
+  }
+  if (mapping->GetSize() == 0) {
+    return SkData::MakeEmpty();
+  }
+  if (!mapping->IsDontNeedSafe()) {
+    return MakeSkDataWithCopy(mapping->GetMapping(), mapping->GetSize());
+  }
+
+  fml::Mapping* mapping_ptr = mapping.release();
+  return SkData::MakeWithProc(
+      mapping_ptr->GetMapping(), mapping_ptr->GetSize(),
+      [](const void* ptr, void* context) {
+        delete reinterpret_cast<fml::Mapping*>(context);
+      },
+      mapping_ptr);
+}
+
 #if FML_OS_ANDROID
 
 // Compressed image buffers are allocated on the UI thread but are deleted on a
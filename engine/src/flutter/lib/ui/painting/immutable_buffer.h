@@ -6,8 +6,10 @@
 #define FLUTTER_LIB_UI_PAINTING_IMMUTABLE_BUFFER_H_
 
 #include <cstdint>
+#include <memory>
 
 #include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
 #include "flutter/lib/ui/dart_wrapper.h"
 #include "third_party/skia/include/core/SkData.h"
 #include "third_party/tonic/dart_library_natives.h"
@@ -79,6 +81,19 @@ class ImmutableBuffer : public RefCountedDartWrappable<ImmutableBuffer> {
   /// Callers should not modify the returned data. This is not exposed to Dart.
   sk_sp<SkData> data() const { return data_; }
 
+  /// Creates an SkData with the contents of |mapping|, or nullptr if
+  /// |mapping| is nullptr.
+  ///
+  /// Mappings that are backed by read-only file pages, as reported by
+  /// |fml::Mapping::IsDontNeedSafe|, are wrapped without a copy and the
+  /// returned SkData takes ownership of them. These pages can be dropped and
+  /// read back from the file by the OS at any time, so wrapping them does not
+  /// increase the memory pressure. All other mappings are copied, because
+  /// their memory might be owned by someone else or be allocated on a heap
+  /// that should not be freed from the decoder threads.
+  static sk_sp<SkData> MakeSkDataFromMapping(
+      std::unique_ptr<fml::Mapping> mapping);
+
   /// Clears the Dart native fields and removes the reference to the underlying
   /// byte buffer.
   ///
@@ -0,0 +1,52 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/immutable_buffer.h"
+
+#include <cstring>
+#include <vector>
+
+#include "flutter/testing/testing.h"
+
+namespace flutter {
+namespace testing {
+
+TEST(ImmutableBufferTest, MakeSkDataFromNullMapping) {
+  EXPECT_EQ(ImmutableBuffer::MakeSkDataFromMapping(nullptr), nullptr);
+}
+
+TEST(ImmutableBufferTest, MakeSkDataFromEmptyMapping) {
+  auto data = ImmutableBuffer::MakeSkDataFromMapping(
+      std::make_unique<fml::DataMapping>(std::vector<uint8_t>{}));
+  ASSERT_NE(data, nullptr);
+  EXPECT_EQ(data->size(), 0u);
+}
+
+TEST(ImmutableBufferTest, MakeSkDataFromFileMappingDoesNotCopy) {
+  auto mapping = OpenFixtureAsMapping("DashInNooglerHat.jpg");
+  ASSERT_NE(mapping, nullptr);
+  ASSERT_TRUE(mapping->IsDontNeedSafe());
+  const uint8_t* bytes = mapping->GetMapping();
+  const size_t size = mapping->GetSize();
+
+  auto data = ImmutableBuffer::MakeSkDataFromMapping(std::move(mapping));
+  ASSERT_NE(data, nullptr);
+  EXPECT_EQ(data->bytes(), bytes);
+  EXPECT_EQ(data->size(), size);
+}
+
+TEST(ImmutableBufferTest, MakeSkDataFromHeapMappingCopies) {
+  std::vector<uint8_t> contents = {1, 2, 3, 4};
+  auto mapping = std::make_unique<fml::DataMapping>(contents);
+  const uint8_t* bytes = mapping->GetMapping();
+
+  auto data = ImmutableBuffer::MakeSkDataFromMapping(std::move(mapping));
+  ASSERT_NE(data, nullptr);
+  EXPECT_NE(data->bytes(), bytes);
+  ASSERT_EQ(data->size(), contents.size());
+  EXPECT_EQ(::memcmp(data->data(), contents.data(), contents.size()), 0);
+}
+
+}  // namespace testing
+}  // namespace flutter
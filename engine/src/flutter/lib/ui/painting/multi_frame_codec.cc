@@ -8,6 +8,7 @@
 
 #include "display_list/image/dl_image.h"
 #include "flutter/fml/make_copyable.h"
+#include "flutter/fml/trace_event.h"
 #include "flutter/lib/ui/painting/display_list_image_gpu.h"
 #include "flutter/lib/ui/painting/image.h"
 #if IMPELLER_SUPPORTS_RENDERING
@@ -24,18 +25,32 @@
 namespace flutter {
 
 MultiFrameCodec::MultiFrameCodec(std::shared_ptr<ImageGenerator> generator)
-    : state_(new State(std::move(generator))) {}
+    : MultiFrameCodec(std::move(generator), Options{}) {}
+
+MultiFrameCodec::MultiFrameCodec(std::shared_ptr<ImageGenerator> generator,
+                                 const Options& options)
+    : state_(new State(std::move(generator), options)) {}
 
 MultiFrameCodec::~MultiFrameCodec() = default;
 
-MultiFrameCodec::State::State(std::shared_ptr<ImageGenerator> generator)
+MultiFrameCodec::State::State(std::shared_ptr<ImageGenerator> generator,
+                              const Options& options)
     : generator_(std::move(generator)),
       frameCount_(generator_->GetFrameCount()),
       repetitionCount_(generator_->GetPlayCount() ==
                                ImageGenerator::kInfinitePlayCount
                            ? -1
                            : generator_->GetPlayCount() - 1),
-      is_impeller_enabled_(UIDartState::Current()->IsImpellerEnabled()) {}
+      options_(options),
+      is_impeller_enabled_(UIDartState::Current()->IsImpellerEnabled()) {
+  // Frames are decoded to N32, see DecodeNextFrameLocked.
+  const SkImageInfo frame_info =
+      generator_->GetInfo().makeColorType(kN32_SkColorType);
+  const size_t animation_bytes = frame_info.computeMinByteSize() * frameCount_;
+  if (frameCount_ > 1 && animation_bytes <= options_.frame_cache_bytes) {
+    frameCache_.resize(frameCount_);
+  }
+}
 
 static void InvokeNextFrameCallback(
     const fml::RefPtr<CanvasImage>& image,
@@ -55,12 +70,11 @@ static void InvokeNextFrameCallback(
                      tonic::ToDart(decode_error)});
 }
 
-std::pair<sk_sp<DlImage>, std::string>
-MultiFrameCodec::State::GetNextFrameImage(
-    const fml::WeakPtr<GrDirectContext>& resourceContext,
-    const std::shared_ptr<const fml::SyncSwitch>& gpu_disable_sync_switch,
-    const std::shared_ptr<impeller::Context>& impeller_context,
-    const fml::RefPtr<flutter::SkiaUnrefQueue>& unref_queue) {
+MultiFrameCodec::DecodedFrame MultiFrameCodec::State::DecodeNextFrameLocked() {
+  TRACE_EVENT0("flutter", "MultiFrameCodec::DecodeFrame");
+  DecodedFrame frame = {.index = decodeFrameIndex_};
+  decodeFrameIndex_ = (decodeFrameIndex_ + 1) % frameCount_;
+
   SkBitmap bitmap = SkBitmap();
   SkImageInfo info = generator_->GetInfo().makeColorType(kN32_SkColorType);
   if (info.alphaType() == kUnpremul_SkAlphaType) {
@@ -71,13 +85,12 @@ MultiFrameCodec::State::GetNextFrameImage(
     std::ostringstream ostr;
     ostr << "Failed to allocate memory for bitmap of size "
          << info.computeMinByteSize() << "B";
-    std::string decode_error = ostr.str();
-    FML_LOG(ERROR) << decode_error;
-    return std::make_pair(nullptr, decode_error);
+    frame.decode_error = ostr.str();
+    FML_LOG(ERROR) << frame.decode_error;
+    return frame;
   }
 
-  ImageGenerator::FrameInfo frameInfo =
-      generator_->GetFrameInfo(nextFrameIndex_);
+  ImageGenerator::FrameInfo frameInfo = generator_->GetFrameInfo(frame.index);
 
   const int requiredFrameIndex =
       frameInfo.required_frame.value_or(SkCodec::kNoFrame);
@@ -88,7 +101,7 @@ MultiFrameCodec::State::GetNextFrameImage(
     // |requiredFrameIndex| is set to ex-frame or ex-ex-frame.
     if (!lastRequiredFrame_.has_value()) {
       FML_DLOG(INFO)
-          << "Frame " << nextFrameIndex_ << " depends on frame "
+          << "Frame " << frame.index << " depends on frame "
           << requiredFrameIndex
           << " and no required frames are cached. Using blank slate instead.";
     } else {
@@ -104,13 +117,16 @@ MultiFrameCodec::State::GetNextFrameImage(
   // Write the new frame to the output buffer. The bitmap pixels as supplied
   // are already set in accordance with the previous frame's disposal policy.
   if (!generator_->GetPixels(info, bitmap.getPixels(), bitmap.rowBytes(),
-                             nextFrameIndex_, requiredFrameIndex)) {
+                             frame.index, requiredFrameIndex)) {
     std::ostringstream ostr;
-    ostr << "Could not getPixels for frame " << nextFrameIndex_;
-    std::string decode_error = ostr.str();
-    FML_LOG(ERROR) << decode_error;
-    return std::make_pair(nullptr, decode_error);
+    ostr << "Could not getPixels for frame " << frame.index;
+    frame.decode_error = ostr.str();
+    FML_LOG(ERROR) << frame.decode_error;
+    return frame;
   }
+  // Later frames are decoded into new bitmaps, so this one can be shared
+  // with the frame cache and the next frame's backdrop.
+  bitmap.setImmutable();
 
   const bool keep_current_frame =
       frameInfo.disposal_method == SkCodecAnimation::DisposalMethod::kKeep;
@@ -134,7 +150,7 @@ MultiFrameCodec::State::GetNextFrameImage(
     // Replace the stored frame. The `lastRequiredFrame_` will get used as the
     // starting backdrop for the next frame.
     lastRequiredFrame_ = bitmap;
-    lastRequiredFrameIndex_ = nextFrameIndex_;
+    lastRequiredFrameIndex_ = frame.index;
   }
 
   if (frameInfo.disposal_method ==
@@ -144,6 +160,103 @@ MultiFrameCodec::State::GetNextFrameImage(
     restoreBGColorRect_.reset();
   }
 
+  frame.bitmap = std::move(bitmap);
+  frame.duration = frameInfo.duration;
+
+  if (!frameCache_.empty() && frameCache_[frame.index].bitmap.isNull()) {
+    frameCache_[frame.index] = frame;
+    cachedFrameCount_++;
+    stats_.cache_bytes += frame.bitmap.computeByteSize();
+  }
+  return frame;
+}
+
+MultiFrameCodec::DecodedFrame MultiFrameCodec::State::TakeFrame(int index) {
+  std::scoped_lock lock(decode_mutex_);
+  DecodedFrame frame;
+  if (!decodedFrames_.empty()) {
+    FML_DCHECK(decodedFrames_.front().index == index);
+    frame = std::move(decodedFrames_.front());
+    decodedFrames_.pop_front();
+    stats_.decode_ahead_hits++;
+    stats_.decode_ahead_bytes -= frame.bitmap.computeByteSize();
+  } else if (cachedFrameCount_ == frameCount_) {
+    frame = frameCache_[index];
+    stats_.cache_hits++;
+  } else {
+    FML_DCHECK(decodeFrameIndex_ == index);
+    frame = DecodeNextFrameLocked();
+    stats_.decode_misses++;
+  }
+  TraceDecodeStatsLocked();
+  return frame;
+}
+
+void MultiFrameCodec::State::ScheduleDecodeAhead(
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& concurrent_runner) {
+  if (!concurrent_runner || options_.decode_ahead_frames <= 0) {
+    return;
+  }
+  {
+    std::scoped_lock lock(decode_mutex_);
+    if (decodeAheadScheduled_ || cachedFrameCount_ == frameCount_ ||
+        decodedFrames_.size() >=
+            static_cast<size_t>(options_.decode_ahead_frames)) {
+      return;
+    }
+    decodeAheadScheduled_ = true;
+  }
+  concurrent_runner->PostTask(
+      [weak_state = std::weak_ptr<State>(shared_from_this())]() {
+        if (auto state = weak_state.lock()) {
+          state->DecodeAhead();
+        }
+      });
+}
+
+void MultiFrameCodec::State::DecodeAhead() {
+  TRACE_EVENT0("flutter", "MultiFrameCodec::DecodeAhead");
+  while (true) {
+    // The lock is released between frames so that a frame requested in the
+    // meantime only waits for the frame being decoded.
+    std::scoped_lock lock(decode_mutex_);
+    if (cachedFrameCount_ == frameCount_ ||
+        decodedFrames_.size() >=
+            static_cast<size_t>(options_.decode_ahead_frames)) {
+      decodeAheadScheduled_ = false;
+      TraceDecodeStatsLocked();
+      return;
+    }
+    DecodedFrame frame = DecodeNextFrameLocked();
+    const bool failed = frame.bitmap.isNull();
+    stats_.decode_ahead_bytes += frame.bitmap.computeByteSize();
+    decodedFrames_.push_back(std::move(frame));
+    if (failed) {
+      decodeAheadScheduled_ = false;
+      TraceDecodeStatsLocked();
+      return;
+    }
+  }
+}
+
+void MultiFrameCodec::State::TraceDecodeStatsLocked() const {
+  FML_TRACE_COUNTER("flutter", "MultiFrameCodec",
+                    reinterpret_cast<int64_t>(this),  // Trace Counter ID
+                    "DecodeAheadHits", stats_.decode_ahead_hits,
+                    "DecodeMisses", stats_.decode_misses,
+                    "CacheHits", stats_.cache_hits,
+                    "DecodeAheadBytes", stats_.decode_ahead_bytes,
+                    "CacheBytes", stats_.cache_bytes);
+}
+
+std::pair<sk_sp<DlImage>, std::string> MultiFrameCodec::State::UploadFrame(
+    SkBitmap bitmap,
+    const fml::WeakPtr<GrDirectContext>& resourceContext,
+    const std::shared_ptr<const fml::SyncSwitch>& gpu_disable_sync_switch,
+    const std::shared_ptr<impeller::Context>& impeller_context,
+    const fml::RefPtr<flutter::SkiaUnrefQueue>& unref_queue) {
+  const SkImageInfo info = bitmap.info();
+
 #if IMPELLER_SUPPORTS_RENDERING
   if (is_impeller_enabled_) {
 #ifdef FML_OS_IOS
@@ -225,6 +338,7 @@ MultiFrameCodec::State::GetNextFrameImage(
 void MultiFrameCodec::State::GetNextFrameAndInvokeCallback(
     std::unique_ptr<tonic::DartPersistentValue> callback,
     const fml::RefPtr<fml::TaskRunner>& ui_task_runner,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& concurrent_runner,
     const fml::WeakPtr<GrDirectContext>& resourceContext,
     const fml::RefPtr<flutter::SkiaUnrefQueue>& unref_queue,
     const std::shared_ptr<const fml::SyncSwitch>& gpu_disable_sync_switch,
@@ -243,18 +357,23 @@ void MultiFrameCodec::State::GetNextFrameAndInvokeCallback(
 
   fml::RefPtr<CanvasImage> image = nullptr;
   int duration = 0;
+  DecodedFrame frame = TakeFrame(nextFrameIndex_);
+  nextFrameIndex_ = (nextFrameIndex_ + 1) % frameCount_;
+  // Start on the following frames while this one is uploaded and shown.
+  ScheduleDecodeAhead(concurrent_runner);
+
   sk_sp<DlImage> dlImage;
-  std::string decode_error;
-  std::tie(dlImage, decode_error) = GetNextFrameImage(
-      resourceContext, gpu_disable_sync_switch, impeller_context, unref_queue);
+  std::string decode_error = std::move(frame.decode_error);
+  if (!frame.bitmap.isNull()) {
+    std::tie(dlImage, decode_error) =
+        UploadFrame(std::move(frame.bitmap), resourceContext,
+                    gpu_disable_sync_switch, impeller_context, unref_queue);
+  }
   if (dlImage) {
     image = CanvasImage::Create();
     image->set_image(dlImage);
-    ImageGenerator::FrameInfo frameInfo =
-        generator_->GetFrameInfo(nextFrameIndex_);
-    duration = frameInfo.duration;
+    duration = frame.duration;
   }
-  nextFrameIndex_ = (nextFrameIndex_ + 1) % frameCount_;
 
   // The static leak checker gets confused by the use of fml::MakeCopyable.
   // NOLINTNEXTLINE(clang-analyzer-cplusplus.NewDeleteLeaks)
@@ -296,6 +415,7 @@ Dart_Handle MultiFrameCodec::getNextFrame(Dart_Handle callback_handle) {
            tonic::DartState::Current(), callback_handle),
        weak_state = std::weak_ptr<MultiFrameCodec::State>(state_), trace_id,
        ui_task_runner = task_runners.GetUITaskRunner(),
+       concurrent_runner = dart_state->GetConcurrentTaskRunner(),
        io_manager = dart_state->GetIOManager()]() mutable {
         auto state = weak_state.lock();
         if (!state) {
@@ -304,7 +424,7 @@ Dart_Handle MultiFrameCodec::getNextFrame(Dart_Handle callback_handle) {
           return;
         }
         state->GetNextFrameAndInvokeCallback(
-            std::move(callback), ui_task_runner,
+            std::move(callback), ui_task_runner, concurrent_runner,
             io_manager->GetResourceContext(), io_manager->GetSkiaUnrefQueue(),
             io_manager->GetIsGpuDisabledSyncSwitch(), trace_id,
             io_manager->GetImpellerContext());
@@ -324,4 +444,9 @@ int MultiFrameCodec::repetitionCount() const {
   return state_->repetitionCount_;
 }
 
+MultiFrameCodec::DecodeStats MultiFrameCodec::GetDecodeStats() const {
+  std::scoped_lock lock(state_->decode_mutex_);
+  return state_->stats_;
+}
+
 }  // namespace flutter
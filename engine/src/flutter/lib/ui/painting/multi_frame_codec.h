@@ -9,14 +9,44 @@
 #include "flutter/lib/ui/painting/codec.h"
 #include "flutter/lib/ui/painting/image_generator.h"
 
+#include <deque>
+#include <memory>
+#include <mutex>
 #include <utility>
+#include <vector>
 
 namespace flutter {
 
 class MultiFrameCodec : public Codec {
  public:
+  struct Options {
+    /// The number of frames to decode on worker threads ahead of the frame
+    /// that is being presented. Zero decodes each frame on demand.
+    int decode_ahead_frames = 1;
+    /// The largest size of all the decoded frames of an animation for which
+    /// they are kept after the first loop, so that later loops need no
+    /// decoding. Zero disables the cache.
+    size_t frame_cache_bytes = 4 << 20;
+  };
+
+  struct DecodeStats {
+    /// Frames that were decoded ahead of being requested.
+    size_t decode_ahead_hits = 0;
+    /// Frames that were decoded when they were requested.
+    size_t decode_misses = 0;
+    /// Frames served from the frame cache.
+    size_t cache_hits = 0;
+    /// Bytes held by frames that were decoded ahead but not yet requested.
+    size_t decode_ahead_bytes = 0;
+    /// Bytes held by the frame cache.
+    size_t cache_bytes = 0;
+  };
+
   explicit MultiFrameCodec(std::shared_ptr<ImageGenerator> generator);
 
+  MultiFrameCodec(std::shared_ptr<ImageGenerator> generator,
+                  const Options& options);
+
   ~MultiFrameCodec() override;
 
   // |Codec|
@@ -28,28 +58,45 @@ class MultiFrameCodec : public Codec {
   // |Codec|
   Dart_Handle getNextFrame(Dart_Handle args) override;
 
+  DecodeStats GetDecodeStats() const;
+
  private:
+  struct DecodedFrame {
+    int index = 0;
+    // Empty if the frame failed to decode.
+    SkBitmap bitmap;
+    int duration = 0;
+    std::string decode_error;
+  };
+
   // Captures the state shared between the IO and UI task runners.
   //
   // The state is initialized on the UI task runner when the Dart object is
-  // created. Decoding occurs on the IO task runner. Since it is possible for
-  // the UI object to be collected independently of the IO task runner work,
-  // it is not safe for this state to live directly on the MultiFrameCodec.
-  // Instead, the MultiFrameCodec creates this object when it is constructed,
-  // shares it with the IO task runner's decoding work, and sets the live_
-  // member to false when it is destructed.
-  struct State {
-    explicit State(std::shared_ptr<ImageGenerator> generator);
+  // created. Decoding occurs on the IO task runner and on worker threads
+  // when frames are decoded ahead. Since it is possible for the UI object to
+  // be collected independently of the IO task runner work, it is not safe for
+  // this state to live directly on the MultiFrameCodec. Instead, the
+  // MultiFrameCodec creates this object when it is constructed, shares it
+  // with the decoding work, and sets the live_ member to false when it is
+  // destructed.
+  struct State : public std::enable_shared_from_this<State> {
+    State(std::shared_ptr<ImageGenerator> generator, const Options& options);
 
     const std::shared_ptr<ImageGenerator> generator_;
     const int frameCount_;
     const int repetitionCount_;
+    const Options options_;
     bool is_impeller_enabled_ = false;
 
-    // The non-const members and functions below here are only read or written
-    // to on the IO thread. They are not safe to access or write on the UI
-    // thread.
+    // Only read or written to on the IO thread.
     int nextFrameIndex_ = 0;
+
+    // Guards the generator and all of the members below, which are accessed
+    // from the IO thread and from the worker threads decoding ahead.
+    mutable std::mutex decode_mutex_;
+    // The index of the next frame to be decoded. Frames are always decoded
+    // in order, since they may depend on the frames before them.
+    int decodeFrameIndex_ = 0;
     // The last decoded frame that's required to decode any subsequent frames.
     std::optional<SkBitmap> lastRequiredFrame_;
     // The index of the last decoded required frame.
@@ -59,7 +106,30 @@ class MultiFrameCodec : public Codec {
     // method was kRestoreBGColor.
     std::optional<SkIRect> restoreBGColorRect_;
 
-    std::pair<sk_sp<DlImage>, std::string> GetNextFrameImage(
+    // Frames decoded ahead of nextFrameIndex_, in order.
+    std::deque<DecodedFrame> decodedFrames_;
+    bool decodeAheadScheduled_ = false;
+
+    // Every frame of the animation once the first loop has been decoded, if
+    // the animation fits Options::frame_cache_bytes. Empty otherwise.
+    std::vector<DecodedFrame> frameCache_;
+    int cachedFrameCount_ = 0;
+
+    DecodeStats stats_;
+
+    DecodedFrame DecodeNextFrameLocked();
+
+    DecodedFrame TakeFrame(int index);
+
+    void ScheduleDecodeAhead(
+        const std::shared_ptr<fml::ConcurrentTaskRunner>& concurrent_runner);
+
+    void DecodeAhead();
+
+    void TraceDecodeStatsLocked() const;
+
+    std::pair<sk_sp<DlImage>, std::string> UploadFrame(
+        SkBitmap bitmap,
         const fml::WeakPtr<GrDirectContext>& resourceContext,
         const std::shared_ptr<const fml::SyncSwitch>& gpu_disable_sync_switch,
         const std::shared_ptr<impeller::Context>& impeller_context,
@@ -68,6 +138,7 @@ class MultiFrameCodec : public Codec {
     void GetNextFrameAndInvokeCallback(
         std::unique_ptr<tonic::DartPersistentValue> callback,
         const fml::RefPtr<fml::TaskRunner>& ui_task_runner,
+        const std::shared_ptr<fml::ConcurrentTaskRunner>& concurrent_runner,
         const fml::WeakPtr<GrDirectContext>& resourceContext,
         const fml::RefPtr<flutter::SkiaUnrefQueue>& unref_queue,
         const std::shared_ptr<const fml::SyncSwitch>& gpu_disable_sync_switch,
@@ -27,12 +27,10 @@ void CanvasPathMeasure::Create(Dart_Handle wrapper,
   fml::RefPtr<CanvasPathMeasure> pathMeasure =
       fml::MakeRefCounted<CanvasPathMeasure>();
   if (path) {
-    const SkPath& skPath = path->path().GetSkPath();
-    SkScalar resScale = 1;
-    pathMeasure->path_measure_ =
-        std::make_unique<SkContourMeasureIter>(skPath, forceClosed, resScale);
+    pathMeasure->measures_ = path->path().GetContourMeasures(forceClosed);
   } else {
-    pathMeasure->path_measure_ = std::make_unique<SkContourMeasureIter>();
+    pathMeasure->measures_ =
+        std::make_shared<DlContourMeasures>(SkPath(), forceClosed);
   }
   pathMeasure->AssociateWithDartWrapper(wrapper);
 }
@@ -42,13 +40,23 @@ CanvasPathMeasure::CanvasPathMeasure() {}
 CanvasPathMeasure::~CanvasPathMeasure() {}
 
 void CanvasPathMeasure::setPath(const CanvasPath* path, bool isClosed) {
-  path_measure_->reset(path->path().GetSkPath(), isClosed);
+  measures_ = path->path().GetContourMeasures(isClosed);
+  contour_count_ = 0;
+}
+
+SkContourMeasure* CanvasPathMeasure::GetContour(int contour_index) const {
+  if (contour_index < 0 ||
+      static_cast<size_t>(contour_index) >= contour_count_) {
+    return nullptr;
+  }
+  // Contours before |contour_count_| have been measured already.
+  return measures_->Get(contour_index).get();
 }
 
 double CanvasPathMeasure::getLength(int contour_index) {
-  if (static_cast<std::vector<sk_sp<SkContourMeasure>>::size_type>(
-          contour_index) < measures_.size()) {
-    return measures_[contour_index]->length();
+  SkContourMeasure* measure = GetContour(contour_index);
+  if (measure) {
+    return measure->length();
   }
   return -1;
 }
@@ -57,15 +65,15 @@ tonic::Float32List CanvasPathMeasure::getPosTan(int contour_index,
                                                 double distance) {
   tonic::Float32List posTan(Dart_NewTypedData(Dart_TypedData_kFloat32, 5));
   posTan[0] = 0;  // dart code will check for this for failure
-  if (static_cast<std::vector<sk_sp<SkContourMeasure>>::size_type>(
-          contour_index) >= measures_.size()) {
+  SkContourMeasure* measure = GetContour(contour_index);
+  if (!measure) {
     return posTan;
   }
 
   SkPoint pos;
   SkVector tan;
   float fdistance = SafeNarrow(distance);
-  bool success = measures_[contour_index]->getPosTan(fdistance, &pos, &tan);
+  bool success = measure->getPosTan(fdistance, &pos, &tan);
 
   if (success) {
     posTan[0] = 1;  // dart code will check for this for success
@@ -83,13 +91,14 @@ void CanvasPathMeasure::getSegment(Dart_Handle path_handle,
                                    double start_d,
                                    double stop_d,
                                    bool start_with_move_to) {
-  if (static_cast<std::vector<sk_sp<SkContourMeasure>>::size_type>(
-          contour_index) >= measures_.size()) {
+  SkContourMeasure* measure = GetContour(contour_index);
+  if (!measure) {
     CanvasPath::Create(path_handle);
+    return;
   }
   SkPathBuilder dst;
-  bool success = measures_[contour_index]->getSegment(
-      SafeNarrow(start_d), SafeNarrow(stop_d), &dst, start_with_move_to);
+  bool success = measure->getSegment(SafeNarrow(start_d), SafeNarrow(stop_d),
+                                     &dst, start_with_move_to);
   if (!success) {
     CanvasPath::Create(path_handle);
   } else {
@@ -97,18 +106,34 @@ void CanvasPathMeasure::getSegment(Dart_Handle path_handle,
   }
 }
 
+void CanvasPathMeasure::getSegments(Dart_Handle path_handle,
+                                    int contour_index,
+                                    const tonic::Float32List& intervals,
+                                    bool start_with_move_to) {
+  SkContourMeasure* measure = GetContour(contour_index);
+  if (!measure) {
+    CanvasPath::Create(path_handle);
+    return;
+  }
+  SkPathBuilder dst;
+  for (size_t i = 0; i + 1 < intervals.num_elements(); i += 2) {
+    measure->getSegment(intervals[i], intervals[i + 1], &dst,
+                        start_with_move_to);
+  }
+  CanvasPath::CreateFrom(path_handle, dst.detach());
+}
+
 bool CanvasPathMeasure::isClosed(int contour_index) {
-  if (static_cast<std::vector<sk_sp<SkContourMeasure>>::size_type>(
-          contour_index) < measures_.size()) {
-    return measures_[contour_index]->isClosed();
+  SkContourMeasure* measure = GetContour(contour_index);
+  if (measure) {
+    return measure->isClosed();
   }
   return false;
 }
 
 bool CanvasPathMeasure::nextContour() {
-  auto measure = path_measure_->next();
-  if (measure) {
-    measures_.push_back(std::move(measure));
+  if (measures_->Get(contour_count_)) {
+    contour_count_++;
     return true;
   }
   return false;
@@ -5,8 +5,9 @@
 #ifndef FLUTTER_LIB_UI_PAINTING_PATH_MEASURE_H_
 #define FLUTTER_LIB_UI_PAINTING_PATH_MEASURE_H_
 
-#include <vector>
+#include <memory>
 
+#include "flutter/display_list/geometry/dl_contour_measures.h"
 #include "flutter/lib/ui/dart_wrapper.h"
 #include "flutter/lib/ui/painting/path.h"
 #include "third_party/skia/include/core/SkContourMeasure.h"
@@ -36,16 +37,24 @@ class CanvasPathMeasure : public RefCountedDartWrappable<CanvasPathMeasure> {
                   double start_d,
                   double stop_d,
                   bool start_with_move_to);
+  // Extracts the segments between each pair of distances in |intervals|
+  // into a single path.
+  void getSegments(Dart_Handle path_handle,
+                   int contour_index,
+                   const tonic::Float32List& intervals,
+                   bool start_with_move_to);
   bool isClosed(int contour_index);
   bool nextContour();
 
-  const SkContourMeasureIter& pathMeasure() const { return *path_measure_; }
-
  private:
   CanvasPathMeasure();
 
-  std::unique_ptr<SkContourMeasureIter> path_measure_;
-  std::vector<sk_sp<SkContourMeasure>> measures_;
+  // Shared with every other measure of the same path.
+  std::shared_ptr<DlContourMeasures> measures_;
+  // The number of contours this measure has iterated over.
+  size_t contour_count_ = 0;
+
+  SkContourMeasure* GetContour(int contour_index) const;
 };
 
 }  // namespace flutter
@@ -258,7 +258,9 @@ Dart_Handle Picture::DoRasterizeToImage(const sk_sp<DisplayList>& display_list,
               DlRect::MakeWH(width, height),
               snapshot_delegate->GetTextureRegistry(),
               is_impeller_enabled ? nullptr : snapshot_delegate->GetGrContext(),
-              aiks_context.get());
+              aiks_context.get(),
+              snapshot_delegate->GetLayerFlattenCache(
+                  SnapshotDelegate::FlattenCacheUser::kSceneToImage));
         }
         if (is_impeller_enabled) {
 #if IMPELLER_SUPPORTS_RENDERING
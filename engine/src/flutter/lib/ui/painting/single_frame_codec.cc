@@ -78,7 +78,8 @@ Dart_Handle SingleFrameCodec::getNextFrame(Dart_Handle callback_handle) {
       descriptor_,
       {.target_width = target_width_,
        .target_height = target_height_,
-       .target_format = target_format_},
+       .target_format = target_format_,
+       .cancelled = decode_cancelled_},
       [raw_codec_ref](const auto& image, const auto& decode_error) {
         std::unique_ptr<fml::RefPtr<SingleFrameCodec>> codec_ref(raw_codec_ref);
         fml::RefPtr<SingleFrameCodec> codec(std::move(*codec_ref));
@@ -124,4 +125,9 @@ Dart_Handle SingleFrameCodec::getNextFrame(Dart_Handle callback_handle) {
   return Dart_Null();
 }
 
+void SingleFrameCodec::dispose() {
+  decode_cancelled_->store(true);
+  Codec::dispose();
+}
+
 }  // namespace flutter
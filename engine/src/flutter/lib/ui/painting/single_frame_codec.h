@@ -5,6 +5,9 @@
 #ifndef FLUTTER_LIB_UI_PAINTING_SINGLE_FRAME_CODEC_H_
 #define FLUTTER_LIB_UI_PAINTING_SINGLE_FRAME_CODEC_H_
 
+#include <atomic>
+#include <memory>
+
 #include "flutter/fml/macros.h"
 #include "flutter/lib/ui/painting/codec.h"
 #include "flutter/lib/ui/painting/image.h"
@@ -31,6 +34,9 @@ class SingleFrameCodec : public Codec {
   // |Codec|
   Dart_Handle getNextFrame(Dart_Handle args) override;
 
+  // |Codec|
+  void dispose() override;
+
  private:
   enum class Status { kNew, kInProgress, kComplete };
   Status status_ = Status::kNew;
@@ -40,6 +46,10 @@ class SingleFrameCodec : public Codec {
   ImageDecoder::TargetPixelFormat target_format_;
   fml::RefPtr<CanvasImage> cached_image_;
   std::vector<tonic::DartPersistentValue> pending_callbacks_;
+  // Set when the codec is disposed so that a decode that has not started yet
+  // is skipped.
+  std::shared_ptr<std::atomic<bool>> decode_cancelled_ =
+      std::make_shared<std::atomic<bool>>(false);
 
   FML_FRIEND_MAKE_REF_COUNTED(SingleFrameCodec);
   FML_FRIEND_REF_COUNTED_THREAD_SAFE(SingleFrameCodec);
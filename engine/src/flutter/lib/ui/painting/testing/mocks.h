@@ -43,6 +43,10 @@ class MockSnapshotDelegate : public SnapshotDelegate {
               GetAiksContext,
               (),
               (const, override));
+  MOCK_METHOD(LayerFlattenCache*,
+              GetLayerFlattenCache,
+              (FlattenCacheUser),
+              (override));
   MOCK_METHOD(void,
               MakeSkiaSnapshot,
               (sk_sp<DisplayList>,
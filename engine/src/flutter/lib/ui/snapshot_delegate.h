@@ -26,9 +26,18 @@ class AiksContext;
 namespace flutter {
 
 class DlImage;
+class LayerFlattenCache;
 
 class SnapshotDelegate {
  public:
+  //----------------------------------------------------------------------------
+  /// @brief      The users of the layer flatten caches. Each user has its own
+  ///             cache so that users do not evict the entries of others.
+  enum class FlattenCacheUser {
+    kSceneToImage,
+    kDeferredImage,
+  };
+
   //----------------------------------------------------------------------------
   /// @brief      A data structure used by the Skia implementation of deferred
   ///             GPU based images.
@@ -87,6 +96,14 @@ class SnapshotDelegate {
 
   virtual std::shared_ptr<impeller::AiksContext> GetAiksContext() const = 0;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Gets the cache that layer trees flattened for snapshots by
+  ///             |user| use to avoid recording unchanged subtrees again.
+  ///
+  /// @return     A pointer to the cache, or null if there is none.
+  ///
+  virtual LayerFlattenCache* GetLayerFlattenCache(FlattenCacheUser user) = 0;
+
   virtual void MakeSkiaSnapshot(sk_sp<DisplayList> display_list,
                                 DlISize picture_size,
                                 std::function<void(sk_sp<SkImage>)> callback,
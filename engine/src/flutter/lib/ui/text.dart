@@ -3193,39 +3193,91 @@ base class _NativeParagraph extends NativeFieldWrapperClass1 implements Paragrap
   bool _needsLayout = true;
 
   @override
+  double get width {
+    _checkLayoutNotPending();
+    return _width;
+  }
+
   @Native<Double Function(Pointer<Void>)>(symbol: 'Paragraph::width', isLeaf: true)
-  external double get width;
+  external double get _width;
 
   @override
+  double get height {
+    _checkLayoutNotPending();
+    return _height;
+  }
+
   @Native<Double Function(Pointer<Void>)>(symbol: 'Paragraph::height', isLeaf: true)
-  external double get height;
+  external double get _height;
 
   @override
+  double get longestLine {
+    _checkLayoutNotPending();
+    return _longestLine;
+  }
+
   @Native<Double Function(Pointer<Void>)>(symbol: 'Paragraph::longestLine', isLeaf: true)
-  external double get longestLine;
+  external double get _longestLine;
 
   @override
+  double get minIntrinsicWidth {
+    _checkLayoutNotPending();
+    return _minIntrinsicWidth;
+  }
+
   @Native<Double Function(Pointer<Void>)>(symbol: 'Paragraph::minIntrinsicWidth', isLeaf: true)
-  external double get minIntrinsicWidth;
+  external double get _minIntrinsicWidth;
 
   @override
+  double get maxIntrinsicWidth {
+    _checkLayoutNotPending();
+    return _maxIntrinsicWidth;
+  }
+
   @Native<Double Function(Pointer<Void>)>(symbol: 'Paragraph::maxIntrinsicWidth', isLeaf: true)
-  external double get maxIntrinsicWidth;
+  external double get _maxIntrinsicWidth;
 
   @override
+  double get alphabeticBaseline {
+    _checkLayoutNotPending();
+    return _alphabeticBaseline;
+  }
+
   @Native<Double Function(Pointer<Void>)>(symbol: 'Paragraph::alphabeticBaseline', isLeaf: true)
-  external double get alphabeticBaseline;
+  external double get _alphabeticBaseline;
 
   @override
+  double get ideographicBaseline {
+    _checkLayoutNotPending();
+    return _ideographicBaseline;
+  }
+
   @Native<Double Function(Pointer<Void>)>(symbol: 'Paragraph::ideographicBaseline', isLeaf: true)
-  external double get ideographicBaseline;
+  external double get _ideographicBaseline;
 
   @override
+  bool get didExceedMaxLines {
+    _checkLayoutNotPending();
+    return _didExceedMaxLines;
+  }
+
   @Native<Bool Function(Pointer<Void>)>(symbol: 'Paragraph::didExceedMaxLines', isLeaf: true)
-  external bool get didExceedMaxLines;
+  external bool get _didExceedMaxLines;
+
+  /// Whether the paragraph is being laid out by [layoutParagraphs].
+  bool _layoutPending = false;
+
+  /// The native paragraph is detached from this object while
+  /// [layoutParagraphs] lays it out, so it cannot be used in the meantime.
+  void _checkLayoutNotPending() {
+    if (_layoutPending) {
+      throw StateError('Paragraph used while layoutParagraphs is pending.');
+    }
+  }
 
   @override
   void layout(ParagraphConstraints constraints) {
+    _checkLayoutNotPending();
     _layout(constraints.width);
     assert(() {
       _needsLayout = false;
@@ -3261,6 +3313,7 @@ base class _NativeParagraph extends NativeFieldWrapperClass1 implements Paragrap
     BoxHeightStyle boxHeightStyle = BoxHeightStyle.tight,
     BoxWidthStyle boxWidthStyle = BoxWidthStyle.tight,
   }) {
+    _checkLayoutNotPending();
     return _decodeTextBoxes(
       _getBoxesForRange(start, end, boxHeightStyle.index, boxWidthStyle.index),
     );
@@ -3274,6 +3327,7 @@ base class _NativeParagraph extends NativeFieldWrapperClass1 implements Paragrap
 
   @override
   List<TextBox> getBoxesForPlaceholders() {
+    _checkLayoutNotPending();
     return _decodeTextBoxes(_getBoxesForPlaceholders());
   }
 
@@ -3282,6 +3336,7 @@ base class _NativeParagraph extends NativeFieldWrapperClass1 implements Paragrap
 
   @override
   TextPosition getPositionForOffset(Offset offset) {
+    _checkLayoutNotPending();
     final List<int> encoded = _getPositionForOffset(offset.dx, offset.dy);
     return TextPosition(offset: encoded[0], affinity: TextAffinity.values[encoded[1]]);
   }
@@ -3290,13 +3345,20 @@ base class _NativeParagraph extends NativeFieldWrapperClass1 implements Paragrap
   external List<int> _getPositionForOffset(double dx, double dy);
 
   @override
-  GlyphInfo? getGlyphInfoAt(int codeUnitOffset) => _getGlyphInfoAt(codeUnitOffset, GlyphInfo._);
+  GlyphInfo? getGlyphInfoAt(int codeUnitOffset) {
+    _checkLayoutNotPending();
+    return _getGlyphInfoAt(codeUnitOffset, GlyphInfo._);
+  }
+
   @Native<Handle Function(Pointer<Void>, Uint32, Handle)>(symbol: 'Paragraph::getGlyphInfoAt')
   external GlyphInfo? _getGlyphInfoAt(int codeUnitOffset, Function constructor);
 
   @override
-  GlyphInfo? getClosestGlyphInfoForOffset(Offset offset) =>
-      _getClosestGlyphInfoForOffset(offset.dx, offset.dy, GlyphInfo._);
+  GlyphInfo? getClosestGlyphInfoForOffset(Offset offset) {
+    _checkLayoutNotPending();
+    return _getClosestGlyphInfoForOffset(offset.dx, offset.dy, GlyphInfo._);
+  }
+
   @Native<Handle Function(Pointer<Void>, Double, Double, Handle)>(
     symbol: 'Paragraph::getClosestGlyphInfo',
   )
@@ -3304,6 +3366,7 @@ base class _NativeParagraph extends NativeFieldWrapperClass1 implements Paragrap
 
   @override
   TextRange getWordBoundary(TextPosition position) {
+    _checkLayoutNotPending();
     final int characterPosition;
     switch (position.affinity) {
       case TextAffinity.upstream:
@@ -3320,6 +3383,7 @@ base class _NativeParagraph extends NativeFieldWrapperClass1 implements Paragrap
 
   @override
   TextRange getLineBoundary(TextPosition position) {
+    _checkLayoutNotPending();
     final List<int> boundary = _getLineBoundary(position.offset);
     final line = TextRange(start: boundary[0], end: boundary[1]);
 
@@ -3353,6 +3417,7 @@ base class _NativeParagraph extends NativeFieldWrapperClass1 implements Paragrap
 
   @override
   List<LineMetrics> computeLineMetrics() {
+    _checkLayoutNotPending();
     final Float64List encoded = _computeLineMetrics();
     final int count = encoded.length ~/ 9;
     var position = 0;
@@ -3377,16 +3442,26 @@ base class _NativeParagraph extends NativeFieldWrapperClass1 implements Paragrap
   external Float64List _computeLineMetrics();
 
   @override
-  LineMetrics? getLineMetricsAt(int lineNumber) => _getLineMetricsAt(lineNumber, LineMetrics._);
+  LineMetrics? getLineMetricsAt(int lineNumber) {
+    _checkLayoutNotPending();
+    return _getLineMetricsAt(lineNumber, LineMetrics._);
+  }
+
   @Native<Handle Function(Pointer<Void>, Uint32, Handle)>(symbol: 'Paragraph::getLineMetricsAt')
   external LineMetrics? _getLineMetricsAt(int lineNumber, Function constructor);
 
   @override
+  int get numberOfLines {
+    _checkLayoutNotPending();
+    return _numberOfLines;
+  }
+
   @Native<Uint32 Function(Pointer<Void>)>(symbol: 'Paragraph::getNumberOfLines')
-  external int get numberOfLines;
+  external int get _numberOfLines;
 
   @override
   int? getLineNumberAt(int codeUnitOffset) {
+    _checkLayoutNotPending();
     final int lineNumber = _getLineNumber(codeUnitOffset);
     return lineNumber < 0 ? null : lineNumber;
   }
@@ -3783,6 +3858,56 @@ base class _NativeParagraphBuilder extends NativeFieldWrapperClass1 implements P
   String toString() => 'ParagraphBuilder';
 }
 
+/// Lays out each of the `paragraphs` with the corresponding `constraints`
+/// on a background thread, so that measuring large amounts of text does not
+/// block the UI thread.
+///
+/// The paragraphs must not be used until the returned future completes, at
+/// which point they are laid out exactly as if [Paragraph.layout] had been
+/// called on each of them. Paragraphs that were not created by a
+/// [ParagraphBuilder] are laid out synchronously.
+Future<void> layoutParagraphs(List<Paragraph> paragraphs, List<ParagraphConstraints> constraints) {
+  if (paragraphs.length != constraints.length) {
+    throw ArgumentError('paragraphs and constraints must have the same length.');
+  }
+  final nativeParagraphs = <_NativeParagraph>[];
+  final widths = <double>[];
+  for (var index = 0; index < paragraphs.length; index += 1) {
+    final Paragraph paragraph = paragraphs[index];
+    if (paragraph is _NativeParagraph) {
+      assert(!paragraph._disposed, 'Cannot lay out a disposed Paragraph.');
+      paragraph._checkLayoutNotPending();
+      paragraph._layoutPending = true;
+      nativeParagraphs.add(paragraph);
+      widths.add(constraints[index].width);
+    } else {
+      paragraph.layout(constraints[index]);
+    }
+  }
+  if (nativeParagraphs.isEmpty) {
+    return Future<void>.value();
+  }
+  return _futurize((_Callback<void> callback) {
+    _layoutParagraphs(nativeParagraphs, Float64List.fromList(widths), callback);
+    return null;
+  }).then((_) {
+    for (final paragraph in nativeParagraphs) {
+      paragraph._layoutPending = false;
+      assert(() {
+        paragraph._needsLayout = false;
+        return true;
+      }());
+    }
+  });
+}
+
+@Native<Void Function(Handle, Handle, Handle)>(symbol: 'Paragraph::LayoutAll')
+external void _layoutParagraphs(
+  List<_NativeParagraph> paragraphs,
+  Float64List widths,
+  _Callback<void> callback,
+);
+
 /// Loads a font from a buffer and makes it available for rendering text.
 ///
 /// * `list`: A list of bytes containing the font file.
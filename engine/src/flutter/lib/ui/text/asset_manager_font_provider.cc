@@ -12,6 +12,7 @@
 #include "third_party/skia/include/core/SkStream.h"
 #include "third_party/skia/include/core/SkString.h"
 #include "third_party/skia/include/core/SkTypeface.h"
+#include "txt/font_style_reader.h"
 #include "txt/platform.h"
 
 namespace flutter {
@@ -88,9 +89,24 @@ void AssetManagerFontStyleSet::getStyle(int index,
                                         SkString* name) {
   FML_DCHECK(index < static_cast<int>(assets_.size()));
   if (style) {
-    sk_sp<SkTypeface> typeface(createTypeface(index));
-    if (typeface) {
-      *style = typeface->fontStyle();
+    TypefaceAsset& asset = assets_[index];
+    if (!asset.style.has_value() && !asset.typeface) {
+      std::unique_ptr<fml::Mapping> mapping = TakeMapping(asset);
+      if (mapping) {
+        asset.style =
+            txt::ReadFontStyle(mapping->GetMapping(), mapping->GetSize());
+        if (mapping->IsDontNeedSafe()) {
+          asset.mapping = std::move(mapping);
+        }
+      }
+    }
+    if (asset.style.has_value()) {
+      *style = asset.style.value();
+    } else {
+      sk_sp<SkTypeface> typeface(createTypeface(index));
+      if (typeface) {
+        *style = typeface->fontStyle();
+      }
     }
   }
   if (name) {
@@ -106,8 +122,7 @@ auto AssetManagerFontStyleSet::createTypeface(int i) -> CreateTypefaceRet {
 
   TypefaceAsset& asset = assets_[index];
   if (!asset.typeface) {
-    std::unique_ptr<fml::Mapping> asset_mapping =
-        asset_manager_->GetAsMapping(asset.asset);
+    std::unique_ptr<fml::Mapping> asset_mapping = TakeMapping(asset);
     if (asset_mapping == nullptr) {
       return nullptr;
     }
@@ -131,6 +146,14 @@ auto AssetManagerFontStyleSet::createTypeface(int i) -> CreateTypefaceRet {
   return CreateTypefaceRet(SkRef(asset.typeface.get()));
 }
 
+std::unique_ptr<fml::Mapping> AssetManagerFontStyleSet::TakeMapping(
+    TypefaceAsset& asset) {
+  if (asset.mapping) {
+    return std::move(asset.mapping);
+  }
+  return asset_manager_->GetAsMapping(asset.asset);
+}
+
 auto AssetManagerFontStyleSet::matchStyle(const SkFontStyle& pattern)
     -> MatchStyleRet {
   return matchStyleCSS3(pattern);
@@ -140,7 +163,7 @@ AssetManagerFontStyleSet::TypefaceAsset::TypefaceAsset(std::string a)
     : asset(std::move(a)) {}
 
 AssetManagerFontStyleSet::TypefaceAsset::TypefaceAsset(
-    const AssetManagerFontStyleSet::TypefaceAsset& other) = default;
+    AssetManagerFontStyleSet::TypefaceAsset&& other) = default;
 
 AssetManagerFontStyleSet::TypefaceAsset::~TypefaceAsset() = default;
 
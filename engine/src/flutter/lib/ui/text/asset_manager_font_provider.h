@@ -6,6 +6,7 @@
 #define FLUTTER_LIB_UI_TEXT_ASSET_MANAGER_FONT_PROVIDER_H_
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -50,15 +51,23 @@ class AssetManagerFontStyleSet : public SkFontStyleSet {
   struct TypefaceAsset {
     explicit TypefaceAsset(std::string a);
 
-    TypefaceAsset(const TypefaceAsset& other);
+    TypefaceAsset(TypefaceAsset&& other);
 
     ~TypefaceAsset();
 
     std::string asset;
     sk_sp<SkTypeface> typeface;
+    // Read from the font file when the family is first matched, so that the
+    // typefaces of styles that are never used are not created.
+    std::optional<SkFontStyle> style;
+    // The file the style was read from, kept until the typeface is created if
+    // it is a file mapping whose pages the kernel can reclaim.
+    std::unique_ptr<fml::Mapping> mapping;
   };
   std::vector<TypefaceAsset> assets_;
 
+  std::unique_ptr<fml::Mapping> TakeMapping(TypefaceAsset& asset);
+
   FML_DISALLOW_COPY_AND_ASSIGN(AssetManagerFontStyleSet);
 };
 
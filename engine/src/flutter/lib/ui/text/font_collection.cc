@@ -164,12 +164,16 @@ void FontCollection::LoadFontFromList(Dart_Handle font_data_handle,
   sk_sp<SkTypeface> typeface = font_mgr->makeFromStream(std::move(font_stream));
   txt::TypefaceFontAssetProvider& font_provider =
       font_collection.dynamic_font_manager_->font_provider();
-  if (family_name.empty()) {
-    font_provider.RegisterTypeface(typeface);
-  } else {
-    font_provider.RegisterTypeface(typeface, family_name);
+  {
+    // Paragraphs may be querying the dynamic font manager on a worker thread.
+    auto lock = font_collection.collection_->LockForLayout();
+    if (family_name.empty()) {
+      font_provider.RegisterTypeface(typeface);
+    } else {
+      font_provider.RegisterTypeface(typeface, family_name);
+    }
+    font_collection.collection_->ClearFontFamilyCache();
   }
-  font_collection.collection_->ClearFontFamilyCache();
 
   font_data.Release();
   tonic::DartInvoke(callback, {tonic::ToDart(0)});
@@ -7,7 +7,10 @@
 #include "flutter/common/settings.h"
 #include "flutter/common/task_runners.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/make_copyable.h"
 #include "flutter/fml/task_runner.h"
+#include "flutter/fml/trace_event.h"
+#include "flutter/lib/ui/ui_dart_state.h"
 #include "third_party/dart/runtime/include/dart_api.h"
 #include "third_party/skia/modules/skparagraph/include/DartTypes.h"
 #include "third_party/skia/modules/skparagraph/include/Paragraph.h"
@@ -15,51 +18,174 @@
 #include "third_party/tonic/dart_args.h"
 #include "third_party/tonic/dart_binding_macros.h"
 #include "third_party/tonic/dart_library_natives.h"
+#include "third_party/tonic/dart_persistent_value.h"
 #include "third_party/tonic/logging/dart_invoke.h"
+#include "third_party/tonic/typed_data/typed_list.h"
 
 namespace flutter {
 
 IMPLEMENT_WRAPPERTYPEINFO(ui, Paragraph);
 
-Paragraph::Paragraph(std::unique_ptr<txt::Paragraph> paragraph)
-    : m_paragraph_(std::move(paragraph)) {}
+namespace {
+
+// A paragraph detached from its Dart object while it is laid out on a worker
+// thread.
+struct PendingLayout {
+  fml::RefPtr<Paragraph> paragraph;
+  std::unique_ptr<txt::Paragraph> txt_paragraph;
+  std::shared_ptr<txt::FontCollection> font_collection;
+  double width = 0;
+};
+
+void LayoutLocked(txt::Paragraph* paragraph,
+                  txt::FontCollection* font_collection,
+                  double width) {
+  if (!font_collection) {
+    paragraph->Layout(width);
+    return;
+  }
+  auto lock = font_collection->LockForLayout();
+  paragraph->Layout(width);
+}
+
+}  // namespace
+
+Paragraph::Paragraph(std::unique_ptr<txt::Paragraph> paragraph,
+                     std::shared_ptr<txt::FontCollection> font_collection)
+    : m_paragraph_(std::move(paragraph)),
+      font_collection_(std::move(font_collection)) {}
 
 Paragraph::~Paragraph() = default;
 
 double Paragraph::width() {
+  if (!m_paragraph_) {
+    return 0;
+  }
   return m_paragraph_->GetMaxWidth();
 }
 
 double Paragraph::height() {
+  if (!m_paragraph_) {
+    return 0;
+  }
   return m_paragraph_->GetHeight();
 }
 
 double Paragraph::longestLine() {
+  if (!m_paragraph_) {
+    return 0;
+  }
   return m_paragraph_->GetLongestLine();
 }
 
 double Paragraph::minIntrinsicWidth() {
+  if (!m_paragraph_) {
+    return 0;
+  }
   return m_paragraph_->GetMinIntrinsicWidth();
 }
 
 double Paragraph::maxIntrinsicWidth() {
+  if (!m_paragraph_) {
+    return 0;
+  }
   return m_paragraph_->GetMaxIntrinsicWidth();
 }
 
 double Paragraph::alphabeticBaseline() {
+  if (!m_paragraph_) {
+    return 0;
+  }
   return m_paragraph_->GetAlphabeticBaseline();
 }
 
 double Paragraph::ideographicBaseline() {
+  if (!m_paragraph_) {
+    return 0;
+  }
   return m_paragraph_->GetIdeographicBaseline();
 }
 
 bool Paragraph::didExceedMaxLines() {
+  if (!m_paragraph_) {
+    return false;
+  }
   return m_paragraph_->DidExceedMaxLines();
 }
 
 void Paragraph::layout(double width) {
-  m_paragraph_->Layout(width);
+  if (!m_paragraph_) {
+    return;
+  }
+  LayoutLocked(m_paragraph_.get(), font_collection_.get(), width);
+}
+
+void Paragraph::LayoutAll(Dart_Handle paragraphs_handle,
+                          Dart_Handle widths_handle,
+                          Dart_Handle callback_handle) {
+  UIDartState::ThrowIfUIOperationsProhibited();
+  auto* dart_state = UIDartState::Current();
+  intptr_t count = 0;
+  Dart_ListLength(paragraphs_handle, &count);
+  tonic::Float64List widths(widths_handle);
+  FML_DCHECK(static_cast<size_t>(count) == widths.num_elements());
+
+  std::vector<PendingLayout> layouts;
+  layouts.reserve(count);
+  for (intptr_t i = 0; i < count; i++) {
+    Paragraph* paragraph = tonic::DartConverter<Paragraph*>::FromDart(
+        Dart_ListGetAt(paragraphs_handle, i));
+    // Disposed paragraphs, and paragraphs that are already being laid out.
+    if (!paragraph || !paragraph->m_paragraph_) {
+      continue;
+    }
+    layouts.push_back({
+        .paragraph = fml::Ref(paragraph),
+        .txt_paragraph = std::move(paragraph->m_paragraph_),
+        .font_collection = paragraph->font_collection_,
+        .width = widths[i],
+    });
+  }
+  widths.Release();
+
+  auto callback = std::make_unique<tonic::DartPersistentValue>(
+      dart_state, callback_handle);
+  auto ui_task_runner = dart_state->GetTaskRunners().GetUITaskRunner();
+  dart_state->GetConcurrentTaskRunner()->PostTask(fml::MakeCopyable(
+      [layouts = std::move(layouts), callback = std::move(callback),
+       ui_task_runner = std::move(ui_task_runner)]() mutable {
+        {
+          const std::string count = std::to_string(layouts.size());
+          TRACE_EVENT1("flutter", "Paragraph::LayoutAll", "count",
+                       count.c_str());
+          // Each paragraph takes the lock separately, so that a paragraph
+          // laid out on the UI thread in the meantime waits for at most one
+          // paragraph of the batch.
+          for (PendingLayout& layout : layouts) {
+            LayoutLocked(layout.txt_paragraph.get(),
+                         layout.font_collection.get(), layout.width);
+          }
+        }
+        // The paragraphs are released on the UI thread, as they may hold the
+        // last references to their Dart objects.
+        ui_task_runner->PostTask(fml::MakeCopyable(
+            [layouts = std::move(layouts),
+             callback = std::move(callback)]() mutable {
+              for (PendingLayout& layout : layouts) {
+                if (!layout.paragraph->disposed_) {
+                  layout.paragraph->m_paragraph_ =
+                      std::move(layout.txt_paragraph);
+                }
+              }
+              std::shared_ptr<tonic::DartState> dart_state =
+                  callback->dart_state().lock();
+              if (!dart_state) {
+                return;
+              }
+              tonic::DartState::Scope scope(dart_state);
+              tonic::DartInvoke(callback->value(), {tonic::ToDart(0)});
+            }));
+      }));
 }
 
 void Paragraph::paint(Canvas* canvas, double x, double y) {
@@ -98,6 +224,9 @@ tonic::Float32List Paragraph::getRectsForRange(unsigned start,
                                                unsigned end,
                                                unsigned boxHeightStyle,
                                                unsigned boxWidthStyle) {
+  if (!m_paragraph_) {
+    return EncodeTextBoxes({});
+  }
   std::vector<txt::Paragraph::TextBox> boxes = m_paragraph_->GetRectsForRange(
       start, end, static_cast<txt::Paragraph::RectHeightStyle>(boxHeightStyle),
       static_cast<txt::Paragraph::RectWidthStyle>(boxWidthStyle));
@@ -105,12 +234,18 @@ tonic::Float32List Paragraph::getRectsForRange(unsigned start,
 }
 
 tonic::Float32List Paragraph::getRectsForPlaceholders() {
+  if (!m_paragraph_) {
+    return EncodeTextBoxes({});
+  }
   std::vector<txt::Paragraph::TextBox> boxes =
       m_paragraph_->GetRectsForPlaceholders();
   return EncodeTextBoxes(boxes);
 }
 
 Dart_Handle Paragraph::getPositionForOffset(double dx, double dy) {
+  if (!m_paragraph_) {
+    return Dart_Null();
+  }
   txt::Paragraph::PositionWithAffinity pos =
       m_paragraph_->GetGlyphPositionAtCoordinate(dx, dy);
   std::vector<size_t> result = {
@@ -138,6 +273,9 @@ Dart_Handle glyphInfoFrom(
 
 Dart_Handle Paragraph::getGlyphInfoAt(unsigned utf16Offset,
                                       Dart_Handle constructor) const {
+  if (!m_paragraph_) {
+    return Dart_Null();
+  }
   skia::textlayout::Paragraph::GlyphInfo glyphInfo;
   const bool found = m_paragraph_->GetGlyphInfoAt(utf16Offset, &glyphInfo);
   if (!found) {
@@ -151,6 +289,9 @@ Dart_Handle Paragraph::getGlyphInfoAt(unsigned utf16Offset,
 Dart_Handle Paragraph::getClosestGlyphInfo(double dx,
                                            double dy,
                                            Dart_Handle constructor) const {
+  if (!m_paragraph_) {
+    return Dart_Null();
+  }
   skia::textlayout::Paragraph::GlyphInfo glyphInfo;
   const bool found =
       m_paragraph_->GetClosestGlyphInfoAtCoordinate(dx, dy, &glyphInfo);
@@ -163,6 +304,9 @@ Dart_Handle Paragraph::getClosestGlyphInfo(double dx,
 }
 
 Dart_Handle Paragraph::getWordBoundary(unsigned utf16Offset) {
+  if (!m_paragraph_) {
+    return Dart_Null();
+  }
   txt::Paragraph::Range<size_t> point =
       m_paragraph_->GetWordBoundary(utf16Offset);
   std::vector<size_t> result = {point.start, point.end};
@@ -170,6 +314,9 @@ Dart_Handle Paragraph::getWordBoundary(unsigned utf16Offset) {
 }
 
 Dart_Handle Paragraph::getLineBoundary(unsigned utf16Offset) {
+  if (!m_paragraph_) {
+    return Dart_Null();
+  }
   std::vector<txt::LineMetrics> metrics = m_paragraph_->GetLineMetrics();
   int line_start = -1;
   int line_end = -1;
@@ -185,6 +332,9 @@ Dart_Handle Paragraph::getLineBoundary(unsigned utf16Offset) {
 }
 
 tonic::Float64List Paragraph::computeLineMetrics() const {
+  if (!m_paragraph_) {
+    return tonic::Float64List(Dart_NewTypedData(Dart_TypedData_kFloat64, 0));
+  }
   std::vector<txt::LineMetrics> metrics = m_paragraph_->GetLineMetrics();
 
   // Layout:
@@ -214,6 +364,9 @@ tonic::Float64List Paragraph::computeLineMetrics() const {
 
 Dart_Handle Paragraph::getLineMetricsAt(int lineNumber,
                                         Dart_Handle constructor) const {
+  if (!m_paragraph_) {
+    return Dart_Null();
+  }
   skia::textlayout::LineMetrics line;
   const bool found = m_paragraph_->GetLineMetricsAt(lineNumber, &line);
   if (!found) {
@@ -241,14 +394,21 @@ Dart_Handle Paragraph::getLineMetricsAt(int lineNumber,
 }
 
 size_t Paragraph::getNumberOfLines() const {
+  if (!m_paragraph_) {
+    return 0;
+  }
   return m_paragraph_->GetNumberOfLines();
 }
 
 int Paragraph::getLineNumberAt(size_t utf16Offset) const {
+  if (!m_paragraph_) {
+    return -1;
+  }
   return m_paragraph_->GetLineNumberAt(utf16Offset);
 }
 
 void Paragraph::dispose() {
+  disposed_ = true;
   m_paragraph_.reset();
   ClearDartWrapper();
 }
@@ -8,6 +8,7 @@
 #include "flutter/fml/message_loop.h"
 #include "flutter/lib/ui/dart_wrapper.h"
 #include "flutter/lib/ui/painting/canvas.h"
+#include "flutter/txt/src/txt/font_collection.h"
 #include "flutter/txt/src/txt/paragraph.h"
 
 namespace flutter {
@@ -18,11 +19,35 @@ class Paragraph : public RefCountedDartWrappable<Paragraph> {
 
  public:
   static void Create(Dart_Handle paragraph_handle,
-                     std::unique_ptr<txt::Paragraph> txt_paragraph) {
-    auto paragraph = fml::MakeRefCounted<Paragraph>(std::move(txt_paragraph));
+                     std::unique_ptr<txt::Paragraph> txt_paragraph,
+                     std::shared_ptr<txt::FontCollection> font_collection) {
+    auto paragraph = fml::MakeRefCounted<Paragraph>(std::move(txt_paragraph),
+                                                    std::move(font_collection));
     paragraph->AssociateWithDartWrapper(paragraph_handle);
   }
 
+  //----------------------------------------------------------------------------
+  /// @brief      Lays out a batch of paragraphs on a worker thread, so that
+  ///             measuring large amounts of text does not block the UI
+  ///             thread.
+  ///
+  ///             The paragraphs are detached from their Dart objects until
+  ///             the layout completes, and are attached again on the UI
+  ///             thread right before the callback is invoked, unless they
+  ///             were disposed in the meantime. Until then the accessors of
+  ///             a paragraph return empty results, and the Dart objects
+  ///             throw instead of calling them.
+  ///
+  /// @param[in]  paragraphs_handle  A list of paragraphs.
+  /// @param[in]  widths_handle      A Float64List of the width to lay out
+  ///                                each paragraph at.
+  /// @param[in]  callback_handle    Invoked once all the paragraphs are laid
+  ///                                out.
+  ///
+  static void LayoutAll(Dart_Handle paragraphs_handle,
+                        Dart_Handle widths_handle,
+                        Dart_Handle callback_handle);
+
   ~Paragraph() override;
 
   double width();
@@ -58,9 +83,14 @@ class Paragraph : public RefCountedDartWrappable<Paragraph> {
   void dispose();
 
  private:
+  // Null once disposed, and while the paragraph is laid out by |LayoutAll|.
   std::unique_ptr<txt::Paragraph> m_paragraph_;
+  bool disposed_ = false;
+  // The collection the paragraph was built with, locked while it is laid out.
+  std::shared_ptr<txt::FontCollection> font_collection_;
 
-  explicit Paragraph(std::unique_ptr<txt::Paragraph> paragraph);
+  Paragraph(std::unique_ptr<txt::Paragraph> paragraph,
+            std::shared_ptr<txt::FontCollection> font_collection);
 };
 
 }  // namespace flutter
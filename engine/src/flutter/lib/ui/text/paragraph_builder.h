@@ -79,6 +79,7 @@ class ParagraphBuilder : public RefCountedDartWrappable<ParagraphBuilder> {
                             const std::string& locale);
 
   std::unique_ptr<txt::ParagraphBuilder> m_paragraph_builder_;
+  std::shared_ptr<txt::FontCollection> m_font_collection_;
 };
 
 }  // namespace flutter
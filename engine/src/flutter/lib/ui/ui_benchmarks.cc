@@ -2,15 +2,35 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include "flutter/assets/directory_asset_bundle.h"
 #include "flutter/benchmarking/benchmarking.h"
 #include "flutter/common/settings.h"
+#include "flutter/fml/build_config.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/lib/ui/painting/image_generator_registry.h"
+#include "flutter/lib/ui/painting/immutable_buffer.h"
+#include "flutter/lib/ui/text/asset_manager_font_provider.h"
 #include "flutter/lib/ui/window/platform_message_response_dart.h"
 #include "flutter/runtime/dart_vm_lifecycle.h"
 #include "flutter/shell/common/thread_host.h"
 #include "flutter/testing/dart_isolate_runner.h"
 #include "flutter/testing/fixture_test.h"
+#include "flutter/testing/testing.h"
+#include "flutter/txt/src/txt/asset_font_manager.h"
+#include "third_party/skia/include/core/SkBitmap.h"
 
+#if IMPELLER_ENABLE_VULKAN
+#include "flutter/impeller/renderer/backend/vulkan/context_vk.h"
+#include "flutter/impeller/renderer/backend/vulkan/test/mock_vulkan.h"
+#include "flutter/lib/ui/painting/image_decoder_impeller.h"
+#endif  // IMPELLER_ENABLE_VULKAN
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
 #include <future>
+#include <string>
 
 namespace flutter {
 
@@ -69,4 +89,267 @@ static void BM_PlatformMessageResponseDartComplete(benchmark::State& state) {
 BENCHMARK(BM_PlatformMessageResponseDartComplete)
     ->Unit(benchmark::kMicrosecond);
 
+#if FML_OS_LINUX
+// The resident memory of the process by kind, from /proc/self/status.
+struct ResidentBytes {
+  int64_t anon = 0;
+  int64_t file = 0;
+};
+
+static ResidentBytes ReadResidentBytes() {
+  ResidentBytes bytes;
+  std::ifstream status("/proc/self/status");
+  std::string line;
+  while (std::getline(status, line)) {
+    long long kilobytes = 0;
+    if (std::sscanf(line.c_str(), "RssAnon: %lld kB", &kilobytes) == 1) {
+      bytes.anon = kilobytes * 1024;
+    } else if (std::sscanf(line.c_str(), "RssFile: %lld kB", &kilobytes) ==
+               1) {
+      bytes.file = kilobytes * 1024;
+    }
+  }
+  return bytes;
+}
+#endif  // FML_OS_LINUX
+
+// Loads a 16 MB asset into an SkData the way ImmutableBuffer.fromAsset does
+// and reads every page of it, as an image decoder would. The asset is either
+// copied to the heap or wrapped as a file mapping.
+//
+// On Linux, the "AnonBytes" and "FileBytes" counters are the growth of the
+// anonymous and file-backed resident memory of the process over the last
+// load, sampled while the buffer is still alive. Their sum is what the load
+// adds to the peak resident size. File-backed pages can be dropped by the
+// kernel under memory pressure, anonymous ones cannot. Other platforms do not
+// report resident memory by kind, so they only report the time.
+static void BM_ImmutableBufferFromFileMapping(benchmark::State& state,
+                                              bool copy) {
+  constexpr size_t kAssetSize = 16 << 20;
+  constexpr size_t kPageSize = 4096;
+  fml::ScopedTemporaryDirectory temp_dir;
+  FML_CHECK(fml::WriteAtomically(
+      temp_dir.fd(), "asset.bin",
+      fml::DataMapping(std::vector<uint8_t>(kAssetSize, 0x42))));
+
+  int64_t anon_bytes = 0;
+  int64_t file_bytes = 0;
+  while (state.KeepRunning()) {
+#if FML_OS_LINUX
+    state.PauseTiming();
+    const ResidentBytes before = ReadResidentBytes();
+    state.ResumeTiming();
+#endif  // FML_OS_LINUX
+
+    std::unique_ptr<fml::Mapping> mapping =
+        fml::FileMapping::CreateReadOnly(temp_dir.fd(), "asset.bin");
+    FML_CHECK(mapping);
+    sk_sp<SkData> data;
+    if (copy) {
+      data = SkData::MakeWithCopy(mapping->GetMapping(), mapping->GetSize());
+    } else {
+      data = ImmutableBuffer::MakeSkDataFromMapping(std::move(mapping));
+    }
+    uint64_t checksum = 0;
+    for (size_t offset = 0; offset < data->size(); offset += kPageSize) {
+      checksum += data->bytes()[offset];
+    }
+    benchmark::DoNotOptimize(checksum);
+
+#if FML_OS_LINUX
+    state.PauseTiming();
+    const ResidentBytes after = ReadResidentBytes();
+    anon_bytes = after.anon - before.anon;
+    file_bytes = after.file - before.file;
+    state.ResumeTiming();
+#endif  // FML_OS_LINUX
+  }
+#if FML_OS_LINUX
+  state.counters["AnonBytes"] = anon_bytes;
+  state.counters["FileBytes"] = file_bytes;
+#endif  // FML_OS_LINUX
+  state.SetBytesProcessed(state.iterations() * kAssetSize);
+}
+
+BENCHMARK_CAPTURE(BM_ImmutableBufferFromFileMapping, Copy, true)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_ImmutableBufferFromFileMapping, Wrap, false)
+    ->Unit(benchmark::kMicrosecond);
+
+// Decodes a fixture image, or the top left quarter of it when |subset| is
+// set, to 1/range(0) of its size the way the Impeller image decoder does.
+// The "OutputBytes" counter is the size of the decoded buffer. Subset decodes
+// with codecs that cannot decode regions directly also allocate an
+// intermediate for the scaled full image, which shows up in the latency.
+static void BM_ImageDecode(benchmark::State& state,
+                           const char* fixture,
+                           bool subset) {
+  ImageGeneratorRegistry registry;
+  std::shared_ptr<ImageGenerator> generator =
+      registry.CreateCompatibleGenerator(
+          testing::OpenFixtureAsSkData(fixture));
+  FML_CHECK(generator);
+  const SkImageInfo info = generator->GetInfo();
+  const SkIRect region =
+      subset ? SkIRect::MakeWH(info.width() / 2, info.height() / 2)
+             : info.bounds();
+  const int64_t divisor = state.range(0);
+  const SkISize target_size =
+      SkISize::Make(std::max<int64_t>(region.width() / divisor, 1),
+                    std::max<int64_t>(region.height() / divisor, 1));
+
+  size_t output_bytes = 0;
+  for (auto _ : state) {
+    SkBitmap bitmap;
+    if (subset) {
+      bitmap.allocPixels(info.makeDimensions(target_size));
+      FML_CHECK(generator->GetSubsetPixels(
+          bitmap.info(), bitmap.getPixels(), bitmap.rowBytes(), region));
+    } else {
+      bitmap.allocPixels(info.makeDimensions(
+          generator->GetScaledDimensions(1.0f / divisor)));
+      FML_CHECK(generator->GetPixels(bitmap.info(), bitmap.getPixels(),
+                                     bitmap.rowBytes()));
+    }
+    output_bytes = bitmap.computeByteSize();
+    benchmark::DoNotOptimize(bitmap.getPixels());
+  }
+  state.counters["OutputBytes"] = output_bytes;
+}
+
+BENCHMARK_CAPTURE(BM_ImageDecode, Jpeg, "DashInNooglerHat.jpg", false)
+    ->RangeMultiplier(2)
+    ->Range(1, 8)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_ImageDecode, JpegSubset, "DashInNooglerHat.jpg", true)
+    ->RangeMultiplier(2)
+    ->Range(1, 8)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_ImageDecode, Png, "Horizontal.png", false)
+    ->RangeMultiplier(2)
+    ->Range(1, 8)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_ImageDecode, PngSubset, "Horizontal.png", true)
+    ->RangeMultiplier(2)
+    ->Range(1, 8)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_ImageDecode, Webp, "hello_loop_2.webp", false)
+    ->RangeMultiplier(2)
+    ->Range(1, 8)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_ImageDecode, WebpSubset, "hello_loop_2.webp", true)
+    ->RangeMultiplier(2)
+    ->Range(1, 8)
+    ->Unit(benchmark::kMicrosecond);
+
+// Registers a family of range(0) font assets and matches one style of it,
+// the way the first paragraph that uses an asset family does at startup.
+// Styles are read from the OS/2 tables of the memory mapped assets, so only
+// the matched font becomes a typeface. The "FamilyBytes" counter is the size
+// of the mapped assets, which are paged in only as far as they are read.
+static void BM_AssetFontFamilyMatch(benchmark::State& state) {
+  const int font_count = state.range(0);
+  sk_sp<SkData> font_data = testing::OpenFixtureAsSkData("Roboto-Medium.ttf");
+  FML_CHECK(font_data);
+  fml::ScopedTemporaryDirectory temp_dir;
+  for (int i = 0; i < font_count; i++) {
+    FML_CHECK(fml::WriteAtomically(
+        temp_dir.fd(), ("font" + std::to_string(i) + ".ttf").c_str(),
+        fml::NonOwnedMapping(font_data->bytes(), font_data->size())));
+  }
+  auto asset_manager = std::make_shared<AssetManager>();
+  asset_manager->PushBack(std::make_unique<DirectoryAssetBundle>(
+      fml::OpenDirectory(temp_dir.path().c_str(), false,
+                         fml::FilePermission::kRead),
+      false));
+
+  while (state.KeepRunning()) {
+    auto font_provider =
+        std::make_unique<AssetManagerFontProvider>(asset_manager);
+    for (int i = 0; i < font_count; i++) {
+      font_provider->RegisterAsset("Family",
+                                   "font" + std::to_string(i) + ".ttf");
+    }
+    auto font_manager =
+        sk_make_sp<txt::AssetFontManager>(std::move(font_provider));
+    sk_sp<SkTypeface> typeface =
+        font_manager->matchFamilyStyle("Family", SkFontStyle::Normal());
+    FML_CHECK(typeface);
+    benchmark::DoNotOptimize(typeface.get());
+  }
+  state.counters["FamilyBytes"] = font_count * font_data->size();
+}
+
+BENCHMARK(BM_AssetFontFamilyMatch)
+    ->RangeMultiplier(4)
+    ->Range(1, 64)
+    ->Unit(benchmark::kMicrosecond);
+
+#if IMPELLER_ENABLE_VULKAN
+// Uploads 100 decoded 16x16 images into device private textures with
+// mipmaps through a Vulkan context backed by a mock driver, either one
+// command buffer per image or all of them in a single batch. The "Submits"
+// counter is the number of queue submissions per 100 images.
+static void BM_ImpellerImageUpload(benchmark::State& state, bool batched) {
+  constexpr size_t kImageCount = 100;
+  const ImageDecoderImpeller::ImageInfo image_info = {
+      .size = impeller::ISize(16, 16),
+      .format = impeller::PixelFormat::kR8G8B8A8UNormInt,
+  };
+  std::shared_ptr<impeller::ContextVK> context =
+      impeller::testing::MockVulkanContextBuilder().Build();
+  FML_CHECK(context);
+  const std::shared_ptr<std::vector<std::string>> called_functions =
+      impeller::testing::GetMockVulkanFunctions(context->GetDevice());
+  auto gpu_disabled_switch = std::make_shared<fml::SyncSwitch>(false);
+  impeller::DeviceBufferDescriptor buffer_descriptor;
+  buffer_descriptor.storage_mode = impeller::StorageMode::kHostVisible;
+  buffer_descriptor.size = image_info.size.Area() * 4;
+
+  size_t uploaded_images = 0;
+  auto on_uploaded = [&uploaded_images](const sk_sp<DlImage>& image,
+                                        const std::string& decode_error) {
+    FML_CHECK(image) << decode_error;
+    uploaded_images++;
+  };
+  for (auto _ : state) {
+    state.PauseTiming();
+    std::vector<ImageDecoderImpeller::PendingUpload> uploads;
+    for (size_t i = 0; i < kImageCount; i++) {
+      uploads.push_back({
+          .result = on_uploaded,
+          .buffer =
+              context->GetResourceAllocator()->CreateBuffer(buffer_descriptor),
+          .image_info = image_info,
+      });
+    }
+    state.ResumeTiming();
+
+    if (batched) {
+      ImageDecoderImpeller::UploadTexturesToPrivate(std::move(uploads), context,
+                                                    gpu_disabled_switch);
+    } else {
+      for (auto& upload : uploads) {
+        ImageDecoderImpeller::UploadTextureToPrivate(
+            std::move(upload.result), context, upload.buffer, image_info,
+            std::nullopt, gpu_disabled_switch);
+      }
+    }
+  }
+  context->Shutdown();
+
+  FML_CHECK(uploaded_images == state.iterations() * kImageCount);
+  const size_t submits = std::count(called_functions->begin(),
+                                    called_functions->end(), "vkQueueSubmit");
+  state.counters["Submits"] =
+      static_cast<double>(submits) / std::max<int64_t>(state.iterations(), 1);
+  state.SetItemsProcessed(state.iterations() * kImageCount);
+}
+
+BENCHMARK_CAPTURE(BM_ImpellerImageUpload, PerImage, false)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_ImpellerImageUpload, Batched, true)
+    ->Unit(benchmark::kMicrosecond);
+#endif  // IMPELLER_ENABLE_VULKAN
+
 }  // namespace flutter
@@ -4,6 +4,7 @@
 
 #include "flutter/lib/ui/window/platform_configuration.h"
 
+#include <cstdlib>
 #include <cstring>
 
 #include "flutter/common/constants.h"
@@ -27,6 +28,43 @@ Dart_Handle ToByteData(const fml::Mapping& buffer) {
   return tonic::DartByteData::Create(buffer.GetMapping(), buffer.GetSize());
 }
 
+void FreeFinalizer(void* isolate_callback_data, void* peer) {
+  free(peer);
+}
+
+void MappingFinalizer(void* isolate_callback_data, void* peer) {
+  delete static_cast<fml::Mapping*>(peer);
+}
+
+// Small messages are copied into the Dart heap. The data of larger messages is
+// handed to Dart instead, which releases it once the ByteData is collected.
+// Data owned by the embedder cannot be modified from Dart.
+Dart_Handle MessageToByteData(PlatformMessage& message) {
+  const size_t size = message.data().GetSize();
+  if (size < tonic::DartByteData::kExternalSizeThreshold) {
+    return ToByteData(message.data());
+  }
+  if (message.hasExternalData()) {
+    std::unique_ptr<fml::Mapping> mapping = message.releaseExternalData();
+    const uint8_t* data = mapping->GetMapping();
+    return Dart_NewUnmodifiableExternalTypedDataWithFinalizer(
+        /*type=*/Dart_TypedData_kByteData,
+        /*data=*/data,
+        /*length=*/size,
+        /*peer=*/mapping.release(),
+        /*external_allocation_size=*/size,
+        /*callback=*/MappingFinalizer);
+  }
+  uint8_t* data = message.releaseData().Release();
+  return Dart_NewExternalTypedDataWithFinalizer(
+      /*type=*/Dart_TypedData_kByteData,
+      /*data=*/data,
+      /*length=*/size,
+      /*peer=*/data,
+      /*external_allocation_size=*/size,
+      /*callback=*/FreeFinalizer);
+}
+
 }  // namespace
 
 PlatformConfigurationClient::~PlatformConfigurationClient() {}
@@ -362,7 +400,7 @@ void PlatformConfiguration::DispatchPlatformMessage(
   }
   tonic::DartState::Scope scope(dart_state);
   Dart_Handle data_handle =
-      (message->hasData()) ? ToByteData(message->data()) : Dart_Null();
+      (message->hasData()) ? MessageToByteData(*message) : Dart_Null();
   if (Dart_IsError(data_handle)) {
     FML_DLOG(WARNING)
         << "Dropping platform message because of a Dart error on channel: "
@@ -15,6 +15,14 @@ PlatformMessage::PlatformMessage(std::string channel,
       data_(std::move(data)),
       has_data_(true),
       response_(std::move(response)) {}
+PlatformMessage::PlatformMessage(std::string channel,
+                                 std::unique_ptr<fml::Mapping> external_data,
+                                 fml::RefPtr<PlatformMessageResponse> response)
+    : channel_(std::move(channel)),
+      data_(),
+      external_data_(std::move(external_data)),
+      has_data_(true),
+      response_(std::move(response)) {}
 PlatformMessage::PlatformMessage(std::string channel,
                                  fml::RefPtr<PlatformMessageResponse> response)
     : channel_(std::move(channel)),
@@ -24,4 +32,20 @@ PlatformMessage::PlatformMessage(std::string channel,
 
 PlatformMessage::~PlatformMessage() = default;
 
+const fml::Mapping& PlatformMessage::data() const {
+  if (external_data_) {
+    return *external_data_;
+  }
+  return data_;
+}
+
+fml::MallocMapping PlatformMessage::releaseData() {
+  if (external_data_) {
+    std::unique_ptr<fml::Mapping> external_data = std::move(external_data_);
+    return fml::MallocMapping::Copy(external_data->GetMapping(),
+                                    external_data->GetSize());
+  }
+  return std::move(data_);
+}
+
 }  // namespace flutter
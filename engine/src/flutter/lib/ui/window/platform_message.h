@@ -5,9 +5,11 @@
 #ifndef FLUTTER_LIB_UI_WINDOW_PLATFORM_MESSAGE_H_
 #define FLUTTER_LIB_UI_WINDOW_PLATFORM_MESSAGE_H_
 
+#include <memory>
 #include <string>
 #include <vector>
 
+#include "flutter/fml/mapping.h"
 #include "flutter/fml/memory/ref_counted.h"
 #include "flutter/fml/memory/ref_ptr.h"
 #include "flutter/lib/ui/window/platform_message_response.h"
@@ -19,23 +21,35 @@ class PlatformMessage {
   PlatformMessage(std::string channel,
                   fml::MallocMapping data,
                   fml::RefPtr<PlatformMessageResponse> response);
+  /// Creates a message whose data is owned by the embedder, which is not
+  /// copied on its way to Dart.
+  PlatformMessage(std::string channel,
+                  std::unique_ptr<fml::Mapping> external_data,
+                  fml::RefPtr<PlatformMessageResponse> response);
   PlatformMessage(std::string channel,
                   fml::RefPtr<PlatformMessageResponse> response);
   ~PlatformMessage();
 
   const std::string& channel() const { return channel_; }
-  const fml::MallocMapping& data() const { return data_; }
+  const fml::Mapping& data() const;
   bool hasData() { return has_data_; }
+  bool hasExternalData() const { return external_data_ != nullptr; }
 
   const fml::RefPtr<PlatformMessageResponse>& response() const {
     return response_;
   }
 
-  fml::MallocMapping releaseData() { return std::move(data_); }
+  /// Removes ownership of the data. External data is copied.
+  fml::MallocMapping releaseData();
+
+  std::unique_ptr<fml::Mapping> releaseExternalData() {
+    return std::move(external_data_);
+  }
 
  private:
   std::string channel_;
   fml::MallocMapping data_;
+  std::unique_ptr<fml::Mapping> external_data_;
   bool has_data_;
   fml::RefPtr<PlatformMessageResponse> response_;
 };
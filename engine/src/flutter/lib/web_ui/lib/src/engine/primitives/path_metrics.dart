@@ -128,6 +128,29 @@ class EnginePathMetric implements ui.PathMetric {
     return EnginePath.extracted(iterator.path, this, start, end, startWithMoveTo: startWithMoveTo);
   }
 
+  /// Extracts the segments of the contour between each pair of distances in
+  /// [intervals] into a single [ui.Path].
+  @override
+  ui.Path extractPathSegments(List<double> intervals, {bool startWithMoveTo = true}) {
+    if (intervals.length.isOdd) {
+      throw ArgumentError('intervals must list a start and an end distance for each segment.');
+    }
+    final result = ui.Path();
+    for (var i = 0; i < intervals.length; i += 2) {
+      final ui.Path segment = extractPath(
+        intervals[i],
+        intervals[i + 1],
+        startWithMoveTo: startWithMoveTo,
+      );
+      if (startWithMoveTo) {
+        result.addPath(segment, ui.Offset.zero);
+      } else {
+        result.extendWithPath(segment, ui.Offset.zero);
+      }
+    }
+    return result;
+  }
+
   /// Builds a backend path segment of this contour from [start] to [end].
   BackendPathBuilder buildExtractedPath(double start, double end, {required bool startWithMoveTo}) {
     return backendMetric.extractPath(start, end, startWithMoveTo: startWithMoveTo);
@@ -683,6 +683,18 @@ abstract class ParagraphBuilder {
   });
 }
 
+Future<void> layoutParagraphs(
+  List<Paragraph> paragraphs,
+  List<ParagraphConstraints> constraints,
+) async {
+  if (paragraphs.length != constraints.length) {
+    throw ArgumentError('paragraphs and constraints must have the same length.');
+  }
+  for (var index = 0; index < paragraphs.length; index += 1) {
+    paragraphs[index].layout(constraints[index]);
+  }
+}
+
 Future<void> loadFontFromList(Uint8List list, {String? fontFamily}) async {
   await engine.renderer.fontCollection.loadFontFromBytes(list, fontFamily: fontFamily);
   await engine.sendFontChangeMessage();
@@ -6,6 +6,7 @@
 
 #include "flutter/common/constants.h"
 #include "flutter/flow/frame_timings.h"
+#include "flutter/fml/make_copyable.h"
 #include "flutter/fml/time/time_point.h"
 #include "flutter/fml/trace_event.h"
 #include "third_party/dart/runtime/include/dart_tools_api.h"
@@ -152,6 +153,12 @@ void Animator::EndFrame() {
     } else {
       delegate_.OnAnimatorDraw(layer_tree_pipeline_);
     }
+  } else {
+    // Without a continuation, the pipeline was full and |BeginFrame| has
+    // requested the frame again.
+    delegate_.OnAnimatorDiscardFrame(
+        frame_timings_recorder_->GetVsyncStartTime(),
+        /*will_retry=*/!producer_continuation_);
   }
   frame_timings_recorder_ = nullptr;
 
@@ -215,6 +222,11 @@ const std::weak_ptr<VsyncWaiter> Animator::GetVsyncWaiter() const {
   return weak;
 }
 
+void Animator::SetFrameSchedulePredictor(
+    std::shared_ptr<FrameSchedulePredictor> predictor) {
+  frame_schedule_predictor_ = std::move(predictor);
+}
+
 bool Animator::CanReuseLastLayerTrees() {
   return !regenerate_layer_trees_;
 }
@@ -278,8 +290,7 @@ void Animator::AwaitVSync() {
           if (self->CanReuseLastLayerTrees()) {
             self->DrawLastLayerTrees(std::move(frame_timings_recorder));
           } else {
-            self->BeginFrame(std::move(frame_timings_recorder));
-            self->EndFrame();
+            self->ScheduleBeginFrame(std::move(frame_timings_recorder));
           }
         }
       });
@@ -288,6 +299,37 @@ void Animator::AwaitVSync() {
   }
 }
 
+void Animator::ScheduleBeginFrame(
+    std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder) {
+  fml::TimeDelta delay;
+  if (frame_schedule_predictor_) {
+    delay = frame_schedule_predictor_->GetBeginFrameDelay(
+        frame_timings_recorder->GetVsyncStartTime(),
+        frame_timings_recorder->GetVsyncTargetTime(), fml::TimePoint::Now());
+  }
+  if (delay <= fml::TimeDelta::Zero()) {
+    BeginFrame(std::move(frame_timings_recorder));
+    EndFrame();
+    return;
+  }
+
+  // The frame request stays pending until BeginFrame, so further calls to
+  // RequestFrame in the meantime are folded into this frame.
+  TRACE_EVENT_INSTANT1("flutter", "Animator::ScheduleBeginFrame", "DelayMicros",
+                       std::to_string(delay.ToMicroseconds()).c_str());
+  task_runners_.GetUITaskRunner()->PostDelayedTask(
+      fml::MakeCopyable(
+          [self = weak_factory_.GetWeakPtr(),
+           recorder = std::move(frame_timings_recorder)]() mutable {
+            if (!self) {
+              return;
+            }
+            self->BeginFrame(std::move(recorder));
+            self->EndFrame();
+          }),
+      delay);
+}
+
 void Animator::OnAllViewsRendered() {
   if (!layer_trees_tasks_.empty()) {
     EndFrame();
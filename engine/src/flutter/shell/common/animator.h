@@ -13,6 +13,7 @@
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/fml/synchronization/semaphore.h"
 #include "flutter/fml/time/time_point.h"
+#include "flutter/shell/common/frame_schedule_predictor.h"
 #include "flutter/shell/common/pipeline.h"
 #include "flutter/shell/common/rasterizer.h"
 #include "flutter/shell/common/vsync_waiter.h"
@@ -43,6 +44,13 @@ class Animator final {
 
     virtual void OnAnimatorDrawLastLayerTrees(
         std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder) = 0;
+
+    // Called when the frame that began at |vsync_start_time| ends without a
+    // layer tree to draw. |will_retry| is set if the frame was not built
+    // because the pipeline was full, in which case it begins again at the
+    // next vsync.
+    virtual void OnAnimatorDiscardFrame(fml::TimePoint vsync_start_time,
+                                        bool will_retry) = 0;
   };
 
   Animator(Delegate& delegate,
@@ -89,6 +97,17 @@ class Animator final {
 
   const std::weak_ptr<VsyncWaiter> GetVsyncWaiter() const;
 
+  //--------------------------------------------------------------------------
+  /// @brief    Enables predictive frame scheduling. At each vsync, the start
+  ///           of the frame is postponed by the delay returned by
+  ///           |FrameSchedulePredictor::GetBeginFrameDelay| so that input
+  ///           events delivered in the meantime are handled by that frame.
+  ///
+  ///           Passing `nullptr` starts frames at vsync again.
+  ///
+  void SetFrameSchedulePredictor(
+      std::shared_ptr<FrameSchedulePredictor> predictor);
+
   //--------------------------------------------------------------------------
   /// @brief    Schedule a secondary callback to be executed right after the
   ///           main `VsyncWaiter::AsyncWaitForVsync` callback (which is added
@@ -128,12 +147,18 @@ class Animator final {
 
   void AwaitVSync();
 
+  // Begins and ends the frame right away, or after the delay predicted by
+  // |frame_schedule_predictor_|.
+  void ScheduleBeginFrame(
+      std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder);
+
   // Clear |trace_flow_ids_| if |frame_scheduled_| is false.
   void ScheduleMaybeClearTraceFlowIds();
 
   Delegate& delegate_;
   TaskRunners task_runners_;
   std::shared_ptr<VsyncWaiter> waiter_;
+  std::shared_ptr<FrameSchedulePredictor> frame_schedule_predictor_;
 
   std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder_;
   std::unordered_map<int64_t, std::unique_ptr<LayerTreeTask>>
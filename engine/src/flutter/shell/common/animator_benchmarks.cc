@@ -0,0 +1,106 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#define FML_USED_ON_EMBEDDER
+
+#include "flutter/shell/common/animator.h"
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/shell/common/thread_host.h"
+#include "flutter/shell/common/vsync_waiters_test.h"
+#include "flutter/testing/post_task_sync.h"
+
+namespace flutter::testing {
+
+namespace {
+
+constexpr fml::TimeDelta kFrameInterval =
+    fml::TimeDelta::FromMicroseconds(16667);
+constexpr fml::TimeDelta kFrameDuration = fml::TimeDelta::FromMilliseconds(4);
+
+class LatencyAnimatorDelegate : public Animator::Delegate {
+ public:
+  void OnAnimatorBeginFrame(fml::TimePoint frame_target_time,
+                            uint64_t frame_number) override {
+    // Input delivered before this point is handled by the frame, so the
+    // time until the frame is displayed is its input latency.
+    latency = frame_target_time - fml::TimePoint::Now();
+    latch.Signal();
+  }
+
+  void OnAnimatorNotifyIdle(fml::TimeDelta deadline) override {}
+
+  void OnAnimatorUpdateLatestFrameTargetTime(
+      fml::TimePoint frame_target_time) override {}
+
+  void OnAnimatorDraw(std::shared_ptr<FramePipeline> pipeline) override {}
+
+  void OnAnimatorDrawLastLayerTrees(
+      std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder) override {}
+
+  void OnAnimatorDiscardFrame(fml::TimePoint vsync_start_time,
+                              bool will_retry) override {}
+
+  fml::AutoResetWaitableEvent latch;
+  fml::TimeDelta latency;
+};
+
+}  // namespace
+
+// Measures the time between the start of a frame and its vsync target time,
+// which bounds the latency of the input events handled by that frame.
+static void BM_AnimatorInputLatency(benchmark::State& state,
+                                    bool predictive_scheduling) {
+  ThreadHost thread_host(
+      "io.flutter.bench.", ThreadHost::Type::kPlatform |
+                               ThreadHost::Type::kRaster |
+                               ThreadHost::Type::kUi | ThreadHost::Type::kIo);
+  TaskRunners task_runners("test",
+                           thread_host.platform_thread->GetTaskRunner(),
+                           thread_host.raster_thread->GetTaskRunner(),
+                           thread_host.ui_thread->GetTaskRunner(),
+                           thread_host.io_thread->GetTaskRunner());
+
+  auto clock = std::make_shared<ShellTestVsyncClock>();
+  LatencyAnimatorDelegate delegate;
+  std::unique_ptr<Animator> animator;
+  PostTaskSync(task_runners.GetUITaskRunner(), [&] {
+    animator = std::make_unique<Animator>(
+        delegate, task_runners,
+        std::make_unique<ShellTestVsyncWaiter>(task_runners, clock,
+                                               kFrameInterval));
+    if (predictive_scheduling) {
+      auto predictor = std::make_shared<FrameSchedulePredictor>();
+      for (size_t i = 0; i < FrameSchedulePredictor::kSampleCount; i++) {
+        predictor->AddFrame(kFrameDuration);
+      }
+      animator->SetFrameSchedulePredictor(predictor);
+    }
+  });
+
+  for (auto _ : state) {
+    task_runners.GetUITaskRunner()->PostTask([&] { animator->RequestFrame(); });
+    fml::AutoResetWaitableEvent ui_latch;
+    task_runners.GetUITaskRunner()->PostTask([&] { ui_latch.Signal(); });
+    do {
+      clock->SimulateVSync();
+    } while (ui_latch.WaitWithTimeout(fml::TimeDelta::FromMilliseconds(1)));
+    delegate.latch.Wait();
+    state.SetIterationTime(delegate.latency.ToSecondsF());
+  }
+
+  PostTaskSync(task_runners.GetUITaskRunner(), [&] { animator.reset(); });
+}
+
+BENCHMARK_CAPTURE(BM_AnimatorInputLatency, VsyncStart, false)
+    ->UseManualTime()
+    ->Iterations(60)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_AnimatorInputLatency, Predictive, true)
+    ->UseManualTime()
+    ->Iterations(60)
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace flutter::testing
@@ -6,6 +6,7 @@
 
 #include "flutter/shell/common/animator.h"
 
+#include <algorithm>
 #include <functional>
 #include <future>
 #include <memory>
@@ -49,6 +50,11 @@ class FakeAnimatorDelegate : public Animator::Delegate {
   void OnAnimatorDrawLastLayerTrees(
       std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder) override {}
 
+  MOCK_METHOD(void,
+              OnAnimatorDiscardFrame,
+              (fml::TimePoint vsync_start_time, bool will_retry),
+              (override));
+
   bool notify_idle_called_ = false;
 };
 
@@ -259,6 +265,118 @@ TEST_F(ShellTest, AnimatorDoesNotNotifyDelegateIfPipelineIsNotEmpty) {
   PostTaskSync(task_runners.GetUITaskRunner(), [&] { animator.reset(); });
 }
 
+TEST_F(ShellTest, AnimatorReportsFramesThatAreNotRendered) {
+  FakeAnimatorDelegate delegate;
+  TaskRunners task_runners = {
+      "test",
+      CreateNewThread(),  // platform
+      CreateNewThread(),  // raster
+      CreateNewThread(),  // ui
+      CreateNewThread()   // io
+  };
+
+  auto clock = std::make_shared<ShellTestVsyncClock>();
+  std::shared_ptr<Animator> animator;
+
+  PostTaskSync(task_runners.GetUITaskRunner(), [&] {
+    auto vsync_waiter = static_cast<std::unique_ptr<VsyncWaiter>>(
+        std::make_unique<ShellTestVsyncWaiter>(task_runners, clock));
+    animator = std::make_unique<Animator>(delegate, task_runners,
+                                          std::move(vsync_waiter));
+  });
+
+  fml::AutoResetWaitableEvent discard_latch;
+  fml::TimePoint discarded_vsync_start;
+  PostTaskSync(task_runners.GetUITaskRunner(), [&] {
+    // The frame begins, but the delegate does not render anything.
+    EXPECT_CALL(delegate, OnAnimatorBeginFrame).Times(1);
+    EXPECT_CALL(delegate, OnAnimatorDraw).Times(0);
+    EXPECT_CALL(delegate,
+                OnAnimatorDiscardFrame(::testing::_, /*will_retry=*/false))
+        .WillOnce([&](fml::TimePoint vsync_start_time, bool will_retry) {
+          discarded_vsync_start = vsync_start_time;
+          discard_latch.Signal();
+        });
+    animator->RequestFrame();
+  });
+  const fml::TimePoint vsync_time = fml::TimePoint::Now();
+  fml::AutoResetWaitableEvent ui_latch;
+  task_runners.GetUITaskRunner()->PostTask([&] { ui_latch.Signal(); });
+  do {
+    clock->SimulateVSync();
+  } while (ui_latch.WaitWithTimeout(fml::TimeDelta::FromMilliseconds(1)));
+  discard_latch.Wait();
+
+  // The discarded frame is identified by the start time of its vsync.
+  EXPECT_GE(discarded_vsync_start, vsync_time);
+
+  PostTaskSync(task_runners.GetUITaskRunner(), [&] { animator.reset(); });
+}
+
+TEST_F(ShellTest, AnimatorPostponesBeginFrameWithFrameSchedulePredictor) {
+  FakeAnimatorDelegate delegate;
+  TaskRunners task_runners = {
+      "test",
+      CreateNewThread(),  // platform
+      CreateNewThread(),  // raster
+      CreateNewThread(),  // ui
+      CreateNewThread()   // io
+  };
+
+  constexpr fml::TimeDelta kFrameInterval =
+      fml::TimeDelta::FromMilliseconds(100);
+  constexpr fml::TimeDelta kFrameDuration =
+      fml::TimeDelta::FromMilliseconds(20);
+  constexpr fml::TimeDelta kSafetyMargin = fml::TimeDelta::FromMilliseconds(2);
+
+  auto clock = std::make_shared<ShellTestVsyncClock>();
+  auto predictor = std::make_shared<FrameSchedulePredictor>(kSafetyMargin);
+  for (size_t i = 0; i < FrameSchedulePredictor::kMinSampleCount; i++) {
+    predictor->AddFrame(kFrameDuration);
+  }
+  std::shared_ptr<Animator> animator;
+
+  PostTaskSync(task_runners.GetUITaskRunner(), [&] {
+    auto vsync_waiter = static_cast<std::unique_ptr<VsyncWaiter>>(
+        std::make_unique<ShellTestVsyncWaiter>(task_runners, clock,
+                                               kFrameInterval));
+    animator = std::make_unique<Animator>(delegate, task_runners,
+                                          std::move(vsync_waiter));
+    animator->SetFrameSchedulePredictor(predictor);
+  });
+
+  fml::AutoResetWaitableEvent begin_frame_latch;
+  fml::TimePoint vsync_time;
+  fml::TimePoint begin_frame_time;
+  fml::TimePoint frame_target_time;
+  PostTaskSync(task_runners.GetUITaskRunner(), [&] {
+    EXPECT_CALL(delegate, OnAnimatorBeginFrame)
+        .WillOnce([&](fml::TimePoint target_time, uint64_t frame_number) {
+          begin_frame_time = fml::TimePoint::Now();
+          frame_target_time = target_time;
+          begin_frame_latch.Signal();
+        });
+    animator->RequestFrame();
+  });
+  // The vsync is fired no earlier than this point.
+  vsync_time = fml::TimePoint::Now();
+  fml::AutoResetWaitableEvent ui_latch;
+  task_runners.GetUITaskRunner()->PostTask([&] { ui_latch.Signal(); });
+  do {
+    clock->SimulateVSync();
+  } while (ui_latch.WaitWithTimeout(fml::TimeDelta::FromMilliseconds(1)));
+  begin_frame_latch.Wait();
+
+  // The frame is started as late as the predicted frame duration allows,
+  // but no later than the middle of the vsync interval.
+  const fml::TimeDelta expected_delay = std::min(
+      kFrameInterval - kFrameDuration - kSafetyMargin, kFrameInterval / 2);
+  EXPECT_GE(begin_frame_time - vsync_time, expected_delay);
+  EXPECT_LE(begin_frame_time, frame_target_time - kFrameDuration);
+
+  PostTaskSync(task_runners.GetUITaskRunner(), [&] { animator.reset(); });
+}
+
 }  // namespace testing
 }  // namespace flutter
 
@@ -294,6 +294,9 @@ Engine::RunStatus Engine::Run(RunConfiguration configuration) {
 }
 
 void Engine::BeginFrame(fml::TimePoint frame_time, uint64_t frame_number) {
+  if (settings_.enable_predictive_frame_scheduling) {
+    pointer_data_dispatcher_->LatchPendingPackets();
+  }
   runtime_controller_->BeginFrame(frame_time, frame_number);
 }
 
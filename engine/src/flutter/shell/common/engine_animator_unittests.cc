@@ -116,6 +116,10 @@ class MockAnimatorDelegate : public Animator::Delegate {
               OnAnimatorDrawLastLayerTrees,
               (std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder),
               (override));
+  MOCK_METHOD(void,
+              OnAnimatorDiscardFrame,
+              (fml::TimePoint vsync_start_time, bool will_retry),
+              (override));
 };
 
 class MockPlatformMessageHandler : public PlatformMessageHandler {
@@ -0,0 +1,52 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/frame_schedule_predictor.h"
+
+#include <algorithm>
+
+namespace flutter {
+
+FrameSchedulePredictor::FrameSchedulePredictor(fml::TimeDelta safety_margin)
+    : safety_margin_(safety_margin) {}
+
+FrameSchedulePredictor::~FrameSchedulePredictor() = default;
+
+void FrameSchedulePredictor::AddFrame(fml::TimeDelta frame_duration) {
+  std::scoped_lock lock(mutex_);
+  samples_[next_sample_] = frame_duration;
+  next_sample_ = (next_sample_ + 1) % kSampleCount;
+  sample_count_ = std::min(sample_count_ + 1, kSampleCount);
+}
+
+fml::TimeDelta FrameSchedulePredictor::GetBeginFrameDelay(
+    fml::TimePoint vsync_start,
+    fml::TimePoint vsync_target,
+    fml::TimePoint now) const {
+  fml::TimeDelta predicted_duration;
+  {
+    std::scoped_lock lock(mutex_);
+    if (sample_count_ < kMinSampleCount) {
+      return fml::TimeDelta::Zero();
+    }
+    predicted_duration = *std::max_element(
+        samples_.begin(), samples_.begin() + sample_count_);
+  }
+
+  const fml::TimePoint latest_start =
+      std::min(vsync_target - predicted_duration - safety_margin_,
+               vsync_start + (vsync_target - vsync_start) / 2);
+  if (latest_start <= now) {
+    return fml::TimeDelta::Zero();
+  }
+  return latest_start - now;
+}
+
+void FrameSchedulePredictor::Reset() {
+  std::scoped_lock lock(mutex_);
+  sample_count_ = 0;
+  next_sample_ = 0;
+}
+
+}  // namespace flutter
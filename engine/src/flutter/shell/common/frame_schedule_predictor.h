@@ -0,0 +1,82 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_FRAME_SCHEDULE_PREDICTOR_H_
+#define FLUTTER_SHELL_COMMON_FRAME_SCHEDULE_PREDICTOR_H_
+
+#include <array>
+#include <mutex>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// Predicts how long the start of a frame can be postponed within its vsync
+/// interval while still rasterizing it before the vsync target time.
+///
+/// Starting the build of a frame as late as possible means that the input
+/// events delivered in the meantime are handled by that frame instead of the
+/// next one, which reduces the input-to-display latency of fast frames.
+///
+/// The prediction is based on the time between the start of the build and the
+/// end of the rasterization of recent frames. The slowest of them is used so
+/// that a single slow frame immediately makes the scheduling more
+/// conservative.
+///
+/// This class is thread safe. Frames are added on the raster thread and the
+/// predictions are made on the UI thread.
+///
+class FrameSchedulePredictor {
+ public:
+  /// The number of recent frames the prediction is based on.
+  static constexpr size_t kSampleCount = 16;
+
+  /// The number of frames that must be added before the start of a frame is
+  /// postponed at all.
+  static constexpr size_t kMinSampleCount = 4;
+
+  /// The default time reserved for scheduling jitter on top of the predicted
+  /// frame duration.
+  static constexpr fml::TimeDelta kDefaultSafetyMargin =
+      fml::TimeDelta::FromMilliseconds(2);
+
+  explicit FrameSchedulePredictor(
+      fml::TimeDelta safety_margin = kDefaultSafetyMargin);
+
+  ~FrameSchedulePredictor();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Adds the time between the start of the build and the end of
+  ///             the rasterization of a frame.
+  ///
+  void AddFrame(fml::TimeDelta frame_duration);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns how long the build of a frame for the given vsync
+  ///             interval should be postponed from |now|. The delay is zero
+  ///             until enough frames have been added, and never postpones the
+  ///             build past the middle of the vsync interval.
+  ///
+  fml::TimeDelta GetBeginFrameDelay(fml::TimePoint vsync_start,
+                                    fml::TimePoint vsync_target,
+                                    fml::TimePoint now) const;
+
+  void Reset();
+
+ private:
+  const fml::TimeDelta safety_margin_;
+  mutable std::mutex mutex_;
+  std::array<fml::TimeDelta, kSampleCount> samples_ = {};
+  size_t sample_count_ = 0;
+  size_t next_sample_ = 0;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(FrameSchedulePredictor);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_FRAME_SCHEDULE_PREDICTOR_H_
@@ -0,0 +1,90 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/frame_schedule_predictor.h"
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+constexpr fml::TimePoint kVsyncStart =
+    fml::TimePoint::FromEpochDelta(fml::TimeDelta::FromSeconds(10));
+constexpr fml::TimePoint kVsyncTarget =
+    kVsyncStart + fml::TimeDelta::FromMicroseconds(16667);
+
+void AddFrames(FrameSchedulePredictor& predictor,
+               fml::TimeDelta duration,
+               size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    predictor.AddFrame(duration);
+  }
+}
+
+}  // namespace
+
+TEST(FrameSchedulePredictorTest, DoesNotDelayWithoutEnoughFrames) {
+  FrameSchedulePredictor predictor;
+  AddFrames(predictor, fml::TimeDelta::FromMilliseconds(1),
+            FrameSchedulePredictor::kMinSampleCount - 1);
+  EXPECT_EQ(predictor.GetBeginFrameDelay(kVsyncStart, kVsyncTarget,
+                                         kVsyncStart),
+            fml::TimeDelta::Zero());
+}
+
+TEST(FrameSchedulePredictorTest, DelaysFastFrames) {
+  FrameSchedulePredictor predictor(fml::TimeDelta::FromMilliseconds(2));
+  AddFrames(predictor, fml::TimeDelta::FromMilliseconds(10),
+            FrameSchedulePredictor::kMinSampleCount);
+  // 16.667ms - 10ms - 2ms.
+  EXPECT_EQ(
+      predictor.GetBeginFrameDelay(kVsyncStart, kVsyncTarget, kVsyncStart),
+      fml::TimeDelta::FromMicroseconds(4667));
+  // The delay is relative to the current time.
+  EXPECT_EQ(predictor.GetBeginFrameDelay(
+                kVsyncStart, kVsyncTarget,
+                kVsyncStart + fml::TimeDelta::FromMilliseconds(1)),
+            fml::TimeDelta::FromMicroseconds(3667));
+}
+
+TEST(FrameSchedulePredictorTest, NeverDelaysPastMiddleOfInterval) {
+  FrameSchedulePredictor predictor(fml::TimeDelta::FromMilliseconds(2));
+  AddFrames(predictor, fml::TimeDelta::FromMilliseconds(1),
+            FrameSchedulePredictor::kSampleCount);
+  EXPECT_EQ(
+      predictor.GetBeginFrameDelay(kVsyncStart, kVsyncTarget, kVsyncStart),
+      (kVsyncTarget - kVsyncStart) / 2);
+}
+
+TEST(FrameSchedulePredictorTest, SlowFrameDisablesDelay) {
+  FrameSchedulePredictor predictor(fml::TimeDelta::FromMilliseconds(2));
+  AddFrames(predictor, fml::TimeDelta::FromMilliseconds(4),
+            FrameSchedulePredictor::kSampleCount);
+  predictor.AddFrame(fml::TimeDelta::FromMilliseconds(20));
+  EXPECT_EQ(
+      predictor.GetBeginFrameDelay(kVsyncStart, kVsyncTarget, kVsyncStart),
+      fml::TimeDelta::Zero());
+
+  // The slow frame is forgotten once enough fast frames have been added.
+  AddFrames(predictor, fml::TimeDelta::FromMilliseconds(4),
+            FrameSchedulePredictor::kSampleCount);
+  EXPECT_GT(
+      predictor.GetBeginFrameDelay(kVsyncStart, kVsyncTarget, kVsyncStart),
+      fml::TimeDelta::Zero());
+}
+
+TEST(FrameSchedulePredictorTest, ResetForgetsFrames) {
+  FrameSchedulePredictor predictor;
+  AddFrames(predictor, fml::TimeDelta::FromMilliseconds(1),
+            FrameSchedulePredictor::kSampleCount);
+  predictor.Reset();
+  EXPECT_EQ(predictor.GetBeginFrameDelay(kVsyncStart, kVsyncTarget,
+                                         kVsyncStart),
+            fml::TimeDelta::Zero());
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -2,6 +2,9 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <map>
+
+#include "flutter/shell/common/pointer_data_dispatcher.h"
 #include "flutter/shell/common/shell_test.h"
 #include "flutter/testing/testing.h"
 
@@ -23,7 +26,35 @@ namespace {
 
 constexpr int64_t kImplicitViewId = 0;
 
-}
+// A dispatcher delegate that records the dispatched packets, and runs the
+// secondary vsync callbacks when told to.
+class RecordingDispatcherDelegate : public PointerDataDispatcher::Delegate {
+ public:
+  void DoDispatchPacket(std::unique_ptr<PointerDataPacket> packet,
+                        uint64_t trace_flow_id) override {
+    packets.push_back(std::move(packet));
+  }
+
+  void ScheduleSecondaryVsyncCallback(uintptr_t id,
+                                      const fml::closure& callback) override {
+    callbacks_[id] = callback;
+  }
+
+  void FireVsync() {
+    std::map<uintptr_t, fml::closure> callbacks;
+    callbacks.swap(callbacks_);
+    for (auto& [id, callback] : callbacks) {
+      callback();
+    }
+  }
+
+  std::vector<std::unique_ptr<PointerDataPacket>> packets;
+
+ private:
+  std::map<uintptr_t, fml::closure> callbacks_;
+};
+
+}  // namespace
 
 //----------------------------------------------------------------------------
 /// Simulate n input events where the i-th one is delivered at delivery_time(i).
@@ -438,6 +469,174 @@ TEST_F(ShellTest, CanCorrectlySynthesizePointerPacket) {
   ASSERT_FALSE(DartVMRef::IsInstanceRunning());
 }
 
+static std::unique_ptr<PointerDataPacket> CreateSimulatedPointerPacket(
+    PointerData::Change change,
+    int64_t device,
+    double dx,
+    double dy) {
+  auto packet = std::make_unique<PointerDataPacket>(1);
+  PointerData data;
+  CreateSimulatedPointerData(data, change, dx, dy);
+  data.device = device;
+  packet->SetPointerData(0, data);
+  return packet;
+}
+
+TEST(CoalescingPointerDataDispatcherTest, MergesPacketsWithinOneFrame) {
+  fml::MessageLoop::EnsureInitializedForCurrentThread();
+  RecordingDispatcherDelegate delegate;
+  CoalescingPointerDataDispatcher dispatcher(delegate);
+
+  // The first packet of a frame is dispatched right away.
+  dispatcher.DispatchPacket(
+      CreateSimulatedPointerPacket(PointerData::Change::kDown, 0, 0.0, 0.0),
+      1);
+  ASSERT_EQ(delegate.packets.size(), 1u);
+
+  // The following ones, of any device, are merged in order until the next
+  // vsync.
+  dispatcher.DispatchPacket(
+      CreateSimulatedPointerPacket(PointerData::Change::kMove, 0, 1.0, 0.0),
+      2);
+  dispatcher.DispatchPacket(
+      CreateSimulatedPointerPacket(PointerData::Change::kHover, 1, 5.0, 5.0),
+      3);
+  dispatcher.DispatchPacket(
+      CreateSimulatedPointerPacket(PointerData::Change::kMove, 0, 2.0, 0.0),
+      4);
+  dispatcher.DispatchPacket(
+      CreateSimulatedPointerPacket(PointerData::Change::kUp, 0, 2.0, 0.0), 5);
+  ASSERT_EQ(delegate.packets.size(), 1u);
+
+  delegate.FireVsync();
+  ASSERT_EQ(delegate.packets.size(), 2u);
+  const PointerDataPacket& packet = *delegate.packets[1];
+  ASSERT_EQ(packet.GetLength(), 4u);
+  EXPECT_EQ(packet.GetPointerData(0).change, PointerData::Change::kMove);
+  EXPECT_EQ(packet.GetPointerData(0).physical_x, 1.0);
+  EXPECT_EQ(packet.GetPointerData(1).change, PointerData::Change::kHover);
+  EXPECT_EQ(packet.GetPointerData(1).device, 1);
+  EXPECT_EQ(packet.GetPointerData(2).change, PointerData::Change::kMove);
+  EXPECT_EQ(packet.GetPointerData(2).physical_x, 2.0);
+  EXPECT_EQ(packet.GetPointerData(3).change, PointerData::Change::kUp);
+
+  // A vsync without pending packets ends the frame, so the next packet is
+  // dispatched right away again.
+  delegate.FireVsync();
+  ASSERT_EQ(delegate.packets.size(), 2u);
+  dispatcher.DispatchPacket(
+      CreateSimulatedPointerPacket(PointerData::Change::kDown, 0, 0.0, 0.0),
+      6);
+  ASSERT_EQ(delegate.packets.size(), 3u);
+}
+
+TEST(CoalescingPointerDataDispatcherTest, LatchesPendingPackets) {
+  fml::MessageLoop::EnsureInitializedForCurrentThread();
+  RecordingDispatcherDelegate delegate;
+  CoalescingPointerDataDispatcher dispatcher(delegate);
+
+  dispatcher.DispatchPacket(
+      CreateSimulatedPointerPacket(PointerData::Change::kHover, 0, 0.0, 0.0),
+      1);
+  dispatcher.LatchPendingPackets();
+  ASSERT_EQ(delegate.packets.size(), 1u);
+
+  dispatcher.DispatchPacket(
+      CreateSimulatedPointerPacket(PointerData::Change::kHover, 0, 1.0, 0.0),
+      2);
+  dispatcher.DispatchPacket(
+      CreateSimulatedPointerPacket(PointerData::Change::kHover, 0, 2.0, 0.0),
+      3);
+  dispatcher.LatchPendingPackets();
+  ASSERT_EQ(delegate.packets.size(), 2u);
+  EXPECT_EQ(delegate.packets[1]->GetLength(), 2u);
+
+  // The latched packets are not dispatched again at vsync.
+  delegate.FireVsync();
+  EXPECT_EQ(delegate.packets.size(), 2u);
+}
+
+TEST_F(ShellTest, CoalescesPointerPacketsWhenEnabled) {
+  // Sets up shell with test fixture.
+  auto settings = CreateSettingsForFixture();
+  settings.enable_pointer_event_coalescing = true;
+  std::unique_ptr<Shell> shell = CreateShell({
+      .settings = settings,
+      .platform_view_create_callback = ShellTestPlatformViewBuilder({
+          .simulate_vsync = true,
+      }),
+  });
+
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  configuration.SetEntrypoint("onPointerDataPacketMain");
+  // Sets up native handler. It is only called on the UI thread.
+  constexpr int kMoveCount = 16;
+  constexpr size_t kEventCount = kMoveCount + 4;
+  fml::AutoResetWaitableEvent reportLatch;
+  int packet_count = 0;
+  std::vector<int64_t> result_sequence;
+  auto nativeOnPointerDataPacket = [&](Dart_Handle sequences) {
+    std::vector<int64_t> sequence =
+        tonic::DartConverter<std::vector<int64_t>>::FromDart(sequences);
+    packet_count += 1;
+    result_sequence.insert(result_sequence.end(), sequence.begin(),
+                           sequence.end());
+    if (result_sequence.size() == kEventCount) {
+      reportLatch.Signal();
+    }
+  };
+  // Starts engine.
+  AddFfiNativeCallback("NativeOnPointerDataPacket",
+                       CREATE_FFI_LAMBDA(nativeOnPointerDataPacket));
+  ASSERT_TRUE(configuration.IsValid());
+  RunEngine(shell.get(), std::move(configuration));
+  // Starts test. Each event is sent in its own packet, as a high rate device
+  // would.
+  ShellTest::DispatchPointerData(
+      shell.get(),
+      CreateSimulatedPointerPacket(PointerData::Change::kAdd, 0, 0.0, 0.0));
+  ShellTest::DispatchPointerData(
+      shell.get(),
+      CreateSimulatedPointerPacket(PointerData::Change::kDown, 0, 0.0, 0.0));
+  for (int i = 1; i <= kMoveCount; i++) {
+    ShellTest::DispatchPointerData(
+        shell.get(),
+        CreateSimulatedPointerPacket(PointerData::Change::kMove, 0, i, 0.0));
+  }
+  ShellTest::DispatchPointerData(
+      shell.get(), CreateSimulatedPointerPacket(PointerData::Change::kUp, 0,
+                                                kMoveCount, 0.0));
+  ShellTest::DispatchPointerData(
+      shell.get(), CreateSimulatedPointerPacket(PointerData::Change::kRemove,
+                                                0, kMoveCount, 0.0));
+  // The merged packet is only dispatched once a vsync has been scheduled for
+  // it, so keep issuing vsyncs until it arrives.
+  do {
+    ShellTest::VSyncFlush(shell.get());
+  } while (reportLatch.WaitWithTimeout(fml::TimeDelta::FromMilliseconds(10)));
+
+  // The first packet is dispatched right away, the others in one packet at
+  // the next vsync.
+  ASSERT_EQ(packet_count, 2);
+  ASSERT_EQ(result_sequence.size(), kEventCount);
+  ASSERT_EQ(PointerData::Change(result_sequence[0]), PointerData::Change::kAdd);
+  ASSERT_EQ(PointerData::Change(result_sequence[1]),
+            PointerData::Change::kDown);
+  for (int i = 0; i < kMoveCount; i++) {
+    ASSERT_EQ(PointerData::Change(result_sequence[2 + i]),
+              PointerData::Change::kMove);
+  }
+  ASSERT_EQ(PointerData::Change(result_sequence[kEventCount - 2]),
+            PointerData::Change::kUp);
+  ASSERT_EQ(PointerData::Change(result_sequence[kEventCount - 1]),
+            PointerData::Change::kRemove);
+
+  // Cleans up shell.
+  ASSERT_TRUE(DartVMRef::IsInstanceRunning());
+  DestroyShell(std::move(shell));
+  ASSERT_FALSE(DartVMRef::IsInstanceRunning());
+}
+
 }  // namespace testing
 }  // namespace flutter
 
@@ -15,6 +15,11 @@ SmoothPointerDataDispatcher::SmoothPointerDataDispatcher(Delegate& delegate)
     : DefaultPointerDataDispatcher(delegate), weak_factory_(this) {}
 SmoothPointerDataDispatcher::~SmoothPointerDataDispatcher() = default;
 
+CoalescingPointerDataDispatcher::CoalescingPointerDataDispatcher(
+    Delegate& delegate)
+    : DefaultPointerDataDispatcher(delegate), weak_factory_(this) {}
+CoalescingPointerDataDispatcher::~CoalescingPointerDataDispatcher() = default;
+
 void DefaultPointerDataDispatcher::DispatchPacket(
     std::unique_ptr<PointerDataPacket> packet,
     uint64_t trace_flow_id) {
@@ -48,6 +53,13 @@ void SmoothPointerDataDispatcher::DispatchPacket(
   ScheduleSecondaryVsyncCallback();
 }
 
+void SmoothPointerDataDispatcher::LatchPendingPackets() {
+  if (pending_packet_ != nullptr) {
+    TRACE_EVENT0("flutter", "SmoothPointerDataDispatcher::LatchPendingPackets");
+    DispatchPendingPacket();
+  }
+}
+
 void SmoothPointerDataDispatcher::ScheduleSecondaryVsyncCallback() {
   delegate_.ScheduleSecondaryVsyncCallback(
       reinterpret_cast<uintptr_t>(this),
@@ -72,4 +84,69 @@ void SmoothPointerDataDispatcher::DispatchPendingPacket() {
   ScheduleSecondaryVsyncCallback();
 }
 
+void CoalescingPointerDataDispatcher::DispatchPacket(
+    std::unique_ptr<PointerDataPacket> packet,
+    uint64_t trace_flow_id) {
+  TRACE_EVENT0_WITH_FLOW_IDS("flutter",
+                             "CoalescingPointerDataDispatcher::DispatchPacket",
+                             /*flow_id_count=*/1, &trace_flow_id);
+  TRACE_FLOW_STEP("flutter", "PointerEvent", trace_flow_id);
+
+  if (is_pointer_data_in_progress_) {
+    const std::vector<uint8_t>& data = packet->data();
+    pending_data_.insert(pending_data_.end(), data.begin(), data.end());
+    pending_trace_flow_ids_.push_back(trace_flow_id);
+  } else {
+    FML_DCHECK(pending_data_.empty());
+    DefaultPointerDataDispatcher::DispatchPacket(std::move(packet),
+                                                 trace_flow_id);
+    is_pointer_data_in_progress_ = true;
+    ScheduleSecondaryVsyncCallback();
+  }
+}
+
+void CoalescingPointerDataDispatcher::LatchPendingPackets() {
+  if (!pending_data_.empty()) {
+    TRACE_EVENT0("flutter",
+                 "CoalescingPointerDataDispatcher::LatchPendingPackets");
+    DispatchPendingPackets();
+  }
+}
+
+void CoalescingPointerDataDispatcher::ScheduleSecondaryVsyncCallback() {
+  delegate_.ScheduleSecondaryVsyncCallback(
+      reinterpret_cast<uintptr_t>(this),
+      [dispatcher = weak_factory_.GetWeakPtr()]() {
+        if (dispatcher && dispatcher->is_pointer_data_in_progress_) {
+          if (!dispatcher->pending_data_.empty()) {
+            dispatcher->DispatchPendingPackets();
+          } else {
+            dispatcher->is_pointer_data_in_progress_ = false;
+          }
+        }
+      });
+}
+
+void CoalescingPointerDataDispatcher::DispatchPendingPackets() {
+  FML_DCHECK(!pending_data_.empty());
+  FML_DCHECK(is_pointer_data_in_progress_);
+  TRACE_EVENT0("flutter",
+               "CoalescingPointerDataDispatcher::DispatchPendingPackets");
+
+  // The merged packet continues the flow of the last packet, the flows of the
+  // others end here.
+  uint64_t trace_flow_id = pending_trace_flow_ids_.back();
+  for (size_t i = 0; i + 1 < pending_trace_flow_ids_.size(); i++) {
+    TRACE_FLOW_END("flutter", "PointerEvent", pending_trace_flow_ids_[i]);
+  }
+
+  auto packet = std::make_unique<PointerDataPacket>(pending_data_.data(),
+                                                    pending_data_.size());
+  pending_data_.clear();
+  pending_trace_flow_ids_.clear();
+  DefaultPointerDataDispatcher::DispatchPacket(std::move(packet),
+                                               trace_flow_id);
+  ScheduleSecondaryVsyncCallback();
+}
+
 }  // namespace flutter
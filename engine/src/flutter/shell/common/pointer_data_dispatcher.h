@@ -74,6 +74,16 @@ class PointerDataDispatcher {
   virtual void DispatchPacket(std::unique_ptr<PointerDataPacket> packet,
                               uint64_t trace_flow_id) = 0;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Signal that a frame is about to be built, so that any packet
+  ///             that is being held back should be dispatched now to be
+  ///             handled by that frame.
+  ///
+  ///             This is only called when predictive frame scheduling is
+  ///             enabled, in which case the frame may start well after the
+  ///             vsync that would otherwise have released the packet.
+  virtual void LatchPendingPackets() {}
+
   //----------------------------------------------------------------------------
   /// @brief      Default destructor.
   virtual ~PointerDataDispatcher();
@@ -145,6 +155,9 @@ class SmoothPointerDataDispatcher : public DefaultPointerDataDispatcher {
   void DispatchPacket(std::unique_ptr<PointerDataPacket> packet,
                       uint64_t trace_flow_id) override;
 
+  // |PointerDataDispatcer|
+  void LatchPendingPackets() override;
+
   virtual ~SmoothPointerDataDispatcher();
 
  private:
@@ -164,6 +177,52 @@ class SmoothPointerDataDispatcher : public DefaultPointerDataDispatcher {
   FML_DISALLOW_COPY_AND_ASSIGN(SmoothPointerDataDispatcher);
 };
 
+//------------------------------------------------------------------------------
+/// A dispatcher that merges the packets received within one VSYNC into a
+/// single packet, so that high rate input devices (1000Hz mice, pen tablets or
+/// touchscreens) cost the UI thread one dispatch per frame rather than one per
+/// event.
+///
+/// The first packet received after a frame is dispatched right away, as in
+/// `SmoothPointerDataDispatcher`. The packets received after it are appended,
+/// in order, to a pending packet which is dispatched at the next VSYNC (or
+/// when `LatchPendingPackets` is called). No pointer data is dropped or
+/// reordered: every move and hover sample of each device is kept, so the
+/// framework can still resample the pointer positions from their history, and
+/// downs and ups stay in order with the moves around them.
+///
+/// This dispatcher is used instead of the one of the `PlatformView` when
+/// `Settings::enable_pointer_event_coalescing` is set.
+class CoalescingPointerDataDispatcher : public DefaultPointerDataDispatcher {
+ public:
+  explicit CoalescingPointerDataDispatcher(Delegate& delegate);
+
+  // |PointerDataDispatcer|
+  void DispatchPacket(std::unique_ptr<PointerDataPacket> packet,
+                      uint64_t trace_flow_id) override;
+
+  // |PointerDataDispatcer|
+  void LatchPendingPackets() override;
+
+  virtual ~CoalescingPointerDataDispatcher();
+
+ private:
+  void DispatchPendingPackets();
+  void ScheduleSecondaryVsyncCallback();
+
+  // The pointer data of the packets received since the last dispatch, in the
+  // format of `PointerDataPacket::data`.
+  std::vector<uint8_t> pending_data_;
+  // The trace flow ids of the packets in `pending_data_`.
+  std::vector<uint64_t> pending_trace_flow_ids_;
+  bool is_pointer_data_in_progress_ = false;
+
+  // WeakPtrFactory must be the last member.
+  fml::TaskRunnerAffineWeakPtrFactory<CoalescingPointerDataDispatcher>
+      weak_factory_;
+  FML_DISALLOW_COPY_AND_ASSIGN(CoalescingPointerDataDispatcher);
+};
+
 //--------------------------------------------------------------------------
 /// @brief      Signature for constructing PointerDataDispatcher.
 ///
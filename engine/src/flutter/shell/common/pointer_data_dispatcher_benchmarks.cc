@@ -0,0 +1,106 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/pointer_data_dispatcher.h"
+
+#include <cstring>
+#include <map>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/message_loop.h"
+
+namespace flutter::testing {
+
+namespace {
+
+// A 1000Hz mouse delivers about 17 events per frame at 60Hz.
+constexpr int kEventsPerFrame = 17;
+
+// A dispatcher delegate that does the work the UI thread does for each packet
+// before the framework handles it: copying its data for the isolate and
+// unpacking each event.
+class BenchmarkDispatcherDelegate : public PointerDataDispatcher::Delegate {
+ public:
+  void DoDispatchPacket(std::unique_ptr<PointerDataPacket> packet,
+                        uint64_t trace_flow_id) override {
+    std::vector<uint8_t> data = packet->data();
+    for (size_t i = 0; i < packet->GetLength(); i++) {
+      PointerData pointer_data;
+      memcpy(&pointer_data, &data[i * sizeof(PointerData)],
+             sizeof(PointerData));
+      benchmark::DoNotOptimize(pointer_data);
+    }
+    packet_count++;
+  }
+
+  void ScheduleSecondaryVsyncCallback(uintptr_t id,
+                                      const fml::closure& callback) override {
+    callbacks_[id] = callback;
+  }
+
+  void FireVsync() {
+    std::map<uintptr_t, fml::closure> callbacks;
+    callbacks.swap(callbacks_);
+    for (auto& [id, callback] : callbacks) {
+      callback();
+    }
+  }
+
+  int64_t packet_count = 0;
+
+ private:
+  std::map<uintptr_t, fml::closure> callbacks_;
+};
+
+std::unique_ptr<PointerDataPacket> CreateMovePacket(int i) {
+  PointerData data;
+  memset(&data, 0, sizeof(data));
+  data.change = PointerData::Change::kMove;
+  data.kind = PointerData::DeviceKind::kMouse;
+  data.physical_x = i;
+  data.physical_delta_x = 1.0;
+  data.buttons = kPointerButtonMousePrimary;
+  auto packet = std::make_unique<PointerDataPacket>(1);
+  packet->SetPointerData(0, data);
+  return packet;
+}
+
+}  // namespace
+
+// Measures the UI thread time spent per frame on the pointer events of a
+// 1000Hz input device, each delivered in its own packet.
+static void BM_DispatchHighRateInput(benchmark::State& state, bool coalesce) {
+  fml::MessageLoop::EnsureInitializedForCurrentThread();
+  BenchmarkDispatcherDelegate delegate;
+  std::unique_ptr<PointerDataDispatcher> dispatcher;
+  if (coalesce) {
+    dispatcher = std::make_unique<CoalescingPointerDataDispatcher>(delegate);
+  } else {
+    dispatcher = std::make_unique<DefaultPointerDataDispatcher>(delegate);
+  }
+
+  uint64_t trace_flow_id = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    std::vector<std::unique_ptr<PointerDataPacket>> packets;
+    for (int i = 0; i < kEventsPerFrame; i++) {
+      packets.push_back(CreateMovePacket(i));
+    }
+    state.ResumeTiming();
+
+    for (auto& packet : packets) {
+      dispatcher->DispatchPacket(std::move(packet), trace_flow_id++);
+    }
+    delegate.FireVsync();
+  }
+  state.counters["PacketsPerFrame"] = benchmark::Counter(
+      static_cast<double>(delegate.packet_count) / state.iterations());
+}
+
+BENCHMARK_CAPTURE(BM_DispatchHighRateInput, Default, false)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DispatchHighRateInput, Coalescing, true)
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace flutter::testing
@@ -135,6 +135,9 @@ void Rasterizer::Teardown() {
   }
 
   view_records_.clear();
+  scene_to_image_flatten_cache_.Clear();
+  deferred_image_flatten_cache_.Clear();
+  screenshot_flatten_cache_.Clear();
 
   if (raster_thread_merger_.get() != nullptr &&
       raster_thread_merger_.get()->IsMerged()) {
@@ -202,6 +205,16 @@ std::shared_ptr<flutter::TextureRegistry> Rasterizer::GetTextureRegistry() {
   return compositor_context_->texture_registry();
 }
 
+LayerFlattenCache* Rasterizer::GetLayerFlattenCache(FlattenCacheUser user) {
+  switch (user) {
+    case FlattenCacheUser::kSceneToImage:
+      return &scene_to_image_flatten_cache_;
+    case FlattenCacheUser::kDeferredImage:
+      return &deferred_image_flatten_cache_;
+  }
+  FML_UNREACHABLE();
+}
+
 GrDirectContext* Rasterizer::GetGrContext() {
   return surface_ ? surface_->GetContext() : nullptr;
 }
@@ -697,8 +710,9 @@ std::unique_ptr<FrameItem> Rasterizer::DrawToSurfacesUnsafe(
     std::unique_ptr<LayerTree> layer_tree = std::move(task->layer_tree);
     float device_pixel_ratio = task->device_pixel_ratio;
 
-    DrawSurfaceStatus status = DrawToSurfaceUnsafe(
-        view_id, *layer_tree, device_pixel_ratio, presentation_time);
+    DrawSurfaceStatus status =
+        DrawToSurfaceUnsafe(frame_timings_recorder, view_id, *layer_tree,
+                            device_pixel_ratio, presentation_time);
     FML_DCHECK(status != DrawSurfaceStatus::kDiscarded);
 
     auto& view_record = EnsureViewRecord(task->view_id);
@@ -715,6 +729,7 @@ std::unique_ptr<FrameItem> Rasterizer::DrawToSurfacesUnsafe(
   // See https://github.com/flutter/flutter/issues/135530, item 4.
   frame_timings_recorder.RecordRasterEnd(
       NOT_SLIMPELLER(&compositor_context_->raster_cache()));
+  frame_timing_stats_->AddFrame(frame_timings_recorder);
 
   FireNextFrameCallbackIfPresent();
 
@@ -736,6 +751,7 @@ std::unique_ptr<FrameItem> Rasterizer::DrawToSurfacesUnsafe(
 
 /// \see Rasterizer::DrawToSurfaces
 DrawSurfaceStatus Rasterizer::DrawToSurfaceUnsafe(
+    FrameTimingsRecorder& frame_timings_recorder,
     int64_t view_id,
     flutter::LayerTree& layer_tree,
     float device_pixel_ratio,
@@ -814,6 +830,11 @@ DrawSurfaceStatus Rasterizer::DrawToSurfaceUnsafe(
                                  ignore_raster_cache,  // ignore raster cache
                                  damage.get()          // frame damage
         );
+    for (size_t i = 0; i < FrameTimingsRecorder::kPhaseCount; i++) {
+      auto phase = static_cast<FrameTimingsRecorder::Phase>(i);
+      frame_timings_recorder.RecordPhaseDuration(
+          phase, compositor_frame->GetPhaseDuration(phase));
+    }
     if (frame_status == RasterStatus::kSkipAndRetry) {
       return DrawSurfaceStatus::kRetry;
     }
@@ -827,6 +848,7 @@ DrawSurfaceStatus Rasterizer::DrawToSurfaceUnsafe(
 
     frame->set_submit_info(submit_info);
 
+    fml::TimePoint submit_start = fml::TimePoint::Now();
     if (external_view_embedder_ &&
         (!raster_thread_merger_ || raster_thread_merger_->IsMerged())) {
       FML_DCHECK(!frame->IsSubmitted());
@@ -836,6 +858,9 @@ DrawSurfaceStatus Rasterizer::DrawToSurfaceUnsafe(
     } else {
       frame->Submit();
     }
+    frame_timings_recorder.RecordPhaseDuration(
+        FrameTimingsRecorder::Phase::kSubmit,
+        fml::TimePoint::Now() - submit_start);
 
 #if !SLIMPELLER
     // Do not update raster cache metrics for kResubmit because that status
@@ -897,12 +922,12 @@ static sk_sp<SkData> ScreenshotLayerTreeAsPicture(
 #endif  //  SLIMPELLER
 }
 
+#if !SLIMPELLER
 static void RenderFrameForScreenshot(
     flutter::CompositorContext& compositor_context,
     DlCanvas* canvas,
     flutter::LayerTree* tree,
-    GrDirectContext* surface_context,
-    const std::shared_ptr<impeller::AiksContext>& aiks_context) {
+    GrDirectContext* surface_context) {
   // There is no root surface transformation for the screenshot layer. Reset
   // the matrix to identity.
   DlMatrix root_surface_transformation;
@@ -915,11 +940,12 @@ static void RenderFrameForScreenshot(
       /*instrumentation_enabled=*/false,
       /*surface_supports_readback=*/true,
       /*raster_thread_merger=*/nullptr,
-      /*aiks_context=*/aiks_context.get());
+      /*aiks_context=*/nullptr);
   canvas->Clear(DlColor::kTransparent());
   frame->Raster(*tree, true, nullptr);
   canvas->Flush();
 }
+#endif  //  !SLIMPELLER
 
 #if IMPELLER_SUPPORTS_RENDERING
 Rasterizer::ScreenshotFormat ToScreenshotFormat(impeller::PixelFormat format) {
@@ -971,19 +997,22 @@ ScreenshotLayerTreeAsImageImpeller(
     const std::shared_ptr<impeller::AiksContext>& aiks_context,
     flutter::LayerTree* tree,
     flutter::CompositorContext& compositor_context,
+    LayerFlattenCache* flatten_cache,
     bool compressed) {
   if (compressed) {
     FML_LOG(ERROR) << "Compressed screenshots not supported for Impeller";
     return {nullptr, Rasterizer::ScreenshotFormat::kUnknown};
   }
 
-  DisplayListBuilder builder(DlRect::MakeSize(tree->frame_size()));
-
-  RenderFrameForScreenshot(compositor_context, &builder, tree, nullptr,
-                           aiks_context);
+  // Periodic screenshots of a mostly static UI only record the subtrees
+  // that changed since the previous screenshot.
+  sk_sp<DisplayList> display_list = tree->Flatten(
+      DlRect::MakeSize(tree->frame_size()),
+      compositor_context.texture_registry(), /*gr_context=*/nullptr,
+      aiks_context.get(), flatten_cache);
 
   std::shared_ptr<impeller::Texture> texture = impeller::DisplayListToTexture(
-      builder.Build(), impeller::ISize(tree->frame_size()), *aiks_context);
+      display_list, impeller::ISize(tree->frame_size()), *aiks_context);
   if (!texture) {
     FML_LOG(ERROR) << "Failed to render to texture";
     return {nullptr, Rasterizer::ScreenshotFormat::kUnknown};
@@ -1032,7 +1061,9 @@ Rasterizer::ScreenshotLayerTreeAsImage(
 #if IMPELLER_SUPPORTS_RENDERING
   if (delegate_.GetSettings().enable_impeller) {
     return ScreenshotLayerTreeAsImageImpeller(GetAiksContext(), tree,
-                                              compositor_context, compressed);
+                                              compositor_context,
+                                              &screenshot_flatten_cache_,
+                                              compressed);
   }
 #endif  // IMPELLER_SUPPORTS_RENDERING
 
@@ -1064,8 +1095,7 @@ Rasterizer::ScreenshotLayerTreeAsImage(
     return {nullptr, ScreenshotFormat::kUnknown};
   }
 
-  RenderFrameForScreenshot(compositor_context, canvas, tree, surface_context,
-                           nullptr);
+  RenderFrameForScreenshot(compositor_context, canvas, tree, surface_context);
 
   return std::make_pair(snapshot_surface->GetRasterData(compressed),
                         ScreenshotFormat::kUnknown);
@@ -1129,6 +1159,8 @@ Rasterizer::Screenshot Rasterizer::ScreenshotLastLayerTree(
     auto b64_data = SkData::MakeUninitialized(b64_size);
     Base64::Encode(data.first->data(), data.first->size(),
                    b64_data->writable_data());
+    // Release the raw data before handing out the encoded copy.
+    data.first.reset();
     return Rasterizer::Screenshot{b64_data, layer_tree->frame_size(), format,
                                   data.second};
   }
@@ -15,7 +15,9 @@
 #include "flutter/display_list/image/dl_image.h"
 #include "flutter/flow/compositor_context.h"
 #include "flutter/flow/embedded_views.h"
+#include "flutter/flow/frame_timing_stats.h"
 #include "flutter/flow/frame_timings.h"
+#include "flutter/flow/layer_flatten_cache.h"
 #include "flutter/flow/layers/layer_tree.h"
 #include "flutter/flow/surface.h"
 #include "flutter/fml/closure.h"
@@ -310,6 +312,9 @@ class Rasterizer final : public SnapshotDelegate,
 
   std::shared_ptr<flutter::TextureRegistry> GetTextureRegistry() override;
 
+  // |SnapshotDelegate|
+  LayerFlattenCache* GetLayerFlattenCache(FlattenCacheUser user) override;
+
   //----------------------------------------------------------------------------
   /// @brief      Takes the next item from the layer tree pipeline and executes
   ///             the raster thread frame workload for that pipeline item to
@@ -517,6 +522,15 @@ class Rasterizer final : public SnapshotDelegate,
     return compositor_context_.get();
   }
 
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the aggregated timings of the frames drawn by this
+  ///             rasterizer. The statistics are thread safe and may be read
+  ///             from any thread. This pointer will never be `nullptr`.
+  ///
+  const std::shared_ptr<FrameTimingStats>& GetFrameTimingStats() const {
+    return frame_timing_stats_;
+  }
+
   //----------------------------------------------------------------------------
   /// @brief      Returns the raster thread merger used by this rasterizer.
   ///             This may be `nullptr`.
@@ -768,9 +782,11 @@ class Rasterizer final : public SnapshotDelegate,
   // Draws the layer tree to the specified view, assuming we have access to the
   // GPU.
   //
-  // This method is not affiliated with the frame timing recorder, but must be
-  // included between the RasterStart and RasterEnd.
+  // This method must be called between the RasterStart and RasterEnd of the
+  // frame timing recorder, and records the duration of each rasterization
+  // phase to it.
   DrawSurfaceStatus DrawToSurfaceUnsafe(
+      FrameTimingsRecorder& frame_timings_recorder,
       int64_t view_id,
       flutter::LayerTree& layer_tree,
       float device_pixel_ratio,
@@ -797,6 +813,11 @@ class Rasterizer final : public SnapshotDelegate,
   fml::RefPtr<fml::RasterThreadMerger> raster_thread_merger_;
   std::shared_ptr<ExternalViewEmbedder> external_view_embedder_;
   std::unique_ptr<SnapshotController> snapshot_controller_;
+  LayerFlattenCache scene_to_image_flatten_cache_;
+  LayerFlattenCache deferred_image_flatten_cache_;
+  LayerFlattenCache screenshot_flatten_cache_;
+  const std::shared_ptr<FrameTimingStats> frame_timing_stats_ =
+      std::make_shared<FrameTimingStats>();
 
   // WeakPtrFactory must be the last member.
   fml::TaskRunnerAffineWeakPtrFactory<Rasterizer> weak_factory_;
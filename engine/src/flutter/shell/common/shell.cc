@@ -394,6 +394,11 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
   // Send dispatcher_maker to the engine constructor because shell won't have
   // platform_view set until Shell::Setup is called later.
   auto dispatcher_maker = platform_view->GetDispatcherMaker();
+  if (settings.enable_pointer_event_coalescing) {
+    dispatcher_maker = [](PointerDataDispatcher::Delegate& delegate) {
+      return std::make_unique<CoalescingPointerDataDispatcher>(delegate);
+    };
+  }
 
   // Create the engine on the UI thread.
   std::promise<std::unique_ptr<Engine>> engine_promise;
@@ -418,6 +423,7 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
         // from the platform.
         auto animator = std::make_unique<Animator>(*shell, task_runners,
                                                    std::move(vsync_waiter));
+        animator->SetFrameSchedulePredictor(shell->frame_schedule_predictor_);
 
         engine_promise.set_value(
             on_create_engine(*shell,                               //
@@ -542,6 +548,10 @@ Shell::Shell(DartVMRef vm,
   FML_DCHECK(task_runners_.IsValid());
   FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
 
+  if (settings_.enable_predictive_frame_scheduling) {
+    frame_schedule_predictor_ = std::make_shared<FrameSchedulePredictor>();
+  }
+
   display_manager_ = std::make_unique<DisplayManager>();
   resource_cache_limit_calculator->AddResourceCacheLimitItem(
       weak_factory_.GetWeakPtr());
@@ -610,6 +620,11 @@ Shell::Shell(DartVMRef vm,
       {task_runners_.GetIOTaskRunner(),
        std::bind(&Shell::OnServiceProtocolGetPipelineUsage, this,
                  std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_
+      [ServiceProtocol::kGetFrameTimingStatsExtensionName] = {
+          task_runners_.GetRasterTaskRunner(),
+          std::bind(&Shell::OnServiceProtocolGetFrameTimingStats, this,
+                    std::placeholders::_1, std::placeholders::_2)};
 }
 
 Shell::~Shell() {
@@ -743,6 +758,25 @@ std::unique_ptr<Shell> Shell::Spawn(
             /*gpu_disabled_switch=*/is_gpu_disabled_sync_switch);
       },
       is_gpu_disabled);
+#if !SLIMPELLER
+  if (settings_.enable_shared_raster_cache) {
+    fml::TaskRunner::RunNowOrPostTask(
+        task_runners_.GetRasterTaskRunner(),
+        [parent = rasterizer_->GetWeakPtr(),
+         spawn = result->rasterizer_->GetWeakPtr()]() {
+          if (!parent || !spawn) {
+            return;
+          }
+          RasterCache& parent_cache =
+              parent->compositor_context()->raster_cache();
+          if (!parent_cache.shared_cache()) {
+            parent_cache.SetSharedCache(std::make_shared<SharedRasterCache>());
+          }
+          spawn->compositor_context()->raster_cache().SetSharedCache(
+              parent_cache.shared_cache());
+        });
+  }
+#endif  //  !SLIMPELLER
   result->RunEngine(std::move(run_configuration));
   return result;
 }
@@ -895,6 +929,7 @@ bool Shell::Setup(std::unique_ptr<PlatformView> platform_view,
   // ptr.
   weak_engine_ = engine_->GetWeakPtr();
   weak_rasterizer_ = rasterizer_->GetWeakPtr();
+  frame_timing_stats_ = rasterizer_->GetFrameTimingStats();
   weak_platform_view_ = platform_view_->GetWeakPtr();
 
   // Add the implicit view with empty metrics.
@@ -947,6 +982,11 @@ fml::TaskRunnerAffineWeakPtr<Rasterizer> Shell::GetRasterizer() const {
   return weak_rasterizer_;
 }
 
+const std::shared_ptr<FrameTimingStats>& Shell::GetFrameTimingStats() const {
+  FML_DCHECK(is_set_up_);
+  return frame_timing_stats_;
+}
+
 fml::TaskRunnerAffineWeakPtr<Engine> Shell::GetEngine() {
   FML_DCHECK(is_set_up_);
   return weak_engine_;
@@ -1468,6 +1508,17 @@ void Shell::OnAnimatorDrawLastLayerTrees(
   task_runners_.GetRasterTaskRunner()->PostTask(task);
 }
 
+// |Animator::Delegate|
+void Shell::OnAnimatorDiscardFrame(fml::TimePoint vsync_start_time,
+                                   bool will_retry) {
+  FML_DCHECK(is_set_up_);
+  FML_DCHECK(task_runners_.GetUITaskRunner()->RunsTasksOnCurrentThread());
+
+  if (settings_.frame_discarded_callback) {
+    settings_.frame_discarded_callback(vsync_start_time, will_retry);
+  }
+}
+
 // |Engine::Delegate|
 void Shell::OnEngineUpdateSemantics(int64_t view_id,
                                     SemanticsNodeUpdates update,
@@ -1775,6 +1826,12 @@ void Shell::OnFrameRasterized(const FrameTiming& timing) {
     settings_.frame_rasterized_callback(timing);
   }
 
+  if (frame_schedule_predictor_) {
+    frame_schedule_predictor_->AddFrame(
+        timing.Get(FrameTiming::kRasterFinish) -
+        timing.Get(FrameTiming::kBuildStart));
+  }
+
   if (!needs_report_timings_) {
     return;
   }
@@ -2149,6 +2206,56 @@ bool Shell::OnServiceProtocolEstimateRasterCacheMemory(
   return true;
 }
 
+bool Shell::OnServiceProtocolGetFrameTimingStats(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetRasterTaskRunner()->RunsTasksOnCurrentThread());
+
+  const auto& stats = rasterizer_->GetFrameTimingStats();
+  const FrameTimingStats::Snapshot snapshot = stats->GetSnapshot();
+  auto found = params.find("reset");
+  if (found != params.end() && found->second == "true") {
+    stats->Reset();
+  }
+
+  auto& allocator = response->GetAllocator();
+  auto percentiles_json = [&allocator](
+                              const FrameTimingStats::Percentiles& value) {
+    rapidjson::Value json(rapidjson::kObjectType);
+    json.AddMember<int64_t>("p50", value.p50.ToMicroseconds(), allocator);
+    json.AddMember<int64_t>("p90", value.p90.ToMicroseconds(), allocator);
+    json.AddMember<int64_t>("p99", value.p99.ToMicroseconds(), allocator);
+    return json;
+  };
+
+  rapidjson::Value missed_phases_json(rapidjson::kObjectType);
+  for (size_t i = 0; i < FrameTimingStats::kAttributionPhaseCount; i++) {
+    rapidjson::Value phase_json(rapidjson::kObjectType);
+    phase_json.AddMember<int64_t>(
+        "timeMicros", snapshot.missed_phase_time[i].ToMicroseconds(),
+        allocator);
+    phase_json.AddMember<uint64_t>("count", snapshot.missed_phase_count[i],
+                                   allocator);
+    missed_phases_json.AddMember(
+        rapidjson::StringRef(FrameTimingStats::GetAttributionPhaseName(i)),
+        phase_json, allocator);
+  }
+
+  response->SetObject();
+  response->AddMember("type", "FrameTimingStats", allocator);
+  response->AddMember<uint64_t>("frameCount", snapshot.frame_count, allocator);
+  response->AddMember<uint64_t>("missedFrameCount",
+                                snapshot.missed_frame_count, allocator);
+  response->AddMember("buildMicros", percentiles_json(snapshot.build),
+                      allocator);
+  response->AddMember("rasterMicros", percentiles_json(snapshot.raster),
+                      allocator);
+  response->AddMember("totalMicros", percentiles_json(snapshot.total),
+                      allocator);
+  response->AddMember("missedFramePhases", missed_phases_json, allocator);
+  return true;
+}
+
 // Service protocol handler
 bool Shell::OnServiceProtocolSetAssetBundlePath(
     const ServiceProtocol::Handler::ServiceProtocolMap& params,
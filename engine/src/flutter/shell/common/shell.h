@@ -256,6 +256,15 @@ class Shell final : public PlatformView::Delegate,
   ///
   fml::TaskRunnerAffineWeakPtr<Rasterizer> GetRasterizer() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      The aggregated timings of the frames rasterized by this
+  ///             shell. Unlike the rasterizer, the statistics may be accessed
+  ///             on any thread.
+  ///
+  /// @return     The frame timing statistics.
+  ///
+  const std::shared_ptr<FrameTimingStats>& GetFrameTimingStats() const;
+
   //------------------------------------------------------------------------------
   /// @brief      Engines may only be accessed on the UI thread. This method is
   ///             deprecated, and implementers should instead use other API
@@ -505,6 +514,10 @@ class Shell final : public PlatformView::Delegate,
       weak_engine_;  // to be shared across threads
   fml::TaskRunnerAffineWeakPtr<Rasterizer>
       weak_rasterizer_;  // to be shared across threads
+  std::shared_ptr<FrameTimingStats>
+      frame_timing_stats_;  // to be shared across threads
+  std::shared_ptr<FrameSchedulePredictor>
+      frame_schedule_predictor_;  // to be shared across threads
   fml::WeakPtr<PlatformView>
       weak_platform_view_;  // to be shared across threads
 
@@ -720,6 +733,10 @@ class Shell final : public PlatformView::Delegate,
   void OnAnimatorDrawLastLayerTrees(
       std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder) override;
 
+  // |Animator::Delegate|
+  void OnAnimatorDiscardFrame(fml::TimePoint vsync_start_time,
+                              bool will_retry) override;
+
   // |Engine::Delegate|
   void OnEngineUpdateSemantics(
       int64_t view_id,
@@ -841,6 +858,15 @@ class Shell final : public PlatformView::Delegate,
       const ServiceProtocol::Handler::ServiceProtocolMap& params,
       rapidjson::Document* response);
 
+  // Service protocol handler
+  //
+  // Reports the frame latency percentiles and the phases that were
+  // responsible for missed frames. The statistics are cleared afterwards if
+  // the "reset" parameter is "true".
+  bool OnServiceProtocolGetFrameTimingStats(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
   // Service protocol handler
   //
   // Forces the FontCollection to reload the font manifest. Used to support
@@ -3442,6 +3442,52 @@ TEST_F(ShellTest, IOManagerIsSharedBetweenParentAndSpawnedShell) {
   DestroyShell(std::move(shell));
 }
 
+#if !SLIMPELLER
+TEST_F(ShellTest, RasterCacheIsSharedBetweenParentAndSpawnedShellWhenEnabled) {
+  auto settings = CreateSettingsForFixture();
+  settings.enable_shared_raster_cache = true;
+  auto shell = CreateShell(settings);
+  ASSERT_TRUE(ValidateShell(shell.get()));
+
+  PostSync(shell->GetTaskRunners().GetPlatformTaskRunner(), [this,
+                                                             &spawner = shell,
+                                                             &settings] {
+    auto second_configuration = RunConfiguration::InferFromSettings(settings);
+    ASSERT_TRUE(second_configuration.IsValid());
+    second_configuration.SetEntrypoint("emptyMain");
+    const std::string initial_route("/foo");
+    MockPlatformViewDelegate platform_view_delegate;
+    auto spawn = spawner->Spawn(
+        std::move(second_configuration), initial_route,
+        [&platform_view_delegate](Shell& shell) {
+          auto result = std::make_unique<MockPlatformView>(
+              platform_view_delegate, shell.GetTaskRunners());
+          ON_CALL(*result, CreateRenderingSurface()).WillByDefault([] {
+            return std::make_unique<MockSurface>();
+          });
+          return result;
+        },
+        [](Shell& shell) { return std::make_unique<Rasterizer>(shell); });
+    ASSERT_TRUE(ValidateShell(spawn.get()));
+
+    PostSync(spawner->GetTaskRunners().GetRasterTaskRunner(),
+             [&spawner, &spawn] {
+               auto& parent_cache = spawner->GetRasterizer()
+                                        ->compositor_context()
+                                        ->raster_cache();
+               auto& spawn_cache =
+                   spawn->GetRasterizer()->compositor_context()->raster_cache();
+               ASSERT_NE(parent_cache.shared_cache(), nullptr);
+               ASSERT_EQ(parent_cache.shared_cache(),
+                         spawn_cache.shared_cache());
+             });
+
+    DestroyShell(std::move(spawn));
+  });
+  DestroyShell(std::move(shell));
+}
+#endif  //  !SLIMPELLER
+
 TEST_F(ShellTest, IOManagerInSpawnedShellIsNotNullAfterParentShellDestroyed) {
   auto settings = CreateSettingsForFixture();
   auto shell = CreateShell(settings);
@@ -109,6 +109,22 @@ DEF_SWITCH(EnableSoftwareRendering,
            "Enable rendering using the Skia software backend. This is useful "
            "when testing Flutter on emulators. By default, Flutter will "
            "attempt to either use OpenGL, Metal, or Vulkan.")
+DEF_SWITCH(EnableSharedRasterCache,
+           "enable-shared-raster-cache",
+           "Share rasterized pictures between the raster caches of an engine "
+           "and the engines spawned from it. Identical content displayed by "
+           "several engines is then only rasterized and stored once.")
+DEF_SWITCH(EnablePredictiveFrameScheduling,
+           "enable-predictive-frame-scheduling",
+           "Start building each frame as late in its vsync interval as the "
+           "duration of recent frames allows, and handle the pointer events "
+           "received until then in that frame. This reduces the input latency "
+           "of frames that are fast to build and rasterize.")
+DEF_SWITCH(EnablePointerEventCoalescing,
+           "enable-pointer-event-coalescing",
+           "Dispatch the pointer events received within one vsync to the "
+           "framework as a single packet. This reduces the UI thread time "
+           "spent on high rate input devices such as 1000Hz mice.")
 DEF_SWITCH(Route,
            "route",
            "Start app with an specific route defined on the framework")
@@ -305,6 +305,15 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line,
   settings.enable_software_rendering =
       command_line.HasOption(FlagForSwitch(Switch::EnableSoftwareRendering));
 
+  settings.enable_shared_raster_cache =
+      command_line.HasOption(FlagForSwitch(Switch::EnableSharedRasterCache));
+
+  settings.enable_predictive_frame_scheduling = command_line.HasOption(
+      FlagForSwitch(Switch::EnablePredictiveFrameScheduling));
+
+  settings.enable_pointer_event_coalescing = command_line.HasOption(
+      FlagForSwitch(Switch::EnablePointerEventCoalescing));
+
   settings.endless_trace_buffer =
       command_line.HasOption(FlagForSwitch(Switch::EndlessTraceBuffer));
 
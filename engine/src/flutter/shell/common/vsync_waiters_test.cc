@@ -51,7 +51,8 @@ void ShellTestVsyncWaiter::AwaitVSync() {
     //
     // For example, HandlesActualIphoneXsInputEvents will fail without this.
     task_runners_.GetPlatformTaskRunner()->PostTask([this]() {
-      FireCallback(fml::TimePoint::Now(), fml::TimePoint::Now());
+      const fml::TimePoint now = fml::TimePoint::Now();
+      FireCallback(now, now + frame_interval_);
     });
   });
 }
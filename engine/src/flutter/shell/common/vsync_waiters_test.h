@@ -32,15 +32,21 @@ class ShellTestVsyncClock {
 
 class ShellTestVsyncWaiter : public VsyncWaiter {
  public:
+  /// Fires a vsync whose target time is |frame_interval| after the time the
+  /// vsync signal was simulated.
   ShellTestVsyncWaiter(const TaskRunners& task_runners,
-                       std::shared_ptr<ShellTestVsyncClock> clock)
-      : VsyncWaiter(task_runners), clock_(std::move(clock)) {}
+                       std::shared_ptr<ShellTestVsyncClock> clock,
+                       fml::TimeDelta frame_interval = fml::TimeDelta::Zero())
+      : VsyncWaiter(task_runners),
+        clock_(std::move(clock)),
+        frame_interval_(frame_interval) {}
 
  protected:
   void AwaitVSync() override;
 
  private:
   std::shared_ptr<ShellTestVsyncClock> clock_;
+  const fml::TimeDelta frame_interval_;
 };
 
 class ConstantFiringVsyncWaiter : public VsyncWaiter {
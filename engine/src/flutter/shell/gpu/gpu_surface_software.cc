@@ -61,6 +61,18 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceSoftware::AcquireFrame(
     return nullptr;
   }
 
+  if (delegate_->SupportsPartialRepaint()) {
+    framebuffer_info.supports_partial_repaint = true;
+    // A backing store that was just created holds no previous frame, so the
+    // whole of it must be rasterized.
+    if (backing_store == last_presented_backing_store_) {
+      framebuffer_info.existing_damage = DlIRect();
+    }
+    // Until this frame is presented, the backing store holds no complete
+    // frame.
+    last_presented_backing_store_ = nullptr;
+  }
+
   // If the surface has been scaled, we need to apply the inverse scaling to the
   // underlying canvas so that coordinates are mapped to the same spot
   // irrespective of surface scaling.
@@ -84,8 +96,18 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceSoftware::AcquireFrame(
         if (!self || !self->IsValid()) {
           return false;
         }
-        return self->delegate_->PresentBackingStore(
-            surface_frame.SkiaSurface());
+        sk_sp<SkSurface> backing_store = surface_frame.SkiaSurface();
+        if (!self->delegate_->SupportsPartialRepaint()) {
+          return self->delegate_->PresentBackingStore(backing_store);
+        }
+        // The backing store is not swapped, so the frame damage is also the
+        // damage of the buffer.
+        if (!self->delegate_->PresentBackingStoreWithDamage(
+                backing_store, surface_frame.submit_info().frame_damage)) {
+          return false;
+        }
+        self->last_presented_backing_store_ = std::move(backing_store);
+        return true;
       };
 
   return std::make_unique<SurfaceFrame>(backing_store, framebuffer_info,
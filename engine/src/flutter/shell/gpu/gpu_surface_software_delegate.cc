@@ -4,8 +4,20 @@
 
 #include "flutter/shell/gpu/gpu_surface_software_delegate.h"
 
+#include <utility>
+
 namespace flutter {
 
 GPUSurfaceSoftwareDelegate::~GPUSurfaceSoftwareDelegate() = default;
 
+bool GPUSurfaceSoftwareDelegate::SupportsPartialRepaint() const {
+  return false;
+}
+
+bool GPUSurfaceSoftwareDelegate::PresentBackingStoreWithDamage(
+    sk_sp<SkSurface> backing_store,
+    const std::optional<DlIRect>& damage) {
+  return PresentBackingStore(std::move(backing_store));
+}
+
 }  // namespace flutter
@@ -5,6 +5,8 @@
 #ifndef FLUTTER_SHELL_GPU_GPU_SURFACE_SOFTWARE_DELEGATE_H_
 #define FLUTTER_SHELL_GPU_GPU_SURFACE_SOFTWARE_DELEGATE_H_
 
+#include <optional>
+
 #include "flutter/flow/embedded_views.h"
 #include "flutter/fml/macros.h"
 #include "third_party/skia/include/core/SkSurface.h"
@@ -48,6 +50,33 @@ class GPUSurfaceSoftwareDelegate {
   ///             the screen.
   ///
   virtual bool PresentBackingStore(sk_sp<SkSurface> backing_store) = 0;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether the backing store returned by `AcquireBackingStore`
+  ///             keeps the contents of the last frame presented from it. If
+  ///             it does, only the region of each frame that changed since
+  ///             that frame is rasterized, and the backing store is presented
+  ///             with `PresentBackingStoreWithDamage`.
+  ///
+  /// @return     Returns false unless overridden.
+  ///
+  virtual bool SupportsPartialRepaint() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Called instead of `PresentBackingStore` when the rasterizer
+  ///             knows which region of the backing store changed.
+  ///
+  /// @param[in]  backing_store  The software backing store to present.
+  /// @param[in]  damage         The region of the backing store that changed
+  ///                            since the last frame presented from it, or
+  ///                            std::nullopt if all of it may have.
+  ///
+  /// @return     Returns if the platform could present the backing store onto
+  ///             the screen. Calls `PresentBackingStore` unless overridden.
+  ///
+  virtual bool PresentBackingStoreWithDamage(
+      sk_sp<SkSurface> backing_store,
+      const std::optional<DlIRect>& damage);
 };
 
 }  // namespace flutter
@@ -83,11 +83,11 @@ void AccessibilityBridge::CommitUpdates() {
   std::vector<std::vector<SemanticsNode>> results;
   while (!pending_semantics_node_updates_.empty()) {
     auto begin = pending_semantics_node_updates_.begin();
-    SemanticsNode target = begin->second;
-    std::vector<SemanticsNode> sub_tree_list;
-    GetSubTreeList(target, sub_tree_list);
-    results.push_back(sub_tree_list);
+    SemanticsNode target = std::move(begin->second);
     pending_semantics_node_updates_.erase(begin);
+    std::vector<SemanticsNode> sub_tree_list;
+    GetSubTreeList(std::move(target), sub_tree_list);
+    results.push_back(std::move(sub_tree_list));
   }
 
   for (size_t i = results.size(); i > 0; i--) {
@@ -267,15 +267,20 @@ AccessibilityBridge::CreateRemoveReparentedNodesUpdate() {
 }
 
 // Private method.
-void AccessibilityBridge::GetSubTreeList(const SemanticsNode& target,
+void AccessibilityBridge::GetSubTreeList(SemanticsNode target,
                                          std::vector<SemanticsNode>& result) {
-  result.push_back(target);
-  for (int32_t child : target.children_in_traversal_order) {
+  // |result| may be reallocated by the recursive calls, so the target is
+  // accessed by index.
+  size_t index = result.size();
+  result.push_back(std::move(target));
+  for (size_t i = 0; i < result[index].children_in_traversal_order.size();
+       i++) {
+    int32_t child = result[index].children_in_traversal_order[i];
     auto iter = pending_semantics_node_updates_.find(child);
     if (iter != pending_semantics_node_updates_.end()) {
-      SemanticsNode node = iter->second;
-      GetSubTreeList(node, result);
+      SemanticsNode node = std::move(iter->second);
       pending_semantics_node_updates_.erase(iter);
+      GetSubTreeList(std::move(node), result);
     }
   }
 }
@@ -303,11 +308,38 @@ void AccessibilityBridge::ConvertFlutterUpdate(const SemanticsNode& node,
       node.transform.skewY, node.transform.scaleY, node.transform.transY, 0,
       node.transform.pers0, node.transform.pers1, node.transform.pers2, 0, 0, 0,
       0, 0);
-  for (auto child : node.children_in_traversal_order) {
-    node_data.child_ids.push_back(child);
-  }
+  node_data.child_ids = node.children_in_traversal_order;
   SetTreeData(node, tree_update);
-  tree_update.nodes.push_back(node_data);
+
+  // The framework also sends nodes that did not change, for example the
+  // siblings of a changed node. Leave these out of the tree update so that
+  // their platform nodes are not touched. Nodes that are being reparented were
+  // removed from the tree by the previous update, so they are always kept.
+  ui::AXNode* existing_node = tree_->GetFromId(node.id);
+  if (existing_node && IsSameNodeData(existing_node->data(), node_data)) {
+    return;
+  }
+  tree_update.nodes.push_back(std::move(node_data));
+}
+
+bool AccessibilityBridge::IsSameNodeData(const ui::AXNodeData& a,
+                                         const ui::AXNodeData& b) {
+  // The offset container of the bounds is set from the parent of the node
+  // once it is in the tree, see OnAtomicUpdateFinished, so it is not compared.
+  const gfx::Transform* a_transform = a.relative_bounds.transform.get();
+  const gfx::Transform* b_transform = b.relative_bounds.transform.get();
+  bool same_transform = a_transform && b_transform
+                            ? *a_transform == *b_transform
+                            : a_transform == b_transform;
+  return a.id == b.id && a.role == b.role && a.state == b.state &&
+         a.actions == b.actions && a.string_attributes == b.string_attributes &&
+         a.int_attributes == b.int_attributes &&
+         a.float_attributes == b.float_attributes &&
+         a.bool_attributes == b.bool_attributes &&
+         a.intlist_attributes == b.intlist_attributes &&
+         a.stringlist_attributes == b.stringlist_attributes &&
+         a.html_attributes == b.html_attributes && a.child_ids == b.child_ids &&
+         a.relative_bounds.bounds == b.relative_bounds.bounds && same_transform;
 }
 
 void AccessibilityBridge::SetRoleFromFlutterUpdate(ui::AXNodeData& node_data,
@@ -209,10 +209,13 @@ class AccessibilityBridge
   // pending_semantics_updates_. Returns std::nullopt if none are reparented.
   std::optional<ui::AXTreeUpdate> CreateRemoveReparentedNodesUpdate();
 
-  void GetSubTreeList(const SemanticsNode& target,
+  void GetSubTreeList(SemanticsNode target,
                       std::vector<SemanticsNode>& result);
+  // Converts |node| and adds it to |tree_update|, unless the tree already
+  // contains the same node.
   void ConvertFlutterUpdate(const SemanticsNode& node,
                             ui::AXTreeUpdate& tree_update);
+  static bool IsSameNodeData(const ui::AXNodeData& a, const ui::AXNodeData& b);
   void SetRoleFromFlutterUpdate(ui::AXNodeData& node_data,
                                 const SemanticsNode& node);
   void SetStateFromFlutterUpdate(ui::AXNodeData& node_data,
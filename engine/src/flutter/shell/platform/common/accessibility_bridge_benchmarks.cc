@@ -0,0 +1,120 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "accessibility_bridge.h"
+
+#include <string>
+#include <vector>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "test_accessibility_bridge.h"
+
+namespace flutter {
+
+namespace {
+
+FlutterSemanticsFlags kEmptyFlags = FlutterSemanticsFlags{};
+
+// The semantics nodes of a data grid: a root with one child per cell.
+class SemanticsGrid {
+ public:
+  explicit SemanticsGrid(int64_t cell_count) {
+    for (int32_t i = 1; i <= cell_count; i++) {
+      children_.push_back(i);
+      labels_.push_back("cell " + std::to_string(i));
+    }
+    nodes_.push_back(CreateNode(0, "grid"));
+    nodes_.back().child_count = children_.size();
+    nodes_.back().children_in_traversal_order = children_.data();
+    for (int32_t i = 1; i <= cell_count; i++) {
+      nodes_.push_back(CreateNode(i, labels_[i - 1].c_str()));
+      nodes_.back().rect = {0, 20.0 * i, 100, 20.0 * (i + 1)};
+    }
+  }
+
+  // Sends all the nodes of the grid to |bridge|.
+  void AddUpdates(AccessibilityBridge& bridge) const {
+    for (const FlutterSemanticsNode2& node : nodes_) {
+      bridge.AddFlutterSemanticsNodeUpdate(node);
+    }
+  }
+
+  // Changes the label of one cell.
+  void ChangeLabel(int32_t id, const char* label) { nodes_[id].label = label; }
+
+ private:
+  static FlutterSemanticsNode2 CreateNode(int32_t id, const char* label) {
+    return {
+        .id = id,
+        // NOLINTNEXTLINE(clang-analyzer-optin.core.EnumCastOutOfRange)
+        .actions = static_cast<FlutterSemanticsAction>(0),
+        .text_selection_base = -1,
+        .text_selection_extent = -1,
+        .label = label,
+        .hint = "",
+        .value = "",
+        .increased_value = "",
+        .decreased_value = "",
+        .transform = {.scaleX = 1, .scaleY = 1, .pers2 = 1},
+        .tooltip = "",
+        .flags2 = &kEmptyFlags,
+    };
+  }
+
+  std::vector<int32_t> children_;
+  std::vector<std::string> labels_;
+  std::vector<FlutterSemanticsNode2> nodes_;
+};
+
+}  // namespace
+
+// Measures building the accessibility tree of a grid from scratch.
+static void BM_AccessibilityBridgeInitialUpdate(benchmark::State& state) {
+  SemanticsGrid grid(state.range(0));
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto bridge = std::make_shared<TestAccessibilityBridge>();
+    state.ResumeTiming();
+
+    grid.AddUpdates(*bridge);
+    bridge->CommitUpdates();
+
+    state.PauseTiming();
+    bridge.reset();
+    state.ResumeTiming();
+  }
+  state.SetComplexityN(state.range(0));
+}
+
+// Measures an update that resends every node of a grid while only one cell
+// changed, as the framework does when the children of a node change.
+static void BM_AccessibilityBridgeOneCellChanged(benchmark::State& state) {
+  SemanticsGrid grid(state.range(0));
+  auto bridge = std::make_shared<TestAccessibilityBridge>();
+  grid.AddUpdates(*bridge);
+  bridge->CommitUpdates();
+
+  bool changed = false;
+  for (auto _ : state) {
+    changed = !changed;
+    grid.ChangeLabel(1, changed ? "changed" : "cell 1");
+    grid.AddUpdates(*bridge);
+    bridge->CommitUpdates();
+    bridge->accessibility_events.clear();
+  }
+  state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK(BM_AccessibilityBridgeInitialUpdate)
+    ->RangeMultiplier(4)
+    ->Range(64, 16384)
+    ->Complexity()
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_AccessibilityBridgeOneCellChanged)
+    ->RangeMultiplier(4)
+    ->Range(64, 16384)
+    ->Complexity()
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace flutter
@@ -652,6 +652,60 @@ TEST(AccessibilityBridgeTest, CanReparentNodeWithChild) {
               Contains(ui::AXEventGenerator::Event::ROLE_CHANGED).Times(1));
 }
 
+// Records the nodes whose data changes in an ui::AXTree.
+class NodeDataChangeRecorder : public ui::AXTreeObserver {
+ public:
+  void OnNodeDataChanged(ui::AXTree* tree,
+                         const ui::AXNodeData& old_node_data,
+                         const ui::AXNodeData& new_node_data) override {
+    changed_ids.push_back(new_node_data.id);
+  }
+
+  std::vector<int32_t> changed_ids;
+};
+
+TEST(AccessibilityBridgeTest, DoesNotUpdateUnchangedNodes) {
+  std::shared_ptr<TestAccessibilityBridge> bridge =
+      std::make_shared<TestAccessibilityBridge>();
+
+  std::vector<int32_t> children{1, 2};
+  FlutterSemanticsNode2 root = CreateSemanticsNode(0, "root", &children);
+  FlutterSemanticsNode2 child1 = CreateSemanticsNode(1, "child 1");
+  FlutterSemanticsNode2 child2 = CreateSemanticsNode(2, "child 2");
+
+  bridge->AddFlutterSemanticsNodeUpdate(root);
+  bridge->AddFlutterSemanticsNodeUpdate(child1);
+  bridge->AddFlutterSemanticsNodeUpdate(child2);
+  bridge->CommitUpdates();
+  bridge->accessibility_events.clear();
+
+  NodeDataChangeRecorder recorder;
+  bridge->GetTree()->AddObserver(&recorder);
+
+  // Send all the nodes again, with only child 2 changed.
+  child2.label = "child 2 changed";
+  bridge->AddFlutterSemanticsNodeUpdate(root);
+  bridge->AddFlutterSemanticsNodeUpdate(child1);
+  bridge->AddFlutterSemanticsNodeUpdate(child2);
+  bridge->CommitUpdates();
+
+  bridge->GetTree()->RemoveObserver(&recorder);
+
+  EXPECT_EQ(recorder.changed_ids, std::vector<int32_t>{2});
+  auto root_node = bridge->GetFlutterPlatformNodeDelegateFromID(0).lock();
+  auto child1_node = bridge->GetFlutterPlatformNodeDelegateFromID(1).lock();
+  auto child2_node = bridge->GetFlutterPlatformNodeDelegateFromID(2).lock();
+  EXPECT_EQ(root_node->GetChildCount(), 2);
+  EXPECT_EQ(root_node->GetName(), "root");
+  EXPECT_EQ(child1_node->GetName(), "child 1");
+  EXPECT_EQ(child2_node->GetName(), "child 2 changed");
+  EXPECT_THAT(bridge->accessibility_events,
+              Contains(ui::AXEventGenerator::Event::NAME_CHANGED));
+
+  // The bounds of the unchanged node are still relative to its parent.
+  EXPECT_EQ(child1_node->GetData().relative_bounds.offset_container_id, 0);
+}
+
 TEST(AccessibilityBridgeTest, AXTreeManagerTest) {
   std::shared_ptr<TestAccessibilityBridge> bridge =
       std::make_shared<TestAccessibilityBridge>();
@@ -16,7 +16,7 @@
 namespace flutter {
 
 // Implementation of ByteStreamReader base on a byte array.
-class ByteBufferStreamReader : public ByteStreamReader {
+class ByteBufferStreamReader final : public ByteStreamReader {
  public:
   // Createa a reader reading from |bytes|, which must have a length of |size|.
   // |bytes| must remain valid for the lifetime of this object.
@@ -62,7 +62,7 @@ class ByteBufferStreamReader : public ByteStreamReader {
 };
 
 // Implementation of ByteStreamWriter based on a byte array.
-class ByteBufferStreamWriter : public ByteStreamWriter {
+class ByteBufferStreamWriter final : public ByteStreamWriter {
  public:
   // Creates a writer that writes into |buffer|.
   // |buffer| must remain valid for the lifetime of this object.
@@ -74,21 +74,19 @@ class ByteBufferStreamWriter : public ByteStreamWriter {
   virtual ~ByteBufferStreamWriter() = default;
 
   // |ByteStreamWriter|
-  void WriteByte(uint8_t byte) { bytes_->push_back(byte); }
+  void WriteByte(uint8_t byte) override { bytes_->push_back(byte); }
 
   // |ByteStreamWriter|
-  void WriteBytes(const uint8_t* bytes, size_t length) {
+  void WriteBytes(const uint8_t* bytes, size_t length) override {
     assert(length > 0);
     bytes_->insert(bytes_->end(), bytes, bytes + length);
   }
 
   // |ByteStreamWriter|
-  void WriteAlignment(uint8_t alignment) {
+  void WriteAlignment(uint8_t alignment) override {
     uint8_t mod = bytes_->size() % alignment;
     if (mod) {
-      for (int i = 0; i < alignment - mod; ++i) {
-        WriteByte(0);
-      }
+      bytes_->resize(bytes_->size() + alignment - mod, 0);
     }
   }
 
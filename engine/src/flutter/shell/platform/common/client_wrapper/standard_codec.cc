@@ -12,6 +12,7 @@
 #include <iostream>
 #include <map>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "byte_buffer_streams.h"
@@ -78,6 +79,83 @@ EncodedType EncodedTypeForValue(const EncodableValue& value) {
   return EncodedType::kNull;
 }
 
+// Returns the number of bytes WriteSize writes for |size|.
+size_t EncodedSizeLength(size_t size) {
+  if (size < 254) {
+    return 1;
+  }
+  return size <= 0xffff ? 3 : 5;
+}
+
+// Returns |position| rounded up to a multiple of |alignment|.
+size_t AlignPosition(size_t position, size_t alignment) {
+  size_t mod = position % alignment;
+  return mod ? position + alignment - mod : position;
+}
+
+// Returns the position following a fixed-type list written at |position|.
+template <typename T>
+size_t EncodedVectorEnd(const std::vector<T>& vector, size_t position) {
+  position += EncodedSizeLength(vector.size());
+  if (vector.empty()) {
+    return position;
+  }
+  return AlignPosition(position, sizeof(T)) + vector.size() * sizeof(T);
+}
+
+// Returns the position following the encoding of |value| written at
+// |position|, which is where alignment padding is computed from.
+//
+// Used to size encoding buffers up front, so that they are allocated once.
+// Custom values are counted as their type byte only, since their encoding is
+// up to the serializer that extends the codec.
+size_t EncodedValueEnd(const EncodableValue& value, size_t position) {
+  // The type discrimination byte.
+  position++;
+  switch (value.index()) {
+    case 2:
+      return position + 4;
+    case 3:
+      return position + 8;
+    case 4:
+      return AlignPosition(position, 8) + 8;
+    case 5: {
+      size_t size = std::get<std::string>(value).size();
+      return position + EncodedSizeLength(size) + size;
+    }
+    case 6:
+      return EncodedVectorEnd(std::get<std::vector<uint8_t>>(value), position);
+    case 7:
+      return EncodedVectorEnd(std::get<std::vector<int32_t>>(value), position);
+    case 8:
+      return EncodedVectorEnd(std::get<std::vector<int64_t>>(value), position);
+    case 9:
+      return EncodedVectorEnd(std::get<std::vector<double>>(value), position);
+    case 10: {
+      const auto& list = std::get<EncodableList>(value);
+      position += EncodedSizeLength(list.size());
+      for (const auto& item : list) {
+        position = EncodedValueEnd(item, position);
+      }
+      return position;
+    }
+    case 11: {
+      const auto& map = std::get<EncodableMap>(value);
+      position += EncodedSizeLength(map.size());
+      for (const auto& pair : map) {
+        position = EncodedValueEnd(pair.first, position);
+        position = EncodedValueEnd(pair.second, position);
+      }
+      return position;
+    }
+    case 13:
+      return EncodedVectorEnd(std::get<std::vector<float>>(value), position);
+    default:
+      // Null and bool are encoded in the type byte.
+      return position;
+  }
+}
+
 }  // namespace
 
 StandardCodecSerializer::StandardCodecSerializer() = default;
@@ -188,7 +266,7 @@ EncodableValue StandardCodecSerializer::ReadValueOfType(
       std::string string_value;
       string_value.resize(size);
       stream->ReadBytes(reinterpret_cast<uint8_t*>(&string_value[0]), size);
-      return EncodableValue(string_value);
+      return EncodableValue(std::move(string_value));
     }
     case EncodedType::kUInt8List:
       return ReadVector<uint8_t>(stream);
@@ -205,7 +283,7 @@ EncodableValue StandardCodecSerializer::ReadValueOfType(
       for (size_t i = 0; i < length; ++i) {
         list_value.push_back(ReadValue(stream));
       }
-      return EncodableValue(list_value);
+      return EncodableValue(std::move(list_value));
     }
     case EncodedType::kMap: {
       size_t length = ReadSize(stream);
@@ -215,7 +293,7 @@ EncodableValue StandardCodecSerializer::ReadValueOfType(
         EncodableValue value = ReadValue(stream);
         map_value.emplace(std::move(key), std::move(value));
       }
-      return EncodableValue(map_value);
+      return EncodableValue(std::move(map_value));
     }
     case EncodedType::kFloat32List: {
       return ReadVector<float>(stream);
@@ -268,11 +346,11 @@ EncodableValue StandardCodecSerializer::ReadVector(
   }
   stream->ReadBytes(reinterpret_cast<uint8_t*>(vector.data()),
                     count * type_size);
-  return EncodableValue(vector);
+  return EncodableValue(std::move(vector));
 }
 
 template <typename T>
-void StandardCodecSerializer::WriteVector(const std::vector<T> vector,
+void StandardCodecSerializer::WriteVector(const std::vector<T>& vector,
                                           ByteStreamWriter* stream) const {
   size_t count = vector.size();
   WriteSize(count, stream);
@@ -330,6 +408,7 @@ std::unique_ptr<std::vector<uint8_t>>
 StandardMessageCodec::EncodeMessageInternal(
     const EncodableValue& message) const {
   auto encoded = std::make_unique<std::vector<uint8_t>>();
+  encoded->reserve(EncodedValueEnd(message, 0));
   ByteBufferStreamWriter stream(encoded.get());
   serializer_->WriteValue(message, &stream);
   return encoded;
@@ -384,9 +463,15 @@ StandardMethodCodec::DecodeMethodCallInternal(const uint8_t* message,
 std::unique_ptr<std::vector<uint8_t>>
 StandardMethodCodec::EncodeMethodCallInternal(
     const MethodCall<EncodableValue>& method_call) const {
+  EncodableValue method_name(method_call.method_name());
+  size_t size = EncodedValueEnd(method_name, 0);
+  size = method_call.arguments()
+             ? EncodedValueEnd(*method_call.arguments(), size)
+             : size + 1;
   auto encoded = std::make_unique<std::vector<uint8_t>>();
+  encoded->reserve(size);
   ByteBufferStreamWriter stream(encoded.get());
-  serializer_->WriteValue(EncodableValue(method_call.method_name()), &stream);
+  serializer_->WriteValue(method_name, &stream);
   if (method_call.arguments()) {
     serializer_->WriteValue(*method_call.arguments(), &stream);
   } else {
@@ -399,6 +484,7 @@ std::unique_ptr<std::vector<uint8_t>>
 StandardMethodCodec::EncodeSuccessEnvelopeInternal(
     const EncodableValue* result) const {
   auto encoded = std::make_unique<std::vector<uint8_t>>();
+  encoded->reserve(result ? EncodedValueEnd(*result, 1) : 2);
   ByteBufferStreamWriter stream(encoded.get());
   stream.WriteByte(0);
   if (result) {
@@ -0,0 +1,101 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/shell/platform/common/client_wrapper/byte_buffer_streams.h"
+#include "flutter/shell/platform/common/client_wrapper/include/flutter/standard_message_codec.h"
+
+namespace flutter {
+
+namespace {
+
+// A batch of sensor readings, as a plugin streaming sensor data sends it.
+EncodableValue CreateSensorBatch() {
+  std::vector<double> values(256);
+  for (size_t i = 0; i < values.size(); i++) {
+    values[i] = i * 0.25;
+  }
+  return EncodableValue(EncodableMap{
+      {EncodableValue("timestamp"), EncodableValue(int64_t{1234567890123})},
+      {EncodableValue("accuracy"), EncodableValue(3)},
+      {EncodableValue("values"), EncodableValue(std::move(values))},
+  });
+}
+
+// The objects detected in a camera frame, as a plugin streaming camera
+// metadata sends them.
+EncodableValue CreateCameraMetadata() {
+  EncodableList objects;
+  for (int32_t i = 0; i < 32; i++) {
+    objects.push_back(EncodableValue(EncodableMap{
+        {EncodableValue("id"), EncodableValue(i)},
+        {EncodableValue("label"),
+         EncodableValue("object_" + std::to_string(i))},
+        {EncodableValue("confidence"), EncodableValue(0.5 + i / 64.0)},
+        {EncodableValue("bounds"),
+         EncodableValue(std::vector<float>{1.0f * i, 2.0f * i, 16.0f, 16.0f})},
+    }));
+  }
+  return EncodableValue(EncodableMap{
+      {EncodableValue("frame"), EncodableValue(int64_t{42})},
+      {EncodableValue("objects"), EncodableValue(std::move(objects))},
+  });
+}
+
+// A thumbnail of a camera frame.
+EncodableValue CreateImage() {
+  return EncodableValue(std::vector<uint8_t>(64 * 1024, 0x7f));
+}
+
+}  // namespace
+
+// Encodes |value| the way the codec did before encoding buffers were sized up
+// front: into a buffer that grows as values are written.
+static void BM_EncodeUnreserved(benchmark::State& state,
+                                EncodableValue (*create_value)()) {
+  const EncodableValue value = create_value();
+  const StandardCodecSerializer& serializer =
+      StandardCodecSerializer::GetInstance();
+  for (auto _ : state) {
+    std::vector<uint8_t> encoded;
+    ByteBufferStreamWriter stream(&encoded);
+    serializer.WriteValue(value, &stream);
+    benchmark::DoNotOptimize(encoded.data());
+  }
+}
+
+static void BM_Encode(benchmark::State& state,
+                      EncodableValue (*create_value)()) {
+  const EncodableValue value = create_value();
+  const StandardMessageCodec& codec = StandardMessageCodec::GetInstance();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(codec.EncodeMessage(value));
+  }
+}
+
+static void BM_Decode(benchmark::State& state,
+                      EncodableValue (*create_value)()) {
+  const StandardMessageCodec& codec = StandardMessageCodec::GetInstance();
+  const auto encoded = codec.EncodeMessage(create_value());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(codec.DecodeMessage(*encoded));
+  }
+  state.SetBytesProcessed(state.iterations() * encoded->size());
+}
+
+BENCHMARK_CAPTURE(BM_EncodeUnreserved, SensorBatch, CreateSensorBatch);
+BENCHMARK_CAPTURE(BM_Encode, SensorBatch, CreateSensorBatch);
+BENCHMARK_CAPTURE(BM_Decode, SensorBatch, CreateSensorBatch);
+BENCHMARK_CAPTURE(BM_EncodeUnreserved, CameraMetadata, CreateCameraMetadata);
+BENCHMARK_CAPTURE(BM_Encode, CameraMetadata, CreateCameraMetadata);
+BENCHMARK_CAPTURE(BM_Decode, CameraMetadata, CreateCameraMetadata);
+BENCHMARK_CAPTURE(BM_EncodeUnreserved, Image, CreateImage);
+BENCHMARK_CAPTURE(BM_Encode, Image, CreateImage);
+BENCHMARK_CAPTURE(BM_Decode, Image, CreateImage);
+
+}  // namespace flutter
@@ -227,6 +227,26 @@ TEST(StandardMessageCodec, CanEncodeAndDecodeFloat64Array) {
   CheckEncodeDecode(value, bytes);
 }
 
+TEST(StandardMessageCodec, CanEncodeAndDecodeLongString) {
+  std::vector<uint8_t> bytes = {0x07, 0xfe, 0x2c, 0x01};
+  bytes.insert(bytes.end(), 300, 0x61);
+  CheckEncodeDecode(EncodableValue(std::string(300, 'a')), bytes);
+}
+
+TEST(StandardMessageCodec, CanEncodeAndDecodeTypedListsInList) {
+  std::vector<uint8_t> bytes = {
+      0x0c, 0x03, 0x07, 0x01, 0x61, 0x0b, 0x01, 0x00, 0x00, 0x00, 0x00,
+      0x00, 0x00, 0x00, 0xf0, 0x3f, 0x09, 0x01, 0x00, 0x00, 0x2a, 0x00,
+      0x00, 0x00,
+  };
+  EncodableValue value(EncodableList{
+      EncodableValue("a"),
+      EncodableValue(std::vector<double>{1.0}),
+      EncodableValue(std::vector<int32_t>{42}),
+  });
+  CheckEncodeDecode(value, bytes);
+}
+
 TEST(StandardMessageCodec, CanEncodeAndDecodeSimpleCustomType) {
   std::vector<uint8_t> bytes = {0x80, 0x09, 0x00, 0x00, 0x00,
                                 0x10, 0x00, 0x00, 0x00};
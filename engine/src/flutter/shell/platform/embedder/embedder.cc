@@ -57,6 +57,7 @@ extern const intptr_t kPlatformStrongDillSize;
 #include "flutter/shell/platform/embedder/embedder.h"
 #include "flutter/shell/platform/embedder/embedder_engine.h"
 #include "flutter/shell/platform/embedder/embedder_external_texture_resolver.h"
+#include "flutter/shell/platform/embedder/embedder_headless_frames.h"
 #include "flutter/shell/platform/embedder/embedder_platform_message_response.h"
 #include "flutter/shell/platform/embedder/embedder_render_target.h"
 #include "flutter/shell/platform/embedder/embedder_render_target_skia.h"
@@ -175,15 +176,22 @@ static bool IsOpenGLRendererConfigValid(const FlutterRendererConfig* config) {
   return true;
 }
 
-static bool IsSoftwareRendererConfigValid(const FlutterRendererConfig* config) {
+static bool IsSoftwareRendererConfigValid(const FlutterRendererConfig* config,
+                                          bool headless) {
   if (config->type != kSoftware) {
     return false;
   }
 
+  // Headless frames are copied into the buffers of their requests instead of
+  // being presented.
+  if (headless) {
+    return true;
+  }
+
   const FlutterSoftwareRendererConfig* software_config = &config->software;
 
-  if (SAFE_ACCESS(software_config, surface_present_callback, nullptr) ==
-      nullptr) {
+  if (!SAFE_EXISTS_ONE_OF(software_config, surface_present_callback,
+                          surface_present_with_damage_callback)) {
     return false;
   }
 
@@ -228,16 +236,22 @@ static bool IsVulkanRendererConfigValid(const FlutterRendererConfig* config) {
   return true;
 }
 
-static bool IsRendererValid(const FlutterRendererConfig* config) {
+static bool IsRendererValid(const FlutterRendererConfig* config,
+                            bool headless) {
   if (config == nullptr) {
     return false;
   }
 
+  // Only the software renderer can render headless frames.
+  if (headless && config->type != kSoftware) {
+    return false;
+  }
+
   switch (config->type) {
     case kOpenGL:
       return IsOpenGLRendererConfigValid(config);
     case kSoftware:
-      return IsSoftwareRendererConfigValid(config);
+      return IsSoftwareRendererConfigValid(config, headless);
     case kMetal:
       return IsMetalRendererConfigValid(config);
     case kVulkan:
@@ -262,7 +276,6 @@ static void* DefaultGLProcResolver(const char* name) {
 }
 #endif  // FML_OS_LINUX || FML_OS_WIN
 
-#ifdef SHELL_ENABLE_GL
 // Auxiliary function used to translate rectangles of type SkIRect to
 // FlutterRect.
 static FlutterRect DlIRectToFlutterRect(const flutter::DlIRect& dl_rect) {
@@ -273,6 +286,7 @@ static FlutterRect DlIRectToFlutterRect(const flutter::DlIRect& dl_rect) {
   return flutter_rect;
 }
 
+#ifdef SHELL_ENABLE_GL
 // Auxiliary function used to translate rectangles of type FlutterRect to
 // SkIRect.
 static const flutter::DlIRect FlutterRectToDlIRect(FlutterRect flutter_rect) {
@@ -786,21 +800,45 @@ InferSoftwarePlatformViewCreationCallback(
     const flutter::PlatformViewEmbedder::PlatformDispatchTable&
         platform_dispatch_table,
     std::unique_ptr<flutter::EmbedderExternalViewEmbedder>
-        external_view_embedder) {
+        external_view_embedder,
+    const std::shared_ptr<flutter::EmbedderHeadlessFrames>& headless_frames) {
   if (config->type != kSoftware) {
     return nullptr;
   }
 
-  auto software_present_backing_store =
-      [ptr = config->software.surface_present_callback, user_data](
-          const void* allocation, size_t row_bytes, size_t height) -> bool {
-    return ptr(user_data, allocation, row_bytes, height);
-  };
+  const FlutterSoftwareRendererConfig* software_config = &config->software;
+
+  auto present_with_damage_callback = SAFE_ACCESS(
+      software_config, surface_present_with_damage_callback, nullptr);
 
   flutter::EmbedderSurfaceSoftware::SoftwareDispatchTable
-      software_dispatch_table = {
-          software_present_backing_store,  // required
-      };
+      software_dispatch_table;
+  if (headless_frames) {
+    software_dispatch_table.software_present_backing_store =
+        [headless_frames](const void* allocation, size_t row_bytes,
+                          size_t height) {
+          return headless_frames->Present(allocation, row_bytes, height);
+        };
+  } else if (auto ptr = present_with_damage_callback) {
+    software_dispatch_table.software_present_backing_store_with_damage =
+        [ptr, user_data](const void* allocation, size_t row_bytes,
+                         size_t height, const flutter::DlIRect& damage) {
+          FlutterRect damage_rect = DlIRectToFlutterRect(damage);
+          FlutterDamage flutter_damage{
+              .struct_size = sizeof(FlutterDamage),
+              .num_rects = 1,
+              .damage = &damage_rect,
+          };
+          return ptr(user_data, allocation, row_bytes, height,
+                     &flutter_damage);
+        };
+  } else {
+    software_dispatch_table.software_present_backing_store =
+        [ptr = software_config->surface_present_callback, user_data](
+            const void* allocation, size_t row_bytes, size_t height) -> bool {
+      return ptr(user_data, allocation, row_bytes, height);
+    };
+  }
 
   return fml::MakeCopyable(
       [software_dispatch_table, platform_dispatch_table,
@@ -825,7 +863,8 @@ InferPlatformViewCreationCallback(
     std::unique_ptr<flutter::EmbedderExternalViewEmbedder>
         external_view_embedder,
     bool enable_impeller,
-    impeller::Flags impeller_flags) {
+    impeller::Flags impeller_flags,
+    const std::shared_ptr<flutter::EmbedderHeadlessFrames>& headless_frames) {
   if (config == nullptr) {
     return nullptr;
   }
@@ -838,7 +877,7 @@ InferPlatformViewCreationCallback(
     case kSoftware:
       return InferSoftwarePlatformViewCreationCallback(
           config, user_data, platform_dispatch_table,
-          std::move(external_view_embedder));
+          std::move(external_view_embedder), headless_frames);
     case kMetal:
       return InferMetalPlatformViewCreationCallback(
           config, user_data, platform_dispatch_table,
@@ -2060,7 +2099,8 @@ FlutterEngineResult FlutterEngineInitialize(size_t version,
                         "should be set null.";
   }
 
-  if (!IsRendererValid(config)) {
+  const bool headless = SAFE_ACCESS(args, enable_headless_rendering, false);
+  if (!IsRendererValid(config, headless)) {
     return LOG_EMBEDDER_ERROR(kInvalidArguments,
                               "The renderer configuration was invalid.");
   }
@@ -2206,8 +2246,37 @@ FlutterEngineResult FlutterEngineInitialize(size_t version,
         };
   }
 
+  std::shared_ptr<flutter::EmbedderHeadlessFrames> headless_frames;
+  if (headless) {
+    if (SAFE_ACCESS(args, compositor, nullptr) != nullptr) {
+      return LOG_EMBEDDER_ERROR(
+          kInvalidArguments,
+          "Headless rendering does not support a custom compositor.");
+    }
+    headless_frames = std::make_shared<flutter::EmbedderHeadlessFrames>();
+    // Headless frames begin as soon as they are requested, there is no vsync
+    // interval to delay them in.
+    settings.enable_predictive_frame_scheduling = false;
+    // Requests are served by the frames begun for them, which are told apart
+    // by the start time of their vsync.
+    settings.frame_rasterized_callback =
+        [headless_frames](const flutter::FrameTiming& timing) {
+          headless_frames->OnFrameRasterized(
+              timing.Get(flutter::FrameTiming::kVsyncStart));
+        };
+    settings.frame_discarded_callback = [headless_frames](
+                                            fml::TimePoint vsync_start_time,
+                                            bool will_retry) {
+      headless_frames->OnFrameDiscarded(vsync_start_time, will_retry);
+    };
+  }
+
   flutter::VsyncWaiterEmbedder::VsyncCallback vsync_callback = nullptr;
-  if (SAFE_ACCESS(args, vsync_callback, nullptr) != nullptr) {
+  if (headless_frames) {
+    vsync_callback = [headless_frames](intptr_t baton) {
+      headless_frames->OnVsyncRequested(baton);
+    };
+  } else if (SAFE_ACCESS(args, vsync_callback, nullptr) != nullptr) {
     vsync_callback = [ptr = args->vsync_callback, user_data](intptr_t baton) {
       return ptr(user_data, baton);
     };
@@ -2323,7 +2392,7 @@ FlutterEngineResult FlutterEngineInitialize(size_t version,
   auto on_create_platform_view = InferPlatformViewCreationCallback(
       config, user_data, platform_dispatch_table,
       std::move(external_view_embedder_result.value()),
-      settings.enable_impeller, impeller_flags);
+      settings.enable_impeller, impeller_flags, headless_frames);
 
   if (!on_create_platform_view) {
     return LOG_EMBEDDER_ERROR(
@@ -2483,13 +2552,14 @@ FlutterEngineResult FlutterEngineInitialize(size_t version,
 
   // Create the engine but don't launch the shell or run the root isolate.
   auto embedder_engine = std::make_unique<flutter::EmbedderEngine>(
-      std::move(thread_host),               //
-      std::move(task_runners),              //
-      std::move(settings),                  //
-      std::move(run_configuration),         //
-      on_create_platform_view,              //
-      on_create_rasterizer,                 //
-      std::move(external_texture_resolver)  //
+      std::move(thread_host),                //
+      std::move(task_runners),               //
+      std::move(settings),                   //
+      std::move(run_configuration),          //
+      on_create_platform_view,               //
+      on_create_rasterizer,                  //
+      std::move(external_texture_resolver),  //
+      std::move(headless_frames)             //
   );
 
   // Release the ownership of the embedder engine to the caller.
@@ -3070,6 +3140,74 @@ FlutterEngineResult FlutterEngineSendPlatformMessage(
                                   "Flutter application.");
 }
 
+// Wraps a buffer whose ownership the embedder transfers to the engine. The
+// buffer is released when the mapping is destroyed.
+static std::unique_ptr<fml::Mapping> CreatePlatformMessageBufferMapping(
+    const FlutterPlatformMessageBuffer* buffer) {
+  VoidCallback release_callback =
+      SAFE_ACCESS(buffer, release_callback, nullptr);
+  void* user_data = SAFE_ACCESS(buffer, user_data, nullptr);
+  fml::NonOwnedMapping::ReleaseProc release_proc;
+  if (release_callback) {
+    release_proc = [release_callback, user_data](const uint8_t* data,
+                                                 size_t size) {
+      release_callback(user_data);
+    };
+  }
+  return std::make_unique<fml::NonOwnedMapping>(
+      SAFE_ACCESS(buffer, data, nullptr), SAFE_ACCESS(buffer, size, 0),
+      release_proc);
+}
+
+FlutterEngineResult FlutterEngineSendPlatformMessageBuffer(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const char* channel,
+    const FlutterPlatformMessageBuffer* buffer,
+    const FlutterPlatformMessageResponseHandle* response_handle) {
+  if (buffer == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid buffer argument.");
+  }
+
+  // Releases the buffer on failure.
+  std::unique_ptr<fml::Mapping> mapping =
+      CreatePlatformMessageBufferMapping(buffer);
+
+  if (engine == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid engine handle.");
+  }
+
+  if (channel == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "Did not specify a valid channel.");
+  }
+
+  if (mapping->GetSize() != 0 && mapping->GetMapping() == nullptr) {
+    return LOG_EMBEDDER_ERROR(
+        kInvalidArguments,
+        "Buffer size was non-zero but the buffer data was nullptr.");
+  }
+
+  fml::RefPtr<flutter::PlatformMessageResponse> response;
+  if (response_handle && response_handle->message) {
+    response = response_handle->message->response();
+  }
+
+  std::unique_ptr<flutter::PlatformMessage> message;
+  if (mapping->GetSize() == 0) {
+    message = std::make_unique<flutter::PlatformMessage>(channel, response);
+  } else {
+    message = std::make_unique<flutter::PlatformMessage>(
+        channel, std::move(mapping), response);
+  }
+
+  return reinterpret_cast<flutter::EmbedderEngine*>(engine)
+                 ->SendPlatformMessage(std::move(message))
+             ? kSuccess
+             : LOG_EMBEDDER_ERROR(kInternalInconsistency,
+                                  "Could not send a message to the running "
+                                  "Flutter application.");
+}
+
 FlutterEngineResult FlutterPlatformMessageCreateResponseHandle(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
     FlutterDataCallback data_callback,
@@ -3147,6 +3285,45 @@ FlutterEngineResult FlutterEngineSendPlatformMessageResponse(
   return kSuccess;
 }
 
+// Note: This can execute on any thread.
+FlutterEngineResult FlutterEngineSendPlatformMessageResponseBuffer(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterPlatformMessageResponseHandle* handle,
+    const FlutterPlatformMessageBuffer* buffer) {
+  if (buffer == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid buffer argument.");
+  }
+
+  // Releases the buffer on failure.
+  std::unique_ptr<fml::Mapping> mapping =
+      CreatePlatformMessageBufferMapping(buffer);
+
+  if (handle == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "Invalid response handle argument.");
+  }
+
+  if (mapping->GetSize() != 0 && mapping->GetMapping() == nullptr) {
+    return LOG_EMBEDDER_ERROR(
+        kInvalidArguments,
+        "Buffer size was non-zero but the buffer data was nullptr.");
+  }
+
+  auto response = handle->message->response();
+
+  if (response) {
+    if (mapping->GetSize() == 0) {
+      response->CompleteEmpty();
+    } else {
+      response->Complete(std::move(mapping));
+    }
+  }
+
+  delete handle;
+
+  return kSuccess;
+}
+
 FlutterEngineResult __FlutterEngineFlushPendingTasksNow() {
   fml::MessageLoop::GetCurrent().RunExpiredTasksNow();
   return kSuccess;
@@ -3738,6 +3915,134 @@ FlutterEngineResult FlutterEngineSetNextFrameCallback(
   return kSuccess;
 }
 
+FlutterEngineResult FlutterEngineGetFrameTimingStats(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    bool reset,
+    FlutterFrameTimingStats* stats) {
+  if (engine == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid engine handle.");
+  }
+
+  if (stats == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "Frame timing stats were null.");
+  }
+
+  if (!STRUCT_HAS_MEMBER(stats, missed_submit_count)) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "The stats struct has invalid size.");
+  }
+
+  auto embedder_engine = reinterpret_cast<flutter::EmbedderEngine*>(engine);
+  if (!embedder_engine->IsValid()) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Engine handle was invalid.");
+  }
+
+  const auto& frame_timing_stats =
+      embedder_engine->GetShell().GetFrameTimingStats();
+  const flutter::FrameTimingStats::Snapshot snapshot =
+      frame_timing_stats->GetSnapshot();
+  if (reset) {
+    frame_timing_stats->Reset();
+  }
+
+  auto percentiles = [](const flutter::FrameTimingStats::Percentiles& value) {
+    return FlutterFrameTimingPercentiles{
+        .struct_size = sizeof(FlutterFrameTimingPercentiles),
+        .p50_us = value.p50.ToMicroseconds(),
+        .p90_us = value.p90.ToMicroseconds(),
+        .p99_us = value.p99.ToMicroseconds(),
+    };
+  };
+  auto missed_time = [&snapshot](flutter::FrameTimingsRecorder::Phase phase) {
+    return snapshot
+        .missed_phase_time[flutter::FrameTimingStats::GetAttributionPhaseIndex(
+            phase)]
+        .ToMicroseconds();
+  };
+  auto missed_count = [&snapshot](flutter::FrameTimingsRecorder::Phase phase) {
+    return snapshot.missed_phase_count
+        [flutter::FrameTimingStats::GetAttributionPhaseIndex(phase)];
+  };
+  using Phase = flutter::FrameTimingsRecorder::Phase;
+
+  stats->frame_count = snapshot.frame_count;
+  stats->missed_frame_count = snapshot.missed_frame_count;
+  stats->build = percentiles(snapshot.build);
+  stats->raster = percentiles(snapshot.raster);
+  stats->total = percentiles(snapshot.total);
+  stats->missed_build_time_us =
+      snapshot.missed_phase_time[flutter::FrameTimingStats::kBuildPhase]
+          .ToMicroseconds();
+  stats->missed_build_count =
+      snapshot.missed_phase_count[flutter::FrameTimingStats::kBuildPhase];
+  stats->missed_diff_time_us = missed_time(Phase::kDiff);
+  stats->missed_diff_count = missed_count(Phase::kDiff);
+  stats->missed_preroll_time_us = missed_time(Phase::kPreroll);
+  stats->missed_preroll_count = missed_count(Phase::kPreroll);
+  stats->missed_raster_cache_time_us = missed_time(Phase::kRasterCache);
+  stats->missed_raster_cache_count = missed_count(Phase::kRasterCache);
+  stats->missed_paint_time_us = missed_time(Phase::kPaint);
+  stats->missed_paint_count = missed_count(Phase::kPaint);
+  stats->missed_submit_time_us = missed_time(Phase::kSubmit);
+  stats->missed_submit_count = missed_count(Phase::kSubmit);
+
+  return kSuccess;
+}
+
+FlutterEngineResult FlutterEngineRenderHeadlessFrames(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterHeadlessFrameRequest* requests,
+    size_t request_count) {
+  if (engine == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid engine handle.");
+  }
+
+  if (requests == nullptr && request_count > 0) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "Headless frame requests were null.");
+  }
+
+  TRACE_EVENT0("flutter", "FlutterEngineRenderHeadlessFrames");
+
+  std::vector<flutter::EmbedderHeadlessFrames::Request> frame_requests;
+  frame_requests.reserve(request_count);
+  for (size_t i = 0; i < request_count; i++) {
+    const FlutterHeadlessFrameRequest* request = &requests[i];
+    if (SAFE_ACCESS(request, buffer, nullptr) == nullptr ||
+        SAFE_ACCESS(request, callback, nullptr) == nullptr) {
+      return LOG_EMBEDDER_ERROR(
+          kInvalidArguments,
+          "Headless frame requests must specify a buffer and a callback.");
+    }
+
+    std::optional<fml::TimePoint> frame_time;
+    if (uint64_t nanos = SAFE_ACCESS(request, frame_time_nanos, 0)) {
+      frame_time = fml::TimePoint::FromEpochDelta(
+          fml::TimeDelta::FromNanoseconds(nanos));
+    }
+    frame_requests.push_back({
+        .frame_time = frame_time,
+        .buffer = request->buffer,
+        .row_bytes = SAFE_ACCESS(request, row_bytes, 0),
+        .height = SAFE_ACCESS(request, height, 0),
+        .callback = [callback = request->callback,
+                     user_data = SAFE_ACCESS(request, user_data, nullptr)](
+                        bool rendered) { callback(rendered, user_data); },
+    });
+  }
+
+  if (!reinterpret_cast<flutter::EmbedderEngine*>(engine)
+           ->RenderHeadlessFrames(std::move(frame_requests))) {
+    return LOG_EMBEDDER_ERROR(
+        kInvalidArguments,
+        "Headless frames can only be rendered by a running engine in "
+        "headless mode.");
+  }
+
+  return kSuccess;
+}
+
 FlutterEngineResult FlutterEngineGetProcAddresses(
     FlutterEngineProcTable* table) {
   if (!table) {
@@ -3794,6 +4099,11 @@ FlutterEngineResult FlutterEngineGetProcAddresses(
   SET_PROC(AddView, FlutterEngineAddView);
   SET_PROC(RemoveView, FlutterEngineRemoveView);
   SET_PROC(SendViewFocusEvent, FlutterEngineSendViewFocusEvent);
+  SET_PROC(GetFrameTimingStats, FlutterEngineGetFrameTimingStats);
+  SET_PROC(RenderHeadlessFrames, FlutterEngineRenderHeadlessFrames);
+  SET_PROC(SendPlatformMessageBuffer, FlutterEngineSendPlatformMessageBuffer);
+  SET_PROC(SendPlatformMessageResponseBuffer,
+           FlutterEngineSendPlatformMessageResponseBuffer);
 #undef SET_PROC
 
   return kSuccess;
@@ -687,6 +687,17 @@ typedef struct {
   FlutterRect* damage;
 } FlutterDamage;
 
+/// Callback for when a software surface is presented with the region of it
+/// that changed.
+///
+/// See: \ref FlutterSoftwareRendererConfig.
+typedef bool (*SoftwareSurfacePresentWithDamageCallback)(
+    void* /* user data */,
+    const void* /* allocation */,
+    size_t /* row bytes */,
+    size_t /* height */,
+    const FlutterDamage* /* damage */);
+
 /// This information is passed to the embedder when requesting a frame buffer
 /// object.
 ///
@@ -1041,7 +1052,25 @@ typedef struct {
   /// to the user. The pixel format of the buffer is the native 32-bit RGBA
   /// format. The buffer is owned by the Flutter engine and must be copied in
   /// this callback if needed.
+  ///
+  /// Specifying one (and only one) of `surface_present_callback` or
+  /// `surface_present_with_damage_callback` is required. Specifying both is an
+  /// error and engine initialization will be terminated.
   SoftwareSurfacePresentCallback surface_present_callback;
+  /// The callback presented to the embedder to present a fully populated buffer
+  /// to the user, along with the region of it that changed since the previous
+  /// present. The buffer has the same format and ownership as the one given to
+  /// `surface_present_callback`.
+  ///
+  /// When this variant is used, the engine keeps the buffer between frames
+  /// while the size of the surface does not change, and only rasterizes the
+  /// region of each frame that changed. Pixels outside of the damage are the
+  /// same as in the previously presented buffer, so an embedder that keeps a
+  /// copy of it only needs to copy the damaged region. The damage contains a
+  /// single rectangle in physical pixels, which is empty if nothing changed and
+  /// covers the whole buffer for the first frame of every size.
+  SoftwareSurfacePresentWithDamageCallback
+      surface_present_with_damage_callback;
 } FlutterSoftwareRendererConfig;
 
 typedef struct {
@@ -1519,6 +1548,24 @@ typedef void (*FlutterDataCallback)(const uint8_t* /* data */,
                                     size_t /* size */,
                                     void* /* user data */);
 
+/// A buffer allocated by the embedder whose ownership is transferred to the
+/// engine. The engine does not copy large buffers: the Dart application reads
+/// them in place, as unmodifiable `ByteData`.
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterPlatformMessageBuffer).
+  size_t struct_size;
+  /// The data of the buffer. It must not be modified or freed until
+  /// `release_callback` is invoked.
+  const uint8_t* data;
+  size_t size;
+  /// Invoked exactly once when the engine no longer needs `data`, including
+  /// when the call the buffer was passed to fails. This may happen on any
+  /// thread, and before that call returns. May be null.
+  VoidCallback release_callback;
+  /// The baton passed to `release_callback`.
+  void* user_data;
+} FlutterPlatformMessageBuffer;
+
 /// The identifier of the platform view. This identifier is specified by the
 /// application when a platform view is added to the scene via the
 /// `SceneBuilder.addPlatformView` call.
@@ -2838,6 +2885,16 @@ typedef struct {
   /// If true, the engine will decode images in wide gamut color spaces
   /// (Display P3) when supported. If false, images are decoded to sRGB.
   bool enable_wide_gamut;
+
+  /// If true, the engine renders frames only when they are requested with
+  /// `FlutterEngineRenderHeadlessFrames`, as fast as it can produce them, and
+  /// copies their pixels into buffers provided with the requests. Frames are
+  /// not paced by vsync: `vsync_callback` is not used.
+  ///
+  /// Headless rendering requires the software renderer and does not support a
+  /// custom compositor. The surface present callbacks of the software renderer
+  /// are not used and may be null.
+  bool enable_headless_rendering;
 } FlutterProjectArgs;
 
 typedef struct {
@@ -2861,6 +2918,87 @@ typedef struct {
   size_t data_length;
 } FlutterSendSemanticsActionInfo;
 
+/// Approximate percentiles of a frame duration, in microseconds.
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterFrameTimingPercentiles).
+  size_t struct_size;
+  int64_t p50_us;
+  int64_t p90_us;
+  int64_t p99_us;
+} FlutterFrameTimingPercentiles;
+
+/// The aggregated timings of the frames rendered by an engine instance.
+///
+/// A frame is missed if its rasterization ended after its vsync target time.
+/// The time spent in each phase of the missed frames is summed up in the
+/// `missed_*_time_us` fields, and the `missed_*_count` fields count the
+/// missed frames in which that phase was the most expensive one.
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterFrameTimingStats).
+  size_t struct_size;
+  /// The number of frames rasterized since the statistics were last reset.
+  uint64_t frame_count;
+  /// The number of frames that missed their vsync target.
+  uint64_t missed_frame_count;
+  /// The duration of the frame build on the UI thread.
+  FlutterFrameTimingPercentiles build;
+  /// The duration of the frame rasterization on the raster thread.
+  FlutterFrameTimingPercentiles raster;
+  /// The time between the vsync that started the frame and the end of its
+  /// rasterization.
+  FlutterFrameTimingPercentiles total;
+  /// Building the frame on the UI thread.
+  int64_t missed_build_time_us;
+  uint64_t missed_build_count;
+  /// Computing the damage of the frame.
+  int64_t missed_diff_time_us;
+  uint64_t missed_diff_count;
+  /// Prerolling the layer tree.
+  int64_t missed_preroll_time_us;
+  uint64_t missed_preroll_count;
+  /// Populating the raster cache.
+  int64_t missed_raster_cache_time_us;
+  uint64_t missed_raster_cache_count;
+  /// Painting the layer tree.
+  int64_t missed_paint_time_us;
+  uint64_t missed_paint_count;
+  /// Submitting the frame to the surface.
+  int64_t missed_submit_time_us;
+  uint64_t missed_submit_count;
+} FlutterFrameTimingStats;
+
+/// The callback invoked when a headless frame was rendered into the buffer of
+/// its request, or failed to be. `rendered` is false if the application did
+/// not render the frame, or if the engine shut down before it was rendered.
+typedef void (*FlutterHeadlessFrameCallback)(bool /* rendered */,
+                                             void* /* user data */);
+
+/// A request for a frame of an engine in headless mode. See
+/// `FlutterProjectArgs.enable_headless_rendering`.
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterHeadlessFrameRequest).
+  size_t struct_size;
+  /// The time of the frame given to the framework, in nanoseconds, on the
+  /// clock of `FlutterEngineGetCurrentTime`. Frames rendered for a given time
+  /// show the animations of the application at that time. Zero renders the
+  /// frame at the time it begins.
+  uint64_t frame_time_nanos;
+  /// The buffer the pixels of the frame are copied into, in the format of the
+  /// allocations passed to `SoftwareSurfacePresentCallback`. It must stay valid
+  /// until `callback` is invoked.
+  void* buffer;
+  /// The number of bytes in each row of `buffer`.
+  size_t row_bytes;
+  /// The number of rows of `buffer`. Rows and columns of the frame that do not
+  /// fit into the buffer are dropped.
+  size_t height;
+  /// Invoked on the raster task runner once the frame has been copied into
+  /// `buffer`.
+  FlutterHeadlessFrameCallback callback;
+  /// The baton passed to `callback`.
+  void* user_data;
+} FlutterHeadlessFrameRequest;
+
 #ifndef FLUTTER_ENGINE_NO_PROTOTYPES
 
 // NOLINTBEGIN(google-objc-function-naming)
@@ -3115,6 +3253,29 @@ FlutterEngineResult FlutterEngineSendPlatformMessage(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
     const FlutterPlatformMessage* message);
 
+//------------------------------------------------------------------------------
+/// @brief      Sends a platform message to the Dart application, transferring
+///             ownership of its data to the engine. Unlike
+///             `FlutterEngineSendPlatformMessage`, the data is not copied.
+///
+/// @param[in]  engine           A running engine instance.
+/// @param[in]  channel          The channel of the message.
+/// @param[in]  buffer           The data of the message. Ownership of the
+///                              buffer is transferred even if the call fails.
+/// @param[in]  response_handle  The handle on which the response is received,
+///                              created by
+///                              `FlutterPlatformMessageCreateResponseHandle`.
+///                              Accepts nullptr.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineSendPlatformMessageBuffer(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const char* channel,
+    const FlutterPlatformMessageBuffer* buffer,
+    const FlutterPlatformMessageResponseHandle* response_handle);
+
 //------------------------------------------------------------------------------
 /// @brief     Creates a platform message response handle that allows the
 ///            embedder to set a native callback for a response to a message.
@@ -3188,6 +3349,26 @@ FlutterEngineResult FlutterEngineSendPlatformMessageResponse(
     const uint8_t* data,
     size_t data_length);
 
+//------------------------------------------------------------------------------
+/// @brief      Send a response from the native side to a platform message from
+///             the Dart Flutter application, transferring ownership of its
+///             data to the engine. Unlike
+///             `FlutterEngineSendPlatformMessageResponse`, the data is not
+///             copied.
+///
+/// @param[in]  engine       The running engine instance.
+/// @param[in]  handle       The platform message response handle.
+/// @param[in]  buffer       The data of the response. Ownership of the buffer
+///                          is transferred even if the call fails.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineSendPlatformMessageResponseBuffer(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterPlatformMessageResponseHandle* handle,
+    const FlutterPlatformMessageBuffer* buffer);
+
 //------------------------------------------------------------------------------
 /// @brief      This API is only meant to be used by platforms that need to
 ///             flush tasks on a message loop not controlled by the Flutter
@@ -3640,6 +3821,50 @@ FlutterEngineResult FlutterEngineSetNextFrameCallback(
     VoidCallback callback,
     void* user_data);
 
+//------------------------------------------------------------------------------
+/// @brief      Gets the aggregated timings of the frames rendered by the
+///             engine, including which phases of the frame pipeline were
+///             responsible for missed frames. This may be called on any
+///             thread.
+///
+/// @param[in]  engine     A running engine instance.
+/// @param[in]  reset      Whether to clear the statistics after reading them.
+/// @param[out] stats      The statistics. The `struct_size` field must be set
+///                        by the caller.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineGetFrameTimingStats(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    bool reset,
+    FlutterFrameTimingStats* stats);
+
+//------------------------------------------------------------------------------
+/// @brief      Requests frames from an engine running in headless mode. See
+///             `FlutterProjectArgs.enable_headless_rendering`.
+///
+///             The requests are served in order, each by the next frame the
+///             engine presents. The next frame begins as soon as the previous
+///             request has been served. If the application has not scheduled
+///             a frame, its last frame is drawn again. If the application
+///             does not render the frame begun for a request, the request
+///             fails.
+///
+///             This must be called from the platform thread.
+///
+/// @param[in]  engine         A running engine instance in headless mode.
+/// @param[in]  requests       The frames to render.
+/// @param[in]  request_count  The number of requests.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineRenderHeadlessFrames(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterHeadlessFrameRequest* requests,
+    size_t request_count);
+
 #endif  // !FLUTTER_ENGINE_NO_PROTOTYPES
 
 // Typedefs for the function pointers in FlutterEngineProcTable.
@@ -3774,6 +3999,24 @@ typedef FlutterEngineResult (*FlutterEngineRemoveViewFnPtr)(
 typedef FlutterEngineResult (*FlutterEngineSendViewFocusEventFnPtr)(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
     const FlutterViewFocusEvent* event);
+typedef FlutterEngineResult (*FlutterEngineGetFrameTimingStatsFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    bool reset,
+    FlutterFrameTimingStats* stats);
+typedef FlutterEngineResult (*FlutterEngineRenderHeadlessFramesFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterHeadlessFrameRequest* requests,
+    size_t request_count);
+typedef FlutterEngineResult (*FlutterEngineSendPlatformMessageBufferFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const char* channel,
+    const FlutterPlatformMessageBuffer* buffer,
+    const FlutterPlatformMessageResponseHandle* response_handle);
+typedef FlutterEngineResult (
+    *FlutterEngineSendPlatformMessageResponseBufferFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterPlatformMessageResponseHandle* handle,
+    const FlutterPlatformMessageBuffer* buffer);
 
 /// Function-pointer-based versions of the APIs above.
 typedef struct {
@@ -3824,6 +4067,11 @@ typedef struct {
   FlutterEngineRemoveViewFnPtr RemoveView;
   FlutterEngineSendViewFocusEventFnPtr SendViewFocusEvent;
   FlutterEngineSendSemanticsActionFnPtr SendSemanticsAction;
+  FlutterEngineGetFrameTimingStatsFnPtr GetFrameTimingStats;
+  FlutterEngineRenderHeadlessFramesFnPtr RenderHeadlessFrames;
+  FlutterEngineSendPlatformMessageBufferFnPtr SendPlatformMessageBuffer;
+  FlutterEngineSendPlatformMessageResponseBufferFnPtr
+      SendPlatformMessageResponseBuffer;
 } FlutterEngineProcTable;
 
 //------------------------------------------------------------------------------
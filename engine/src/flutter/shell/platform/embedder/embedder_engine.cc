@@ -28,14 +28,16 @@ EmbedderEngine::EmbedderEngine(
     RunConfiguration run_configuration,
     const Shell::CreateCallback<PlatformView>& on_create_platform_view,
     const Shell::CreateCallback<Rasterizer>& on_create_rasterizer,
-    std::unique_ptr<EmbedderExternalTextureResolver> external_texture_resolver)
+    std::unique_ptr<EmbedderExternalTextureResolver> external_texture_resolver,
+    std::shared_ptr<EmbedderHeadlessFrames> headless_frames)
     : thread_host_(std::move(thread_host)),
       task_runners_(task_runners),
       run_configuration_(std::move(run_configuration)),
       shell_args_(std::make_unique<ShellArgs>(settings,
                                               on_create_platform_view,
                                               on_create_rasterizer)),
-      external_texture_resolver_(std::move(external_texture_resolver)) {}
+      external_texture_resolver_(std::move(external_texture_resolver)),
+      headless_frames_(std::move(headless_frames)) {}
 
 EmbedderEngine::~EmbedderEngine() = default;
 
@@ -57,6 +59,10 @@ bool EmbedderEngine::LaunchShell() {
   // shell again.
   shell_args_.reset();
 
+  if (headless_frames_ && IsValid()) {
+    headless_frames_->Attach(task_runners_, shell_->GetEngine());
+  }
+
   return IsValid();
 }
 
@@ -344,6 +350,16 @@ bool EmbedderEngine::ScheduleFrame() {
   return true;
 }
 
+bool EmbedderEngine::RenderHeadlessFrames(
+    std::vector<EmbedderHeadlessFrames::Request> requests) {
+  if (!IsValid() || !headless_frames_) {
+    return false;
+  }
+
+  headless_frames_->Enqueue(std::move(requests));
+  return true;
+}
+
 Shell& EmbedderEngine::GetShell() {
   FML_DCHECK(shell_);
   return *shell_.get();
@@ -13,6 +13,7 @@
 #include "flutter/shell/common/thread_host.h"
 #include "flutter/shell/platform/embedder/embedder.h"
 #include "flutter/shell/platform/embedder/embedder_external_texture_resolver.h"
+#include "flutter/shell/platform/embedder/embedder_headless_frames.h"
 #include "flutter/shell/platform/embedder/embedder_thread_host.h"
 namespace flutter {
 
@@ -30,7 +31,8 @@ class EmbedderEngine {
       const Shell::CreateCallback<PlatformView>& on_create_platform_view,
       const Shell::CreateCallback<Rasterizer>& on_create_rasterizer,
       std::unique_ptr<EmbedderExternalTextureResolver>
-          external_texture_resolver);
+          external_texture_resolver,
+      std::shared_ptr<EmbedderHeadlessFrames> headless_frames = nullptr);
 
   ~EmbedderEngine();
 
@@ -88,6 +90,9 @@ class EmbedderEngine {
 
   bool ScheduleFrame();
 
+  bool RenderHeadlessFrames(
+      std::vector<EmbedderHeadlessFrames::Request> requests);
+
   Shell& GetShell();
 
  private:
@@ -97,6 +102,7 @@ class EmbedderEngine {
   std::unique_ptr<ShellArgs> shell_args_;
   std::unique_ptr<Shell> shell_;
   std::unique_ptr<EmbedderExternalTextureResolver> external_texture_resolver_;
+  std::shared_ptr<EmbedderHeadlessFrames> headless_frames_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(EmbedderEngine);
 };
@@ -575,6 +575,10 @@ void EmbedderExternalViewEmbedder::SubmitFlutterView(
   // to the embedder. Here, the embedder has the opportunity to trample on the
   // OpenGL context.
   //
+  // Render targets that were not needed by this frame stay in the cache for a
+  // few frames, so that frames with a fluctuating number of layers do not
+  // reallocate them.
+  //
   // For optimum performance, we should tell the render target cache to clear
   // its unused entries before allocating new ones. This collection step
   // before allocating new render targets ameliorates peak memory usage within
@@ -584,7 +588,7 @@ void EmbedderExternalViewEmbedder::SubmitFlutterView(
   //
   // @warning: Embedder may trample on our OpenGL context here.
   auto deferred_cleanup_render_targets =
-      render_target_cache.ClearAllRenderTargetsInCache();
+      render_target_cache.CollectUnusedRenderTargets();
 
 #if !SLIMPELLER
   // The OpenGL context could have been trampled by the embedder at this point
@@ -0,0 +1,179 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/embedder/embedder_headless_frames.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+#include "flutter/shell/common/engine.h"
+#include "flutter/shell/platform/embedder/vsync_waiter_embedder.h"
+
+namespace flutter {
+
+EmbedderHeadlessFrames::EmbedderHeadlessFrames() = default;
+
+EmbedderHeadlessFrames::~EmbedderHeadlessFrames() {
+  if (current_request_.has_value()) {
+    current_request_->callback(false);
+  }
+  for (const Request& request : pending_requests_) {
+    request.callback(false);
+  }
+}
+
+void EmbedderHeadlessFrames::Attach(
+    const TaskRunners& task_runners,
+    fml::TaskRunnerAffineWeakPtr<Engine> engine) {
+  std::scoped_lock lock(mutex_);
+  task_runners_.emplace(task_runners);
+  engine_ = std::move(engine);
+  ServeNextRequestLocked();
+}
+
+void EmbedderHeadlessFrames::Enqueue(std::vector<Request> requests) {
+  std::scoped_lock lock(mutex_);
+  for (Request& request : requests) {
+    pending_requests_.push_back(std::move(request));
+  }
+  ServeNextRequestLocked();
+}
+
+void EmbedderHeadlessFrames::OnVsyncRequested(intptr_t baton) {
+  std::scoped_lock lock(mutex_);
+  FML_DCHECK(vsync_baton_ == 0);
+  vsync_baton_ = baton;
+  ServeNextRequestLocked();
+}
+
+bool EmbedderHeadlessFrames::Present(const void* allocation,
+                                     size_t row_bytes,
+                                     size_t height) {
+  TRACE_EVENT0("flutter", "EmbedderHeadlessFrames::Present");
+  std::scoped_lock lock(mutex_);
+  // Frames may be presented without having been requested, for example when
+  // the pipeline held a frame before the request was made. Whether the frame
+  // was begun for the current request is only known once it is rasterized,
+  // so its pixels are kept in the buffer of the request until then. The frame
+  // begun for the request overwrites them.
+  if (!current_request_.has_value()) {
+    return true;
+  }
+
+  const auto* src = static_cast<const uint8_t*>(allocation);
+  auto* dst = static_cast<uint8_t*>(current_request_->buffer);
+  const size_t request_row_bytes = current_request_->row_bytes;
+  const size_t copy_bytes = std::min(row_bytes, request_row_bytes);
+  const size_t copy_rows = std::min(height, current_request_->height);
+  if (row_bytes == request_row_bytes) {
+    std::memcpy(dst, src, row_bytes * copy_rows);
+  } else {
+    for (size_t row = 0; row < copy_rows; row++) {
+      std::memcpy(dst + row * request_row_bytes, src + row * row_bytes,
+                  copy_bytes);
+    }
+  }
+  current_frame_presented_ = true;
+  return true;
+}
+
+void EmbedderHeadlessFrames::OnFrameRasterized(
+    fml::TimePoint vsync_start_time) {
+  std::optional<Request> request;
+  bool presented = false;
+  {
+    std::scoped_lock lock(mutex_);
+    presented = std::exchange(current_frame_presented_, false);
+    if (!current_request_.has_value() ||
+        vsync_start_time != current_frame_start_) {
+      return;
+    }
+    request.swap(current_request_);
+    ServeNextRequestLocked();
+  }
+
+  if (!presented) {
+    FML_DLOG(WARNING) << "The frame of a headless frame request was "
+                         "rasterized without being presented.";
+  }
+  request->callback(presented);
+}
+
+void EmbedderHeadlessFrames::OnFrameDiscarded(fml::TimePoint vsync_start_time,
+                                              bool will_retry) {
+  std::function<void(bool)> callback;
+  fml::RefPtr<fml::TaskRunner> raster_task_runner;
+  {
+    std::scoped_lock lock(mutex_);
+    if (!current_request_.has_value() ||
+        vsync_start_time != current_frame_start_) {
+      return;
+    }
+    if (will_retry) {
+      // The engine has asked for another vsync to begin the frame again. Serve
+      // the request with it.
+      pending_requests_.push_front(std::move(current_request_.value()));
+      current_request_.reset();
+      ServeNextRequestLocked();
+      return;
+    }
+    callback = std::move(current_request_->callback);
+    current_request_.reset();
+    raster_task_runner = task_runners_->GetRasterTaskRunner();
+    ServeNextRequestLocked();
+  }
+
+  FML_DLOG(WARNING) << "The frame of a headless frame request was not "
+                       "rendered.";
+  // Requests are completed on the raster task runner.
+  raster_task_runner->PostTask(
+      [callback = std::move(callback)]() { callback(false); });
+}
+
+void EmbedderHeadlessFrames::ServeNextRequestLocked() {
+  if (!task_runners_.has_value() || current_request_.has_value() ||
+      pending_requests_.empty()) {
+    return;
+  }
+
+  if (vsync_baton_ == 0) {
+    // The framework has not asked for a frame. Ask for one. Repeated requests
+    // are folded into the frame that is already pending.
+    task_runners_->GetUITaskRunner()->PostTask([engine = engine_]() {
+      if (engine) {
+        engine->ScheduleFrame();
+      }
+    });
+    return;
+  }
+
+  current_request_ = std::move(pending_requests_.front());
+  pending_requests_.pop_front();
+  current_frame_start_ = fml::TimePoint::Now();
+  current_frame_presented_ = false;
+  const fml::TimePoint frame_target_time =
+      current_request_->frame_time.value_or(current_frame_start_);
+
+  // A vsync that was asked for without rebuilding the frame draws the last
+  // layer trees again. Such a frame shows the application at the time of an
+  // earlier frame and is not reported as rasterized, so make the engine build
+  // the frame before the vsync task begins it.
+  task_runners_->GetUITaskRunner()->PostTask(
+      [engine = engine_, task_runners = task_runners_.value(),
+       baton = vsync_baton_, frame_start_time = current_frame_start_,
+       frame_target_time]() {
+        if (engine) {
+          engine->ScheduleFrame(/*regenerate_layer_trees=*/true);
+        }
+        VsyncWaiterEmbedder::OnEmbedderVsync(task_runners, baton,
+                                             frame_start_time,
+                                             frame_target_time);
+      });
+  vsync_baton_ = 0;
+}
+
+}  // namespace flutter
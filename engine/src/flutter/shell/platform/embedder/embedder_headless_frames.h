@@ -0,0 +1,123 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_HEADLESS_FRAMES_H_
+#define FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_HEADLESS_FRAMES_H_
+
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include "flutter/common/task_runners.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/memory/weak_ptr.h"
+#include "flutter/fml/time/time_point.h"
+
+namespace flutter {
+
+class Engine;
+
+//------------------------------------------------------------------------------
+/// @brief      Drives the frames of an engine in headless mode.
+///
+///             In headless mode, frames are not paced by vsync. Instead, the
+///             embedder requests frames, and each request is served by a
+///             frame begun for it as soon as the previous request has been
+///             served. Frames are told apart by the start time of their vsync:
+///             the pixels of the frame rasterized for a request are copied
+///             into the buffer of the request, and frames that were not begun
+///             for a request are ignored. A request fails if the engine
+///             reports that its frame was discarded, for example because the
+///             application did not render it, or that its frame was
+///             rasterized without being presented.
+///
+///             This object stands in for both the vsync callback and the
+///             software surface present callback of the embedder, and
+///             receives the frame rasterized and frame discarded callbacks of
+///             the shell. Requests are made on the platform task runner, vsync
+///             requests and discarded frames arrive on the UI task runner, and
+///             frames are presented and rasterized on the raster task runner.
+///
+class EmbedderHeadlessFrames {
+ public:
+  struct Request {
+    /// The time of the frame given to the framework. The time at which the
+    /// frame begins if unset.
+    std::optional<fml::TimePoint> frame_time;
+    /// The buffer the pixels of the frame are copied into. It must stay valid
+    /// until the callback is invoked.
+    void* buffer = nullptr;
+    size_t row_bytes = 0;
+    size_t height = 0;
+    /// Invoked with whether the frame was copied into the buffer.
+    std::function<void(bool)> callback;
+  };
+
+  EmbedderHeadlessFrames();
+
+  /// Fails all requests that have not been served yet.
+  ~EmbedderHeadlessFrames();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Connects this object to the engine whose frames it drives.
+  ///             Requests made before are served once it is attached.
+  ///
+  void Attach(const TaskRunners& task_runners,
+              fml::TaskRunnerAffineWeakPtr<Engine> engine);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Queues frame requests, which are served in order.
+  ///
+  void Enqueue(std::vector<Request> requests);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The vsync callback of the engine. The frame begins once there
+  ///             is a request for it.
+  ///
+  void OnVsyncRequested(intptr_t baton);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The software present callback of the engine. Copies the
+  ///             frame into the buffer of the current request, which keeps it
+  ///             if the frame turns out to be the one begun for the request.
+  ///
+  bool Present(const void* allocation, size_t row_bytes, size_t height);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The frame rasterized callback of the shell. Serves the
+  ///             current request if the frame was begun for it.
+  ///
+  void OnFrameRasterized(fml::TimePoint vsync_start_time);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The frame discarded callback of the shell. Fails the current
+  ///             request if the frame was begun for it, or begins the frame of
+  ///             the request again if the engine retries it.
+  ///
+  void OnFrameDiscarded(fml::TimePoint vsync_start_time, bool will_retry);
+
+ private:
+  std::mutex mutex_;
+  std::optional<TaskRunners> task_runners_;
+  fml::TaskRunnerAffineWeakPtr<Engine> engine_;
+  std::deque<Request> pending_requests_;
+  // The request whose frame has begun but not yet been rasterized.
+  std::optional<Request> current_request_;
+  // The vsync start time of the frame begun for the current request.
+  fml::TimePoint current_frame_start_;
+  // Whether a frame has been copied into the buffer of the current request
+  // since the last frame was rasterized.
+  bool current_frame_presented_ = false;
+  intptr_t vsync_baton_ = 0;
+
+  void ServeNextRequestLocked();
+
+  FML_DISALLOW_COPY_AND_ASSIGN(EmbedderHeadlessFrames);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_HEADLESS_FRAMES_H_
@@ -4,9 +4,13 @@
 
 #include "flutter/shell/platform/embedder/embedder_render_target_cache.h"
 
+#include <algorithm>
+#include <vector>
+
 namespace flutter {
 
-EmbedderRenderTargetCache::EmbedderRenderTargetCache() = default;
+EmbedderRenderTargetCache::EmbedderRenderTargetCache(size_t max_unused_bytes)
+    : max_unused_bytes_(max_unused_bytes) {}
 
 EmbedderRenderTargetCache::~EmbedderRenderTargetCache() = default;
 
@@ -17,19 +21,52 @@ EmbedderRenderTargetCache::GetRenderTarget(
   if (compatible_target == cached_render_targets_.end()) {
     return nullptr;
   }
-  auto target = std::move(compatible_target->second);
+  auto target = std::move(compatible_target->second.target);
+  cached_render_targets_bytes_ -= GetRenderTargetBytes(descriptor);
   cached_render_targets_.erase(compatible_target);
   return target;
 }
 
 std::set<std::unique_ptr<EmbedderRenderTarget>>
-EmbedderRenderTargetCache::ClearAllRenderTargetsInCache() {
-  std::set<std::unique_ptr<EmbedderRenderTarget>> cleared_targets;
-  for (auto& targets : cached_render_targets_) {
-    cleared_targets.insert(std::move(targets.second));
+EmbedderRenderTargetCache::CollectUnusedRenderTargets() {
+  std::set<std::unique_ptr<EmbedderRenderTarget>> collected_targets;
+  auto collect = [&](CachedRenderTargets::iterator it) {
+    cached_render_targets_bytes_ -= GetRenderTargetBytes(it->first);
+    collected_targets.insert(std::move(it->second.target));
+    return cached_render_targets_.erase(it);
+  };
+
+  for (auto it = cached_render_targets_.begin();
+       it != cached_render_targets_.end();) {
+    if (++it->second.unused_frames > kMaxUnusedFrames) {
+      it = collect(it);
+    } else {
+      ++it;
+    }
+  }
+
+  if (cached_render_targets_bytes_ <= max_unused_bytes_) {
+    return collected_targets;
+  }
+
+  // Over budget. Collect the render targets that have been unused the longest
+  // first.
+  std::vector<CachedRenderTargets::iterator> by_age;
+  by_age.reserve(cached_render_targets_.size());
+  for (auto it = cached_render_targets_.begin();
+       it != cached_render_targets_.end(); ++it) {
+    by_age.push_back(it);
   }
-  cached_render_targets_.clear();
-  return cleared_targets;
+  std::stable_sort(by_age.begin(), by_age.end(), [](auto lhs, auto rhs) {
+    return lhs->second.unused_frames > rhs->second.unused_frames;
+  });
+  for (auto it : by_age) {
+    if (cached_render_targets_bytes_ <= max_unused_bytes_) {
+      break;
+    }
+    collect(it);
+  }
+  return collected_targets;
 }
 
 void EmbedderRenderTargetCache::CacheRenderTarget(
@@ -39,11 +76,23 @@ void EmbedderRenderTargetCache::CacheRenderTarget(
   }
   auto desc = EmbedderExternalView::RenderTargetDescriptor{
       target->GetRenderTargetSize()};
-  cached_render_targets_.insert(std::make_pair(desc, std::move(target)));
+  cached_render_targets_bytes_ += GetRenderTargetBytes(desc);
+  cached_render_targets_.insert(
+      std::make_pair(desc, CachedRenderTarget{.target = std::move(target)}));
 }
 
 size_t EmbedderRenderTargetCache::GetCachedTargetsCount() const {
   return cached_render_targets_.size();
 }
 
+size_t EmbedderRenderTargetCache::GetCachedTargetsBytes() const {
+  return cached_render_targets_bytes_;
+}
+
+size_t EmbedderRenderTargetCache::GetRenderTargetBytes(
+    const EmbedderExternalView::RenderTargetDescriptor& descriptor) {
+  return static_cast<size_t>(descriptor.surface_size.width) *
+         static_cast<size_t>(descriptor.surface_size.height) * 4;
+}
+
 }  // namespace flutter
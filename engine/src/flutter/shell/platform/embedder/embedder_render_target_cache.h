@@ -25,28 +25,65 @@ namespace flutter {
 ///
 class EmbedderRenderTargetCache {
  public:
-  EmbedderRenderTargetCache();
+  /// The number of frames an unused render target is kept for before it is
+  /// collected. This lets frames whose layer count fluctuates reuse the render
+  /// targets of previous frames.
+  static constexpr size_t kMaxUnusedFrames = 3;
+
+  /// The default for the number of bytes of unused render targets kept by a
+  /// cache.
+  static constexpr size_t kDefaultMaxUnusedBytes = 64 * 1024 * 1024;
+
+  explicit EmbedderRenderTargetCache(
+      size_t max_unused_bytes = kDefaultMaxUnusedBytes);
 
   ~EmbedderRenderTargetCache();
 
   std::unique_ptr<EmbedderRenderTarget> GetRenderTarget(
       const EmbedderExternalView::RenderTargetDescriptor& descriptor);
 
-  std::set<std::unique_ptr<EmbedderRenderTarget>>
-  ClearAllRenderTargetsInCache();
+  //----------------------------------------------------------------------------
+  /// @brief      Called once per frame after the render targets of the frame
+  ///             have been taken from the cache. Ages the render targets that
+  ///             were not used, and removes the ones that have been unused
+  ///             for more than |kMaxUnusedFrames| frames. The least recently
+  ///             used render targets are then removed until the remaining
+  ///             ones fit in the byte budget of the cache.
+  ///
+  /// @return     The removed render targets. The caller decides when they are
+  ///             collected.
+  ///
+  std::set<std::unique_ptr<EmbedderRenderTarget>> CollectUnusedRenderTargets();
 
   void CacheRenderTarget(std::unique_ptr<EmbedderRenderTarget> target);
 
   size_t GetCachedTargetsCount() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      The approximate number of bytes used by the render targets in
+  ///             the cache, assuming four bytes per pixel.
+  ///
+  size_t GetCachedTargetsBytes() const;
+
  private:
+  struct CachedRenderTarget {
+    std::unique_ptr<EmbedderRenderTarget> target;
+    // The number of frames since the render target was last used.
+    size_t unused_frames = 0;
+  };
+
   using CachedRenderTargets = std::unordered_multimap<
       EmbedderExternalView::RenderTargetDescriptor,
-      std::unique_ptr<EmbedderRenderTarget>,
+      CachedRenderTarget,
       EmbedderExternalView::RenderTargetDescriptor::Hash,
       EmbedderExternalView::RenderTargetDescriptor::Equal>;
 
+  const size_t max_unused_bytes_;
   CachedRenderTargets cached_render_targets_;
+  size_t cached_render_targets_bytes_ = 0;
+
+  static size_t GetRenderTargetBytes(
+      const EmbedderExternalView::RenderTargetDescriptor& descriptor);
 
   FML_DISALLOW_COPY_AND_ASSIGN(EmbedderRenderTargetCache);
 };
@@ -29,9 +29,9 @@ FlutterTristate ToFlutterTristate(flutter::SemanticsTristate state) {
   }
 }
 
-std::unique_ptr<FlutterSemanticsFlags> ConvertToFlutterSemanticsFlags(
+FlutterSemanticsFlags ConvertToFlutterSemanticsFlags(
     const flutter::SemanticsFlags& source) {
-  return std::make_unique<FlutterSemanticsFlags>(FlutterSemanticsFlags{
+  return FlutterSemanticsFlags{
       .is_checked = ToFlutterCheckState(source.isChecked),
       .is_selected = ToFlutterTristate(source.isSelected),
       .is_enabled = ToFlutterTristate(source.isEnabled),
@@ -56,7 +56,7 @@ std::unique_ptr<FlutterSemanticsFlags> ConvertToFlutterSemanticsFlags(
       .is_slider = source.isSlider,
       .is_keyboard_key = source.isKeyboardKey,
       .is_accessibility_focus_blocked = source.isAccessibilityFocusBlocked,
-  });
+  };
 }
 
 }  // namespace
@@ -299,7 +299,7 @@ void EmbedderSemanticsUpdate2::AddNode(const SemanticsNode& node) {
       CreateStringAttributes(node.increasedValueAttributes);
   auto decreased_value_attributes =
       CreateStringAttributes(node.decreasedValueAttributes);
-  flags_.emplace_back(ConvertToFlutterSemanticsFlags(node.flags));
+  flags_.push_back(ConvertToFlutterSemanticsFlags(node.flags));
 
   nodes_.push_back({
       sizeof(FlutterSemanticsNode2),
@@ -341,7 +341,7 @@ void EmbedderSemanticsUpdate2::AddNode(const SemanticsNode& node) {
       increased_value_attributes.attributes,
       decreased_value_attributes.count,
       decreased_value_attributes.attributes,
-      flags_.back().get(),
+      &flags_.back(),
       node.headingLevel,
       node.identifier.c_str(),
   });
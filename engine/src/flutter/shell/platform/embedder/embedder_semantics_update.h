@@ -67,7 +67,9 @@ class EmbedderSemanticsUpdate2 {
   std::vector<FlutterSemanticsNode2*> node_pointers_;
   std::vector<FlutterSemanticsCustomAction2> actions_;
   std::vector<FlutterSemanticsCustomAction2*> action_pointers_;
-  std::vector<std::unique_ptr<FlutterSemanticsFlags>> flags_;
+  // Reserved for all the nodes up front, so that the nodes can point to its
+  // elements without allocating the flags of each node separately.
+  std::vector<FlutterSemanticsFlags> flags_;
 
   std::vector<std::unique_ptr<std::vector<const FlutterStringAttribute*>>>
       node_string_attributes_;
@@ -20,7 +20,8 @@ EmbedderSurfaceSoftware::EmbedderSurfaceSoftware(
     std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder)
     : software_dispatch_table_(std::move(software_dispatch_table)),
       external_view_embedder_(std::move(external_view_embedder)) {
-  if (!software_dispatch_table_.software_present_backing_store) {
+  if (!software_dispatch_table_.software_present_backing_store &&
+      !software_dispatch_table_.software_present_backing_store_with_damage) {
     return;
   }
   valid_ = true;
@@ -85,6 +86,27 @@ sk_sp<SkSurface> EmbedderSurfaceSoftware::AcquireBackingStore(
 // |GPUSurfaceSoftwareDelegate|
 bool EmbedderSurfaceSoftware::PresentBackingStore(
     sk_sp<SkSurface> backing_store) {
+  return PresentPixmap(std::move(backing_store), std::nullopt);
+}
+
+// |GPUSurfaceSoftwareDelegate|
+bool EmbedderSurfaceSoftware::SupportsPartialRepaint() const {
+  // The backing store is retained between frames as long as its size does not
+  // change, so only the damaged region of each frame needs to be rasterized.
+  return static_cast<bool>(
+      software_dispatch_table_.software_present_backing_store_with_damage);
+}
+
+// |GPUSurfaceSoftwareDelegate|
+bool EmbedderSurfaceSoftware::PresentBackingStoreWithDamage(
+    sk_sp<SkSurface> backing_store,
+    const std::optional<DlIRect>& damage) {
+  return PresentPixmap(std::move(backing_store), damage);
+}
+
+bool EmbedderSurfaceSoftware::PresentPixmap(
+    sk_sp<SkSurface> backing_store,
+    const std::optional<DlIRect>& damage) {
   if (!IsValid()) {
     FML_LOG(ERROR) << "Tried to present an invalid software surface.";
     return false;
@@ -106,10 +128,22 @@ bool EmbedderSurfaceSoftware::PresentBackingStore(
     return false;
   }
 
-  return software_dispatch_table_.software_present_backing_store(
-      pixmap.addr(),      //
-      pixmap.rowBytes(),  //
-      pixmap.height()     //
+  if (!software_dispatch_table_.software_present_backing_store_with_damage) {
+    return software_dispatch_table_.software_present_backing_store(
+        pixmap.addr(),      //
+        pixmap.rowBytes(),  //
+        pixmap.height()     //
+    );
+  }
+
+  // Without damage information, the whole backing store is reported as
+  // damaged.
+  const DlIRect bounds = DlIRect::MakeWH(pixmap.width(), pixmap.height());
+  return software_dispatch_table_.software_present_backing_store_with_damage(
+      pixmap.addr(),                                        //
+      pixmap.rowBytes(),                                    //
+      pixmap.height(),                                      //
+      damage.has_value() ? damage->IntersectionOrEmpty(bounds) : bounds  //
   );
 }
 
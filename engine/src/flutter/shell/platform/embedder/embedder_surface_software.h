@@ -19,7 +19,12 @@ class EmbedderSurfaceSoftware final : public EmbedderSurface,
  public:
   struct SoftwareDispatchTable {
     std::function<bool(const void* allocation, size_t row_bytes, size_t height)>
-        software_present_backing_store;  // required
+        software_present_backing_store;  // required unless the below is set
+    std::function<bool(const void* allocation,
+                       size_t row_bytes,
+                       size_t height,
+                       const DlIRect& damage)>
+        software_present_backing_store_with_damage;  // optional
   };
 
   EmbedderSurfaceSoftware(
@@ -49,6 +54,17 @@ class EmbedderSurfaceSoftware final : public EmbedderSurface,
   // |GPUSurfaceSoftwareDelegate|
   bool PresentBackingStore(sk_sp<SkSurface> backing_store) override;
 
+  // |GPUSurfaceSoftwareDelegate|
+  bool SupportsPartialRepaint() const override;
+
+  // |GPUSurfaceSoftwareDelegate|
+  bool PresentBackingStoreWithDamage(
+      sk_sp<SkSurface> backing_store,
+      const std::optional<DlIRect>& damage) override;
+
+  bool PresentPixmap(sk_sp<SkSurface> backing_store,
+                     const std::optional<DlIRect>& damage);
+
   FML_DISALLOW_COPY_AND_ASSIGN(EmbedderSurfaceSoftware);
 };
 
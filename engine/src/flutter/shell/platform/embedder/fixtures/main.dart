@@ -453,6 +453,33 @@ void null_platform_messages() {
   signalNativeTest();
 }
 
+@pragma('vm:entry-point')
+// ignore: non_constant_identifier_names
+void platform_message_buffers() {
+  PlatformDispatcher.instance.onPlatformMessage =
+      (String name, ByteData? data, PlatformMessageResponseCallback? callback) {
+        callback!(data);
+      };
+  PlatformDispatcher.instance.sendPlatformMessage('test/request', null, (ByteData? reply) {
+    int sum = 0;
+    for (int i = 0; i < reply!.lengthInBytes; i++) {
+      sum += reply.getUint8(i);
+    }
+    signalNativeCount(sum);
+  });
+  signalNativeTest();
+}
+
+@pragma('vm:entry-point')
+// ignore: non_constant_identifier_names
+void platform_message_throughput() {
+  PlatformDispatcher.instance.onPlatformMessage =
+      (String name, ByteData? data, PlatformMessageResponseCallback? callback) {
+        signalNativeCount(data!.lengthInBytes);
+      };
+  signalNativeTest();
+}
+
 Picture createSimplePicture() {
   final blackPaint = Paint();
   final whitePaint = Paint()..color = const Color.fromARGB(255, 255, 255, 255);
@@ -1302,6 +1329,30 @@ void render_targets_are_recycled() {
   PlatformDispatcher.instance.scheduleFrame();
 }
 
+@pragma('vm:entry-point')
+// ignore: non_constant_identifier_names
+void render_targets_are_kept_across_frames() {
+  var frameCount = 0;
+  PlatformDispatcher.instance.onBeginFrame = (Duration duration) {
+    final builder = SceneBuilder();
+    // Alternate between 10 and 5 platform views, as a scrolling list of
+    // platform views would.
+    final platformViewCount = frameCount.isEven ? 10 : 5;
+    for (var i = 0; i < platformViewCount; i++) {
+      builder.addPicture(Offset.zero, createGradientBox(const Size(30.0, 20.0)));
+      builder.addPlatformView(42 + i, width: 30.0, height: 20.0);
+    }
+    PlatformDispatcher.instance.views.first.render(builder.build());
+    frameCount++;
+    if (frameCount == 8) {
+      signalNativeTest();
+    } else {
+      PlatformDispatcher.instance.scheduleFrame();
+    }
+  };
+  PlatformDispatcher.instance.scheduleFrame();
+}
+
 @pragma('vm:entry-point')
 // ignore: non_constant_identifier_names
 void render_targets_are_in_stable_order() {
@@ -1581,6 +1632,36 @@ void render_gradient_retained() {
   PlatformDispatcher.instance.scheduleFrame();
 }
 
+@pragma('vm:entry-point')
+// ignore: non_constant_identifier_names
+void render_headless_frames() {
+  PlatformDispatcher.instance.onBeginFrame = (Duration duration) {
+    final FlutterView view = PlatformDispatcher.instance.views.first;
+    final builder = SceneBuilder();
+    builder.pushOffset(0.0, 0.0);
+    builder.addPicture(
+      Offset.zero,
+      createColoredBox(const Color.fromARGB(255, 255, 0, 0), view.physicalSize),
+    );
+    builder.pop();
+    view.render(builder.build());
+    signalNativeCount(duration.inMicroseconds);
+    // Keep animating, so that every frame is built for its own time.
+    PlatformDispatcher.instance.scheduleFrame();
+  };
+  PlatformDispatcher.instance.scheduleFrame();
+  signalNativeTest();
+}
+
+@pragma('vm:entry-point')
+// ignore: non_constant_identifier_names
+void skip_headless_frames() {
+  PlatformDispatcher.instance.onBeginFrame = (Duration duration) {
+    signalNativeCount(duration.inMicroseconds);
+  };
+  signalNativeTest();
+}
+
 @pragma('vm:entry-point')
 // ignore: non_constant_identifier_names
 void render_impeller_test() {
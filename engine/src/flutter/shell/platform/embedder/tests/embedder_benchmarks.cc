@@ -0,0 +1,154 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#define FML_USED_ON_EMBEDDER
+
+#include <vector>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/shell/platform/embedder/tests/embedder_config_builder.h"
+#include "flutter/shell/platform/embedder/tests/embedder_test_context_software.h"
+#include "flutter/testing/testing.h"
+
+namespace flutter::testing {
+
+// Renders frames of an animating application in headless mode as fast as the
+// engine can produce them, in batches of kFramesPerBatch requests.
+static void BM_HeadlessFrames(benchmark::State& state) {
+  constexpr size_t kFramesPerBatch = 60;
+  const int64_t size = state.range(0);
+
+  EmbedderTestContextSoftware context(GetFixturesPath());
+  EmbedderConfigBuilder builder(context);
+  builder.SetSurface(DlISize(size, size));
+  builder.SetDartEntrypoint("render_headless_frames");
+  builder.GetProjectArgs().enable_headless_rendering = true;
+
+  fml::AutoResetWaitableEvent ready_latch;
+  context.AddFfiNativeCallback(
+      "SignalNativeTest",
+      CREATE_FFI_LAMBDA([&ready_latch]() { ready_latch.Signal(); }));
+  context.AddFfiNativeCallback("SignalNativeCount",
+                               CREATE_FFI_LAMBDA([](int64_t micros) {}));
+
+  auto engine = builder.LaunchEngine();
+  FML_CHECK(engine.is_valid());
+
+  FlutterWindowMetricsEvent event = {};
+  event.struct_size = sizeof(event);
+  event.width = size;
+  event.height = size;
+  event.pixel_ratio = 1.0;
+  FML_CHECK(FlutterEngineSendWindowMetricsEvent(engine.get(), &event) ==
+            kSuccess);
+  ready_latch.Wait();
+
+  // Requests are served one after another, so they can share a buffer.
+  const size_t row_bytes = size * 4;
+  std::vector<uint8_t> buffer(row_bytes * size);
+  std::vector<FlutterHeadlessFrameRequest> requests(kFramesPerBatch);
+  uint64_t frame_time_nanos = 0;
+
+  for (auto _ : state) {
+    fml::CountDownLatch batch_latch(kFramesPerBatch);
+    for (size_t i = 0; i < kFramesPerBatch; i++) {
+      // Frames 16ms apart, as if the application was animating at 60fps.
+      frame_time_nanos += 16000000;
+      requests[i] = {
+          .struct_size = sizeof(FlutterHeadlessFrameRequest),
+          .frame_time_nanos = frame_time_nanos,
+          .buffer = buffer.data(),
+          .row_bytes = row_bytes,
+          .height = static_cast<size_t>(size),
+          .callback =
+              [](bool rendered, void* user_data) {
+                FML_CHECK(rendered);
+                static_cast<fml::CountDownLatch*>(user_data)->CountDown();
+              },
+          .user_data = &batch_latch,
+      };
+    }
+    FML_CHECK(FlutterEngineRenderHeadlessFrames(engine.get(), requests.data(),
+                                                requests.size()) == kSuccess);
+    batch_latch.Wait();
+  }
+
+  state.counters["FramesPerSecond"] = benchmark::Counter(
+      state.iterations() * kFramesPerBatch, benchmark::Counter::kIsRate);
+}
+
+BENCHMARK(BM_HeadlessFrames)
+    ->Arg(256)
+    ->Arg(1024)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+// Sends platform messages of the given size to an application that signals
+// once it received each of them. The data of the messages is either copied by
+// the engine, or handed to it in a buffer.
+static void BM_PlatformMessageThroughput(benchmark::State& state,
+                                         bool use_buffers) {
+  const size_t message_size = state.range(0);
+
+  EmbedderTestContextSoftware context(GetFixturesPath());
+  EmbedderConfigBuilder builder(context);
+  builder.SetSurface(DlISize(1, 1));
+  builder.SetDartEntrypoint("platform_message_throughput");
+
+  fml::AutoResetWaitableEvent ready_latch;
+  fml::AutoResetWaitableEvent received_latch;
+  context.AddFfiNativeCallback(
+      "SignalNativeTest",
+      CREATE_FFI_LAMBDA([&ready_latch]() { ready_latch.Signal(); }));
+  context.AddFfiNativeCallback(
+      "SignalNativeCount", CREATE_FFI_LAMBDA([&received_latch](int64_t size) {
+        received_latch.Signal();
+      }));
+
+  // Outlives the engine, which may hold on to the buffers until it shuts down.
+  const std::vector<uint8_t> data(message_size);
+
+  auto engine = builder.LaunchEngine();
+  FML_CHECK(engine.is_valid());
+  ready_latch.Wait();
+
+  for (auto _ : state) {
+    if (use_buffers) {
+      const FlutterPlatformMessageBuffer buffer = {
+          .struct_size = sizeof(FlutterPlatformMessageBuffer),
+          .data = data.data(),
+          .size = data.size(),
+      };
+      FML_CHECK(FlutterEngineSendPlatformMessageBuffer(
+                    engine.get(), "test/throughput", &buffer, nullptr) ==
+                kSuccess);
+    } else {
+      const FlutterPlatformMessage message = {
+          .struct_size = sizeof(FlutterPlatformMessage),
+          .channel = "test/throughput",
+          .message = data.data(),
+          .message_size = data.size(),
+      };
+      FML_CHECK(FlutterEngineSendPlatformMessage(engine.get(), &message) ==
+                kSuccess);
+    }
+    received_latch.Wait();
+  }
+
+  state.SetBytesProcessed(state.iterations() * message_size);
+}
+
+BENCHMARK_CAPTURE(BM_PlatformMessageThroughput, Copy, false)
+    ->RangeMultiplier(16)
+    ->Range(1 << 10, 16 << 20)
+    ->UseRealTime();
+BENCHMARK_CAPTURE(BM_PlatformMessageThroughput, Buffer, true)
+    ->RangeMultiplier(16)
+    ->Range(1 << 10, 16 << 20)
+    ->UseRealTime();
+
+}  // namespace flutter::testing
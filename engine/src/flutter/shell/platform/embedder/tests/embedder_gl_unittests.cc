@@ -3429,6 +3429,58 @@ TEST_F(EmbedderTest, CompositorRenderTargetsAreRecycled) {
   ASSERT_EQ(context.GetCompositor().GetBackingStoresCollectedCount(), 10u);
 }
 
+TEST_F(EmbedderTest, CompositorRenderTargetsAreKeptAcrossFrames) {
+  auto& context = GetEmbedderContext<EmbedderTestContextGL>();
+
+  EmbedderConfigBuilder builder(context);
+  builder.SetSurface(DlISize(300, 200));
+  builder.SetCompositor();
+  builder.SetDartEntrypoint("render_targets_are_kept_across_frames");
+  builder.SetRenderTargetType(
+      EmbedderTestBackingStoreProducer::RenderTargetType::kOpenGLTexture);
+
+  const unsigned num_frames = 8;
+  fml::CountDownLatch latch(1 + num_frames);  // 1 for native test signal.
+
+  context.AddFfiNativeCallback("SignalNativeTest",
+                               CREATE_FFI_LAMBDA([&]() { latch.CountDown(); }));
+
+  // The number of backing stores created for each frame.
+  std::vector<size_t> created_counts;
+  size_t created_count = 0;
+  context.GetCompositor().SetPresentCallback(
+      [&](FlutterViewId view_id, const FlutterLayer** layers,
+          size_t layers_count) {
+        size_t count = context.GetCompositor().GetBackingStoresCreatedCount();
+        created_counts.push_back(count - created_count);
+        created_count = count;
+        latch.CountDown();
+      },
+      /*one_shot=*/false);
+
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+
+  FlutterWindowMetricsEvent event = {};
+  event.struct_size = sizeof(event);
+  event.width = 300;
+  event.height = 200;
+  event.pixel_ratio = 1.0;
+  ASSERT_EQ(FlutterEngineSendWindowMetricsEvent(engine.get(), &event),
+            kSuccess);
+
+  latch.Wait();
+
+  // Only the first frame allocates. The frames with fewer layers leave some
+  // backing stores unused, which are kept for the frames that follow.
+  ASSERT_EQ(created_counts,
+            std::vector<size_t>({10u, 0u, 0u, 0u, 0u, 0u, 0u, 0u}));
+  ASSERT_EQ(context.GetCompositor().GetBackingStoresCollectedCount(), 0u);
+  engine.reset();
+  ASSERT_EQ(context.GetCompositor().GetPendingBackingStoresCount(), 0u);
+  ASSERT_EQ(context.GetCompositor().GetBackingStoresCollectedCount(), 10u);
+}
+
 TEST_F(EmbedderTest, CompositorRenderTargetsAreInStableOrder) {
   auto& context = GetEmbedderContext<EmbedderTestContextGL>();
 
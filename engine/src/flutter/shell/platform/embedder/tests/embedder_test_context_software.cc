@@ -45,6 +45,40 @@ EmbedderTestContextSoftware::EmbedderTestContextSoftware(
 
 EmbedderTestContextSoftware::~EmbedderTestContextSoftware() = default;
 
+void EmbedderTestContextSoftware::SetSoftwarePresentWithDamageCallback(
+    PresentDamageCallback callback) {
+  {
+    std::scoped_lock lock(present_damage_callback_mutex_);
+    present_damage_callback_ = std::move(callback);
+  }
+  renderer_config_.software.surface_present_callback = nullptr;
+  renderer_config_.software.surface_present_with_damage_callback =
+      [](void* context, const void* allocation, size_t row_bytes,
+         size_t height, const FlutterDamage* damage) {
+        auto test_context =
+            reinterpret_cast<EmbedderTestContextSoftware*>(context);
+        FML_CHECK(damage->num_rects == 1u);
+        PresentDamageCallback callback;
+        {
+          std::scoped_lock lock(test_context->present_damage_callback_mutex_);
+          callback = test_context->present_damage_callback_;
+        }
+        if (callback) {
+          callback(damage->damage[0]);
+        }
+        auto image_info = SkImageInfo::MakeN32Premul(
+            SkISize::Make(row_bytes / 4, height));
+        SkBitmap bitmap;
+        if (!bitmap.tryAllocPixels(image_info) ||
+            !bitmap.writePixels(
+                SkPixmap(image_info, allocation, row_bytes))) {
+          return false;
+        }
+        bitmap.setImmutable();
+        return test_context->Present(SkImages::RasterFromBitmap(bitmap));
+      };
+}
+
 EmbedderTestContextType EmbedderTestContextSoftware::GetContextType() const {
   return EmbedderTestContextType::kSoftwareContext;
 }
@@ -5,6 +5,8 @@
 #ifndef FLUTTER_SHELL_PLATFORM_EMBEDDER_TESTS_EMBEDDER_TEST_CONTEXT_SOFTWARE_H_
 #define FLUTTER_SHELL_PLATFORM_EMBEDDER_TESTS_EMBEDDER_TEST_CONTEXT_SOFTWARE_H_
 
+#include <mutex>
+
 #include "flutter/shell/platform/embedder/tests/embedder_test_context.h"
 
 #include "third_party/skia/include/core/SkSurface.h"
@@ -14,6 +16,8 @@ namespace testing {
 
 class EmbedderTestContextSoftware : public EmbedderTestContext {
  public:
+  using PresentDamageCallback = std::function<void(const FlutterRect& damage)>;
+
   explicit EmbedderTestContextSoftware(std::string assets_path = "");
 
   ~EmbedderTestContextSoftware() override;
@@ -26,6 +30,18 @@ class EmbedderTestContextSoftware : public EmbedderTestContext {
 
   bool Present(const sk_sp<SkImage>& image);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Presents the root surface with
+  ///             `surface_present_with_damage_callback` instead of
+  ///             `surface_present_callback`, and sets a callback that is
+  ///             invoked (on the raster task runner) with the damage of every
+  ///             present.
+  ///
+  /// @param[in]  callback  The callback to set. The previous callback will be
+  ///                       un-registered.
+  ///
+  void SetSoftwarePresentWithDamageCallback(PresentDamageCallback callback);
+
  private:
   // |EmbedderTestContext|
   void SetSurface(DlISize surface_size) override;
@@ -36,6 +52,8 @@ class EmbedderTestContextSoftware : public EmbedderTestContext {
   sk_sp<SkSurface> surface_;
   DlISize surface_size_;
   size_t software_surface_present_count_ = 0;
+  std::mutex present_damage_callback_mutex_;
+  PresentDamageCallback present_damage_callback_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(EmbedderTestContextSoftware);
 };
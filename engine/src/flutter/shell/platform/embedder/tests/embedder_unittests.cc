@@ -4,6 +4,9 @@
 
 #define FML_USED_ON_EMBEDDER
 
+#include <array>
+#include <atomic>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -31,6 +34,7 @@
 #include "flutter/shell/platform/embedder/tests/embedder_unittests_util.h"
 #include "flutter/testing/assertions_skia.h"
 #include "flutter/testing/testing.h"
+#include "third_party/skia/include/core/SkPixmap.h"
 #include "third_party/skia/include/core/SkSurface.h"
 #include "third_party/tonic/converter/dart_converter.h"
 
@@ -770,6 +774,137 @@ TEST_F(EmbedderTest, InvalidPlatformMessages) {
   ASSERT_EQ(result, kInvalidArguments);
 }
 
+//------------------------------------------------------------------------------
+/// Tests that platform messages and responses can transfer the ownership of
+/// their buffers to the engine, and that the engine releases each buffer once.
+///
+TEST_F(EmbedderTest, PlatformMessageBuffersAreReleasedOnce) {
+  // Larger than the messages that are copied into the Dart heap.
+  constexpr size_t kBufferSize = 4096;
+  struct EchoCaptures {
+    std::vector<uint8_t> expected;
+    fml::AutoResetWaitableEvent latch;
+  };
+  EchoCaptures echo;
+  std::vector<uint8_t> response_data(kBufferSize);
+  int64_t response_sum = 0;
+  for (size_t i = 0; i < kBufferSize; i++) {
+    echo.expected.push_back(i % 251);
+    response_data[i] = i % 13;
+    response_sum += response_data[i];
+  }
+
+  std::atomic<int> release_count = 0;
+  auto make_buffer = [&release_count](const std::vector<uint8_t>& data) {
+    return FlutterPlatformMessageBuffer{
+        .struct_size = sizeof(FlutterPlatformMessageBuffer),
+        .data = data.data(),
+        .size = data.size(),
+        .release_callback =
+            [](void* user_data) {
+              static_cast<std::atomic<int>*>(user_data)->fetch_add(1);
+            },
+        .user_data = &release_count,
+    };
+  };
+
+  auto platform_task_runner = CreateNewThread("platform_thread");
+  UniqueEngine engine;
+  fml::AutoResetWaitableEvent ready, response_latch;
+  platform_task_runner->PostTask([&]() {
+    auto& context = GetEmbedderContext<EmbedderTestContextSoftware>();
+    EmbedderConfigBuilder builder(context);
+    builder.SetSurface(DlISize(1, 1));
+    builder.SetDartEntrypoint("platform_message_buffers");
+    builder.SetPlatformMessageCallback(
+        [&](const FlutterPlatformMessage* message) {
+          ASSERT_EQ(std::string(message->channel), "test/request");
+          FlutterPlatformMessageBuffer buffer = make_buffer(response_data);
+          EXPECT_EQ(FlutterEngineSendPlatformMessageResponseBuffer(
+                        engine.get(), message->response_handle, &buffer),
+                    kSuccess);
+        });
+    context.AddFfiNativeCallback(
+        "SignalNativeTest", CREATE_FFI_LAMBDA([&ready]() { ready.Signal(); }));
+    context.AddFfiNativeCallback(
+        "SignalNativeCount", CREATE_FFI_LAMBDA([&](int64_t sum) {
+          EXPECT_EQ(sum, response_sum);
+          response_latch.Signal();
+        }));
+
+    engine = builder.LaunchEngine();
+    ASSERT_TRUE(engine.is_valid());
+  });
+
+  ready.Wait();
+  response_latch.Wait();
+
+  platform_task_runner->PostTask([&]() {
+    FlutterPlatformMessageResponseHandle* response_handle = nullptr;
+    ASSERT_EQ(FlutterPlatformMessageCreateResponseHandle(
+                  engine.get(),
+                  [](const uint8_t* data, size_t size, void* user_data) {
+                    auto echo = reinterpret_cast<EchoCaptures*>(user_data);
+                    EXPECT_EQ(std::vector<uint8_t>(data, data + size),
+                              echo->expected);
+                    echo->latch.Signal();
+                  },
+                  &echo, &response_handle),
+              kSuccess);
+
+    FlutterPlatformMessageBuffer buffer = make_buffer(echo.expected);
+    EXPECT_EQ(FlutterEngineSendPlatformMessageBuffer(
+                  engine.get(), "test_channel", &buffer, response_handle),
+              kSuccess);
+    EXPECT_EQ(FlutterPlatformMessageReleaseResponseHandle(engine.get(),
+                                                          response_handle),
+              kSuccess);
+  });
+  echo.latch.Wait();
+
+  // Dart holds on to the buffers until they are collected, at the latest
+  // when the isolate shuts down.
+  fml::AutoResetWaitableEvent shutdown_latch;
+  platform_task_runner->PostTask([&]() {
+    engine.reset();
+    shutdown_latch.Signal();
+  });
+  shutdown_latch.Wait();
+  EXPECT_EQ(release_count, 2);
+}
+
+//------------------------------------------------------------------------------
+/// Tests that platform message buffers are released when they cannot be sent.
+///
+TEST_F(EmbedderTest, PlatformMessageBuffersAreReleasedOnFailure) {
+  auto& context = GetEmbedderContext<EmbedderTestContextSoftware>();
+  EmbedderConfigBuilder builder(context);
+  builder.SetSurface(DlISize(1, 1));
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+
+  int release_count = 0;
+  FlutterPlatformMessageBuffer buffer = {
+      .struct_size = sizeof(FlutterPlatformMessageBuffer),
+      .data = nullptr,
+      .size = 1,
+      .release_callback =
+          [](void* user_data) { (*static_cast<int*>(user_data))++; },
+      .user_data = &release_count,
+  };
+  EXPECT_EQ(FlutterEngineSendPlatformMessageBuffer(
+                engine.get(), "test_channel", &buffer, nullptr),
+            kInvalidArguments);
+  EXPECT_EQ(release_count, 1);
+
+  const uint8_t data = 0;
+  buffer.data = &data;
+  EXPECT_EQ(FlutterEngineSendPlatformMessageBuffer(engine.get(), nullptr,
+                                                   &buffer, nullptr),
+            kInvalidArguments);
+  EXPECT_EQ(release_count, 2);
+}
+
 //------------------------------------------------------------------------------
 /// Tests that setting a custom log callback works as expected and defaults to
 /// using tag "flutter".
@@ -880,6 +1015,221 @@ TEST_F(EmbedderTest, VMAndIsolateSnapshotSizesAreRedundantInAOTMode) {
   ASSERT_TRUE(engine.is_valid());
 }
 
+TEST_F(EmbedderTest, MustNotRunWithBothSoftwarePresentCallbacksSet) {
+  auto& context = GetEmbedderContext<EmbedderTestContextSoftware>();
+  context.GetRendererConfig().software.surface_present_with_damage_callback =
+      [](void* context, const void* allocation, size_t row_bytes,
+         size_t height, const FlutterDamage* damage) { return true; };
+  EmbedderConfigBuilder builder(context);
+  builder.SetSurface(DlISize(1, 1));
+  auto engine = builder.LaunchEngine();
+  ASSERT_FALSE(engine.is_valid());
+}
+
+TEST_F(EmbedderTest, SoftwarePresentWithDamageOnlyReportsChangedRegion) {
+  auto& context = GetEmbedderContext<EmbedderTestContextSoftware>();
+  fml::AutoResetWaitableEvent latch;
+
+  // The first frame has no previous frame in the buffer.
+  context.SetSoftwarePresentWithDamageCallback([&](const FlutterRect& damage) {
+    EXPECT_EQ(damage.left, 0);
+    EXPECT_EQ(damage.top, 0);
+    EXPECT_EQ(damage.right, 800);
+    EXPECT_EQ(damage.bottom, 600);
+    latch.Signal();
+  });
+
+  EmbedderConfigBuilder builder(context);
+  builder.SetSurface(DlISize(800, 600));
+  builder.SetDartEntrypoint("render_gradient_retained");
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+
+  FlutterWindowMetricsEvent event = {};
+  event.struct_size = sizeof(event);
+  event.width = 800;
+  event.height = 600;
+  event.pixel_ratio = 1.0;
+  ASSERT_EQ(FlutterEngineSendWindowMetricsEvent(engine.get(), &event),
+            kSuccess);
+  latch.Wait();
+
+  // The second frame is the same as the first one, which the engine kept in
+  // the buffer, so nothing is damaged.
+  context.SetSoftwarePresentWithDamageCallback([&](const FlutterRect& damage) {
+    EXPECT_EQ(damage.left, 0);
+    EXPECT_EQ(damage.top, 0);
+    EXPECT_EQ(damage.right, 0);
+    EXPECT_EQ(damage.bottom, 0);
+    latch.Signal();
+  });
+  ASSERT_EQ(FlutterEngineSendWindowMetricsEvent(engine.get(), &event),
+            kSuccess);
+  latch.Wait();
+}
+
+TEST_F(EmbedderTest, CanRenderHeadlessFramesIntoRequestBuffers) {
+  auto& context = GetEmbedderContext<EmbedderTestContextSoftware>();
+  EmbedderConfigBuilder builder(context);
+  builder.SetSurface(DlISize(4, 4));
+  builder.SetDartEntrypoint("render_headless_frames");
+  builder.GetProjectArgs().enable_headless_rendering = true;
+
+  fml::AutoResetWaitableEvent ready_latch;
+  context.AddFfiNativeCallback(
+      "SignalNativeTest",
+      CREATE_FFI_LAMBDA([&ready_latch]() { ready_latch.Signal(); }));
+  std::mutex frame_times_mutex;
+  std::vector<int64_t> frame_times;
+  context.AddFfiNativeCallback(
+      "SignalNativeCount", CREATE_FFI_LAMBDA([&](int64_t micros) {
+        std::scoped_lock lock(frame_times_mutex);
+        frame_times.push_back(micros);
+      }));
+
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+
+  FlutterWindowMetricsEvent event = {};
+  event.struct_size = sizeof(event);
+  event.width = 4;
+  event.height = 4;
+  event.pixel_ratio = 1.0;
+  ASSERT_EQ(FlutterEngineSendWindowMetricsEvent(engine.get(), &event),
+            kSuccess);
+  ready_latch.Wait();
+
+  struct Frame {
+    std::array<uint32_t, 16> pixels = {};
+    bool rendered = false;
+    fml::CountDownLatch* latch = nullptr;
+  };
+  constexpr size_t kFrameCount = 3;
+  fml::CountDownLatch frames_latch(kFrameCount);
+  std::array<Frame, kFrameCount> frames;
+  std::array<FlutterHeadlessFrameRequest, kFrameCount> requests;
+  for (size_t i = 0; i < kFrameCount; i++) {
+    frames[i].latch = &frames_latch;
+    requests[i] = {
+        .struct_size = sizeof(FlutterHeadlessFrameRequest),
+        .frame_time_nanos = (i + 1) * 1000000000u,
+        .buffer = frames[i].pixels.data(),
+        .row_bytes = 4 * sizeof(uint32_t),
+        .height = 4,
+        .callback =
+            [](bool rendered, void* user_data) {
+              auto* frame = static_cast<Frame*>(user_data);
+              frame->rendered = rendered;
+              frame->latch->CountDown();
+            },
+        .user_data = &frames[i],
+    };
+  }
+
+  FlutterHeadlessFrameRequest invalid_request = requests[0];
+  invalid_request.buffer = nullptr;
+  ASSERT_EQ(
+      FlutterEngineRenderHeadlessFrames(engine.get(), &invalid_request, 1),
+      kInvalidArguments);
+
+  ASSERT_EQ(FlutterEngineRenderHeadlessFrames(engine.get(), requests.data(),
+                                              requests.size()),
+            kSuccess);
+  frames_latch.Wait();
+
+  for (const Frame& frame : frames) {
+    ASSERT_TRUE(frame.rendered);
+    SkPixmap pixmap(SkImageInfo::MakeN32Premul(4, 4), frame.pixels.data(),
+                    4 * sizeof(uint32_t));
+    EXPECT_EQ(pixmap.getColor(0, 0), SK_ColorRED);
+    EXPECT_EQ(pixmap.getColor(3, 3), SK_ColorRED);
+  }
+
+  // Every frame was built for the time it was requested for, in order.
+  std::scoped_lock lock(frame_times_mutex);
+  EXPECT_EQ(frame_times, (std::vector<int64_t>{1000000, 2000000, 3000000}));
+}
+
+TEST_F(EmbedderTest, HeadlessFramesFailIfTheApplicationDoesNotRender) {
+  auto& context = GetEmbedderContext<EmbedderTestContextSoftware>();
+  EmbedderConfigBuilder builder(context);
+  builder.SetSurface(DlISize(1, 1));
+  builder.SetDartEntrypoint("skip_headless_frames");
+  builder.GetProjectArgs().enable_headless_rendering = true;
+
+  fml::AutoResetWaitableEvent ready_latch;
+  context.AddFfiNativeCallback(
+      "SignalNativeTest",
+      CREATE_FFI_LAMBDA([&ready_latch]() { ready_latch.Signal(); }));
+  std::atomic<int> begun_frames = 0;
+  context.AddFfiNativeCallback(
+      "SignalNativeCount",
+      CREATE_FFI_LAMBDA([&begun_frames](int64_t micros) { begun_frames++; }));
+
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+  ready_latch.Wait();
+
+  struct Frame {
+    bool called = false;
+    bool rendered = true;
+    fml::AutoResetWaitableEvent latch;
+  } frame;
+  uint32_t pixel = 0;
+  FlutterHeadlessFrameRequest request = {
+      .struct_size = sizeof(FlutterHeadlessFrameRequest),
+      .buffer = &pixel,
+      .row_bytes = sizeof(pixel),
+      .height = 1,
+      .callback =
+          [](bool rendered, void* user_data) {
+            auto* frame = static_cast<Frame*>(user_data);
+            frame->called = true;
+            frame->rendered = rendered;
+            frame->latch.Signal();
+          },
+      .user_data = &frame,
+  };
+  ASSERT_EQ(FlutterEngineRenderHeadlessFrames(engine.get(), &request, 1),
+            kSuccess);
+  frame.latch.Wait();
+
+  // The frame was begun for the request, and failed because the application
+  // did not render it.
+  EXPECT_TRUE(frame.called);
+  EXPECT_FALSE(frame.rendered);
+  EXPECT_EQ(begun_frames, 1);
+}
+
+TEST_F(EmbedderTest, MustNotRenderHeadlessFramesWithoutHeadlessMode) {
+  auto& context = GetEmbedderContext<EmbedderTestContextSoftware>();
+  EmbedderConfigBuilder builder(context);
+  builder.SetSurface(DlISize(1, 1));
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+
+  uint32_t pixel = 0;
+  FlutterHeadlessFrameRequest request = {
+      .struct_size = sizeof(FlutterHeadlessFrameRequest),
+      .buffer = &pixel,
+      .row_bytes = sizeof(pixel),
+      .height = 1,
+      .callback = [](bool rendered, void* user_data) {},
+  };
+  EXPECT_EQ(FlutterEngineRenderHeadlessFrames(engine.get(), &request, 1),
+            kInvalidArguments);
+}
+
+TEST_F(EmbedderTest, MustNotRunHeadlessWithCustomCompositor) {
+  auto& context = GetEmbedderContext<EmbedderTestContextSoftware>();
+  EmbedderConfigBuilder builder(context);
+  builder.SetSurface(DlISize(1, 1));
+  builder.SetCompositor();
+  builder.GetProjectArgs().enable_headless_rendering = true;
+  auto engine = builder.LaunchEngine();
+  ASSERT_FALSE(engine.is_valid());
+}
+
 TEST_F(EmbedderTest, CanRenderImplicitView) {
   auto& context = GetEmbedderContext<EmbedderTestContextSoftware>();
 
@@ -2241,6 +2591,27 @@ TEST_F(EmbedderTest, CanSendViewFocusEvent) {
             "2 ViewFocusState.unfocused ViewFocusDirection.backward");
 }
 
+TEST_F(EmbedderTest, CanGetFrameTimingStats) {
+  auto& context = GetEmbedderContext<EmbedderTestContextSoftware>();
+  EmbedderConfigBuilder builder(context);
+  builder.SetSurface(DlISize(1, 1));
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+
+  ASSERT_EQ(FlutterEngineGetFrameTimingStats(engine.get(), false, nullptr),
+            kInvalidArguments);
+
+  FlutterFrameTimingStats stats = {};
+  ASSERT_EQ(FlutterEngineGetFrameTimingStats(engine.get(), false, &stats),
+            kInvalidArguments);
+
+  stats.struct_size = sizeof(FlutterFrameTimingStats);
+  ASSERT_EQ(FlutterEngineGetFrameTimingStats(engine.get(), true, &stats),
+            kSuccess);
+  ASSERT_LE(stats.missed_frame_count, stats.frame_count);
+  ASSERT_LE(stats.total.p50_us, stats.total.p99_us);
+}
+
 //------------------------------------------------------------------------------
 /// Test that the backing store is created with the correct view ID, is used
 /// for the correct view, and is cached according to their views.
@@ -14,6 +14,7 @@
 #include "flutter/shell/platform/linux/fl_compositor_opengl_shader.h"
 #include "flutter/shell/platform/linux/fl_engine_private.h"
 #include "flutter/shell/platform/linux/fl_framebuffer.h"
+#include "flutter/shell/platform/linux/fl_layer_region.h"
 
 struct _FlCompositorOpenGL {
   GObject parent_instance;
@@ -94,12 +95,20 @@ FlCompositorOpenGL* fl_compositor_opengl_new(FlOpenGLManager* opengl_manager) {
   return self;
 }
 
+// Sets the scissor box to @rect, which is in frame coordinates (top left
+// origin) while OpenGL uses a bottom left origin.
+static void set_scissor(const cairo_rectangle_int_t* rect, size_t height) {
+  glScissor(rect->x, height - rect->y - rect->height, rect->width,
+            rect->height);
+}
+
 static void composite_layer(FlCompositorOpenGL* self,
                             FlFramebuffer* framebuffer,
                             double x,
                             double y,
                             int width,
-                            int height) {
+                            int height,
+                            const cairo_region_t* region) {
   size_t texture_width = fl_framebuffer_get_width(framebuffer);
   size_t texture_height = fl_framebuffer_get_height(framebuffer);
   fl_compositor_opengl_shader_set_offset(self->shader, (2 * x / width) - 1.0,
@@ -110,14 +119,45 @@ static void composite_layer(FlCompositorOpenGL* self,
   GLuint texture_id = fl_framebuffer_get_texture_id(framebuffer);
   glBindTexture(GL_TEXTURE_2D, texture_id);
 
-  glDrawArrays(GL_TRIANGLES, 0, 6);
+  // Only draw the parts of the layer with content.
+  glEnable(GL_SCISSOR_TEST);
+  int n_rects = cairo_region_num_rectangles(region);
+  for (int i = 0; i < n_rects; i++) {
+    cairo_rectangle_int_t rect;
+    cairo_region_get_rectangle(region, i, &rect);
+    set_scissor(&rect, height);
+    glDrawArrays(GL_TRIANGLES, 0, 6);
+  }
+  glDisable(GL_SCISSOR_TEST);
 }
 
-void fl_compositor_opengl_composite_layers(FlCompositorOpenGL* self,
-                                           const FlutterLayer** layers,
-                                           size_t layers_count) {
+// Copies the parts of the layer in @framebuffer with content into the bound
+// framebuffer.
+static void blit_layer(FlFramebuffer* framebuffer,
+                       const cairo_region_t* region,
+                       size_t height) {
+  glBindFramebuffer(GL_READ_FRAMEBUFFER, fl_framebuffer_get_id(framebuffer));
+  int n_rects = cairo_region_num_rectangles(region);
+  for (int i = 0; i < n_rects; i++) {
+    cairo_rectangle_int_t rect;
+    cairo_region_get_rectangle(region, i, &rect);
+    GLint x0 = rect.x;
+    GLint y0 = height - rect.y - rect.height;
+    GLint x1 = rect.x + rect.width;
+    GLint y1 = height - rect.y;
+    glBlitFramebuffer(x0, y0, x1, y1, x0, y0, x1, y1, GL_COLOR_BUFFER_BIT,
+                      GL_NEAREST);
+  }
+}
+
+cairo_region_t* fl_compositor_opengl_composite_layers(
+    FlCompositorOpenGL* self,
+    const FlutterLayer** layers,
+    size_t layers_count,
+    const cairo_region_t* previous_region) {
   if (layers_count == 0) {
-    return;
+    return previous_region != nullptr ? cairo_region_copy(previous_region)
+                                      : cairo_region_create();
   }
 
   // Save bindings that are set by this function.  All bindings must be restored
@@ -134,6 +174,10 @@ void fl_compositor_opengl_composite_layers(FlCompositorOpenGL* self,
   GLint saved_current_program;
   glGetIntegerv(GL_CURRENT_PROGRAM, &saved_current_program);
   GLboolean saved_scissor_test = glIsEnabled(GL_SCISSOR_TEST);
+  GLint saved_scissor_box[4];
+  glGetIntegerv(GL_SCISSOR_BOX, saved_scissor_box);
+  GLfloat saved_clear_color[4];
+  glGetFloatv(GL_COLOR_CLEAR_VALUE, saved_clear_color);
   GLboolean saved_blend = glIsEnabled(GL_BLEND);
   GLint saved_src_rgb;
   glGetIntegerv(GL_BLEND_SRC_RGB, &saved_src_rgb);
@@ -147,6 +191,22 @@ void fl_compositor_opengl_composite_layers(FlCompositorOpenGL* self,
   size_t width = layers[0]->size.width;
   size_t height = layers[0]->size.height;
 
+  // Find the parts of each layer with content, and the first layer that can be
+  // blitted as it replaces the contents of the framebuffer where it paints.
+  g_autoptr(GPtrArray) layer_regions = g_ptr_array_new_with_free_func(
+      reinterpret_cast<GDestroyNotify>(cairo_region_destroy));
+  cairo_region_t* painted_region = cairo_region_create();
+  const cairo_region_t* blit_region = nullptr;
+  for (size_t i = 0; i < layers_count; ++i) {
+    cairo_region_t* region = fl_layer_region_new(layers[i]);
+    if (blit_region == nullptr && self->can_blit &&
+        layers[i]->type == kFlutterLayerContentTypeBackingStore) {
+      blit_region = region;
+    }
+    cairo_region_union(painted_region, region);
+    g_ptr_array_add(layer_regions, region);
+  }
+
   // FIXME(robert-ancell): The vertex array is the same for all views, but
   // cannot be shared in OpenGL. Find a way to not generate this every time.
   GLuint vao;
@@ -163,9 +223,34 @@ void fl_compositor_opengl_composite_layers(FlCompositorOpenGL* self,
   // See OpenGL specification version 4.6, section 18.3.1.
   glDisable(GL_SCISSOR_TEST);
 
-  gboolean first_layer = TRUE;
+  // Clear what the previous frame painted and this frame doesn't, and where
+  // layers are blended, keeping the rest of the framebuffer.
+  cairo_region_t* clear_region =
+      previous_region != nullptr
+          ? cairo_region_copy(previous_region)
+          : fl_layer_region_new_for_frame(width, height);
+  cairo_region_union(clear_region, painted_region);
+  if (blit_region != nullptr) {
+    cairo_region_subtract(clear_region, blit_region);
+  }
+  int n_clear_rects = cairo_region_num_rectangles(clear_region);
+  if (n_clear_rects > 0) {
+    glClearColor(0.0, 0.0, 0.0, 0.0);
+    glEnable(GL_SCISSOR_TEST);
+    for (int i = 0; i < n_clear_rects; i++) {
+      cairo_rectangle_int_t rect;
+      cairo_region_get_rectangle(clear_region, i, &rect);
+      set_scissor(&rect, height);
+      glClear(GL_COLOR_BUFFER_BIT);
+    }
+    glDisable(GL_SCISSOR_TEST);
+  }
+  cairo_region_destroy(clear_region);
+
   for (size_t i = 0; i < layers_count; ++i) {
     const FlutterLayer* layer = layers[i];
+    const cairo_region_t* region =
+        static_cast<cairo_region_t*>(g_ptr_array_index(layer_regions, i));
     switch (layer->type) {
       case kFlutterLayerContentTypeBackingStore: {
         const FlutterBackingStore* backing_store = layer->backing_store;
@@ -174,19 +259,12 @@ void fl_compositor_opengl_composite_layers(FlCompositorOpenGL* self,
         // The first layer can be blitted, and following layers composited with
         // this. If glBlitFramebuffer is unavailable, composite the first layer
         // with the shader instead.
-        if (first_layer && self->can_blit) {
-          glBindFramebuffer(GL_READ_FRAMEBUFFER,
-                            fl_framebuffer_get_id(layer_framebuffer));
-          glBlitFramebuffer(layer->offset.x, layer->offset.y, layer->size.width,
-                            layer->size.height, layer->offset.x,
-                            layer->offset.y, layer->size.width,
-                            layer->size.height, GL_COLOR_BUFFER_BIT,
-                            GL_NEAREST);
+        if (region == blit_region) {
+          blit_layer(layer_framebuffer, region, height);
         } else {
           composite_layer(self, layer_framebuffer, layer->offset.x,
-                          layer->offset.y, width, height);
+                          layer->offset.y, width, height, region);
         }
-        first_layer = FALSE;
       } break;
       case kFlutterLayerContentTypePlatformView: {
         // TODO(robert-ancell) Not implemented -
@@ -208,6 +286,10 @@ void fl_compositor_opengl_composite_layers(FlCompositorOpenGL* self,
   } else {
     glDisable(GL_SCISSOR_TEST);
   }
+  glScissor(saved_scissor_box[0], saved_scissor_box[1], saved_scissor_box[2],
+            saved_scissor_box[3]);
+  glClearColor(saved_clear_color[0], saved_clear_color[1],
+               saved_clear_color[2], saved_clear_color[3]);
 
   glBindTexture(GL_TEXTURE_2D, saved_texture_binding);
   glBindVertexArray(saved_vao_binding);
@@ -216,4 +298,6 @@ void fl_compositor_opengl_composite_layers(FlCompositorOpenGL* self,
   glUseProgram(saved_current_program);
   glBlendFuncSeparate(saved_src_rgb, saved_dst_rgb, saved_src_alpha,
                       saved_dst_alpha);
+
+  return painted_region;
 }
@@ -44,14 +44,25 @@ FlCompositorOpenGL* fl_compositor_opengl_new(FlOpenGLManager* opengl_manager);
  * @compositor: an #FlCompositorOpenGL.
  * @layers: layers to be composited.
  * @layers_count: number of layers.
+ * @previous_region: (allow-none): the region of the framebuffer the previous
+ * frame painted, or %NULL if the contents of the framebuffer are unknown.
  *
  * Composite @layers into the OpenGL framebuffer bound to the current OpenGL
  * context. The caller is responsible for binding the target framebuffer before
  * calling this function.
+ *
+ * Only the region of each layer that contains Flutter content is composited.
+ * The rest of the framebuffer is kept, and only cleared where the previous
+ * frame painted. The pixels that may have changed are the union of
+ * @previous_region and the returned region.
+ *
+ * Returns: the region of the framebuffer @layers painted, in frame coordinates.
  */
-void fl_compositor_opengl_composite_layers(FlCompositorOpenGL* compositor,
-                                           const FlutterLayer** layers,
-                                           size_t layers_count);
+cairo_region_t* fl_compositor_opengl_composite_layers(
+    FlCompositorOpenGL* compositor,
+    const FlutterLayer** layers,
+    size_t layers_count,
+    const cairo_region_t* previous_region);
 
 G_END_DECLS
 
@@ -58,7 +58,8 @@ TEST_F(FlCompositorOpenGLTest, Composite) {
   // Composite the layers from a thread, as is done on the raster thread.
   std::thread([&]() {
     glBindFramebuffer(GL_DRAW_FRAMEBUFFER, fl_framebuffer_get_id(target));
-    fl_compositor_opengl_composite_layers(compositor, layers, 1);
+    cairo_region_destroy(
+        fl_compositor_opengl_composite_layers(compositor, layers, 1, nullptr));
   }).join();
 }
 
@@ -96,7 +97,8 @@ TEST_F(FlCompositorOpenGLTest, RestoresGLState) {
   // Composite the layers.
   std::thread([&]() {
     glBindFramebuffer(GL_DRAW_FRAMEBUFFER, fl_framebuffer_get_id(target));
-    fl_compositor_opengl_composite_layers(compositor, layers, 1);
+    cairo_region_destroy(
+        fl_compositor_opengl_composite_layers(compositor, layers, 1, nullptr));
   }).join();
 
   GLuint texture_2d_binding;
@@ -137,7 +139,8 @@ TEST_F(FlCompositorOpenGLTest, BlitFramebuffer) {
 
   std::thread([&]() {
     glBindFramebuffer(GL_DRAW_FRAMEBUFFER, fl_framebuffer_get_id(target));
-    fl_compositor_opengl_composite_layers(compositor, layers, 1);
+    cairo_region_destroy(
+        fl_compositor_opengl_composite_layers(compositor, layers, 1, nullptr));
   }).join();
 }
 
@@ -176,7 +179,8 @@ TEST_F(FlCompositorOpenGLTest, BlitFramebufferExtension) {
 
   std::thread([&]() {
     glBindFramebuffer(GL_DRAW_FRAMEBUFFER, fl_framebuffer_get_id(target));
-    fl_compositor_opengl_composite_layers(compositor, layers, 1);
+    cairo_region_destroy(
+        fl_compositor_opengl_composite_layers(compositor, layers, 1, nullptr));
   }).join();
 }
 
@@ -210,7 +214,8 @@ TEST_F(FlCompositorOpenGLTest, NoBlitFramebuffer) {
 
   std::thread([&]() {
     glBindFramebuffer(GL_DRAW_FRAMEBUFFER, fl_framebuffer_get_id(target));
-    fl_compositor_opengl_composite_layers(compositor, layers, 1);
+    cairo_region_destroy(
+        fl_compositor_opengl_composite_layers(compositor, layers, 1, nullptr));
   }).join();
 }
 
@@ -245,6 +250,64 @@ TEST_F(FlCompositorOpenGLTest, BlitFramebufferNvidia) {
 
   std::thread([&]() {
     glBindFramebuffer(GL_DRAW_FRAMEBUFFER, fl_framebuffer_get_id(target));
-    fl_compositor_opengl_composite_layers(compositor, layers, 1);
+    cairo_region_destroy(
+        fl_compositor_opengl_composite_layers(compositor, layers, 1, nullptr));
   }).join();
 }
+
+TEST_F(FlCompositorOpenGLTest, BlitPaintRegion) {
+  constexpr size_t width = 100;
+  constexpr size_t height = 100;
+
+  // OpenGL 3.0
+  ON_CALL(epoxy, glGetString(GL_VENDOR))
+      .WillByDefault(
+          ::testing::Return(reinterpret_cast<const GLubyte*>("Intel")));
+  ON_CALL(epoxy, epoxy_is_desktop_gl).WillByDefault(::testing::Return(true));
+  EXPECT_CALL(epoxy, epoxy_gl_version).WillRepeatedly(::testing::Return(30));
+
+  // Only the painted rectangle is blitted, flipped to the bottom left origin
+  // used by OpenGL.
+  EXPECT_CALL(epoxy, glBlitFramebuffer(10, 40, 30, 80, 10, 40, 30, 80,
+                                       GL_COLOR_BUFFER_BIT, GL_NEAREST));
+
+  compositor = fl_compositor_opengl_new(opengl_manager);
+
+  g_autoptr(FlFramebuffer) target =
+      fl_framebuffer_new(GL_RGBA, width, height, FALSE);
+  g_autoptr(FlFramebuffer) framebuffer =
+      fl_framebuffer_new(GL_RGB, width, height, FALSE);
+  FlutterBackingStore backing_store = {
+      .type = kFlutterBackingStoreTypeOpenGL,
+      .open_gl = {.framebuffer = {.user_data = framebuffer}}};
+  FlutterRect paint_rect = {.left = 10, .top = 20, .right = 30, .bottom = 60};
+  FlutterRegion paint_region = {.struct_size = sizeof(FlutterRegion),
+                                .rects_count = 1,
+                                .rects = &paint_rect};
+  FlutterBackingStorePresentInfo present_info = {
+      .struct_size = sizeof(FlutterBackingStorePresentInfo),
+      .paint_region = &paint_region};
+  FlutterLayer layer = {.type = kFlutterLayerContentTypeBackingStore,
+                        .backing_store = &backing_store,
+                        .offset = {0, 0},
+                        .size = {width, height},
+                        .backing_store_present_info = &present_info};
+  const FlutterLayer* layers[1] = {&layer};
+
+  cairo_region_t* painted_region = nullptr;
+  std::thread([&]() {
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, fl_framebuffer_get_id(target));
+    painted_region =
+        fl_compositor_opengl_composite_layers(compositor, layers, 1, nullptr);
+  }).join();
+
+  // The painted region is reported in frame coordinates.
+  ASSERT_EQ(cairo_region_num_rectangles(painted_region), 1);
+  cairo_rectangle_int_t rect;
+  cairo_region_get_rectangle(painted_region, 0, &rect);
+  EXPECT_EQ(rect.x, 10);
+  EXPECT_EQ(rect.y, 20);
+  EXPECT_EQ(rect.width, 20);
+  EXPECT_EQ(rect.height, 40);
+  cairo_region_destroy(painted_region);
+}
@@ -4,6 +4,8 @@
 
 #include "fl_compositor_software.h"
 
+#include "flutter/shell/platform/linux/fl_layer_region.h"
+
 struct _FlCompositorSoftware {
   GObject parent_instance;
 };
@@ -20,30 +22,84 @@ FlCompositorSoftware* fl_compositor_software_new() {
       g_object_new(fl_compositor_software_get_type(), nullptr));
 }
 
-gboolean fl_compositor_software_composite_layers(FlCompositorSoftware* self,
-                                                 cairo_t* cr,
-                                                 const FlutterLayer** layers,
-                                                 size_t layers_count) {
+// Adds the rectangles of @region to the current path of @cr.
+static void add_region_to_path(cairo_t* cr, const cairo_region_t* region) {
+  int n_rects = cairo_region_num_rectangles(region);
+  for (int i = 0; i < n_rects; i++) {
+    cairo_rectangle_int_t rect;
+    cairo_region_get_rectangle(region, i, &rect);
+    cairo_rectangle(cr, rect.x, rect.y, rect.width, rect.height);
+  }
+}
+
+cairo_region_t* fl_compositor_software_composite_layers(
+    FlCompositorSoftware* self,
+    cairo_t* cr,
+    const FlutterLayer** layers,
+    size_t layers_count,
+    const cairo_region_t* previous_region) {
   if (layers_count == 0) {
-    return TRUE;
+    return previous_region != nullptr ? cairo_region_copy(previous_region)
+                                      : cairo_region_create();
   }
 
-  // TODO(robert-ancell): Support multiple layers
-  if (layers_count == 1) {
-    const FlutterLayer* layer = layers[0];
-    g_assert(layer->type == kFlutterLayerContentTypeBackingStore);
-    g_assert(layer->backing_store->type == kFlutterBackingStoreTypeSoftware);
+  size_t width = layers[0]->size.width;
+  size_t height = layers[0]->size.height;
+
+  // Find the parts of each layer with content.
+  g_autoptr(GPtrArray) layer_regions = g_ptr_array_new_with_free_func(
+      reinterpret_cast<GDestroyNotify>(cairo_region_destroy));
+  cairo_region_t* painted_region = cairo_region_create();
+  for (size_t i = 0; i < layers_count; i++) {
+    g_assert(layers[i]->type == kFlutterLayerContentTypeBackingStore);
+    g_assert(layers[i]->backing_store->type ==
+             kFlutterBackingStoreTypeSoftware);
+    cairo_region_t* region = fl_layer_region_new(layers[i]);
+    cairo_region_union(painted_region, region);
+    g_ptr_array_add(layer_regions, region);
+  }
+
+  cairo_save(cr);
+
+  // Clear what the previous frame painted and this frame doesn't, and where
+  // layers are blended, keeping the rest of the surface.
+  cairo_region_t* clear_region =
+      previous_region != nullptr
+          ? cairo_region_copy(previous_region)
+          : fl_layer_region_new_for_frame(width, height);
+  cairo_region_union(clear_region, painted_region);
+  cairo_region_subtract(
+      clear_region,
+      static_cast<cairo_region_t*>(g_ptr_array_index(layer_regions, 0)));
+  if (!cairo_region_is_empty(clear_region)) {
+    cairo_set_operator(cr, CAIRO_OPERATOR_CLEAR);
+    add_region_to_path(cr, clear_region);
+    cairo_fill(cr);
+  }
+  cairo_region_destroy(clear_region);
+
+  for (size_t i = 0; i < layers_count; i++) {
+    const FlutterLayer* layer = layers[i];
     const FlutterBackingStore* backing_store = layer->backing_store;
+    const cairo_region_t* region =
+        static_cast<cairo_region_t*>(g_ptr_array_index(layer_regions, i));
 
     cairo_surface_t* surface = cairo_image_surface_create_for_data(
         static_cast<unsigned char*>(
             const_cast<void*>(backing_store->software.allocation)),
         CAIRO_FORMAT_ARGB32, backing_store->software.row_bytes / 4,
         backing_store->software.height, backing_store->software.row_bytes);
-    cairo_set_source_surface(cr, surface, 0.0, 0.0);
-    cairo_paint(cr);
+    // The first layer replaces the contents of the surface, and following
+    // layers are blended over it.
+    cairo_set_operator(cr,
+                       i == 0 ? CAIRO_OPERATOR_SOURCE : CAIRO_OPERATOR_OVER);
+    cairo_set_source_surface(cr, surface, layer->offset.x, layer->offset.y);
+    add_region_to_path(cr, region);
+    cairo_fill(cr);
     cairo_surface_destroy(surface);
   }
 
-  return TRUE;
+  cairo_restore(cr);
+
+  return painted_region;
 }
@@ -45,17 +45,25 @@ FlCompositorSoftware* fl_compositor_software_new();
  * (%kFlutterLayerContentTypeBackingStore) backed by a software backing store
  * (%kFlutterBackingStoreTypeSoftware).
  * @layers_count: number of layers.
+ * @previous_region: (allow-none): the region of the surface the previous frame
+ * painted, or %NULL if the contents of the surface are unknown.
  *
  * Combines and draws the provided layers into @cr. The caller is responsible
  * for managing the surface that @cr writes into.
  *
- * Returns %TRUE if successful.
+ * Only the region of each layer that contains Flutter content is drawn. The
+ * rest of the surface is kept, and only cleared where the previous frame
+ * painted. The pixels that may have changed are the union of @previous_region
+ * and the returned region.
+ *
+ * Returns: the region of the surface @layers painted, in frame coordinates.
  */
-gboolean fl_compositor_software_composite_layers(
+cairo_region_t* fl_compositor_software_composite_layers(
     FlCompositorSoftware* compositor,
     cairo_t* cr,
     const FlutterLayer** layers,
-    size_t layers_count);
+    size_t layers_count,
+    const cairo_region_t* previous_region);
 
 G_END_DECLS
 
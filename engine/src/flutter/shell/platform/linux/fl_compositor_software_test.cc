@@ -43,14 +43,152 @@ TEST_F(FlCompositorSoftwareTest, Render) {
   cairo_surface_t* surface = cairo_image_surface_create_for_data(
       image_data, CAIRO_FORMAT_ARGB32, width, height, stride);
   cairo_t* cr = cairo_create(surface);
-  EXPECT_TRUE(
-      fl_compositor_software_composite_layers(compositor, cr, layers, 1));
+  cairo_region_t* painted_region = fl_compositor_software_composite_layers(
+      compositor, cr, layers, 1, nullptr);
   cairo_surface_flush(surface);
 
   // The layer was drawn into the surface.
   uint32_t* pixels = reinterpret_cast<uint32_t*>(image_data);
   EXPECT_EQ(pixels[50 * (stride / 4) + 50], 0xFFFFFFFFu);
 
+  // Without a paint region the whole layer is painted.
+  cairo_rectangle_int_t extents;
+  cairo_region_get_extents(painted_region, &extents);
+  EXPECT_EQ(extents.x, 0);
+  EXPECT_EQ(extents.y, 0);
+  EXPECT_EQ(extents.width, static_cast<int>(width));
+  EXPECT_EQ(extents.height, static_cast<int>(height));
+
+  cairo_region_destroy(painted_region);
+  cairo_destroy(cr);
+  cairo_surface_destroy(surface);
+}
+
+TEST_F(FlCompositorSoftwareTest, PaintRegion) {
+  constexpr size_t width = 100;
+  constexpr size_t height = 100;
+  size_t row_bytes = width * 4;
+  g_autofree unsigned char* layer_data =
+      static_cast<unsigned char*>(malloc(height * row_bytes));
+  // Fill the layer with an opaque white, of which only the left half has
+  // content.
+  memset(layer_data, 0xFF, height * row_bytes);
+  FlutterBackingStore backing_store = {
+      .type = kFlutterBackingStoreTypeSoftware,
+      .software = {
+          .allocation = layer_data, .row_bytes = row_bytes, .height = height}};
+  FlutterRect paint_rect = {.left = 0, .top = 0, .right = 50, .bottom = 100};
+  FlutterRegion paint_region = {.struct_size = sizeof(FlutterRegion),
+                                .rects_count = 1,
+                                .rects = &paint_rect};
+  FlutterBackingStorePresentInfo present_info = {
+      .struct_size = sizeof(FlutterBackingStorePresentInfo),
+      .paint_region = &paint_region};
+  FlutterLayer layer = {.type = kFlutterLayerContentTypeBackingStore,
+                        .backing_store = &backing_store,
+                        .offset = {0, 0},
+                        .size = {width, height},
+                        .backing_store_present_info = &present_info};
+  const FlutterLayer* layers[1] = {&layer};
+
+  // The surface contains a previous frame that painted its top half. The rest
+  // is filled with opaque red, to check it is left alone.
+  int stride = cairo_format_stride_for_width(CAIRO_FORMAT_ARGB32, width);
+  g_autofree unsigned char* image_data =
+      static_cast<unsigned char*>(malloc(height * stride));
+  uint32_t* pixels = reinterpret_cast<uint32_t*>(image_data);
+  for (size_t i = 0; i < height * (stride / 4); i++) {
+    pixels[i] = 0xFFFF0000;
+  }
+  cairo_surface_t* surface = cairo_image_surface_create_for_data(
+      image_data, CAIRO_FORMAT_ARGB32, width, height, stride);
+  cairo_rectangle_int_t previous_rect = {
+      .x = 0, .y = 0, .width = 100, .height = 50};
+  cairo_region_t* previous_region =
+      cairo_region_create_rectangle(&previous_rect);
+
+  cairo_t* cr = cairo_create(surface);
+  cairo_region_t* painted_region = fl_compositor_software_composite_layers(
+      compositor, cr, layers, 1, previous_region);
+  cairo_surface_flush(surface);
+
+  // The painted half of the layer was drawn.
+  EXPECT_EQ(pixels[25 * (stride / 4) + 25], 0xFFFFFFFFu);
+  EXPECT_EQ(pixels[75 * (stride / 4) + 25], 0xFFFFFFFFu);
+  // What only the previous frame painted was cleared.
+  EXPECT_EQ(pixels[25 * (stride / 4) + 75], 0x00000000u);
+  // The rest of the surface was kept.
+  EXPECT_EQ(pixels[75 * (stride / 4) + 75], 0xFFFF0000u);
+
+  ASSERT_EQ(cairo_region_num_rectangles(painted_region), 1);
+  cairo_rectangle_int_t rect;
+  cairo_region_get_rectangle(painted_region, 0, &rect);
+  EXPECT_EQ(rect.x, 0);
+  EXPECT_EQ(rect.y, 0);
+  EXPECT_EQ(rect.width, 50);
+  EXPECT_EQ(rect.height, 100);
+
+  cairo_region_destroy(painted_region);
+  cairo_region_destroy(previous_region);
+  cairo_destroy(cr);
+  cairo_surface_destroy(surface);
+}
+
+TEST_F(FlCompositorSoftwareTest, MultipleLayers) {
+  constexpr size_t width = 100;
+  constexpr size_t height = 100;
+  size_t row_bytes = width * 4;
+  // An opaque white layer, and an opaque black layer above it with content in
+  // a small square.
+  g_autofree unsigned char* layer0_data =
+      static_cast<unsigned char*>(malloc(height * row_bytes));
+  memset(layer0_data, 0xFF, height * row_bytes);
+  g_autofree uint32_t* layer1_data =
+      static_cast<uint32_t*>(malloc(height * row_bytes));
+  for (size_t i = 0; i < width * height; i++) {
+    layer1_data[i] = 0xFF000000;
+  }
+  FlutterBackingStore backing_store0 = {
+      .type = kFlutterBackingStoreTypeSoftware,
+      .software = {
+          .allocation = layer0_data, .row_bytes = row_bytes, .height = height}};
+  FlutterBackingStore backing_store1 = {
+      .type = kFlutterBackingStoreTypeSoftware,
+      .software = {
+          .allocation = layer1_data, .row_bytes = row_bytes, .height = height}};
+  FlutterRect paint_rect = {.left = 20, .top = 20, .right = 40, .bottom = 40};
+  FlutterRegion paint_region = {.struct_size = sizeof(FlutterRegion),
+                                .rects_count = 1,
+                                .rects = &paint_rect};
+  FlutterBackingStorePresentInfo present_info = {
+      .struct_size = sizeof(FlutterBackingStorePresentInfo),
+      .paint_region = &paint_region};
+  FlutterLayer layer0 = {.type = kFlutterLayerContentTypeBackingStore,
+                         .backing_store = &backing_store0,
+                         .offset = {0, 0},
+                         .size = {width, height}};
+  FlutterLayer layer1 = {.type = kFlutterLayerContentTypeBackingStore,
+                         .backing_store = &backing_store1,
+                         .offset = {0, 0},
+                         .size = {width, height},
+                         .backing_store_present_info = &present_info};
+  const FlutterLayer* layers[2] = {&layer0, &layer1};
+
+  cairo_surface_t* surface =
+      cairo_image_surface_create(CAIRO_FORMAT_ARGB32, width, height);
+  cairo_t* cr = cairo_create(surface);
+  cairo_region_t* painted_region = fl_compositor_software_composite_layers(
+      compositor, cr, layers, 2, nullptr);
+  cairo_surface_flush(surface);
+
+  // The second layer is only drawn where it has content.
+  int stride = cairo_image_surface_get_stride(surface);
+  uint32_t* pixels =
+      reinterpret_cast<uint32_t*>(cairo_image_surface_get_data(surface));
+  EXPECT_EQ(pixels[30 * (stride / 4) + 30], 0xFF000000u);
+  EXPECT_EQ(pixels[60 * (stride / 4) + 60], 0xFFFFFFFFu);
+
+  cairo_region_destroy(painted_region);
   cairo_destroy(cr);
   cairo_surface_destroy(surface);
 }
@@ -0,0 +1,52 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/linux/fl_layer_region.h"
+
+#include <cmath>
+
+cairo_region_t* fl_layer_region_new(const FlutterLayer* layer) {
+  if (layer->type != kFlutterLayerContentTypeBackingStore) {
+    return cairo_region_create();
+  }
+
+  cairo_rectangle_int_t bounds = {
+      .x = static_cast<int>(layer->offset.x),
+      .y = static_cast<int>(layer->offset.y),
+      .width = static_cast<int>(layer->size.width),
+      .height = static_cast<int>(layer->size.height)};
+  const FlutterBackingStorePresentInfo* present_info =
+      layer->backing_store_present_info;
+  if (present_info == nullptr || present_info->paint_region == nullptr) {
+    return cairo_region_create_rectangle(&bounds);
+  }
+
+  // Round the rectangles outwards so partially covered pixels are included.
+  cairo_region_t* region = cairo_region_create();
+  const FlutterRegion* paint_region = present_info->paint_region;
+  for (size_t i = 0; i < paint_region->rects_count; i++) {
+    const FlutterRect* rect = &paint_region->rects[i];
+    int left = static_cast<int>(floor(rect->left));
+    int top = static_cast<int>(floor(rect->top));
+    int right = static_cast<int>(ceil(rect->right));
+    int bottom = static_cast<int>(ceil(rect->bottom));
+    if (right <= left || bottom <= top) {
+      continue;
+    }
+    cairo_rectangle_int_t r = {
+        .x = left, .y = top, .width = right - left, .height = bottom - top};
+    cairo_region_union_rectangle(region, &r);
+  }
+  cairo_region_intersect_rectangle(region, &bounds);
+
+  return region;
+}
+
+cairo_region_t* fl_layer_region_new_for_frame(size_t width, size_t height) {
+  cairo_rectangle_int_t rect = {.x = 0,
+                                .y = 0,
+                                .width = static_cast<int>(width),
+                                .height = static_cast<int>(height)};
+  return cairo_region_create_rectangle(&rect);
+}
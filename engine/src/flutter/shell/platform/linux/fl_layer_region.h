@@ -0,0 +1,42 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_LINUX_FL_LAYER_REGION_H_
+#define FLUTTER_SHELL_PLATFORM_LINUX_FL_LAYER_REGION_H_
+
+#include <cairo/cairo.h>
+#include <glib.h>
+
+#include "flutter/shell/platform/embedder/embedder.h"
+
+G_BEGIN_DECLS
+
+/**
+ * fl_layer_region_new:
+ * @layer: a layer of a frame.
+ *
+ * Creates a region covering the pixels of the frame that @layer has content
+ * in. For backing store layers this is the paint region provided by the engine,
+ * clipped to the bounds of the layer. If the engine did not provide a paint
+ * region the whole layer is covered. Platform view layers cover nothing, as
+ * they are not composited.
+ *
+ * Returns: a new #cairo_region_t in frame coordinates (top left origin).
+ */
+cairo_region_t* fl_layer_region_new(const FlutterLayer* layer);
+
+/**
+ * fl_layer_region_new_for_frame:
+ * @width: width of the frame in pixels.
+ * @height: height of the frame in pixels.
+ *
+ * Creates a region covering a whole frame.
+ *
+ * Returns: a new #cairo_region_t.
+ */
+cairo_region_t* fl_layer_region_new_for_frame(size_t width, size_t height);
+
+G_END_DECLS
+
+#endif  // FLUTTER_SHELL_PLATFORM_LINUX_FL_LAYER_REGION_H_
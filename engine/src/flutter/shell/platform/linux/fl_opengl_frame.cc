@@ -8,6 +8,7 @@
 #include <epoxy/gl.h>
 
 #include "flutter/shell/platform/linux/fl_framebuffer.h"
+#include "flutter/shell/platform/linux/fl_layer_region.h"
 
 struct _FlOpenGLFrame {
   GObject parent_instance;
@@ -20,6 +21,10 @@ struct _FlOpenGLFrame {
 
   // Copy of the current frame in CPU memory (only set if shareable is FALSE).
   uint8_t* pixels;
+
+  // Region of the framebuffer the current frame painted, or NULL if the
+  // framebuffer has not been composited into yet.
+  cairo_region_t* painted_region;
 };
 
 G_DEFINE_TYPE(FlOpenGLFrame, fl_opengl_frame, G_TYPE_OBJECT)
@@ -36,6 +41,7 @@ static void fl_opengl_frame_finalize(GObject* object) {
   FlOpenGLFrame* self = FL_OPENGL_FRAME(object);
 
   g_clear_pointer(&self->pixels, g_free);
+  g_clear_pointer(&self->painted_region, cairo_region_destroy);
 
   G_OBJECT_CLASS(fl_opengl_frame_parent_class)->finalize(object);
 }
@@ -58,7 +64,8 @@ FlOpenGLFrame* fl_opengl_frame_new(gboolean shareable) {
 void fl_opengl_frame_composite(FlOpenGLFrame* self,
                                FlCompositorOpenGL* compositor,
                                const FlutterLayer** layers,
-                               size_t layers_count) {
+                               size_t layers_count,
+                               cairo_region_t* damage) {
   g_return_if_fail(FL_IS_OPENGL_FRAME(self));
 
   if (layers_count == 0) {
@@ -73,8 +80,12 @@ void fl_opengl_frame_composite(FlOpenGLFrame* self,
     // the renderer reports no frame rather than an empty framebuffer (a 0x0
     // framebuffer would otherwise be treated as a valid frame while matching
     // the "no frame" size of 0x0).
+    if (damage != nullptr && self->painted_region != nullptr) {
+      cairo_region_union(damage, self->painted_region);
+    }
     g_clear_object(&self->framebuffer);
     g_clear_pointer(&self->pixels, g_free);
+    g_clear_pointer(&self->painted_region, cairo_region_destroy);
     return;
   }
 
@@ -89,6 +100,7 @@ void fl_opengl_frame_composite(FlOpenGLFrame* self,
     g_clear_object(&self->framebuffer);
     self->framebuffer =
         fl_framebuffer_new(general_format, width, height, self->shareable);
+    g_clear_pointer(&self->painted_region, cairo_region_destroy);
 
     // If not shareable make a buffer to copy the frame pixels into.
     if (!self->shareable) {
@@ -105,17 +117,37 @@ void fl_opengl_frame_composite(FlOpenGLFrame* self,
   glBindFramebuffer(GL_DRAW_FRAMEBUFFER,
                     fl_framebuffer_get_id(self->framebuffer));
 
-  fl_compositor_opengl_composite_layers(compositor, layers, layers_count);
-
-  if (!self->shareable) {
+  cairo_region_t* painted_region = fl_compositor_opengl_composite_layers(
+      compositor, layers, layers_count, self->painted_region);
+
+  // Pixels may have changed wherever the previous or this frame painted.
+  cairo_region_t* changed_region =
+      self->painted_region != nullptr
+          ? self->painted_region
+          : fl_layer_region_new_for_frame(width, height);
+  cairo_region_union(changed_region, painted_region);
+  self->painted_region = painted_region;
+
+  // Copy the rows that changed. The pixels are stored bottom row first, as
+  // OpenGL uses a bottom left origin.
+  cairo_rectangle_int_t changed;
+  cairo_region_get_extents(changed_region, &changed);
+  if (!self->shareable && changed.height > 0) {
     GLint saved_read_framebuffer_binding;
     glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &saved_read_framebuffer_binding);
     glBindFramebuffer(GL_READ_FRAMEBUFFER,
                       fl_framebuffer_get_id(self->framebuffer));
-    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, self->pixels);
+    size_t y = height - changed.y - changed.height;
+    glReadPixels(0, y, width, changed.height, GL_RGBA, GL_UNSIGNED_BYTE,
+                 self->pixels + y * width * 4);
     glBindFramebuffer(GL_READ_FRAMEBUFFER, saved_read_framebuffer_binding);
   }
 
+  if (damage != nullptr) {
+    cairo_region_union(damage, changed_region);
+  }
+  cairo_region_destroy(changed_region);
+
   glBindFramebuffer(GL_DRAW_FRAMEBUFFER, saved_draw_framebuffer_binding);
 }
 
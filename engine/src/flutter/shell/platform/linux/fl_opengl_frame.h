@@ -43,15 +43,21 @@ FlOpenGLFrame* fl_opengl_frame_new(gboolean shareable);
  * @compositor: the #FlCompositorOpenGL to composite with.
  * @layers: layers to composite.
  * @layers_count: number of layers.
+ * @damage: (allow-none): a region to add the pixels that changed to, or %NULL.
  *
  * Composites @layers into the frame, (re)creating the underlying framebuffer to
  * match the frame size and copying the result into CPU memory when the frame is
  * not shareable. Must be called with an OpenGL context current.
+ *
+ * The framebuffer is kept between frames of the same size, so only the pixels
+ * the previous or the new frame paint are changed. Only those are copied into
+ * CPU memory.
  */
 void fl_opengl_frame_composite(FlOpenGLFrame* frame,
                                FlCompositorOpenGL* compositor,
                                const FlutterLayer** layers,
-                               size_t layers_count);
+                               size_t layers_count,
+                               cairo_region_t* damage);
 
 /**
  * fl_opengl_frame_get_size:
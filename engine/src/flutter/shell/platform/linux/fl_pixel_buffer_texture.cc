@@ -7,15 +7,60 @@
 #include <epoxy/gl.h>
 #include <gmodule.h>
 
+#include <cstring>
+
 #include "flutter/shell/platform/linux/fl_pixel_buffer_texture_private.h"
 
+// Number of frame slots. While the producer writes into one slot and the
+// raster thread uploads from another, the third holds the latest published
+// frame.
+static constexpr gint kFrameSlotCount = 3;
+
+// Flag set on the ready slot index when it holds a frame that has not been
+// uploaded yet.
+static constexpr gint kFrameFresh = 1 << 2;
+
+// Mask to get the slot index from the ready slot index.
+static constexpr gint kFrameSlotMask = kFrameFresh - 1;
+
+typedef struct {
+  uint8_t* pixels;
+  uint32_t width;
+  uint32_t height;
+} FlPixelBufferFrame;
+
 typedef struct {
   int64_t id;
   GLuint texture_id;
+
+  // Size of the storage allocated for the texture.
+  uint32_t texture_width;
+  uint32_t texture_height;
+
+  // TRUE if frames are uploaded through a pixel buffer object.
+  gboolean use_pixel_buffer;
+
+  // Pixel buffer object frames are uploaded through.
+  GLuint pixel_buffer_id;
+
+  // Frames published with fl_pixel_buffer_texture_begin_frame(). The producer
+  // owns the back slot and the raster thread owns the front slot. The ready
+  // slot holds the latest published frame, and is exchanged atomically with
+  // the other two so neither side ever waits for the other.
+  FlPixelBufferFrame frames[kFrameSlotCount];
+  gint back;
+  gint ready;
+  gint front;
+
+  // TRUE once a frame has been published.
+  gint has_frames;
 } FlPixelBufferTexturePrivate;
 
 static void fl_pixel_buffer_texture_iface_init(FlTextureInterface* iface);
 
+G_DEFINE_QUARK(fl_pixel_buffer_texture_error_quark,
+               fl_pixel_buffer_texture_error)
+
 G_DEFINE_TYPE_WITH_CODE(
     FlPixelBufferTexture,
     fl_pixel_buffer_texture,
@@ -57,10 +102,26 @@ static void fl_pixel_buffer_texture_dispose(GObject* object) {
     glDeleteTextures(1, &priv->texture_id);
     priv->texture_id = 0;
   }
+  if (priv->pixel_buffer_id) {
+    glDeleteBuffers(1, &priv->pixel_buffer_id);
+    priv->pixel_buffer_id = 0;
+  }
+  for (gint i = 0; i < kFrameSlotCount; i++) {
+    g_clear_pointer(&priv->frames[i].pixels, g_free);
+  }
 
   G_OBJECT_CLASS(fl_pixel_buffer_texture_parent_class)->dispose(object);
 }
 
+// Replaces the value of @atomic with @value, returning the old value.
+static gint atomic_int_exchange(gint* atomic, gint value) {
+  gint old_value;
+  do {
+    old_value = g_atomic_int_get(atomic);
+  } while (!g_atomic_int_compare_and_exchange(atomic, old_value, value));
+  return old_value;
+}
+
 static void check_gl_error(int line) {
   GLenum err = glGetError();
   if (err) {
@@ -68,22 +129,15 @@ static void check_gl_error(int line) {
   }
 }
 
-gboolean fl_pixel_buffer_texture_populate(FlPixelBufferTexture* texture,
-                                          uint32_t width,
-                                          uint32_t height,
-                                          FlutterOpenGLTexture* opengl_texture,
-                                          GError** error) {
-  FlPixelBufferTexture* self = FL_PIXEL_BUFFER_TEXTURE(texture);
+// Uploads @pixels into the texture, creating the texture if required.
+static void upload_pixels(FlPixelBufferTexture* self,
+                          const uint8_t* pixels,
+                          uint32_t width,
+                          uint32_t height) {
   FlPixelBufferTexturePrivate* priv =
       reinterpret_cast<FlPixelBufferTexturePrivate*>(
           fl_pixel_buffer_texture_get_instance_private(self));
 
-  const uint8_t* buffer = nullptr;
-  if (!FL_PIXEL_BUFFER_TEXTURE_GET_CLASS(self)->copy_pixels(
-          self, &buffer, &width, &height, error)) {
-    return FALSE;
-  }
-
   if (priv->texture_id == 0) {
     glGenTextures(1, &priv->texture_id);
     check_gl_error(__LINE__);
@@ -97,13 +151,93 @@ gboolean fl_pixel_buffer_texture_populate(FlPixelBufferTexture* texture,
     check_gl_error(__LINE__);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
     check_gl_error(__LINE__);
+
+    // Pixel buffer objects and glMapBufferRange are OpenGL 3.0 / GLES 3.0.
+    priv->use_pixel_buffer = epoxy_gl_version() >= 30;
   } else {
     glBindTexture(GL_TEXTURE_2D, priv->texture_id);
     check_gl_error(__LINE__);
   }
-  glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA,
-               GL_UNSIGNED_BYTE, buffer);
+
+  // Only reallocate the texture storage when the size changes.
+  if (width != priv->texture_width || height != priv->texture_height) {
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA,
+                 GL_UNSIGNED_BYTE, nullptr);
+    check_gl_error(__LINE__);
+    priv->texture_width = width;
+    priv->texture_height = height;
+  }
+
+  // Copy the pixels into a pixel buffer object, so the transfer into the
+  // texture is done by the driver asynchronously. The previous contents of the
+  // buffer are orphaned so this doesn't wait for the previous transfer.
+  void* data = nullptr;
+  size_t size = static_cast<size_t>(width) * height * 4;
+  if (priv->use_pixel_buffer) {
+    if (priv->pixel_buffer_id == 0) {
+      glGenBuffers(1, &priv->pixel_buffer_id);
+      check_gl_error(__LINE__);
+    }
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, priv->pixel_buffer_id);
+    glBufferData(GL_PIXEL_UNPACK_BUFFER, size, nullptr, GL_STREAM_DRAW);
+    data = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size,
+                            GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+    check_gl_error(__LINE__);
+  }
+  if (data != nullptr) {
+    memcpy(data, pixels, size);
+    glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, GL_RGBA,
+                    GL_UNSIGNED_BYTE, nullptr);
+  } else {
+    if (priv->use_pixel_buffer) {
+      glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    }
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, GL_RGBA,
+                    GL_UNSIGNED_BYTE, pixels);
+  }
   check_gl_error(__LINE__);
+  if (priv->use_pixel_buffer) {
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+  }
+}
+
+gboolean fl_pixel_buffer_texture_populate(FlPixelBufferTexture* texture,
+                                          uint32_t width,
+                                          uint32_t height,
+                                          FlutterOpenGLTexture* opengl_texture,
+                                          GError** error) {
+  FlPixelBufferTexture* self = FL_PIXEL_BUFFER_TEXTURE(texture);
+  FlPixelBufferTexturePrivate* priv =
+      reinterpret_cast<FlPixelBufferTexturePrivate*>(
+          fl_pixel_buffer_texture_get_instance_private(self));
+
+  if (g_atomic_int_get(&priv->has_frames)) {
+    // Take the latest published frame, if it hasn't been uploaded yet.
+    // Otherwise the texture already contains it.
+    if (g_atomic_int_get(&priv->ready) & kFrameFresh) {
+      priv->front =
+          atomic_int_exchange(&priv->ready, priv->front) & kFrameSlotMask;
+      FlPixelBufferFrame* frame = &priv->frames[priv->front];
+      upload_pixels(self, frame->pixels, frame->width, frame->height);
+    }
+    width = priv->texture_width;
+    height = priv->texture_height;
+  } else {
+    FlPixelBufferTextureClass* klass = FL_PIXEL_BUFFER_TEXTURE_GET_CLASS(self);
+    if (klass->copy_pixels == nullptr) {
+      g_set_error(error, fl_pixel_buffer_texture_error_quark(),
+                  FL_PIXEL_BUFFER_TEXTURE_ERROR_NO_FRAME,
+                  "No frame has been published");
+      return FALSE;
+    }
+
+    const uint8_t* buffer = nullptr;
+    if (!klass->copy_pixels(self, &buffer, &width, &height, error)) {
+      return FALSE;
+    }
+    upload_pixels(self, buffer, width, height);
+  }
 
   opengl_texture->target = GL_TEXTURE_2D;
   opengl_texture->name = priv->texture_id;
@@ -121,4 +255,51 @@ static void fl_pixel_buffer_texture_class_init(
   G_OBJECT_CLASS(klass)->dispose = fl_pixel_buffer_texture_dispose;
 }
 
-static void fl_pixel_buffer_texture_init(FlPixelBufferTexture* self) {}
+static void fl_pixel_buffer_texture_init(FlPixelBufferTexture* self) {
+  FlPixelBufferTexturePrivate* priv =
+      reinterpret_cast<FlPixelBufferTexturePrivate*>(
+          fl_pixel_buffer_texture_get_instance_private(self));
+  priv->back = 0;
+  priv->ready = 1;
+  priv->front = 2;
+}
+
+G_MODULE_EXPORT uint8_t* fl_pixel_buffer_texture_begin_frame(
+    FlPixelBufferTexture* self,
+    uint32_t width,
+    uint32_t height) {
+  g_return_val_if_fail(FL_IS_PIXEL_BUFFER_TEXTURE(self), nullptr);
+
+  FlPixelBufferTexturePrivate* priv =
+      reinterpret_cast<FlPixelBufferTexturePrivate*>(
+          fl_pixel_buffer_texture_get_instance_private(self));
+
+  // The back slot is only used by the producer, so it can be resized freely.
+  FlPixelBufferFrame* frame = &priv->frames[priv->back];
+  if (frame->pixels == nullptr || frame->width != width ||
+      frame->height != height) {
+    g_free(frame->pixels);
+    size_t size = static_cast<size_t>(width) * height * 4;
+    frame->pixels = static_cast<uint8_t*>(g_malloc(size));
+    frame->width = width;
+    frame->height = height;
+  }
+
+  return frame->pixels;
+}
+
+G_MODULE_EXPORT void fl_pixel_buffer_texture_end_frame(
+    FlPixelBufferTexture* self) {
+  g_return_if_fail(FL_IS_PIXEL_BUFFER_TEXTURE(self));
+
+  FlPixelBufferTexturePrivate* priv =
+      reinterpret_cast<FlPixelBufferTexturePrivate*>(
+          fl_pixel_buffer_texture_get_instance_private(self));
+
+  // Publish the frame, and take the previously ready slot to write the next
+  // frame into. If that slot held a frame that was never uploaded it is
+  // dropped, as a newer one is available.
+  priv->back = atomic_int_exchange(&priv->ready, priv->back | kFrameFresh) &
+               kFrameSlotMask;
+  g_atomic_int_set(&priv->has_frames, TRUE);
+}
@@ -11,6 +11,17 @@
 
 G_BEGIN_DECLS
 
+/**
+ * FlPixelBufferTextureError:
+ * Errors for #FlPixelBufferTexture objects to set on failures.
+ */
+
+typedef enum {
+  FL_PIXEL_BUFFER_TEXTURE_ERROR_NO_FRAME,
+} FlPixelBufferTextureError;
+
+GQuark fl_pixel_buffer_texture_error_quark(void) G_GNUC_CONST;
+
 /**
  * fl_pixel_buffer_texture_populate:
  * @texture: an #FlPixelBufferTexture.
@@ -25,6 +36,11 @@ G_BEGIN_DECLS
  * Attempts to populate the specified @opengl_texture with texture details
  * such as the name, width, height and the pixel format.
  *
+ * If frames have been published with fl_pixel_buffer_texture_begin_frame() the
+ * latest one is uploaded, unless it already was. This never waits for the
+ * producer of the frames. Otherwise the pixels are retrieved with
+ * FlPixelBufferTexture::copy_pixels.
+ *
  * Returns: %TRUE on success.
  */
 gboolean fl_pixel_buffer_texture_populate(FlPixelBufferTexture* texture,
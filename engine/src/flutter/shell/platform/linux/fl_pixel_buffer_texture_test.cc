@@ -9,10 +9,17 @@
 #include "flutter/shell/platform/linux/public/flutter_linux/fl_texture_registrar.h"
 #include "flutter/shell/platform/linux/testing/fl_test.h"
 #include "flutter/shell/platform/linux/testing/linux_test.h"
+#include "flutter/shell/platform/linux/testing/mock_epoxy.h"
 #include "gtest/gtest.h"
 
 #include <epoxy/gl.h>
 
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
 static constexpr uint32_t kBufferWidth = 4u;
 static constexpr uint32_t kBufferHeight = 4u;
 static constexpr uint32_t kRealBufferWidth = 2u;
@@ -75,6 +82,7 @@ class FlPixelBufferTextureTest : public flutter::testing::LinuxTest {
 
   ~FlPixelBufferTextureTest() { g_clear_object(&texture); }
 
+  ::testing::NiceMock<flutter::testing::MockEpoxy> epoxy;
   FlPixelBufferTexture* texture = nullptr;
 };
 
@@ -94,3 +102,113 @@ TEST_F(FlPixelBufferTextureTest, PopulateTexture) {
   EXPECT_EQ(opengl_texture.width, kRealBufferWidth);
   EXPECT_EQ(opengl_texture.height, kRealBufferHeight);
 }
+
+// Test that a published frame is used instead of copying pixels.
+TEST_F(FlPixelBufferTextureTest, PublishFrame) {
+  uint8_t* pixels =
+      fl_pixel_buffer_texture_begin_frame(texture, kBufferWidth, kBufferHeight);
+  ASSERT_NE(pixels, nullptr);
+  memset(pixels, 0xff, kBufferWidth * kBufferHeight * 4);
+  fl_pixel_buffer_texture_end_frame(texture);
+
+  FlutterOpenGLTexture opengl_texture = {0};
+  g_autoptr(GError) error = nullptr;
+  EXPECT_TRUE(fl_pixel_buffer_texture_populate(texture, 0, 0, &opengl_texture,
+                                               &error));
+  EXPECT_EQ(error, nullptr);
+  EXPECT_EQ(opengl_texture.width, kBufferWidth);
+  EXPECT_EQ(opengl_texture.height, kBufferHeight);
+
+  // Without a new frame the texture keeps the last one.
+  FlutterOpenGLTexture opengl_texture2 = {0};
+  EXPECT_TRUE(fl_pixel_buffer_texture_populate(texture, 0, 0, &opengl_texture2,
+                                               &error));
+  EXPECT_EQ(error, nullptr);
+  EXPECT_EQ(opengl_texture2.name, opengl_texture.name);
+  EXPECT_EQ(opengl_texture2.width, kBufferWidth);
+  EXPECT_EQ(opengl_texture2.height, kBufferHeight);
+}
+
+// Test that 4K frames streamed at 60Hz can be populated while the producer is
+// in the middle of writing a frame, i.e. the raster thread never waits on it.
+TEST_F(FlPixelBufferTextureTest, StreamFrames) {
+  constexpr uint32_t kWidth = 3840;
+  constexpr uint32_t kHeight = 2160;
+  constexpr int kFrameCount = 30;
+  constexpr std::chrono::microseconds kFrameInterval(16667);
+
+  // Use pixel buffer objects.
+  ON_CALL(epoxy, epoxy_gl_version).WillByDefault(::testing::Return(30));
+
+  std::mutex mutex;
+  std::condition_variable cond;
+  int writing_frame = -1;
+  bool populated = false;
+  bool stalled = false;
+
+  auto write_frame = [this](int frame) {
+    uint8_t* pixels =
+        fl_pixel_buffer_texture_begin_frame(texture, kWidth, kHeight);
+    memset(pixels, frame, static_cast<size_t>(kWidth) * kHeight * 4);
+  };
+  write_frame(0);
+  fl_pixel_buffer_texture_end_frame(texture);
+
+  std::thread producer([&]() {
+    for (int frame = 1; frame < kFrameCount && !stalled; frame++) {
+      auto start = std::chrono::steady_clock::now();
+
+      write_frame(frame);
+
+      // Hold the frame open until the raster thread has populated the
+      // texture.
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        writing_frame = frame;
+        populated = false;
+        cond.notify_all();
+        if (!cond.wait_for(lock, std::chrono::seconds(5),
+                           [&]() { return populated; })) {
+          stalled = true;
+        }
+        writing_frame = -1;
+      }
+
+      fl_pixel_buffer_texture_end_frame(texture);
+      std::this_thread::sleep_until(start + kFrameInterval);
+    }
+  });
+
+  for (int frame = 1; frame < kFrameCount; frame++) {
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      cond.wait(lock, [&]() { return writing_frame == frame || stalled; });
+      if (stalled) {
+        break;
+      }
+    }
+
+    FlutterOpenGLTexture opengl_texture = {0};
+    g_autoptr(GError) error = nullptr;
+    EXPECT_TRUE(fl_pixel_buffer_texture_populate(texture, kWidth, kHeight,
+                                                 &opengl_texture, &error));
+    EXPECT_EQ(error, nullptr);
+    EXPECT_EQ(opengl_texture.width, kWidth);
+    EXPECT_EQ(opengl_texture.height, kHeight);
+
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      populated = true;
+      cond.notify_all();
+    }
+  }
+
+  producer.join();
+  EXPECT_FALSE(stalled);
+
+  FlutterOpenGLTexture opengl_texture = {0};
+  EXPECT_TRUE(fl_pixel_buffer_texture_populate(texture, kWidth, kHeight,
+                                               &opengl_texture, nullptr));
+  EXPECT_EQ(opengl_texture.width, kWidth);
+  EXPECT_EQ(opengl_texture.height, kHeight);
+}
@@ -8,6 +8,8 @@
 
 #include <cstring>
 
+#include "flutter/shell/platform/linux/fl_value_private.h"
+
 // See lib/src/services/message_codecs.dart in Flutter source for description of
 // encoding.
 
@@ -27,9 +29,17 @@ static constexpr int kValueList = 12;
 static constexpr int kValueMap = 13;
 static constexpr int kValueFloat32List = 14;
 
-G_DEFINE_TYPE(FlStandardMessageCodec,
-              fl_standard_message_codec,
-              fl_message_codec_get_type())
+typedef struct {
+  // TRUE if the values of each decoded message are allocated from an arena.
+  gboolean arena_decoding;
+
+  // The arena of the message being decoded.
+  FlValueArena* arena;
+} FlStandardMessageCodecPrivate;
+
+G_DEFINE_TYPE_WITH_PRIVATE(FlStandardMessageCodec,
+                           fl_standard_message_codec,
+                           fl_message_codec_get_type())
 
 // Functions to write standard C number types.
 
@@ -100,6 +110,19 @@ static gboolean read_align(GBytes* buffer,
   return TRUE;
 }
 
+// Gets the arena to allocate the values read from @buffer from, or %NULL if
+// they are allocated on their own.
+static FlValueArena* get_arena(FlStandardMessageCodec* self, GBytes* buffer) {
+  FlStandardMessageCodecPrivate* priv =
+      reinterpret_cast<FlStandardMessageCodecPrivate*>(
+          fl_standard_message_codec_get_instance_private(self));
+  if (priv->arena == nullptr ||
+      fl_value_arena_get_bytes(priv->arena) != buffer) {
+    return nullptr;
+  }
+  return priv->arena;
+}
+
 // Gets a pointer to the given offset in @buffer.
 static const uint8_t* get_data(GBytes* buffer, size_t* offset) {
   return static_cast<const uint8_t*>(g_bytes_get_data(buffer, nullptr)) +
@@ -154,15 +177,16 @@ static gboolean read_uint32(GBytes* buffer,
 // Reads a #FL_VALUE_TYPE_INT stored as a signed 32 bit integer from @buffer.
 // Returns a new #FlValue of type #FL_VALUE_TYPE_INT if successful or %NULL on
 // error.
-static FlValue* read_int32_value(GBytes* buffer,
+static FlValue* read_int32_value(FlValueArena* arena,
+                                 GBytes* buffer,
                                  size_t* offset,
                                  GError** error) {
   if (!check_size(buffer, *offset, sizeof(int32_t), error)) {
     return nullptr;
   }
 
-  FlValue* value = fl_value_new_int(
-      reinterpret_cast<const int32_t*>(get_data(buffer, offset))[0]);
+  FlValue* value = fl_value_arena_new_int(
+      arena, reinterpret_cast<const int32_t*>(get_data(buffer, offset))[0]);
   *offset += sizeof(int32_t);
   return value;
 }
@@ -170,15 +194,16 @@ static FlValue* read_int32_value(GBytes* buffer,
 // Reads a #FL_VALUE_TYPE_INT stored as a signed 64 bit integer from @buffer.
 // Returns a new #FlValue of type #FL_VALUE_TYPE_INT if successful or %NULL on
 // error.
-static FlValue* read_int64_value(GBytes* buffer,
+static FlValue* read_int64_value(FlValueArena* arena,
+                                 GBytes* buffer,
                                  size_t* offset,
                                  GError** error) {
   if (!check_size(buffer, *offset, sizeof(int64_t), error)) {
     return nullptr;
   }
 
-  FlValue* value = fl_value_new_int(
-      reinterpret_cast<const int64_t*>(get_data(buffer, offset))[0]);
+  FlValue* value = fl_value_arena_new_int(
+      arena, reinterpret_cast<const int64_t*>(get_data(buffer, offset))[0]);
   *offset += sizeof(int64_t);
   return value;
 }
@@ -186,7 +211,8 @@ static FlValue* read_int64_value(GBytes* buffer,
 // Reads a 64 bit floating point number from @buffer and writes it to @value.
 // Returns a new #FlValue of type #FL_VALUE_TYPE_FLOAT if successful or %NULL on
 // error.
-static FlValue* read_float64_value(GBytes* buffer,
+static FlValue* read_float64_value(FlValueArena* arena,
+                                   GBytes* buffer,
                                    size_t* offset,
                                    GError** error) {
   if (!read_align(buffer, offset, 8, error)) {
@@ -196,8 +222,8 @@ static FlValue* read_float64_value(GBytes* buffer,
     return nullptr;
   }
 
-  FlValue* value = fl_value_new_float(
-      reinterpret_cast<const double*>(get_data(buffer, offset))[0]);
+  FlValue* value = fl_value_arena_new_float(
+      arena, reinterpret_cast<const double*>(get_data(buffer, offset))[0]);
   *offset += sizeof(double);
   return value;
 }
@@ -206,6 +232,7 @@ static FlValue* read_float64_value(GBytes* buffer,
 // Returns a new #FlValue of type #FL_VALUE_TYPE_STRING if successful or %NULL
 // on error.
 static FlValue* read_string_value(FlStandardMessageCodec* self,
+                                  FlValueArena* arena,
                                   GBytes* buffer,
                                   size_t* offset,
                                   GError** error) {
@@ -217,8 +244,8 @@ static FlValue* read_string_value(FlStandardMessageCodec* self,
   if (!check_size(buffer, *offset, length, error)) {
     return nullptr;
   }
-  FlValue* value = fl_value_new_string_sized(
-      reinterpret_cast<const gchar*>(get_data(buffer, offset)), length);
+  FlValue* value = fl_value_arena_new_string_sized(
+      arena, reinterpret_cast<const gchar*>(get_data(buffer, offset)), length);
   *offset += length;
   return value;
 }
@@ -227,6 +254,7 @@ static FlValue* read_string_value(FlStandardMessageCodec* self,
 // Returns a new #FlValue of type #FL_VALUE_TYPE_UINT8_LIST if successful or
 // %NULL on error.
 static FlValue* read_uint8_list_value(FlStandardMessageCodec* self,
+                                      FlValueArena* arena,
                                       GBytes* buffer,
                                       size_t* offset,
                                       GError** error) {
@@ -238,7 +266,8 @@ static FlValue* read_uint8_list_value(FlStandardMessageCodec* self,
   if (!check_size(buffer, *offset, sizeof(uint8_t) * length, error)) {
     return nullptr;
   }
-  FlValue* value = fl_value_new_uint8_list(get_data(buffer, offset), length);
+  FlValue* value =
+      fl_value_arena_new_uint8_list(arena, get_data(buffer, offset), length);
   *offset += length;
   return value;
 }
@@ -247,6 +276,7 @@ static FlValue* read_uint8_list_value(FlStandardMessageCodec* self,
 // Returns a new #FlValue of type #FL_VALUE_TYPE_INT32_LIST if successful or
 // %NULL on error.
 static FlValue* read_int32_list_value(FlStandardMessageCodec* self,
+                                      FlValueArena* arena,
                                       GBytes* buffer,
                                       size_t* offset,
                                       GError** error) {
@@ -261,8 +291,9 @@ static FlValue* read_int32_list_value(FlStandardMessageCodec* self,
   if (!check_size(buffer, *offset, sizeof(int32_t) * length, error)) {
     return nullptr;
   }
-  FlValue* value = fl_value_new_int32_list(
-      reinterpret_cast<const int32_t*>(get_data(buffer, offset)), length);
+  FlValue* value = fl_value_arena_new_int32_list(
+      arena, reinterpret_cast<const int32_t*>(get_data(buffer, offset)),
+      length);
   *offset += sizeof(int32_t) * length;
   return value;
 }
@@ -271,6 +302,7 @@ static FlValue* read_int32_list_value(FlStandardMessageCodec* self,
 // Returns a new #FlValue of type #FL_VALUE_TYPE_INT64_LIST if successful or
 // %NULL on error.
 static FlValue* read_int64_list_value(FlStandardMessageCodec* self,
+                                      FlValueArena* arena,
                                       GBytes* buffer,
                                       size_t* offset,
                                       GError** error) {
@@ -285,8 +317,9 @@ static FlValue* read_int64_list_value(FlStandardMessageCodec* self,
   if (!check_size(buffer, *offset, sizeof(int64_t) * length, error)) {
     return nullptr;
   }
-  FlValue* value = fl_value_new_int64_list(
-      reinterpret_cast<const int64_t*>(get_data(buffer, offset)), length);
+  FlValue* value = fl_value_arena_new_int64_list(
+      arena, reinterpret_cast<const int64_t*>(get_data(buffer, offset)),
+      length);
   *offset += sizeof(int64_t) * length;
   return value;
 }
@@ -295,6 +328,7 @@ static FlValue* read_int64_list_value(FlStandardMessageCodec* self,
 // format. Returns a new #FlValue of type #FL_VALUE_TYPE_FLOAT32_LIST if
 // successful or %NULL on error.
 static FlValue* read_float32_list_value(FlStandardMessageCodec* self,
+                                        FlValueArena* arena,
                                         GBytes* buffer,
                                         size_t* offset,
                                         GError** error) {
@@ -309,8 +343,8 @@ static FlValue* read_float32_list_value(FlStandardMessageCodec* self,
   if (!check_size(buffer, *offset, sizeof(float) * length, error)) {
     return nullptr;
   }
-  FlValue* value = fl_value_new_float32_list(
-      reinterpret_cast<const float*>(get_data(buffer, offset)), length);
+  FlValue* value = fl_value_arena_new_float32_list(
+      arena, reinterpret_cast<const float*>(get_data(buffer, offset)), length);
   *offset += sizeof(float) * length;
   return value;
 }
@@ -319,6 +353,7 @@ static FlValue* read_float32_list_value(FlStandardMessageCodec* self,
 // Returns a new #FlValue of type #FL_VALUE_TYPE_FLOAT_LIST if successful or
 // %NULL on error.
 static FlValue* read_float64_list_value(FlStandardMessageCodec* self,
+                                        FlValueArena* arena,
                                         GBytes* buffer,
                                         size_t* offset,
                                         GError** error) {
@@ -333,8 +368,8 @@ static FlValue* read_float64_list_value(FlStandardMessageCodec* self,
   if (!check_size(buffer, *offset, sizeof(double) * length, error)) {
     return nullptr;
   }
-  FlValue* value = fl_value_new_float_list(
-      reinterpret_cast<const double*>(get_data(buffer, offset)), length);
+  FlValue* value = fl_value_arena_new_float_list(
+      arena, reinterpret_cast<const double*>(get_data(buffer, offset)), length);
   *offset += sizeof(double) * length;
   return value;
 }
@@ -343,6 +378,7 @@ static FlValue* read_float64_list_value(FlStandardMessageCodec* self,
 // Returns a new #FlValue of type #FL_VALUE_TYPE_LIST if successful or %NULL on
 // error.
 static FlValue* read_list_value(FlStandardMessageCodec* self,
+                                FlValueArena* arena,
                                 GBytes* buffer,
                                 size_t* offset,
                                 GError** error) {
@@ -352,7 +388,10 @@ static FlValue* read_list_value(FlStandardMessageCodec* self,
     return nullptr;
   }
 
-  g_autoptr(FlValue) list = fl_value_new_list();
+  // Every value takes at least one byte, so don't reserve room for more values
+  // than there is data left.
+  g_autoptr(FlValue) list = fl_value_arena_new_list(
+      arena, MIN(length, g_bytes_get_size(buffer) - *offset));
   for (size_t i = 0; i < length; i++) {
     g_autoptr(FlValue) child =
         fl_standard_message_codec_read_value(self, buffer, offset, error);
@@ -369,6 +408,7 @@ static FlValue* read_list_value(FlStandardMessageCodec* self,
 // Returns a new #FlValue of type #FL_VALUE_TYPE_MAP if successful or %NULL on
 // error.
 static FlValue* read_map_value(FlStandardMessageCodec* self,
+                               FlValueArena* arena,
                                GBytes* buffer,
                                size_t* offset,
                                GError** error) {
@@ -378,7 +418,10 @@ static FlValue* read_map_value(FlStandardMessageCodec* self,
     return nullptr;
   }
 
-  g_autoptr(FlValue) map = fl_value_new_map();
+  // Every entry takes at least two bytes, so don't reserve room for more
+  // entries than there is data left.
+  g_autoptr(FlValue) map = fl_value_arena_new_map(
+      arena, MIN(length, (g_bytes_get_size(buffer) - *offset) / 2));
   for (size_t i = 0; i < length; i++) {
     g_autoptr(FlValue) key =
         fl_standard_message_codec_read_value(self, buffer, offset, error);
@@ -583,35 +626,36 @@ static FlValue* fl_standard_message_codec_read_value_of_type(
     size_t* offset,
     int type,
     GError** error) {
+  FlValueArena* arena = get_arena(self, buffer);
   g_autoptr(FlValue) value = nullptr;
   if (type == kValueNull) {
-    return fl_value_new_null();
+    return fl_value_arena_new_null(arena);
   } else if (type == kValueTrue) {
-    return fl_value_new_bool(TRUE);
+    return fl_value_arena_new_bool(arena, TRUE);
   } else if (type == kValueFalse) {
-    return fl_value_new_bool(FALSE);
+    return fl_value_arena_new_bool(arena, FALSE);
   } else if (type == kValueInt32) {
-    value = read_int32_value(buffer, offset, error);
+    value = read_int32_value(arena, buffer, offset, error);
   } else if (type == kValueInt64) {
-    value = read_int64_value(buffer, offset, error);
+    value = read_int64_value(arena, buffer, offset, error);
   } else if (type == kValueFloat64) {
-    value = read_float64_value(buffer, offset, error);
+    value = read_float64_value(arena, buffer, offset, error);
   } else if (type == kValueString) {
-    value = read_string_value(self, buffer, offset, error);
+    value = read_string_value(self, arena, buffer, offset, error);
   } else if (type == kValueUint8List) {
-    value = read_uint8_list_value(self, buffer, offset, error);
+    value = read_uint8_list_value(self, arena, buffer, offset, error);
   } else if (type == kValueInt32List) {
-    value = read_int32_list_value(self, buffer, offset, error);
+    value = read_int32_list_value(self, arena, buffer, offset, error);
   } else if (type == kValueInt64List) {
-    value = read_int64_list_value(self, buffer, offset, error);
+    value = read_int64_list_value(self, arena, buffer, offset, error);
   } else if (type == kValueFloat32List) {
-    value = read_float32_list_value(self, buffer, offset, error);
+    value = read_float32_list_value(self, arena, buffer, offset, error);
   } else if (type == kValueFloat64List) {
-    value = read_float64_list_value(self, buffer, offset, error);
+    value = read_float64_list_value(self, arena, buffer, offset, error);
   } else if (type == kValueList) {
-    value = read_list_value(self, buffer, offset, error);
+    value = read_list_value(self, arena, buffer, offset, error);
   } else if (type == kValueMap) {
-    value = read_map_value(self, buffer, offset, error);
+    value = read_map_value(self, arena, buffer, offset, error);
   } else {
     g_set_error(error, FL_MESSAGE_CODEC_ERROR,
                 FL_MESSAGE_CODEC_ERROR_UNSUPPORTED_TYPE,
@@ -634,6 +678,20 @@ static void fl_standard_message_codec_class_init(
 
 static void fl_standard_message_codec_init(FlStandardMessageCodec* self) {}
 
+// Reads a value from @buffer using FlStandardMessageCodec::read_value_of_type.
+static FlValue* read_value(FlStandardMessageCodec* self,
+                           GBytes* buffer,
+                           size_t* offset,
+                           GError** error) {
+  uint8_t type;
+  if (!read_uint8(buffer, offset, &type, error)) {
+    return nullptr;
+  }
+
+  return FL_STANDARD_MESSAGE_CODEC_GET_CLASS(self)->read_value_of_type(
+      self, buffer, offset, type, error);
+}
+
 G_MODULE_EXPORT FlStandardMessageCodec* fl_standard_message_codec_new() {
   return static_cast<FlStandardMessageCodec*>(
       g_object_new(fl_standard_message_codec_get_type(), nullptr));
@@ -696,11 +754,27 @@ G_MODULE_EXPORT FlValue* fl_standard_message_codec_read_value(
     GBytes* buffer,
     size_t* offset,
     GError** error) {
-  uint8_t type;
-  if (!read_uint8(buffer, offset, &type, error)) {
-    return nullptr;
-  }
+  FlStandardMessageCodecPrivate* priv =
+      reinterpret_cast<FlStandardMessageCodecPrivate*>(
+          fl_standard_message_codec_get_instance_private(self));
+
+  // Values read while reading this one belong to it, so only the outermost
+  // read creates an arena. Once read, the values keep the arena alive.
+  if (!priv->arena_decoding || priv->arena != nullptr) {
+    return read_value(self, buffer, offset, error);
+  }
+  priv->arena = fl_value_arena_new(buffer);
+  FlValue* value = read_value(self, buffer, offset, error);
+  g_clear_pointer(&priv->arena, fl_value_arena_unref);
+  return value;
+}
 
-  return FL_STANDARD_MESSAGE_CODEC_GET_CLASS(self)->read_value_of_type(
-      self, buffer, offset, type, error);
+G_MODULE_EXPORT void fl_standard_message_codec_set_arena_decoding(
+    FlStandardMessageCodec* self,
+    gboolean arena_decoding) {
+  g_return_if_fail(FL_IS_STANDARD_MESSAGE_CODEC(self));
+  FlStandardMessageCodecPrivate* priv =
+      reinterpret_cast<FlStandardMessageCodecPrivate*>(
+          fl_standard_message_codec_get_instance_private(self));
+  priv->arena_decoding = arena_decoding;
 }
@@ -0,0 +1,88 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/linux/public/flutter_linux/fl_standard_message_codec.h"
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/logging.h"
+
+namespace flutter {
+
+namespace {
+
+// A list of integers, as in EncodeDecodeLargeList.
+FlValue* CreateLargeList() {
+  FlValue* value = fl_value_new_list();
+  for (int i = 0; i < 65535; i++) {
+    fl_value_append_take(value, fl_value_new_int(i));
+  }
+  return value;
+}
+
+// A map from strings to integers, as in EncodeDecodeLargeMap.
+FlValue* CreateLargeMap() {
+  FlValue* value = fl_value_new_map();
+  for (int i = 0; i < 512; i++) {
+    g_autofree gchar* key = g_strdup_printf("key%d", i);
+    fl_value_set_string_take(value, key, fl_value_new_int(i));
+  }
+  return value;
+}
+
+// A list of records, each a map with a few typed values.
+FlValue* CreateRecords() {
+  FlValue* value = fl_value_new_list();
+  for (int i = 0; i < 4096; i++) {
+    double bounds[] = {1.0 * i, 2.0 * i, 16.0, 16.0};
+    FlValue* record = fl_value_new_map();
+    fl_value_set_string_take(record, "id", fl_value_new_int(i));
+    fl_value_set_string_take(record, "visible", fl_value_new_bool(i % 2 == 0));
+    fl_value_set_string_take(record, "confidence",
+                             fl_value_new_float(0.5 + i / 8192.0));
+    fl_value_set_string_take(record, "bounds",
+                             fl_value_new_float_list(bounds, 4));
+    fl_value_append_take(value, record);
+  }
+  return value;
+}
+
+// A large block of bytes, such as an image.
+FlValue* CreateImage() {
+  g_autofree uint8_t* data = static_cast<uint8_t*>(g_malloc0(1024 * 1024));
+  return fl_value_new_uint8_list(data, 1024 * 1024);
+}
+
+}  // namespace
+
+// Decodes a message containing the value |create_value| creates, and frees the
+// decoded values. The values are either allocated on their own, or from an
+// arena.
+static void BM_Decode(benchmark::State& state,
+                      FlValue* (*create_value)(),
+                      bool arena_decoding) {
+  g_autoptr(FlStandardMessageCodec) codec = fl_standard_message_codec_new();
+  fl_standard_message_codec_set_arena_decoding(codec, arena_decoding);
+  g_autoptr(FlValue) value = create_value();
+  g_autoptr(GBytes) message =
+      fl_message_codec_encode_message(FL_MESSAGE_CODEC(codec), value, nullptr);
+  FML_CHECK(message != nullptr);
+
+  for (auto _ : state) {
+    g_autoptr(FlValue) decoded = fl_message_codec_decode_message(
+        FL_MESSAGE_CODEC(codec), message, nullptr);
+    benchmark::DoNotOptimize(decoded);
+  }
+  state.SetBytesProcessed(state.iterations() * g_bytes_get_size(message));
+}
+
+BENCHMARK_CAPTURE(BM_Decode, LargeList, CreateLargeList, false);
+BENCHMARK_CAPTURE(BM_Decode, LargeListInArena, CreateLargeList, true);
+BENCHMARK_CAPTURE(BM_Decode, LargeMap, CreateLargeMap, false);
+BENCHMARK_CAPTURE(BM_Decode, LargeMapInArena, CreateLargeMap, true);
+BENCHMARK_CAPTURE(BM_Decode, Records, CreateRecords, false);
+BENCHMARK_CAPTURE(BM_Decode, RecordsInArena, CreateRecords, true);
+BENCHMARK_CAPTURE(BM_Decode, Image, CreateImage, false);
+BENCHMARK_CAPTURE(BM_Decode, ImageInArena, CreateImage, true);
+
+}  // namespace flutter
@@ -5,6 +5,7 @@
 #include "flutter/shell/platform/linux/public/flutter_linux/fl_standard_message_codec.h"
 
 #include <cmath>
+#include "flutter/shell/platform/linux/fl_value_private.h"
 #include "flutter/shell/platform/linux/testing/fl_test.h"
 #include "gtest/gtest.h"
 
@@ -1289,3 +1290,108 @@ TEST(FlStandardMessageCodecTest, EncodeDecode) {
 
   ASSERT_TRUE(fl_value_equal(input, output));
 }
+
+TEST(FlStandardMessageCodecTest, DecodeInArena) {
+  g_autoptr(FlStandardMessageCodec) codec = fl_standard_message_codec_new();
+  fl_standard_message_codec_set_arena_decoding(codec, TRUE);
+
+  int32_t int32_data[] = {0, -1, G_MAXINT32};
+  double float_data[] = {0.0, -0.5, M_PI};
+  g_autoptr(FlValue) input = fl_value_new_map();
+  fl_value_set_string_take(input, "null", fl_value_new_null());
+  fl_value_set_string_take(input, "int", fl_value_new_int(G_MAXINT64));
+  fl_value_set_string_take(input, "float", fl_value_new_float(M_PI));
+  fl_value_set_string_take(input, "int32s",
+                           fl_value_new_int32_list(int32_data, 3));
+  fl_value_set_string_take(input, "floats",
+                           fl_value_new_float_list(float_data, 3));
+  g_autoptr(FlValue) list = fl_value_new_list();
+  for (int i = 0; i < 1000; i++) {
+    fl_value_append_take(list, fl_value_new_int(i));
+    fl_value_append_take(list, fl_value_new_string("hello"));
+  }
+  fl_value_set_string(input, "list", list);
+
+  g_autoptr(GError) error = nullptr;
+  g_autoptr(GBytes) message =
+      fl_message_codec_encode_message(FL_MESSAGE_CODEC(codec), input, &error);
+  ASSERT_NE(message, nullptr);
+  g_autoptr(FlValue) output =
+      fl_message_codec_decode_message(FL_MESSAGE_CODEC(codec), message, &error);
+  EXPECT_EQ(error, nullptr);
+  ASSERT_NE(output, nullptr);
+
+  EXPECT_TRUE(fl_value_equal(input, output));
+  EXPECT_TRUE(fl_value_is_in_arena(output));
+
+  // Typed lists reference the message data.
+  const uint8_t* message_start =
+      static_cast<const uint8_t*>(g_bytes_get_data(message, nullptr));
+  const uint8_t* message_end = message_start + g_bytes_get_size(message);
+  const uint8_t* floats = reinterpret_cast<const uint8_t*>(
+      fl_value_get_float_list(fl_value_lookup_string(output, "floats")));
+  EXPECT_GE(floats, message_start);
+  EXPECT_LT(floats, message_end);
+}
+
+TEST(FlStandardMessageCodecTest, DecodeInArenaOutlivesMessage) {
+  g_autoptr(FlStandardMessageCodec) codec = fl_standard_message_codec_new();
+  fl_standard_message_codec_set_arena_decoding(codec, TRUE);
+
+  g_autoptr(GBytes) message =
+      hex_string_to_bytes("0c02070568656c6c6f0b03000000000000000000000000000000"
+                          "00000000e0bf182d4454fb210940");
+  g_autoptr(GError) error = nullptr;
+  FlValue* output =
+      fl_message_codec_decode_message(FL_MESSAGE_CODEC(codec), message, &error);
+  EXPECT_EQ(error, nullptr);
+  ASSERT_NE(output, nullptr);
+  g_autoptr(FlValue) floats = fl_value_ref(fl_value_get_list_value(output, 1));
+  fl_value_unref(output);
+  g_clear_pointer(&message, g_bytes_unref);
+
+  ASSERT_EQ(fl_value_get_type(floats), FL_VALUE_TYPE_FLOAT_LIST);
+  ASSERT_EQ(fl_value_get_length(floats), static_cast<size_t>(3));
+  EXPECT_EQ(fl_value_get_float_list(floats)[0], 0.0);
+  EXPECT_EQ(fl_value_get_float_list(floats)[1], -0.5);
+  EXPECT_EQ(fl_value_get_float_list(floats)[2], M_PI);
+}
+
+TEST(FlStandardMessageCodecTest, DecodeInArenaCustomTypes) {
+  g_autoptr(FlTestStandardMessageCodec) codec =
+      fl_test_standard_message_codec_new();
+  fl_standard_message_codec_set_arena_decoding(
+      FL_STANDARD_MESSAGE_CODEC(codec), TRUE);
+  g_autoptr(FlValue) value = decode_message_with_codec("0c02800568656c6c6f81",
+                                                       FL_MESSAGE_CODEC(codec));
+  ASSERT_EQ(fl_value_get_type(value), FL_VALUE_TYPE_LIST);
+  EXPECT_TRUE(fl_value_is_in_arena(value));
+  EXPECT_EQ(fl_value_get_length(value), static_cast<size_t>(2));
+  FlValue* value1 = fl_value_get_list_value(value, 0);
+  ASSERT_EQ(fl_value_get_type(value1), FL_VALUE_TYPE_CUSTOM);
+  EXPECT_STREQ(static_cast<const gchar*>(fl_value_get_custom_value(value1)),
+               "hello");
+  FlValue* value2 = fl_value_get_list_value(value, 1);
+  ASSERT_EQ(fl_value_get_type(value2), FL_VALUE_TYPE_CUSTOM);
+  ASSERT_EQ(fl_value_get_custom_type(value2), 129);
+}
+
+TEST(FlStandardMessageCodecTest, DecodeInArenaError) {
+  g_autoptr(FlStandardMessageCodec) codec = fl_standard_message_codec_new();
+  fl_standard_message_codec_set_arena_decoding(codec, TRUE);
+
+  g_autoptr(GBytes) short_data = hex_string_to_bytes("0c0207036f6e6507");
+  g_autoptr(GError) error = nullptr;
+  g_autoptr(FlValue) failed = fl_message_codec_decode_message(
+      FL_MESSAGE_CODEC(codec), short_data, &error);
+  EXPECT_EQ(failed, nullptr);
+  EXPECT_TRUE(g_error_matches(error, FL_MESSAGE_CODEC_ERROR,
+                              FL_MESSAGE_CODEC_ERROR_OUT_OF_DATA));
+
+  // The codec can decode messages after failing to.
+  g_autoptr(FlValue) value = decode_message_with_codec(
+      "0c0207036f6e650302000000", FL_MESSAGE_CODEC(codec));
+  ASSERT_EQ(fl_value_get_length(value), static_cast<size_t>(2));
+  EXPECT_STREQ(fl_value_get_string(fl_value_get_list_value(value, 0)), "one");
+  EXPECT_EQ(fl_value_get_int(fl_value_get_list_value(value, 1)), 2);
+}
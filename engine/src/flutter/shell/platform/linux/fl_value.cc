@@ -8,9 +8,47 @@
 
 #include <cstring>
 
+#include "flutter/shell/platform/linux/fl_value_private.h"
+
+// Alignment of the memory allocated from an arena, enough for any value.
+static constexpr size_t kArenaAlignment = 8;
+
+// Size of the first block of an arena relative to the size of the message the
+// values are decoded from, and the bounds of the size of its blocks.
+static constexpr size_t kArenaBlockSizePerMessageByte = 4;
+static constexpr size_t kArenaMinBlockSize = 256;
+static constexpr size_t kArenaMaxBlockSize = 64 * 1024;
+
+typedef struct _FlValueArenaBlock FlValueArenaBlock;
+
+struct alignas(kArenaAlignment) _FlValueArenaBlock {
+  FlValueArenaBlock* next;
+};
+
+struct alignas(kArenaAlignment) _FlValueArena {
+  int ref_count;
+
+  GBytes* bytes;
+
+  // Lists and maps allocated from the arena, whose arrays are freed with it.
+  GPtrArray* containers;
+
+  // Blocks allocated once the first block, which follows this structure, is
+  // full. Most recent first.
+  FlValueArenaBlock* blocks;
+
+  // Free space in the current block.
+  uint8_t* position;
+  size_t remaining;
+
+  size_t next_block_size;
+};
+
 struct _FlValue {
   FlValueType type;
   int ref_count;
+  // The arena this value is allocated from, or %NULL.
+  FlValueArena* arena;
 };
 
 typedef struct {
@@ -37,30 +75,40 @@ typedef struct {
   FlValue parent;
   uint8_t* values;
   size_t values_length;
+  // The data @values points into, if it is not a copy owned by this value.
+  GBytes* bytes;
 } FlValueUint8List;
 
 typedef struct {
   FlValue parent;
   int32_t* values;
   size_t values_length;
+  // The data @values points into, if it is not a copy owned by this value.
+  GBytes* bytes;
 } FlValueInt32List;
 
 typedef struct {
   FlValue parent;
   int64_t* values;
   size_t values_length;
+  // The data @values points into, if it is not a copy owned by this value.
+  GBytes* bytes;
 } FlValueInt64List;
 
 typedef struct {
   FlValue parent;
   float* values;
   size_t values_length;
+  // The data @values points into, if it is not a copy owned by this value.
+  GBytes* bytes;
 } FlValueFloat32List;
 
 typedef struct {
   FlValue parent;
   double* values;
   size_t values_length;
+  // The data @values points into, if it is not a copy owned by this value.
+  GBytes* bytes;
 } FlValueFloatList;
 
 typedef struct {
@@ -93,6 +141,238 @@ static void fl_value_destroy(gpointer value) {
   fl_value_unref(static_cast<FlValue*>(value));
 }
 
+// Allocates @size bytes from @self. The memory is freed with the arena.
+static gpointer fl_value_arena_allocate(FlValueArena* self, size_t size) {
+  size = (size + kArenaAlignment - 1) & ~(kArenaAlignment - 1);
+  if (size > self->remaining) {
+    size_t block_size = MAX(self->next_block_size, size);
+    FlValueArenaBlock* block = static_cast<FlValueArenaBlock*>(
+        g_malloc(sizeof(FlValueArenaBlock) + block_size));
+    block->next = self->blocks;
+    self->blocks = block;
+    self->position = reinterpret_cast<uint8_t*>(block + 1);
+    self->remaining = block_size;
+    self->next_block_size =
+        MIN(self->next_block_size * 2, kArenaMaxBlockSize);
+  }
+
+  gpointer memory = self->position;
+  self->position += size;
+  self->remaining -= size;
+  return memory;
+}
+
+// Creates a value in @arena, or on its own if @arena is %NULL.
+static FlValue* fl_value_new_in_arena(FlValueArena* arena,
+                                      FlValueType type,
+                                      size_t size) {
+  if (arena == nullptr) {
+    return fl_value_new(type, size);
+  }
+
+  FlValue* self = static_cast<FlValue*>(fl_value_arena_allocate(arena, size));
+  memset(self, 0, size);
+  self->type = type;
+  self->ref_count = 1;
+  self->arena = fl_value_arena_ref(arena);
+  return self;
+}
+
+// Gets the values of a typed list in @arena. @data is referenced if it lies in
+// the bytes of the arena and is aligned to @element_size, and copied into the
+// arena otherwise.
+static gpointer fl_value_arena_get_typed_data(FlValueArena* arena,
+                                              const void* data,
+                                              size_t element_size,
+                                              size_t length) {
+  if (length == 0) {
+    return nullptr;
+  }
+
+  size_t size = element_size * length;
+  gsize bytes_size;
+  uintptr_t bytes_start =
+      reinterpret_cast<uintptr_t>(g_bytes_get_data(arena->bytes, &bytes_size));
+  uintptr_t start = reinterpret_cast<uintptr_t>(data);
+  if (start >= bytes_start && start + size <= bytes_start + bytes_size &&
+      start % element_size == 0) {
+    return const_cast<void*>(data);
+  }
+
+  gpointer values = fl_value_arena_allocate(arena, size);
+  memcpy(values, data, size);
+  return values;
+}
+
+// Gets the values of a typed list from @bytes. The data in @bytes is
+// referenced and @owner set to it if it is aligned to @element_size, otherwise
+// it is copied.
+static gpointer get_typed_data_from_bytes(GBytes* bytes,
+                                          size_t element_size,
+                                          size_t* length,
+                                          GBytes** owner) {
+  gsize size;
+  gconstpointer data = g_bytes_get_data(bytes, &size);
+  *length = size / element_size;
+  if (reinterpret_cast<uintptr_t>(data) % element_size == 0) {
+    *owner = g_bytes_ref(bytes);
+    return const_cast<gpointer>(data);
+  }
+
+  *owner = nullptr;
+  gpointer values = g_malloc(size);
+  memcpy(values, data, size);
+  return values;
+}
+
+// Frees the values of a typed list.
+static void free_typed_data(gpointer values, GBytes* bytes) {
+  if (bytes != nullptr) {
+    g_bytes_unref(bytes);
+  } else {
+    g_free(values);
+  }
+}
+
+// Checks if @value is in an arena, or is a list or map that holds a value in
+// an arena.
+static bool fl_value_references_arena(FlValue* value) {
+  if (value->arena != nullptr) {
+    return true;
+  }
+  if (value->type == FL_VALUE_TYPE_LIST) {
+    GPtrArray* values = reinterpret_cast<FlValueList*>(value)->values;
+    for (guint i = 0; i < values->len; i++) {
+      if (fl_value_references_arena(static_cast<FlValue*>(values->pdata[i]))) {
+        return true;
+      }
+    }
+  } else if (value->type == FL_VALUE_TYPE_MAP) {
+    FlValueMap* v = reinterpret_cast<FlValueMap*>(value);
+    for (guint i = 0; i < v->keys->len; i++) {
+      if (fl_value_references_arena(static_cast<FlValue*>(v->keys->pdata[i])) ||
+          fl_value_references_arena(
+              static_cast<FlValue*>(v->values->pdata[i]))) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+// Copies @value and the values it holds out of any arena. Values that don't
+// reference an arena are referenced instead of copied.
+static FlValue* fl_value_copy_out_of_arenas(FlValue* value) {
+  if (!fl_value_references_arena(value)) {
+    return fl_value_ref(value);
+  }
+
+  switch (value->type) {
+    case FL_VALUE_TYPE_NULL:
+      return fl_value_new_null();
+    case FL_VALUE_TYPE_BOOL:
+      return fl_value_new_bool(fl_value_get_bool(value));
+    case FL_VALUE_TYPE_INT:
+      return fl_value_new_int(fl_value_get_int(value));
+    case FL_VALUE_TYPE_FLOAT:
+      return fl_value_new_float(fl_value_get_float(value));
+    case FL_VALUE_TYPE_STRING:
+      return fl_value_new_string(fl_value_get_string(value));
+    case FL_VALUE_TYPE_UINT8_LIST:
+      return fl_value_new_uint8_list(fl_value_get_uint8_list(value),
+                                     fl_value_get_length(value));
+    case FL_VALUE_TYPE_INT32_LIST:
+      return fl_value_new_int32_list(fl_value_get_int32_list(value),
+                                     fl_value_get_length(value));
+    case FL_VALUE_TYPE_INT64_LIST:
+      return fl_value_new_int64_list(fl_value_get_int64_list(value),
+                                     fl_value_get_length(value));
+    case FL_VALUE_TYPE_FLOAT32_LIST:
+      return fl_value_new_float32_list(fl_value_get_float32_list(value),
+                                       fl_value_get_length(value));
+    case FL_VALUE_TYPE_FLOAT_LIST:
+      return fl_value_new_float_list(fl_value_get_float_list(value),
+                                     fl_value_get_length(value));
+    case FL_VALUE_TYPE_LIST: {
+      GPtrArray* values = reinterpret_cast<FlValueList*>(value)->values;
+      FlValue* copy = fl_value_new_list();
+      GPtrArray* copy_values = reinterpret_cast<FlValueList*>(copy)->values;
+      for (guint i = 0; i < values->len; i++) {
+        g_ptr_array_add(copy_values,
+                        fl_value_copy_out_of_arenas(
+                            static_cast<FlValue*>(values->pdata[i])));
+      }
+      return copy;
+    }
+    case FL_VALUE_TYPE_MAP: {
+      FlValueMap* v = reinterpret_cast<FlValueMap*>(value);
+      FlValue* copy = fl_value_new_map();
+      FlValueMap* copy_v = reinterpret_cast<FlValueMap*>(copy);
+      for (guint i = 0; i < v->keys->len; i++) {
+        g_ptr_array_add(copy_v->keys,
+                        fl_value_copy_out_of_arenas(
+                            static_cast<FlValue*>(v->keys->pdata[i])));
+        g_ptr_array_add(copy_v->values,
+                        fl_value_copy_out_of_arenas(
+                            static_cast<FlValue*>(v->values->pdata[i])));
+      }
+      return copy;
+    }
+    case FL_VALUE_TYPE_CUSTOM:
+      // Custom values are never allocated from an arena.
+      break;
+  }
+  return fl_value_ref(value);
+}
+
+// Takes the reference to @value for the list or map @self it is added to.
+static FlValue* fl_value_take_child(FlValue* self, FlValue* value) {
+  if (self->arena == nullptr) {
+    return value;
+  }
+
+  // Lists and maps don't hold references to values in the same arena, as they
+  // would keep the arena alive.
+  if (value->arena == self->arena) {
+    fl_value_unref(value);
+    return value;
+  }
+
+  // Nor do they hold other values that reference an arena, such as a list
+  // holding values of the same arena, or a value of another arena that may in
+  // turn reference this one. The arena could then only be freed by freeing
+  // itself. Such values are copied out of their arenas instead.
+  if (fl_value_references_arena(value)) {
+    FlValue* copy = fl_value_copy_out_of_arenas(value);
+    fl_value_unref(value);
+    return copy;
+  }
+  return value;
+}
+
+// Drops the reference @self holds to @value, if any.
+static void fl_value_release_child(FlValue* self, FlValue* value) {
+  if (self->arena == nullptr || value->arena != self->arena) {
+    fl_value_unref(value);
+  }
+}
+
+// Drops the references held by @array, an array of @self in an arena.
+static void fl_value_release_children(FlValue* self, GPtrArray* array) {
+  for (guint i = 0; i < array->len; i++) {
+    fl_value_release_child(self, static_cast<FlValue*>(array->pdata[i]));
+  }
+  g_ptr_array_unref(array);
+}
+
+// Registers a list or map in @self, whose arrays are freed with the arena.
+static void fl_value_arena_add_container(FlValueArena* self, FlValue* value) {
+  if (self->containers == nullptr) {
+    self->containers = g_ptr_array_new();
+  }
+  g_ptr_array_add(self->containers, value);
+}
+
 // Finds the index of a key in a FlValueMap.
 // FIXME(robert-ancell) This is highly inefficient, and should be optimized if
 // necessary.
@@ -300,10 +580,12 @@ G_MODULE_EXPORT FlValue* fl_value_new_uint8_list(const uint8_t* data,
 }
 
 G_MODULE_EXPORT FlValue* fl_value_new_uint8_list_from_bytes(GBytes* data) {
-  gsize length;
-  const uint8_t* d =
-      static_cast<const uint8_t*>(g_bytes_get_data(data, &length));
-  return fl_value_new_uint8_list(d, length);
+  g_return_val_if_fail(data != nullptr, nullptr);
+  FlValueUint8List* self = reinterpret_cast<FlValueUint8List*>(
+      fl_value_new(FL_VALUE_TYPE_UINT8_LIST, sizeof(FlValueUint8List)));
+  self->values = static_cast<uint8_t*>(get_typed_data_from_bytes(
+      data, sizeof(uint8_t), &self->values_length, &self->bytes));
+  return reinterpret_cast<FlValue*>(self);
 }
 
 G_MODULE_EXPORT FlValue* fl_value_new_int32_list(const int32_t* data,
@@ -316,6 +598,16 @@ G_MODULE_EXPORT FlValue* fl_value_new_int32_list(const int32_t* data,
   return reinterpret_cast<FlValue*>(self);
 }
 
+G_MODULE_EXPORT FlValue* fl_value_new_int32_list_from_bytes(GBytes* data) {
+  g_return_val_if_fail(data != nullptr, nullptr);
+  g_return_val_if_fail(g_bytes_get_size(data) % sizeof(int32_t) == 0, nullptr);
+  FlValueInt32List* self = reinterpret_cast<FlValueInt32List*>(
+      fl_value_new(FL_VALUE_TYPE_INT32_LIST, sizeof(FlValueInt32List)));
+  self->values = static_cast<int32_t*>(get_typed_data_from_bytes(
+      data, sizeof(int32_t), &self->values_length, &self->bytes));
+  return reinterpret_cast<FlValue*>(self);
+}
+
 G_MODULE_EXPORT FlValue* fl_value_new_int64_list(const int64_t* data,
                                                  size_t data_length) {
   FlValueInt64List* self = reinterpret_cast<FlValueInt64List*>(
@@ -326,6 +618,16 @@ G_MODULE_EXPORT FlValue* fl_value_new_int64_list(const int64_t* data,
   return reinterpret_cast<FlValue*>(self);
 }
 
+G_MODULE_EXPORT FlValue* fl_value_new_int64_list_from_bytes(GBytes* data) {
+  g_return_val_if_fail(data != nullptr, nullptr);
+  g_return_val_if_fail(g_bytes_get_size(data) % sizeof(int64_t) == 0, nullptr);
+  FlValueInt64List* self = reinterpret_cast<FlValueInt64List*>(
+      fl_value_new(FL_VALUE_TYPE_INT64_LIST, sizeof(FlValueInt64List)));
+  self->values = static_cast<int64_t*>(get_typed_data_from_bytes(
+      data, sizeof(int64_t), &self->values_length, &self->bytes));
+  return reinterpret_cast<FlValue*>(self);
+}
+
 G_MODULE_EXPORT FlValue* fl_value_new_float32_list(const float* data,
                                                    size_t data_length) {
   FlValueFloat32List* self = reinterpret_cast<FlValueFloat32List*>(
@@ -336,6 +638,16 @@ G_MODULE_EXPORT FlValue* fl_value_new_float32_list(const float* data,
   return reinterpret_cast<FlValue*>(self);
 }
 
+G_MODULE_EXPORT FlValue* fl_value_new_float32_list_from_bytes(GBytes* data) {
+  g_return_val_if_fail(data != nullptr, nullptr);
+  g_return_val_if_fail(g_bytes_get_size(data) % sizeof(float) == 0, nullptr);
+  FlValueFloat32List* self = reinterpret_cast<FlValueFloat32List*>(
+      fl_value_new(FL_VALUE_TYPE_FLOAT32_LIST, sizeof(FlValueFloat32List)));
+  self->values = static_cast<float*>(get_typed_data_from_bytes(
+      data, sizeof(float), &self->values_length, &self->bytes));
+  return reinterpret_cast<FlValue*>(self);
+}
+
 G_MODULE_EXPORT FlValue* fl_value_new_float_list(const double* data,
                                                  size_t data_length) {
   FlValueFloatList* self = reinterpret_cast<FlValueFloatList*>(
@@ -346,6 +658,16 @@ G_MODULE_EXPORT FlValue* fl_value_new_float_list(const double* data,
   return reinterpret_cast<FlValue*>(self);
 }
 
+G_MODULE_EXPORT FlValue* fl_value_new_float_list_from_bytes(GBytes* data) {
+  g_return_val_if_fail(data != nullptr, nullptr);
+  g_return_val_if_fail(g_bytes_get_size(data) % sizeof(double) == 0, nullptr);
+  FlValueFloatList* self = reinterpret_cast<FlValueFloatList*>(
+      fl_value_new(FL_VALUE_TYPE_FLOAT_LIST, sizeof(FlValueFloatList)));
+  self->values = static_cast<double*>(get_typed_data_from_bytes(
+      data, sizeof(double), &self->values_length, &self->bytes));
+  return reinterpret_cast<FlValue*>(self);
+}
+
 G_MODULE_EXPORT FlValue* fl_value_new_list() {
   FlValueList* self = reinterpret_cast<FlValueList*>(
       fl_value_new(FL_VALUE_TYPE_LIST, sizeof(FlValueList)));
@@ -393,12 +715,20 @@ G_MODULE_EXPORT FlValue* fl_value_new_custom_object_take(int type,
 
 G_MODULE_EXPORT FlValue* fl_value_ref(FlValue* self) {
   g_return_val_if_fail(self != nullptr, nullptr);
+  if (self->arena != nullptr) {
+    fl_value_arena_ref(self->arena);
+    return self;
+  }
   self->ref_count++;
   return self;
 }
 
 G_MODULE_EXPORT void fl_value_unref(FlValue* self) {
   g_return_if_fail(self != nullptr);
+  if (self->arena != nullptr) {
+    fl_value_arena_unref(self->arena);
+    return;
+  }
   g_return_if_fail(self->ref_count > 0);
   self->ref_count--;
   if (self->ref_count != 0) {
@@ -413,27 +743,27 @@ G_MODULE_EXPORT void fl_value_unref(FlValue* self) {
     }
     case FL_VALUE_TYPE_UINT8_LIST: {
       FlValueUint8List* v = reinterpret_cast<FlValueUint8List*>(self);
-      g_free(v->values);
+      free_typed_data(v->values, v->bytes);
       break;
     }
     case FL_VALUE_TYPE_INT32_LIST: {
       FlValueInt32List* v = reinterpret_cast<FlValueInt32List*>(self);
-      g_free(v->values);
+      free_typed_data(v->values, v->bytes);
       break;
     }
     case FL_VALUE_TYPE_INT64_LIST: {
       FlValueInt64List* v = reinterpret_cast<FlValueInt64List*>(self);
-      g_free(v->values);
+      free_typed_data(v->values, v->bytes);
       break;
     }
     case FL_VALUE_TYPE_FLOAT32_LIST: {
       FlValueFloat32List* v = reinterpret_cast<FlValueFloat32List*>(self);
-      g_free(v->values);
+      free_typed_data(v->values, v->bytes);
       break;
     }
     case FL_VALUE_TYPE_FLOAT_LIST: {
       FlValueFloatList* v = reinterpret_cast<FlValueFloatList*>(self);
-      g_free(v->values);
+      free_typed_data(v->values, v->bytes);
       break;
     }
     case FL_VALUE_TYPE_LIST: {
@@ -603,7 +933,7 @@ G_MODULE_EXPORT void fl_value_append_take(FlValue* self, FlValue* value) {
   g_return_if_fail(value != nullptr);
 
   FlValueList* v = reinterpret_cast<FlValueList*>(self);
-  g_ptr_array_add(v->values, value);
+  g_ptr_array_add(v->values, fl_value_take_child(self, value));
 }
 
 G_MODULE_EXPORT void fl_value_set(FlValue* self, FlValue* key, FlValue* value) {
@@ -626,13 +956,14 @@ G_MODULE_EXPORT void fl_value_set_take(FlValue* self,
   FlValueMap* v = reinterpret_cast<FlValueMap*>(self);
   ssize_t index = fl_value_lookup_index(self, key);
   if (index < 0) {
-    g_ptr_array_add(v->keys, key);
-    g_ptr_array_add(v->values, value);
+    g_ptr_array_add(v->keys, fl_value_take_child(self, key));
+    g_ptr_array_add(v->values, fl_value_take_child(self, value));
   } else {
-    fl_value_destroy(v->keys->pdata[index]);
-    v->keys->pdata[index] = key;
-    fl_value_destroy(v->values->pdata[index]);
-    v->values->pdata[index] = value;
+    fl_value_release_child(self, static_cast<FlValue*>(v->keys->pdata[index]));
+    v->keys->pdata[index] = fl_value_take_child(self, key);
+    fl_value_release_child(self,
+                           static_cast<FlValue*>(v->values->pdata[index]));
+    v->values->pdata[index] = fl_value_take_child(self, value);
   }
 }
 
@@ -848,3 +1179,221 @@ G_MODULE_EXPORT gchar* fl_value_to_string(FlValue* value) {
   value_to_string(value, buffer);
   return g_string_free(buffer, FALSE);
 }
+
+FlValueArena* fl_value_arena_new(GBytes* bytes) {
+  g_return_val_if_fail(bytes != nullptr, nullptr);
+
+  // Values are larger than their encoding in the message, so size the first
+  // block as a multiple of it. It is allocated together with the arena.
+  size_t block_size =
+      CLAMP(g_bytes_get_size(bytes) * kArenaBlockSizePerMessageByte,
+            kArenaMinBlockSize, kArenaMaxBlockSize);
+  FlValueArena* self = static_cast<FlValueArena*>(
+      g_malloc(sizeof(FlValueArena) + block_size));
+  self->ref_count = 1;
+  self->bytes = g_bytes_ref(bytes);
+  self->containers = nullptr;
+  self->blocks = nullptr;
+  self->position = reinterpret_cast<uint8_t*>(self + 1);
+  self->remaining = block_size;
+  self->next_block_size = MIN(block_size * 2, kArenaMaxBlockSize);
+  return self;
+}
+
+FlValueArena* fl_value_arena_ref(FlValueArena* self) {
+  g_return_val_if_fail(self != nullptr, nullptr);
+  self->ref_count++;
+  return self;
+}
+
+void fl_value_arena_unref(FlValueArena* self) {
+  g_return_if_fail(self != nullptr);
+  g_return_if_fail(self->ref_count > 0);
+  self->ref_count--;
+  if (self->ref_count != 0) {
+    return;
+  }
+
+  if (self->containers != nullptr) {
+    for (guint i = 0; i < self->containers->len; i++) {
+      FlValue* value = static_cast<FlValue*>(self->containers->pdata[i]);
+      if (value->type == FL_VALUE_TYPE_LIST) {
+        FlValueList* v = reinterpret_cast<FlValueList*>(value);
+        fl_value_release_children(value, v->values);
+      } else {
+        FlValueMap* v = reinterpret_cast<FlValueMap*>(value);
+        fl_value_release_children(value, v->keys);
+        fl_value_release_children(value, v->values);
+      }
+    }
+    g_ptr_array_unref(self->containers);
+  }
+  g_bytes_unref(self->bytes);
+  while (self->blocks != nullptr) {
+    FlValueArenaBlock* block = self->blocks;
+    self->blocks = block->next;
+    g_free(block);
+  }
+  g_free(self);
+}
+
+GBytes* fl_value_arena_get_bytes(FlValueArena* self) {
+  g_return_val_if_fail(self != nullptr, nullptr);
+  return self->bytes;
+}
+
+FlValue* fl_value_arena_new_null(FlValueArena* arena) {
+  return fl_value_new_in_arena(arena, FL_VALUE_TYPE_NULL, sizeof(FlValue));
+}
+
+FlValue* fl_value_arena_new_bool(FlValueArena* arena, bool value) {
+  FlValueBool* self = reinterpret_cast<FlValueBool*>(
+      fl_value_new_in_arena(arena, FL_VALUE_TYPE_BOOL, sizeof(FlValueBool)));
+  self->value = value ? true : false;
+  return reinterpret_cast<FlValue*>(self);
+}
+
+FlValue* fl_value_arena_new_int(FlValueArena* arena, int64_t value) {
+  FlValueInt* self = reinterpret_cast<FlValueInt*>(
+      fl_value_new_in_arena(arena, FL_VALUE_TYPE_INT, sizeof(FlValueInt)));
+  self->value = value;
+  return reinterpret_cast<FlValue*>(self);
+}
+
+FlValue* fl_value_arena_new_float(FlValueArena* arena, double value) {
+  FlValueDouble* self = reinterpret_cast<FlValueDouble*>(fl_value_new_in_arena(
+      arena, FL_VALUE_TYPE_FLOAT, sizeof(FlValueDouble)));
+  self->value = value;
+  return reinterpret_cast<FlValue*>(self);
+}
+
+FlValue* fl_value_arena_new_string_sized(FlValueArena* arena,
+                                         const gchar* value,
+                                         size_t value_length) {
+  if (arena == nullptr) {
+    return fl_value_new_string_sized(value, value_length);
+  }
+
+  FlValueString* self = reinterpret_cast<FlValueString*>(fl_value_new_in_arena(
+      arena, FL_VALUE_TYPE_STRING, sizeof(FlValueString)));
+  self->value =
+      static_cast<gchar*>(fl_value_arena_allocate(arena, value_length + 1));
+  memcpy(self->value, value, value_length);
+  self->value[value_length] = '\0';
+  return reinterpret_cast<FlValue*>(self);
+}
+
+FlValue* fl_value_arena_new_uint8_list(FlValueArena* arena,
+                                       const uint8_t* data,
+                                       size_t data_length) {
+  if (arena == nullptr) {
+    return fl_value_new_uint8_list(data, data_length);
+  }
+
+  FlValueUint8List* self =
+      reinterpret_cast<FlValueUint8List*>(fl_value_new_in_arena(
+          arena, FL_VALUE_TYPE_UINT8_LIST, sizeof(FlValueUint8List)));
+  self->values_length = data_length;
+  self->values = static_cast<uint8_t*>(fl_value_arena_get_typed_data(
+      arena, data, sizeof(uint8_t), data_length));
+  return reinterpret_cast<FlValue*>(self);
+}
+
+FlValue* fl_value_arena_new_int32_list(FlValueArena* arena,
+                                       const int32_t* data,
+                                       size_t data_length) {
+  if (arena == nullptr) {
+    return fl_value_new_int32_list(data, data_length);
+  }
+
+  FlValueInt32List* self =
+      reinterpret_cast<FlValueInt32List*>(fl_value_new_in_arena(
+          arena, FL_VALUE_TYPE_INT32_LIST, sizeof(FlValueInt32List)));
+  self->values_length = data_length;
+  self->values = static_cast<int32_t*>(fl_value_arena_get_typed_data(
+      arena, data, sizeof(int32_t), data_length));
+  return reinterpret_cast<FlValue*>(self);
+}
+
+FlValue* fl_value_arena_new_int64_list(FlValueArena* arena,
+                                       const int64_t* data,
+                                       size_t data_length) {
+  if (arena == nullptr) {
+    return fl_value_new_int64_list(data, data_length);
+  }
+
+  FlValueInt64List* self =
+      reinterpret_cast<FlValueInt64List*>(fl_value_new_in_arena(
+          arena, FL_VALUE_TYPE_INT64_LIST, sizeof(FlValueInt64List)));
+  self->values_length = data_length;
+  self->values = static_cast<int64_t*>(fl_value_arena_get_typed_data(
+      arena, data, sizeof(int64_t), data_length));
+  return reinterpret_cast<FlValue*>(self);
+}
+
+FlValue* fl_value_arena_new_float32_list(FlValueArena* arena,
+                                         const float* data,
+                                         size_t data_length) {
+  if (arena == nullptr) {
+    return fl_value_new_float32_list(data, data_length);
+  }
+
+  FlValueFloat32List* self =
+      reinterpret_cast<FlValueFloat32List*>(fl_value_new_in_arena(
+          arena, FL_VALUE_TYPE_FLOAT32_LIST, sizeof(FlValueFloat32List)));
+  self->values_length = data_length;
+  self->values = static_cast<float*>(fl_value_arena_get_typed_data(
+      arena, data, sizeof(float), data_length));
+  return reinterpret_cast<FlValue*>(self);
+}
+
+FlValue* fl_value_arena_new_float_list(FlValueArena* arena,
+                                       const double* data,
+                                       size_t data_length) {
+  if (arena == nullptr) {
+    return fl_value_new_float_list(data, data_length);
+  }
+
+  FlValueFloatList* self =
+      reinterpret_cast<FlValueFloatList*>(fl_value_new_in_arena(
+          arena, FL_VALUE_TYPE_FLOAT_LIST, sizeof(FlValueFloatList)));
+  self->values_length = data_length;
+  self->values = static_cast<double*>(fl_value_arena_get_typed_data(
+      arena, data, sizeof(double), data_length));
+  return reinterpret_cast<FlValue*>(self);
+}
+
+FlValue* fl_value_arena_new_list(FlValueArena* arena, size_t reserved_length) {
+  FlValueList* self = reinterpret_cast<FlValueList*>(
+      fl_value_new_in_arena(arena, FL_VALUE_TYPE_LIST, sizeof(FlValueList)));
+  if (arena == nullptr) {
+    self->values = g_ptr_array_new_full(reserved_length, fl_value_destroy);
+    return reinterpret_cast<FlValue*>(self);
+  }
+
+  // The references the list holds are dropped when the arena is freed.
+  self->values = g_ptr_array_sized_new(reserved_length);
+  fl_value_arena_add_container(arena, reinterpret_cast<FlValue*>(self));
+  return reinterpret_cast<FlValue*>(self);
+}
+
+FlValue* fl_value_arena_new_map(FlValueArena* arena, size_t reserved_length) {
+  FlValueMap* self = reinterpret_cast<FlValueMap*>(
+      fl_value_new_in_arena(arena, FL_VALUE_TYPE_MAP, sizeof(FlValueMap)));
+  if (arena == nullptr) {
+    self->keys = g_ptr_array_new_full(reserved_length, fl_value_destroy);
+    self->values = g_ptr_array_new_full(reserved_length, fl_value_destroy);
+    return reinterpret_cast<FlValue*>(self);
+  }
+
+  // The references the map holds are dropped when the arena is freed.
+  self->keys = g_ptr_array_sized_new(reserved_length);
+  self->values = g_ptr_array_sized_new(reserved_length);
+  fl_value_arena_add_container(arena, reinterpret_cast<FlValue*>(self));
+  return reinterpret_cast<FlValue*>(self);
+}
+
+gboolean fl_value_is_in_arena(FlValue* self) {
+  g_return_val_if_fail(self != nullptr, FALSE);
+  return self->arena != nullptr;
+}
@@ -0,0 +1,158 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_LINUX_FL_VALUE_PRIVATE_H_
+#define FLUTTER_SHELL_PLATFORM_LINUX_FL_VALUE_PRIVATE_H_
+
+#include "flutter/shell/platform/linux/public/flutter_linux/fl_value.h"
+
+G_BEGIN_DECLS
+
+/**
+ * FlValueArena:
+ *
+ * #FlValueArena is a block of memory that the values decoded from a message
+ * are allocated from. The values are freed together once the last reference to
+ * any of them is dropped, rather than one by one.
+ *
+ * References to a value allocated from an arena are references to the whole
+ * arena. A list or map in an arena does not hold references to the values of
+ * the same arena it contains, so that the arena is not kept alive by itself.
+ * For the same reason, values added to it that reference an arena otherwise,
+ * such as a list holding values of the arena, are copied out of their arenas.
+ */
+typedef struct _FlValueArena FlValueArena;
+
+/**
+ * fl_value_arena_new:
+ * @bytes: the message the values are decoded from.
+ *
+ * Creates an arena for the values decoded from @bytes. Typed lists allocated
+ * from the arena reference the data in @bytes instead of copying it.
+ *
+ * Returns: a new #FlValueArena.
+ */
+FlValueArena* fl_value_arena_new(GBytes* bytes);
+
+/**
+ * fl_value_arena_ref:
+ * @arena: an #FlValueArena.
+ *
+ * Increases the reference count of an #FlValueArena.
+ *
+ * Returns: the arena that was referenced.
+ */
+FlValueArena* fl_value_arena_ref(FlValueArena* arena);
+
+/**
+ * fl_value_arena_unref:
+ * @arena: an #FlValueArena.
+ *
+ * Decreases the reference count of an #FlValueArena. When the reference count
+ * drops to zero the arena and all the values allocated from it are freed.
+ */
+void fl_value_arena_unref(FlValueArena* arena);
+
+/**
+ * fl_value_arena_get_bytes:
+ * @arena: an #FlValueArena.
+ *
+ * Gets the message the values of @arena are decoded from.
+ *
+ * Returns: a #GBytes.
+ */
+GBytes* fl_value_arena_get_bytes(FlValueArena* arena);
+
+/**
+ * fl_value_arena_new_null:
+ * @arena: (allow-none): an #FlValueArena or %NULL.
+ *
+ * Creates an #FlValue that contains a null value in @arena. If @arena is %NULL
+ * this is equivalent to fl_value_new_null(). The same applies to all the
+ * fl_value_arena_new_*() functions.
+ *
+ * Returns: a new #FlValue.
+ */
+FlValue* fl_value_arena_new_null(FlValueArena* arena);
+
+FlValue* fl_value_arena_new_bool(FlValueArena* arena, bool value);
+
+FlValue* fl_value_arena_new_int(FlValueArena* arena, int64_t value);
+
+FlValue* fl_value_arena_new_float(FlValueArena* arena, double value);
+
+FlValue* fl_value_arena_new_string_sized(FlValueArena* arena,
+                                         const gchar* value,
+                                         size_t value_length);
+
+/**
+ * fl_value_arena_new_uint8_list:
+ * @arena: (allow-none): an #FlValueArena or %NULL.
+ * @value: an array of unsigned 8 bit integers.
+ * @value_length: number of elements in @value.
+ *
+ * Creates an ordered list containing 8 bit unsigned integers in @arena. If
+ * @value lies in the bytes of @arena and is suitably aligned it is referenced,
+ * otherwise it is copied. The same applies to the other typed lists.
+ *
+ * Returns: a new #FlValue.
+ */
+FlValue* fl_value_arena_new_uint8_list(FlValueArena* arena,
+                                       const uint8_t* value,
+                                       size_t value_length);
+
+FlValue* fl_value_arena_new_int32_list(FlValueArena* arena,
+                                       const int32_t* value,
+                                       size_t value_length);
+
+FlValue* fl_value_arena_new_int64_list(FlValueArena* arena,
+                                       const int64_t* value,
+                                       size_t value_length);
+
+FlValue* fl_value_arena_new_float32_list(FlValueArena* arena,
+                                         const float* value,
+                                         size_t value_length);
+
+FlValue* fl_value_arena_new_float_list(FlValueArena* arena,
+                                       const double* value,
+                                       size_t value_length);
+
+/**
+ * fl_value_arena_new_list:
+ * @arena: (allow-none): an #FlValueArena or %NULL.
+ * @reserved_length: the number of values the list is expected to contain.
+ *
+ * Creates an ordered list in @arena with room for @reserved_length values.
+ *
+ * Returns: a new #FlValue.
+ */
+FlValue* fl_value_arena_new_list(FlValueArena* arena, size_t reserved_length);
+
+/**
+ * fl_value_arena_new_map:
+ * @arena: (allow-none): an #FlValueArena or %NULL.
+ * @reserved_length: the number of entries the map is expected to contain.
+ *
+ * Creates an ordered associative array in @arena with room for
+ * @reserved_length entries.
+ *
+ * Returns: a new #FlValue.
+ */
+FlValue* fl_value_arena_new_map(FlValueArena* arena, size_t reserved_length);
+
+/**
+ * fl_value_is_in_arena:
+ * @value: an #FlValue.
+ *
+ * Checks if @value was allocated from an #FlValueArena.
+ *
+ * Returns: %TRUE if @value is in an arena.
+ */
+gboolean fl_value_is_in_arena(FlValue* value);
+
+G_DEFINE_AUTOPTR_CLEANUP_FUNC(FlValueArena, fl_value_arena_unref)
+
+G_END_DECLS
+
+#endif  // FLUTTER_SHELL_PLATFORM_LINUX_FL_VALUE_PRIVATE_H_
@@ -7,6 +7,8 @@
 #include <gmodule.h>
 
 #include <cmath>
+#include <cstring>
+#include "flutter/shell/platform/linux/fl_value_private.h"
 #include "gtest/gtest.h"
 
 TEST(FlValueTest, Null) {
@@ -261,6 +263,26 @@ TEST(FlValueTest, Uint8ListToString) {
   EXPECT_STREQ(text, "[0, 1, 254, 255]");
 }
 
+TEST(FlValueTest, Uint8ListFromBytes) {
+  uint8_t data[] = {0x00, 0x01, 0xFE, 0xFF};
+  g_autoptr(GBytes) bytes = g_bytes_new(data, 4);
+  g_autoptr(FlValue) value = fl_value_new_uint8_list_from_bytes(bytes);
+  ASSERT_EQ(fl_value_get_type(value), FL_VALUE_TYPE_UINT8_LIST);
+  ASSERT_EQ(fl_value_get_length(value), static_cast<size_t>(4));
+  // The data is referenced rather than copied.
+  EXPECT_EQ(fl_value_get_uint8_list(value), g_bytes_get_data(bytes, nullptr));
+  EXPECT_EQ(fl_value_get_uint8_list(value)[3], 0xFF);
+}
+
+TEST(FlValueTest, Uint8ListFromBytesOutlivesBytes) {
+  uint8_t data[] = {0x00, 0x01, 0xFE, 0xFF};
+  GBytes* bytes = g_bytes_new(data, 4);
+  g_autoptr(FlValue) value = fl_value_new_uint8_list_from_bytes(bytes);
+  g_bytes_unref(bytes);
+  ASSERT_EQ(fl_value_get_length(value), static_cast<size_t>(4));
+  EXPECT_EQ(fl_value_get_uint8_list(value)[2], 0xFE);
+}
+
 TEST(FlValueTest, Int32List) {
   int32_t data[] = {0, -1, G_MAXINT32, G_MININT32};
   g_autoptr(FlValue) value = fl_value_new_int32_list(data, 4);
@@ -322,6 +344,16 @@ TEST(FlValueTest, Int32ListToString) {
   EXPECT_STREQ(text, "[0, 2147483647, -2147483648]");
 }
 
+TEST(FlValueTest, Int32ListFromBytes) {
+  int32_t data[] = {0, -1, G_MAXINT32, G_MININT32};
+  g_autoptr(GBytes) bytes = g_bytes_new(data, sizeof(data));
+  g_autoptr(FlValue) value = fl_value_new_int32_list_from_bytes(bytes);
+  ASSERT_EQ(fl_value_get_type(value), FL_VALUE_TYPE_INT32_LIST);
+  ASSERT_EQ(fl_value_get_length(value), static_cast<size_t>(4));
+  EXPECT_EQ(fl_value_get_int32_list(value), g_bytes_get_data(bytes, nullptr));
+  EXPECT_EQ(fl_value_get_int32_list(value)[2], G_MAXINT32);
+}
+
 TEST(FlValueTest, Int64List) {
   int64_t data[] = {0, -1, G_MAXINT64, G_MININT64};
   g_autoptr(FlValue) value = fl_value_new_int64_list(data, 4);
@@ -383,6 +415,19 @@ TEST(FlValueTest, Int64ListToString) {
   EXPECT_STREQ(text, "[0, 9223372036854775807, -9223372036854775808]");
 }
 
+TEST(FlValueTest, Int64ListFromBytesSlice) {
+  int64_t data[] = {0, -1, G_MAXINT64, G_MININT64};
+  g_autoptr(GBytes) bytes = g_bytes_new(data, sizeof(data));
+  g_autoptr(GBytes) slice =
+      g_bytes_new_from_bytes(bytes, sizeof(int64_t), sizeof(int64_t) * 2);
+  g_autoptr(FlValue) value = fl_value_new_int64_list_from_bytes(slice);
+  ASSERT_EQ(fl_value_get_type(value), FL_VALUE_TYPE_INT64_LIST);
+  ASSERT_EQ(fl_value_get_length(value), static_cast<size_t>(2));
+  EXPECT_EQ(fl_value_get_int64_list(value), g_bytes_get_data(slice, nullptr));
+  EXPECT_EQ(fl_value_get_int64_list(value)[0], -1);
+  EXPECT_EQ(fl_value_get_int64_list(value)[1], G_MAXINT64);
+}
+
 TEST(FlValueTest, FloatList) {
   double data[] = {0.0, -1.0, M_PI};
   g_autoptr(FlValue) value = fl_value_new_float_list(data, 3);
@@ -443,6 +488,19 @@ TEST(FlValueTest, FloatListToString) {
   EXPECT_STREQ(text, "[0.0, -0.5, 3.1415926535897931]");
 }
 
+TEST(FlValueTest, FloatListFromBytesUnaligned) {
+  uint8_t data[sizeof(double) * 2 + 1];
+  double values[] = {-0.5, M_PI};
+  memcpy(data + 1, values, sizeof(values));
+  g_autoptr(GBytes) bytes = g_bytes_new(data, sizeof(data));
+  g_autoptr(GBytes) slice = g_bytes_new_from_bytes(bytes, 1, sizeof(values));
+  g_autoptr(FlValue) value = fl_value_new_float_list_from_bytes(slice);
+  ASSERT_EQ(fl_value_get_type(value), FL_VALUE_TYPE_FLOAT_LIST);
+  ASSERT_EQ(fl_value_get_length(value), static_cast<size_t>(2));
+  EXPECT_EQ(fl_value_get_float_list(value)[0], -0.5);
+  EXPECT_EQ(fl_value_get_float_list(value)[1], M_PI);
+}
+
 TEST(FlValueTest, ListEmpty) {
   g_autoptr(FlValue) value = fl_value_new_list();
   ASSERT_EQ(fl_value_get_type(value), FL_VALUE_TYPE_LIST);
@@ -984,3 +1042,123 @@ TEST(FlValueTest, ListMapNotEqual) {
   g_autoptr(FlValue) value2 = fl_value_new_map();
   EXPECT_FALSE(fl_value_equal(value1, value2));
 }
+
+TEST(FlValueTest, ArenaValues) {
+  g_autoptr(GBytes) bytes = g_bytes_new(nullptr, 0);
+  FlValueArena* arena = fl_value_arena_new(bytes);
+  g_autoptr(FlValue) list = fl_value_arena_new_list(arena, 4);
+  fl_value_append_take(list, fl_value_arena_new_null(arena));
+  fl_value_append_take(list, fl_value_arena_new_bool(arena, TRUE));
+  fl_value_append_take(list, fl_value_arena_new_int(arena, 42));
+  fl_value_append_take(list,
+                       fl_value_arena_new_string_sized(arena, "hello!", 5));
+  fl_value_arena_unref(arena);
+
+  EXPECT_TRUE(fl_value_is_in_arena(list));
+  EXPECT_TRUE(fl_value_is_in_arena(fl_value_get_list_value(list, 0)));
+  g_autofree gchar* text = fl_value_to_string(list);
+  EXPECT_STREQ(text, "[null, true, 42, hello]");
+}
+
+TEST(FlValueTest, ArenaValueOutlivesParent) {
+  g_autoptr(GBytes) bytes = g_bytes_new(nullptr, 0);
+  g_autoptr(FlValueArena) arena = fl_value_arena_new(bytes);
+  FlValue* map = fl_value_arena_new_map(arena, 1);
+  fl_value_set_take(map, fl_value_arena_new_string_sized(arena, "key", 3),
+                    fl_value_arena_new_float(arena, M_PI));
+  g_clear_pointer(&arena, fl_value_arena_unref);
+
+  g_autoptr(FlValue) value = fl_value_ref(fl_value_lookup_string(map, "key"));
+  fl_value_unref(map);
+  ASSERT_EQ(fl_value_get_type(value), FL_VALUE_TYPE_FLOAT);
+  EXPECT_EQ(fl_value_get_float(value), M_PI);
+}
+
+TEST(FlValueTest, ArenaListHoldsOtherValues) {
+  g_autoptr(GBytes) bytes = g_bytes_new(nullptr, 0);
+  FlValueArena* arena = fl_value_arena_new(bytes);
+  g_autoptr(FlValue) list = fl_value_arena_new_list(arena, 0);
+  fl_value_arena_unref(arena);
+
+  g_autoptr(FlValue) child = fl_value_new_string("hello");
+  fl_value_append(list, child);
+  fl_value_append_take(list, fl_value_new_int(42));
+
+  // Arena values can also be held by values that are not in an arena.
+  g_autoptr(FlValue) holder = fl_value_new_list();
+  fl_value_append(holder, list);
+  g_clear_pointer(&list, fl_value_unref);
+
+  FlValue* held = fl_value_get_list_value(holder, 0);
+  EXPECT_FALSE(fl_value_is_in_arena(holder));
+  EXPECT_TRUE(fl_value_is_in_arena(held));
+  ASSERT_EQ(fl_value_get_length(held), static_cast<size_t>(2));
+  EXPECT_EQ(fl_value_get_list_value(held, 0), child);
+  EXPECT_EQ(fl_value_get_int(fl_value_get_list_value(held, 1)), 42);
+}
+
+TEST(FlValueTest, ArenaListCopiesValuesHoldingArenaValues) {
+  static const uint8_t data[] = {0};
+  gboolean freed = FALSE;
+  GBytes* bytes = g_bytes_new_with_free_func(
+      data, sizeof(data),
+      [](gpointer user_data) { *static_cast<gboolean*>(user_data) = TRUE; },
+      &freed);
+  FlValueArena* arena = fl_value_arena_new(bytes);
+  g_bytes_unref(bytes);
+  FlValue* list = fl_value_arena_new_list(arena, 1);
+  FlValue* holder = fl_value_new_list();
+  fl_value_append_take(holder, fl_value_arena_new_int(arena, 42));
+  fl_value_arena_unref(arena);
+
+  // Holding |holder| would make the arena reference itself, so the list holds
+  // a copy of it without arena values instead.
+  fl_value_append(list, holder);
+  FlValue* held = fl_value_get_list_value(list, 0);
+  EXPECT_NE(held, holder);
+  EXPECT_TRUE(fl_value_equal(held, holder));
+  EXPECT_FALSE(fl_value_is_in_arena(fl_value_get_list_value(held, 0)));
+
+  fl_value_unref(holder);
+  EXPECT_FALSE(freed);
+  fl_value_unref(list);
+  EXPECT_TRUE(freed);
+}
+
+TEST(FlValueTest, ArenaMapReplaceValue) {
+  g_autoptr(GBytes) bytes = g_bytes_new(nullptr, 0);
+  FlValueArena* arena = fl_value_arena_new(bytes);
+  g_autoptr(FlValue) map = fl_value_arena_new_map(arena, 0);
+  fl_value_set_string_take(map, "one", fl_value_arena_new_int(arena, 1));
+  fl_value_set_string_take(map, "two", fl_value_arena_new_int(arena, 2));
+  fl_value_arena_unref(arena);
+
+  fl_value_set_string_take(map, "one", fl_value_new_string("uno"));
+  ASSERT_EQ(fl_value_get_length(map), static_cast<size_t>(2));
+  EXPECT_STREQ(fl_value_get_string(fl_value_lookup_string(map, "one")), "uno");
+  EXPECT_EQ(fl_value_get_int(fl_value_lookup_string(map, "two")), 2);
+}
+
+TEST(FlValueTest, ArenaTypedLists) {
+  int32_t data[] = {1, 2, 3, 4};
+  g_autoptr(GBytes) bytes = g_bytes_new(data, sizeof(data));
+  const int32_t* bytes_data =
+      static_cast<const int32_t*>(g_bytes_get_data(bytes, nullptr));
+  FlValueArena* arena = fl_value_arena_new(bytes);
+  g_autoptr(FlValue) list = fl_value_arena_new_int32_list(arena, bytes_data, 4);
+  // Data outside the bytes of the arena is copied.
+  g_autoptr(FlValue) copy = fl_value_arena_new_int32_list(arena, data, 4);
+  fl_value_arena_unref(arena);
+
+  EXPECT_EQ(fl_value_get_int32_list(list), bytes_data);
+  EXPECT_NE(fl_value_get_int32_list(copy), bytes_data);
+  EXPECT_NE(fl_value_get_int32_list(copy), data);
+  EXPECT_TRUE(fl_value_equal(list, copy));
+}
+
+TEST(FlValueTest, ArenaWithoutArena) {
+  g_autoptr(FlValue) value = fl_value_arena_new_list(nullptr, 1);
+  fl_value_append_take(value, fl_value_arena_new_int(nullptr, 42));
+  EXPECT_FALSE(fl_value_is_in_arena(value));
+  EXPECT_FALSE(fl_value_is_in_arena(fl_value_get_list_value(value, 0)));
+}
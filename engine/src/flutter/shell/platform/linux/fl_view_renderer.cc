@@ -134,3 +134,30 @@ gboolean fl_view_renderer_resize_to_frame(FlViewRenderer* self,
   }
   return TRUE;
 }
+
+void fl_view_renderer_queue_draw_damage(FlViewRenderer* self,
+                                        const cairo_region_t* damage) {
+  g_return_if_fail(FL_IS_VIEW_RENDERER(self));
+
+  // Convert from pixels to widget coordinates, rounding outwards so widget
+  // pixels that are only partly damaged are redrawn.
+  gint scale_factor = gtk_widget_get_scale_factor(GTK_WIDGET(self));
+  cairo_region_t* region = cairo_region_create();
+  int n_rects = cairo_region_num_rectangles(damage);
+  for (int i = 0; i < n_rects; i++) {
+    cairo_rectangle_int_t rect;
+    cairo_region_get_rectangle(damage, i, &rect);
+    int left = rect.x / scale_factor;
+    int top = rect.y / scale_factor;
+    int right = (rect.x + rect.width + scale_factor - 1) / scale_factor;
+    int bottom = (rect.y + rect.height + scale_factor - 1) / scale_factor;
+    cairo_rectangle_int_t widget_rect = {
+        .x = left, .y = top, .width = right - left, .height = bottom - top};
+    cairo_region_union_rectangle(region, &widget_rect);
+  }
+
+  if (!cairo_region_is_empty(region)) {
+    gtk_widget_queue_draw_region(GTK_WIDGET(self), region);
+  }
+  cairo_region_destroy(region);
+}
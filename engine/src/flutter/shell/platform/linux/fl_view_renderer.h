@@ -100,6 +100,18 @@ gboolean fl_view_renderer_resize_to_frame(FlViewRenderer* renderer,
                                           size_t frame_width,
                                           size_t frame_height);
 
+/**
+ * fl_view_renderer_queue_draw_damage:
+ * @renderer: an #FlViewRenderer.
+ * @damage: the region of the frame that changed, in pixels.
+ *
+ * Requests the parts of the view that show @damage to be redrawn, leaving the
+ * rest of the view as it is. Called from the GTK thread when a new frame is
+ * ready.
+ */
+void fl_view_renderer_queue_draw_damage(FlViewRenderer* renderer,
+                                        const cairo_region_t* damage);
+
 G_END_DECLS
 
 #endif  // FLUTTER_SHELL_PLATFORM_LINUX_FL_VIEW_RENDERER_H_
@@ -33,6 +33,9 @@ struct _FlViewRendererOpenGL {
   // Manages the framebuffer the current frame is composited into.
   FlOpenGLFrame* frame;
 
+  // Region of the frame that changed since the view was last redrawn.
+  cairo_region_t* damage;
+
   // Task runner to wait for frames on.
   FlTaskRunner* task_runner;
 
@@ -67,6 +70,11 @@ static gboolean redraw_cb(gpointer user_data) {
 
   fl_view_renderer_notify_frame(FL_VIEW_RENDERER(self));
 
+  g_mutex_lock(&self->frame_mutex);
+  cairo_region_t* damage = self->damage;
+  self->damage = cairo_region_create();
+  g_mutex_unlock(&self->frame_mutex);
+
   // If Flutter is controlling the window size, then resize the view if
   // necessary. The redraw happens once the resized frame arrives.
   if (self->sized_to_content) {
@@ -76,11 +84,14 @@ static gboolean redraw_cb(gpointer user_data) {
     g_mutex_unlock(&self->frame_mutex);
     if (fl_view_renderer_resize_to_frame(FL_VIEW_RENDERER(self), frame_width,
                                          frame_height)) {
+      cairo_region_destroy(damage);
       return G_SOURCE_REMOVE;
     }
   }
 
-  gtk_widget_queue_draw(GTK_WIDGET(self));
+  // Only redraw the parts of the view that changed.
+  fl_view_renderer_queue_draw_damage(FL_VIEW_RENDERER(self), damage);
+  cairo_region_destroy(damage);
 
   return G_SOURCE_REMOVE;
 }
@@ -204,7 +215,7 @@ static void fl_view_renderer_opengl_present_layers(FlViewRenderer* renderer,
 
   g_mutex_lock(&self->frame_mutex);
   fl_opengl_frame_composite(self->frame, self->compositor, layers,
-                            layers_count);
+                            layers_count, self->damage);
   g_mutex_unlock(&self->frame_mutex);
 
   // Wake up the GTK thread if it is waiting for this frame.
@@ -235,6 +246,7 @@ static void fl_view_renderer_opengl_finalize(GObject* object) {
   // presenting.
   g_clear_object(&self->compositor);
   g_clear_object(&self->frame);
+  g_clear_pointer(&self->damage, cairo_region_destroy);
 
   G_OBJECT_CLASS(fl_view_renderer_opengl_parent_class)->finalize(object);
 }
@@ -254,6 +266,7 @@ static void fl_view_renderer_opengl_class_init(
 }
 
 static void fl_view_renderer_opengl_init(FlViewRendererOpenGL* self) {
+  self->damage = cairo_region_create();
   g_mutex_init(&self->frame_mutex);
 }
 
@@ -26,6 +26,13 @@ struct _FlViewRendererSoftware {
   // Surface the current frame is composited into.
   cairo_surface_t* surface;
 
+  // Region of the surface the current frame painted, or NULL if the surface
+  // has not been composited into yet.
+  cairo_region_t* painted_region;
+
+  // Region of the frame that changed since the view was last redrawn.
+  cairo_region_t* damage;
+
   // Task runner to wait for frames on.
   FlTaskRunner* task_runner;
 
@@ -61,6 +68,11 @@ static gboolean redraw_cb(gpointer user_data) {
 
   fl_view_renderer_notify_frame(FL_VIEW_RENDERER(self));
 
+  g_mutex_lock(&self->frame_mutex);
+  cairo_region_t* damage = self->damage;
+  self->damage = cairo_region_create();
+  g_mutex_unlock(&self->frame_mutex);
+
   // If Flutter is controlling the window size, then resize the view if
   // necessary. The redraw happens once the resized frame arrives.
   if (self->sized_to_content) {
@@ -70,11 +82,14 @@ static gboolean redraw_cb(gpointer user_data) {
     g_mutex_unlock(&self->frame_mutex);
     if (fl_view_renderer_resize_to_frame(FL_VIEW_RENDERER(self), frame_width,
                                          frame_height)) {
+      cairo_region_destroy(damage);
       return G_SOURCE_REMOVE;
     }
   }
 
-  gtk_widget_queue_draw(GTK_WIDGET(self));
+  // Only redraw the parts of the view that changed.
+  fl_view_renderer_queue_draw_damage(FL_VIEW_RENDERER(self), damage);
+  cairo_region_destroy(damage);
 
   return G_SOURCE_REMOVE;
 }
@@ -180,7 +195,11 @@ static void fl_view_renderer_software_present_layers(
       // the renderer reports no frame rather than an empty surface (a 0x0
       // surface would otherwise be treated as a valid frame while matching the
       // "no frame" size of 0x0).
+      if (self->painted_region != nullptr) {
+        cairo_region_union(self->damage, self->painted_region);
+      }
       g_clear_pointer(&self->surface, cairo_surface_destroy);
+      g_clear_pointer(&self->painted_region, cairo_region_destroy);
     } else {
       // Recreate the surface if the frame size has changed.
       if (self->surface == nullptr ||
@@ -191,13 +210,29 @@ static void fl_view_renderer_software_present_layers(
         g_clear_pointer(&self->surface, cairo_surface_destroy);
         self->surface =
             cairo_image_surface_create(CAIRO_FORMAT_ARGB32, width, height);
+        g_clear_pointer(&self->painted_region, cairo_region_destroy);
       }
 
       cairo_t* cr = cairo_create(self->surface);
-      fl_compositor_software_composite_layers(self->compositor, cr, layers,
-                                              layers_count);
+      cairo_region_t* painted_region = fl_compositor_software_composite_layers(
+          self->compositor, cr, layers, layers_count, self->painted_region);
       cairo_destroy(cr);
       cairo_surface_flush(self->surface);
+
+      // Pixels may have changed wherever the previous or this frame painted.
+      if (self->painted_region != nullptr) {
+        cairo_region_union(self->damage, self->painted_region);
+        cairo_region_destroy(self->painted_region);
+      } else {
+        cairo_rectangle_int_t frame_rect = {
+            .x = 0,
+            .y = 0,
+            .width = static_cast<int>(width),
+            .height = static_cast<int>(height)};
+        cairo_region_union_rectangle(self->damage, &frame_rect);
+      }
+      cairo_region_union(self->damage, painted_region);
+      self->painted_region = painted_region;
     }
   }
   g_mutex_unlock(&self->frame_mutex);
@@ -229,6 +264,8 @@ static void fl_view_renderer_software_finalize(GObject* object) {
   // presenting.
   g_clear_object(&self->compositor);
   g_clear_pointer(&self->surface, cairo_surface_destroy);
+  g_clear_pointer(&self->painted_region, cairo_region_destroy);
+  g_clear_pointer(&self->damage, cairo_region_destroy);
 
   G_OBJECT_CLASS(fl_view_renderer_software_parent_class)->finalize(object);
 }
@@ -248,6 +285,7 @@ static void fl_view_renderer_software_class_init(
 }
 
 static void fl_view_renderer_software_init(FlViewRendererSoftware* self) {
+  self->damage = cairo_region_create();
   g_mutex_init(&self->frame_mutex);
 }
 
@@ -112,6 +112,38 @@ struct _FlPixelBufferTextureClass {
                           GError** error);
 };
 
+/**
+ * fl_pixel_buffer_texture_begin_frame:
+ * @texture: an #FlPixelBufferTexture.
+ * @width: width of the frame in pixels.
+ * @height: height of the frame in pixels.
+ *
+ * Starts a new frame of @texture. Write the frame into the returned buffer in
+ * RGBA format, then publish it with fl_pixel_buffer_texture_end_frame().
+ *
+ * Frames can be published from any thread, as an alternative to implementing
+ * FlPixelBufferTexture::copy_pixels. The render thread uploads the latest
+ * published frame without waiting for the frame being written, and frames that
+ * are published faster than they are shown are dropped. Only one thread may
+ * write a frame at a time.
+ *
+ * Returns: a buffer of @width * @height * 4 bytes, valid until the frame is
+ * ended.
+ */
+uint8_t* fl_pixel_buffer_texture_begin_frame(FlPixelBufferTexture* texture,
+                                             uint32_t width,
+                                             uint32_t height);
+
+/**
+ * fl_pixel_buffer_texture_end_frame:
+ * @texture: an #FlPixelBufferTexture.
+ *
+ * Publishes the frame started with fl_pixel_buffer_texture_begin_frame(). Call
+ * fl_texture_registrar_mark_texture_frame_available() afterwards to have the
+ * frame shown.
+ */
+void fl_pixel_buffer_texture_end_frame(FlPixelBufferTexture* texture);
+
 G_END_DECLS
 
 #endif  // FLUTTER_SHELL_PLATFORM_LINUX_PUBLIC_FLUTTER_LINUX_FL_PIXEL_BUFFER_TEXTURE_H_
@@ -100,6 +100,30 @@ struct _FlStandardMessageCodecClass {
  */
 FlStandardMessageCodec* fl_standard_message_codec_new();
 
+/**
+ * fl_standard_message_codec_set_arena_decoding:
+ * @codec: an #FlStandardMessageCodec.
+ * @arena_decoding: %TRUE to allocate decoded values from an arena.
+ *
+ * Sets whether the values of each decoded message are allocated together from
+ * a single arena rather than one by one. Typed lists in the message then
+ * reference the message data instead of copying it. This makes decoding large
+ * messages faster, but the memory of the whole message is only freed once no
+ * reference to any of its values is held.
+ *
+ * Lists and maps decoded this way keep values that are added to them alive
+ * until the whole message is freed. Values added to them that hold decoded
+ * values, such as a new list holding a decoded string, are copied rather than
+ * referenced, as the message would otherwise keep itself alive. Decoded values
+ * must not be added to a list or map after it has been added to a decoded list
+ * or map, for the same reason.
+ *
+ * Arena decoding is disabled by default.
+ */
+void fl_standard_message_codec_set_arena_decoding(
+    FlStandardMessageCodec* codec,
+    gboolean arena_decoding);
+
 /**
  * fl_standard_message_codec_write_size:
  * @codec: an #FlStandardMessageCodec.
@@ -159,7 +159,8 @@ FlValue* fl_value_new_uint8_list(const uint8_t* value, size_t value_length);
  * @value: a #GBytes.
  *
  * Creates an ordered list containing 8 bit unsigned integers. The data is
- * copied. The equivalent Dart type is a Uint8List.
+ * referenced, not copied. Use g_bytes_new_from_bytes() to create a list from a
+ * slice of a #GBytes. The equivalent Dart type is a Uint8List.
  *
  * Returns: a new #FlValue.
  */
@@ -177,6 +178,19 @@ FlValue* fl_value_new_uint8_list_from_bytes(GBytes* value);
  */
 FlValue* fl_value_new_int32_list(const int32_t* value, size_t value_length);
 
+/**
+ * fl_value_new_int32_list_from_bytes:
+ * @value: a #GBytes containing an array of signed 32 bit integers.
+ *
+ * Creates an ordered list containing signed 32 bit integers from the data in
+ * @value. The size of @value must be a multiple of the size of int32_t. The
+ * data is referenced rather than copied, unless it is not suitably aligned. The
+ * equivalent Dart type is a Int32List.
+ *
+ * Returns: a new #FlValue.
+ */
+FlValue* fl_value_new_int32_list_from_bytes(GBytes* value);
+
 /**
  * fl_value_new_int64_list:
  * @value: an array of signed 64 bit integers.
@@ -189,6 +203,19 @@ FlValue* fl_value_new_int32_list(const int32_t* value, size_t value_length);
  */
 FlValue* fl_value_new_int64_list(const int64_t* value, size_t value_length);
 
+/**
+ * fl_value_new_int64_list_from_bytes:
+ * @value: a #GBytes containing an array of signed 64 bit integers.
+ *
+ * Creates an ordered list containing signed 64 bit integers from the data in
+ * @value. The size of @value must be a multiple of the size of int64_t. The
+ * data is referenced rather than copied, unless it is not suitably aligned. The
+ * equivalent Dart type is a Int64List.
+ *
+ * Returns: a new #FlValue.
+ */
+FlValue* fl_value_new_int64_list_from_bytes(GBytes* value);
+
 /**
  * fl_value_new_float32_list:
  * @value: an array of floating point numbers.
@@ -201,6 +228,19 @@ FlValue* fl_value_new_int64_list(const int64_t* value, size_t value_length);
  */
 FlValue* fl_value_new_float32_list(const float* value, size_t value_length);
 
+/**
+ * fl_value_new_float32_list_from_bytes:
+ * @value: a #GBytes containing an array of 32 bit floating point numbers.
+ *
+ * Creates an ordered list containing 32 bit floating point numbers from the
+ * data in @value. The size of @value must be a multiple of the size of float.
+ * The data is referenced rather than copied, unless it is not suitably aligned.
+ * The equivalent Dart type is a Float32List.
+ *
+ * Returns: a new #FlValue.
+ */
+FlValue* fl_value_new_float32_list_from_bytes(GBytes* value);
+
 /**
  * fl_value_new_float_list:
  * @value: an array of floating point numbers.
@@ -213,6 +253,19 @@ FlValue* fl_value_new_float32_list(const float* value, size_t value_length);
  */
 FlValue* fl_value_new_float_list(const double* value, size_t value_length);
 
+/**
+ * fl_value_new_float_list_from_bytes:
+ * @value: a #GBytes containing an array of floating point numbers.
+ *
+ * Creates an ordered list containing floating point numbers from the data in
+ * @value. The size of @value must be a multiple of the size of double. The data
+ * is referenced rather than copied, unless it is not suitably aligned. The
+ * equivalent Dart type is a Float64List.
+ *
+ * Returns: a new #FlValue.
+ */
+FlValue* fl_value_new_float_list_from_bytes(GBytes* value);
+
 /**
  * fl_value_new_list:
  *
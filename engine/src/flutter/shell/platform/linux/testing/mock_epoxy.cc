@@ -394,6 +394,11 @@ static GLuint bound_texture_2d;
 
 static std::map<GLenum, GLuint> framebuffer_renderbuffers;
 
+// Contents of the bound pixel unpack buffer.
+static GLuint next_buffer_id = 1;
+static GLuint bound_pixel_unpack_buffer = 0;
+static std::vector<uint8_t> pixel_unpack_buffer_data;
+
 static GLboolean enable_blend = GL_FALSE;
 static GLboolean enable_scissor_test = GL_FALSE;
 
@@ -409,6 +414,12 @@ void _glAttachShader(GLuint program, GLuint shader) {}
 
 static void _glBindFramebuffer(GLenum target, GLuint framebuffer) {}
 
+static void _glBindBuffer(GLenum target, GLuint buffer) {
+  if (target == GL_PIXEL_UNPACK_BUFFER) {
+    bound_pixel_unpack_buffer = buffer;
+  }
+}
+
 static void _glBindRenderbuffer(GLenum target, GLuint framebuffer) {}
 
 static void _glBindTexture(GLenum target, GLuint texture) {
@@ -431,6 +442,19 @@ static void _glBlitFramebuffer(GLint srcX0,
                           dstY1, mask, filter);
 }
 
+static void _glBufferData(GLenum target,
+                          GLsizeiptr size,
+                          const void* data,
+                          GLenum usage) {
+  if (target == GL_PIXEL_UNPACK_BUFFER) {
+    FML_CHECK(bound_pixel_unpack_buffer != 0);
+    pixel_unpack_buffer_data.resize(size);
+    if (data != nullptr) {
+      memcpy(pixel_unpack_buffer_data.data(), data, size);
+    }
+  }
+}
+
 GLuint _glCreateProgram() {
   return 0;
 }
@@ -445,6 +469,8 @@ GLuint _glCreateShader(GLenum shaderType) {
   return 0;
 }
 
+void _glDeleteBuffers(GLsizei n, const GLuint* buffers) {}
+
 void _glDeleteFramebuffers(GLsizei n, const GLuint* framebuffers) {
   if (mock) {
     mock->glDeleteFramebuffers(n, framebuffers);
@@ -486,6 +512,12 @@ static void _glFramebufferTexture2D(GLenum target,
                                     GLuint texture,
                                     GLint level) {}
 
+static void _glGenBuffers(GLsizei n, GLuint* buffers) {
+  for (GLsizei i = 0; i < n; i++) {
+    buffers[i] = next_buffer_id++;
+  }
+}
+
 static void _glGenTextures(GLsizei n, GLuint* textures) {
   for (GLsizei i = 0; i < n; i++) {
     textures[i] = 0;
@@ -569,6 +601,18 @@ static GLboolean _glIsEnabled(GLenum cap) {
   }
 }
 
+static void* _glMapBufferRange(GLenum target,
+                               GLintptr offset,
+                               GLsizeiptr length,
+                               GLbitfield access) {
+  if (target != GL_PIXEL_UNPACK_BUFFER) {
+    return nullptr;
+  }
+  FML_CHECK(offset + length <=
+            static_cast<GLsizeiptr>(pixel_unpack_buffer_data.size()));
+  return pixel_unpack_buffer_data.data() + offset;
+}
+
 static void _glTexParameterf(GLenum target, GLenum pname, GLfloat param) {}
 
 static void _glTexParameteri(GLenum target, GLenum pname, GLint param) {}
@@ -594,6 +638,33 @@ static void _glTexImage2D(GLenum target,
   }
 }
 
+static void _glTexSubImage2D(GLenum target,
+                             GLint level,
+                             GLint xoffset,
+                             GLint yoffset,
+                             GLsizei width,
+                             GLsizei height,
+                             GLenum format,
+                             GLenum type,
+                             const void* pixels) {
+  FML_CHECK(format == GL_RGBA);
+  FML_CHECK(type == GL_UNSIGNED_BYTE);
+
+  // Simple mock read to detect out-of-bounds reads in tests.
+  size_t size = width * height * 4;
+  if (bound_pixel_unpack_buffer != 0) {
+    size_t offset = reinterpret_cast<size_t>(pixels);
+    FML_CHECK(offset + size <= pixel_unpack_buffer_data.size());
+  } else {
+    std::vector<uint8_t> temp(size);
+    memcpy(temp.data(), pixels, size);
+  }
+}
+
+static GLboolean _glUnmapBuffer(GLenum target) {
+  return GL_TRUE;
+}
+
 static GLenum _glGetError() {
   return GL_NO_ERROR;
 }
@@ -761,13 +832,16 @@ static void library_init() {
 
   epoxy_glAttachShader = _glAttachShader;
   epoxy_glBindFramebuffer = _glBindFramebuffer;
+  epoxy_glBindBuffer = _glBindBuffer;
   epoxy_glBindRenderbuffer = _glBindRenderbuffer;
   epoxy_glBindTexture = _glBindTexture;
   epoxy_glBlitFramebuffer = _glBlitFramebuffer;
+  epoxy_glBufferData = _glBufferData;
   epoxy_glCompileShader = _glCompileShader;
   epoxy_glClearColor = _glClearColor;
   epoxy_glCreateProgram = _glCreateProgram;
   epoxy_glCreateShader = _glCreateShader;
+  epoxy_glDeleteBuffers = _glDeleteBuffers;
   epoxy_glDeleteFramebuffers = _glDeleteFramebuffers;
   epoxy_glDeleteRenderbuffers = _glDeleteRenderbuffers;
   epoxy_glDeleteShader = _glDeleteShader;
@@ -776,6 +850,7 @@ static void library_init() {
   epoxy_glEnable = _glEnable;
   epoxy_glFramebufferRenderbuffer = _glFramebufferRenderbuffer;
   epoxy_glFramebufferTexture2D = _glFramebufferTexture2D;
+  epoxy_glGenBuffers = _glGenBuffers;
   epoxy_glGenFramebuffers = _glGenFramebuffers;
   epoxy_glGenRenderbuffers = _glGenRenderbuffers;
   epoxy_glGenTextures = _glGenTextures;
@@ -789,10 +864,13 @@ static void library_init() {
   epoxy_glGetString = _glGetString;
   epoxy_glIsEnabled = _glIsEnabled;
   epoxy_glLinkProgram = _glLinkProgram;
+  epoxy_glMapBufferRange = _glMapBufferRange;
   epoxy_glRenderbufferStorage = _glRenderbufferStorage;
   epoxy_glShaderSource = _glShaderSource;
   epoxy_glTexParameterf = _glTexParameterf;
   epoxy_glTexParameteri = _glTexParameteri;
   epoxy_glTexImage2D = _glTexImage2D;
+  epoxy_glTexSubImage2D = _glTexSubImage2D;
+  epoxy_glUnmapBuffer = _glUnmapBuffer;
   epoxy_glGetError = _glGetError;
 }
@@ -14,8 +14,12 @@ VARIANT=$1
 ${ENGINE_PATH}/src/out/${VARIANT}/txt_benchmarks --benchmark_format=json > ${ENGINE_PATH}/src/out/${VARIANT}/txt_benchmarks.json
 ${ENGINE_PATH}/src/out/${VARIANT}/fml_benchmarks --benchmark_format=json > ${ENGINE_PATH}/src/out/${VARIANT}/fml_benchmarks.json
 ${ENGINE_PATH}/src/out/${VARIANT}/shell_benchmarks --benchmark_format=json > ${ENGINE_PATH}/src/out/${VARIANT}/shell_benchmarks.json
+${ENGINE_PATH}/src/out/${VARIANT}/embedder_benchmarks --benchmark_format=json > ${ENGINE_PATH}/src/out/${VARIANT}/embedder_benchmarks.json
+${ENGINE_PATH}/src/out/${VARIANT}/client_wrapper_benchmarks --benchmark_format=json > ${ENGINE_PATH}/src/out/${VARIANT}/client_wrapper_benchmarks.json
+${ENGINE_PATH}/src/out/${VARIANT}/flutter_linux_benchmarks --benchmark_format=json > ${ENGINE_PATH}/src/out/${VARIANT}/flutter_linux_benchmarks.json
 ${ENGINE_PATH}/src/out/${VARIANT}/ui_benchmarks --benchmark_format=json > ${ENGINE_PATH}/src/out/${VARIANT}/ui_benchmarks.json
 ${ENGINE_PATH}/src/out/${VARIANT}/display_list_builder_benchmarks --benchmark_format=json > ${ENGINE_PATH}/src/out/${VARIANT}/display_list_builder_benchmarks.json
+${ENGINE_PATH}/src/out/${VARIANT}/display_list_path_benchmarks --benchmark_format=json > ${ENGINE_PATH}/src/out/${VARIANT}/display_list_path_benchmarks.json
 ${ENGINE_PATH}/src/out/${VARIANT}/display_list_region_benchmarks --benchmark_format=json > ${ENGINE_PATH}/src/out/${VARIANT}/display_list_region_benchmarks.json
 ${ENGINE_PATH}/src/out/${VARIANT}/display_list_transform_benchmarks --benchmark_format=json > ${ENGINE_PATH}/src/out/${VARIANT}/display_list_transform_benchmarks.json
 ${ENGINE_PATH}/src/out/${VARIANT}/primitive_rendering_benchmarks --benchmark_format=json > ${ENGINE_PATH}/src/out/${VARIANT}/primitive_rendering_benchmarks.json
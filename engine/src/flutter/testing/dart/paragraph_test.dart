@@ -301,6 +301,75 @@ void main() {
     expect(bottomRight?.writingDirection, TextDirection.ltr);
   });
 
+  test('layoutParagraphs lays out like layout', () async {
+    Paragraph build(String text) {
+      final builder = ParagraphBuilder(ParagraphStyle(fontFamily: 'Ahem', fontSize: 10.0));
+      builder.addText(text);
+      return builder.build();
+    }
+
+    final texts = <String>['Test', 'Test Ahem', 'A much longer test paragraph'];
+    final constraints = <ParagraphConstraints>[
+      const ParagraphConstraints(width: 400.0),
+      const ParagraphConstraints(width: 50.0),
+      const ParagraphConstraints(width: 100.0),
+    ];
+    final List<Paragraph> expected = <Paragraph>[
+      for (var index = 0; index < texts.length; index += 1)
+        build(texts[index])..layout(constraints[index]),
+    ];
+    final List<Paragraph> paragraphs = texts.map(build).toList();
+    await layoutParagraphs(paragraphs, constraints);
+
+    for (var index = 0; index < texts.length; index += 1) {
+      expect(paragraphs[index].width, expected[index].width);
+      expect(paragraphs[index].height, expected[index].height);
+      expect(paragraphs[index].numberOfLines, expected[index].numberOfLines);
+      expect(paragraphs[index].maxIntrinsicWidth, expected[index].maxIntrinsicWidth);
+    }
+    expect(paragraphs[1].numberOfLines, 2);
+  });
+
+  test('paragraphs throw while layoutParagraphs is pending', () async {
+    final builder = ParagraphBuilder(ParagraphStyle(fontFamily: 'Ahem', fontSize: 10.0));
+    builder.addText('Test');
+    final Paragraph paragraph = builder.build();
+    const constraints = ParagraphConstraints(width: 100.0);
+    final Future<void> layout = layoutParagraphs(<Paragraph>[paragraph], <ParagraphConstraints>[
+      constraints,
+    ]);
+
+    expect(() => paragraph.width, throwsStateError);
+    expect(() => paragraph.computeLineMetrics(), throwsStateError);
+    expect(() => paragraph.getWordBoundary(const TextPosition(offset: 0)), throwsStateError);
+    expect(() => paragraph.layout(constraints), throwsStateError);
+    expect(
+      () => layoutParagraphs(<Paragraph>[paragraph], <ParagraphConstraints>[constraints]),
+      throwsStateError,
+    );
+
+    await layout;
+    expect(paragraph.width, 100.0);
+    expect(paragraph.numberOfLines, 1);
+  });
+
+  test('disposing a paragraph while layoutParagraphs is pending', () async {
+    final Paragraph paragraph = ParagraphBuilder(ParagraphStyle()).build();
+    final Future<void> layout = layoutParagraphs(<Paragraph>[paragraph], <ParagraphConstraints>[
+      const ParagraphConstraints(width: 100.0),
+    ]);
+    paragraph.dispose();
+    await layout;
+  });
+
+  test('layoutParagraphs requires a constraint per paragraph', () {
+    final Paragraph paragraph = ParagraphBuilder(ParagraphStyle()).build();
+    expect(
+      () => layoutParagraphs(<Paragraph>[paragraph], <ParagraphConstraints>[]),
+      throwsArgumentError,
+    );
+  });
+
   test('painting a disposed paragraph does not crash', () {
     final Paragraph paragraph = ParagraphBuilder(ParagraphStyle()).build();
     paragraph.dispose();
@@ -208,6 +208,35 @@ void main() {
     expect(metrics[1].extractPath(4.0, 6.0).computeMetrics().first.length, 2.0);
   });
 
+  test('PathMetric.extractPathSegments extracts every interval', () {
+    final path = Path()..lineTo(100, 0);
+    final PathMetric metric = path.computeMetrics().single;
+    final Path dashes = metric.extractPathSegments(<double>[0, 10, 20, 30, 40, 55]);
+    final List<PathMetric> dashMetrics = dashes.computeMetrics().toList();
+    expect(dashMetrics.map((PathMetric metric) => metric.length), <double>[10, 10, 15]);
+    expect(dashes.getBounds(), const Rect.fromLTRB(0, 0, 55, 0));
+
+    const intervals = <double>[0, 10, 20, 30];
+    final Path connected = metric.extractPathSegments(intervals, startWithMoveTo: false);
+    expect(connected.computeMetrics().single.length, 30);
+    expect(() => metric.extractPathSegments(<double>[0, 10, 20]), throwsArgumentError);
+  });
+
+  test('PathMetrics of an unchanged path can be computed repeatedly', () {
+    final path = Path()
+      ..cubicTo(10, 40, 60, -20, 100, 20)
+      ..moveTo(0, 50)
+      ..lineTo(50, 50);
+    final List<PathMetric> first = path.computeMetrics().toList();
+    final List<PathMetric> second = path.computeMetrics().toList();
+    expect(second.length, first.length);
+    for (var i = 0; i < first.length; i++) {
+      expect(second[i].length, first[i].length);
+      expect(second[i].contourIndex, first[i].contourIndex);
+    }
+    expect(first[1].length, 50);
+  });
+
   test('PathMetrics on a mutated path', () {
     final path = Path()..lineTo(0, 10);
     final PathMetrics metrics = path.computeMetrics();
@@ -2,16 +2,31 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
+#include <atomic>
+#include <functional>
 #include <sstream>
 
+#include "flutter/display_list/dl_builder.h"
 #include "flutter/fml/command_line.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/time/time_point.h"
+#include "flutter/txt/src/skia/paragraph_builder_skia.h"
+#include "flutter/txt/src/skia/paragraph_layout_cache.h"
+#include "flutter/txt/src/txt/asset_font_manager.h"
+#include "flutter/txt/src/txt/font_collection.h"
+#include "flutter/txt/src/txt/platform.h"
+#include "flutter/txt/src/txt/typeface_font_asset_provider.h"
 #include "flutter/txt/tests/txt_test_utils.h"
 #include "third_party/benchmark/include/benchmark/benchmark.h"
 #include "third_party/icu/source/common/unicode/unistr.h"
 #include "third_party/skia/include/core/SkBitmap.h"
 #include "third_party/skia/include/core/SkCanvas.h"
 #include "third_party/skia/include/core/SkColor.h"
+#include "third_party/skia/include/core/SkData.h"
+#include "third_party/skia/include/core/SkFontMgr.h"
 #include "third_party/skia/modules/skparagraph/include/Paragraph.h"
 #include "third_party/skia/modules/skparagraph/include/ParagraphBuilder.h"
 #include "third_party/skia/modules/skparagraph/include/TypefaceFontProvider.h"
@@ -291,6 +306,179 @@ BENCHMARK_F(SkParagraphFixture, PaintDecoration)(benchmark::State& state) {
   }
 }
 
+static std::shared_ptr<txt::FontCollection> MakeRobotoFontCollection() {
+  auto font_provider = std::make_unique<txt::TypefaceFontAssetProvider>();
+  std::string font_path = txt::GetFontDir() + "/Roboto-Regular.ttf";
+  font_provider->RegisterTypeface(txt::GetDefaultFontManager()->makeFromData(
+      SkData::MakeFromFileName(font_path.c_str())));
+  auto font_collection = std::make_shared<txt::FontCollection>();
+  font_collection->SetAssetFontManager(
+      sk_make_sp<txt::AssetFontManager>(std::move(font_provider)));
+  return font_collection;
+}
+
+// Paints a laid out paragraph into a display list the way the framework does
+// when it repaints text that did not change, for example while scrolling.
+static void BM_ParagraphPaintAfterLayout(benchmark::State& state,
+                                         bool impeller_enabled) {
+  auto font_collection = MakeRobotoFontCollection();
+
+  txt::TextStyle text_style;
+  text_style.font_families.push_back("Roboto");
+  text_style.color = SK_ColorBLACK;
+  txt::ParagraphBuilderSkia builder(txt::ParagraphStyle(), font_collection,
+                                    impeller_enabled);
+  builder.PushStyle(text_style);
+  builder.AddText(
+      u"Hello world! This is a simple sentence to test drawing. Hello world! "
+      u"This is a simple sentence to test drawing. Hello world! This is a "
+      u"simple sentence to test drawing. Hello world! This is a simple "
+      u"sentence to test drawing.");
+  builder.Pop();
+  auto paragraph = builder.Build();
+  paragraph->Layout(300);
+
+  while (state.KeepRunning()) {
+    flutter::DisplayListBuilder display_list_builder;
+    paragraph->Paint(&display_list_builder, 0, 0);
+    benchmark::DoNotOptimize(display_list_builder.Build());
+  }
+}
+
+BENCHMARK_CAPTURE(BM_ParagraphPaintAfterLayout, Skia, false);
+#if IMPELLER_SUPPORTS_RENDERING
+BENCHMARK_CAPTURE(BM_ParagraphPaintAfterLayout, Impeller, true);
+#endif  // IMPELLER_SUPPORTS_RENDERING
+
+// Builds and lays out a list of labels that repeat a few distinct strings,
+// like the cells of a table or the items of a list.
+static void BM_ParagraphRepeatedLabels(benchmark::State& state,
+                                       bool layout_cache) {
+  constexpr int kLabelCount = 1000;
+  const int distinct_labels = state.range(0);
+  auto font_collection = MakeRobotoFontCollection();
+  const std::shared_ptr<txt::ParagraphLayoutCache>& cache =
+      font_collection->GetParagraphLayoutCache();
+  if (!layout_cache) {
+    cache->SetMaxBytes(0);
+  }
+
+  txt::TextStyle text_style;
+  text_style.font_families.push_back("Roboto");
+  text_style.color = SK_ColorBLACK;
+  while (state.KeepRunning()) {
+    for (int i = 0; i < kLabelCount; i++) {
+      std::string label = "Item " + std::to_string(i % distinct_labels);
+      txt::ParagraphBuilderSkia builder(txt::ParagraphStyle(), font_collection,
+                                        false);
+      builder.PushStyle(text_style);
+      builder.AddText(reinterpret_cast<const uint8_t*>(label.data()),
+                      label.size());
+      builder.Pop();
+      auto paragraph = builder.Build();
+      paragraph->Layout(300);
+    }
+  }
+
+  txt::ParagraphLayoutCache::Stats stats = cache->GetStats();
+  const size_t lookups = stats.hits + stats.misses;
+  state.counters["HitRate"] =
+      lookups == 0 ? 0.0 : static_cast<double>(stats.hits) / lookups;
+  state.counters["CacheBytes"] = stats.bytes;
+}
+
+BENCHMARK_CAPTURE(BM_ParagraphRepeatedLabels, Uncached, false)
+    ->RangeMultiplier(10)
+    ->Range(10, 1000);
+BENCHMARK_CAPTURE(BM_ParagraphRepeatedLabels, LayoutCache, true)
+    ->RangeMultiplier(10)
+    ->Range(10, 1000);
+
+// Lays out 10k paragraphs, as when measuring a long chat transcript or log.
+// With |background| set the batch is laid out on a worker thread the way
+// Paragraph::LayoutAll does, while the benchmark thread keeps laying out one
+// paragraph per simulated frame. The reported time is the time the benchmark
+// thread, standing in for the UI thread, spent blocked in layout. "MaxStallUs"
+// is the longest single layout call it made, including lock waits.
+static void BM_ParagraphBatchLayout(benchmark::State& state, bool background) {
+  constexpr int kParagraphCount = 10000;
+  auto font_collection = MakeRobotoFontCollection();
+  // Every paragraph should be shaped, not served from the layout cache.
+  font_collection->GetParagraphLayoutCache()->SetMaxBytes(0);
+  auto worker_loop = fml::ConcurrentMessageLoop::Create(1);
+
+  txt::TextStyle text_style;
+  text_style.font_families.push_back("Roboto");
+  text_style.color = SK_ColorBLACK;
+  auto build = [&](int index) {
+    std::string text = "Message " + std::to_string(index) +
+                       ": Hello world! This is a simple sentence to test "
+                       "laying out a long transcript of messages.";
+    txt::ParagraphBuilderSkia builder(txt::ParagraphStyle(), font_collection,
+                                      false);
+    builder.PushStyle(text_style);
+    builder.AddText(reinterpret_cast<const uint8_t*>(text.data()),
+                    text.size());
+    builder.Pop();
+    return builder.Build();
+  };
+  auto layout = [&](txt::Paragraph* paragraph) {
+    auto lock = font_collection->LockForLayout();
+    paragraph->Layout(300);
+  };
+
+  fml::TimeDelta max_stall;
+  for (auto _ : state) {
+    std::vector<std::unique_ptr<txt::Paragraph>> paragraphs;
+    paragraphs.reserve(kParagraphCount);
+    for (int i = 0; i < kParagraphCount; i++) {
+      paragraphs.push_back(build(i));
+    }
+    auto frame_paragraph = build(-1);
+
+    fml::TimeDelta blocked;
+    auto timed_layout = [&](const std::function<void()>& closure) {
+      const fml::TimePoint start = fml::TimePoint::Now();
+      closure();
+      const fml::TimeDelta elapsed = fml::TimePoint::Now() - start;
+      blocked = blocked + elapsed;
+      max_stall = std::max(max_stall, elapsed);
+    };
+    if (!background) {
+      timed_layout([&] {
+        for (auto& paragraph : paragraphs) {
+          layout(paragraph.get());
+        }
+      });
+    } else {
+      std::atomic<bool> done = false;
+      fml::AutoResetWaitableEvent latch;
+      timed_layout([&] {
+        worker_loop->GetTaskRunner()->PostTask([&] {
+          for (auto& paragraph : paragraphs) {
+            layout(paragraph.get());
+          }
+          done = true;
+          latch.Signal();
+        });
+      });
+      while (!done) {
+        timed_layout([&] { layout(frame_paragraph.get()); });
+      }
+      latch.Wait();
+    }
+    state.SetIterationTime(blocked.ToSecondsF());
+  }
+  state.counters["MaxStallUs"] = max_stall.ToMicrosecondsF();
+}
+
+BENCHMARK_CAPTURE(BM_ParagraphBatchLayout, UIThread, false)
+    ->UseManualTime()
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_ParagraphBatchLayout, Background, true)
+    ->UseManualTime()
+    ->Unit(benchmark::kMillisecond);
+
 BENCHMARK_F(SkParagraphFixture, SimpleBuilder)(benchmark::State& state) {
   const char* text = "Hello World";
   sktxt::ParagraphStyle paragraph_style;
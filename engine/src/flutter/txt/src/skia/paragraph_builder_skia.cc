@@ -3,8 +3,14 @@
 // found in the LICENSE file.
 
 #include "paragraph_builder_skia.h"
+#include "paragraph_layout_cache.h"
 #include "paragraph_skia.h"
 
+#include <cstring>
+#include <functional>
+#include <thread>
+#include <type_traits>
+
 #include "third_party/skia/modules/skparagraph/include/ParagraphStyle.h"
 #include "third_party/skia/modules/skparagraph/include/TextStyle.h"
 #include "third_party/skia/modules/skunicode/include/SkUnicode_icu.h"
@@ -23,6 +29,120 @@ SkFourByteTag GetFourByteTag(const T& tag) {
   return SkSetFourByteTag(tag[0], tag[1], tag[2], tag[3]);
 }
 
+// The layout key is a byte string that is equal for two paragraphs exactly
+// if they are built from the same content. It describes the styles in full
+// rather than their Skia equivalents, but leaves out the contents of the
+// paints, which are only referenced by ID from the Skia paragraph.
+template <typename T>
+void AppendToLayoutKey(std::string& key, T value) {
+  static_assert(std::is_arithmetic_v<T> || std::is_enum_v<T>);
+  key.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void AppendToLayoutKey(std::string& key, std::string_view value) {
+  AppendToLayoutKey(key, value.size());
+  key.append(value);
+}
+
+void AppendToLayoutKey(std::string& key, const std::string& value) {
+  AppendToLayoutKey(key, std::string_view(value));
+}
+
+void AppendToLayoutKey(std::string& key, const std::u16string& value) {
+  AppendToLayoutKey(key, value.size());
+  key.append(reinterpret_cast<const char*>(value.data()),
+             value.size() * sizeof(char16_t));
+}
+
+void AppendToLayoutKey(std::string& key,
+                       const std::vector<std::string>& values) {
+  AppendToLayoutKey(key, values.size());
+  for (const std::string& value : values) {
+    AppendToLayoutKey(key, value);
+  }
+}
+
+void AppendToLayoutKey(std::string& key, const ParagraphStyle& style) {
+  AppendToLayoutKey(key, style.font_weight);
+  AppendToLayoutKey(key, style.font_style);
+  AppendToLayoutKey(key, style.font_family);
+  AppendToLayoutKey(key, style.font_size);
+  AppendToLayoutKey(key, style.height);
+  AppendToLayoutKey(key, style.has_height_override);
+  AppendToLayoutKey(key, style.text_height_behavior);
+  AppendToLayoutKey(key, style.strut_enabled);
+  AppendToLayoutKey(key, style.strut_font_weight);
+  AppendToLayoutKey(key, style.strut_font_style);
+  AppendToLayoutKey(key, style.strut_font_families);
+  AppendToLayoutKey(key, style.strut_font_size);
+  AppendToLayoutKey(key, style.strut_height);
+  AppendToLayoutKey(key, style.strut_has_height_override);
+  AppendToLayoutKey(key, style.strut_half_leading);
+  AppendToLayoutKey(key, style.strut_leading);
+  AppendToLayoutKey(key, style.force_strut_height);
+  AppendToLayoutKey(key, style.text_align);
+  AppendToLayoutKey(key, style.text_direction);
+  AppendToLayoutKey(key, style.max_lines);
+  AppendToLayoutKey(key, style.ellipsis);
+  AppendToLayoutKey(key, style.locale);
+}
+
+void AppendToLayoutKey(std::string& key, const TextStyle& style) {
+  AppendToLayoutKey(key, style.color);
+  AppendToLayoutKey(key, style.decoration);
+  AppendToLayoutKey(key, style.decoration_color);
+  AppendToLayoutKey(key, style.decoration_style);
+  AppendToLayoutKey(key, style.decoration_thickness_multiplier);
+  AppendToLayoutKey(key, style.font_weight);
+  AppendToLayoutKey(key, style.font_style);
+  AppendToLayoutKey(key, style.text_baseline);
+  AppendToLayoutKey(key, style.half_leading);
+  AppendToLayoutKey(key, style.font_families);
+  AppendToLayoutKey(key, style.font_size);
+  AppendToLayoutKey(key, style.letter_spacing);
+  AppendToLayoutKey(key, style.word_spacing);
+  AppendToLayoutKey(key, style.height);
+  AppendToLayoutKey(key, style.has_height_override);
+  AppendToLayoutKey(key, style.locale);
+  // Only whether there are paints matters, since it determines their IDs.
+  AppendToLayoutKey(key, style.background.has_value());
+  AppendToLayoutKey(key, style.foreground.has_value());
+  AppendToLayoutKey(key, style.text_shadows.size());
+  for (const TextShadow& shadow : style.text_shadows) {
+    AppendToLayoutKey(key, shadow.color);
+    AppendToLayoutKey(key, shadow.offset.fX);
+    AppendToLayoutKey(key, shadow.offset.fY);
+    AppendToLayoutKey(key, shadow.blur_sigma);
+  }
+  AppendToLayoutKey(key, style.font_features.GetFontFeatures().size());
+  for (const auto& [tag, value] : style.font_features.GetFontFeatures()) {
+    AppendToLayoutKey(key, tag);
+    AppendToLayoutKey(key, value);
+  }
+  AppendToLayoutKey(key, style.font_variations.GetAxisValues().size());
+  for (const auto& [axis, value] : style.font_variations.GetAxisValues()) {
+    AppendToLayoutKey(key, axis);
+    AppendToLayoutKey(key, value);
+  }
+}
+
+void AppendToLayoutKey(std::string& key, const PlaceholderRun& span) {
+  AppendToLayoutKey(key, span.width);
+  AppendToLayoutKey(key, span.height);
+  AppendToLayoutKey(key, span.alignment);
+  AppendToLayoutKey(key, span.baseline);
+  AppendToLayoutKey(key, span.baseline_offset);
+}
+
+// Tags the calls made on the builder in the layout key.
+enum class LayoutKeyOp : char {
+  kPushStyle,
+  kPop,
+  kAddUtf16Text,
+  kAddUtf8Text,
+  kAddPlaceholder,
+};
+
 SkFontStyle MakeSkFontStyle(int font_weight, txt::FontStyle font_style) {
   return SkFontStyle(font_weight, SkFontStyle::Width::kNormal_Width,
                      font_style == txt::FontStyle::normal
@@ -37,21 +157,53 @@ ParagraphBuilderSkia::ParagraphBuilderSkia(
     const std::shared_ptr<FontCollection>& font_collection,
     const bool impeller_enabled)
     : base_style_(style.GetTextStyle()), impeller_enabled_(impeller_enabled) {
+  skt_font_collection_ = font_collection->CreateSktFontCollection();
+  skt_paragraph_style_ = TxtToSkia(style);
   builder_ = skt::ParagraphBuilder::make(
-      TxtToSkia(style), font_collection->CreateSktFontCollection(),
-      SkUnicodes::ICU::Make());
+      skt_paragraph_style_, skt_font_collection_, SkUnicodes::ICU::Make());
+
+  if (font_collection->GetParagraphLayoutCache()->IsEnabled()) {
+    layout_cache_ = font_collection->GetParagraphLayoutCache();
+    // Font collections can be shared by engines running on different UI
+    // threads, and Skia paragraphs are not safe to paint or query on several
+    // threads at once. Only share layouts between paragraphs built on the
+    // same thread. Paragraphs laid out on a worker thread are still built and
+    // used on the UI thread.
+    AppendToLayoutKey(layout_key_,
+                      std::hash<std::thread::id>{}(std::this_thread::get_id()));
+    AppendToLayoutKey(layout_key_, style);
+  }
 }
 
 ParagraphBuilderSkia::~ParagraphBuilderSkia() = default;
 
 void ParagraphBuilderSkia::PushStyle(const TextStyle& style) {
-  builder_->pushStyle(TxtToSkia(style));
+  skt::TextStyle skt_style = TxtToSkia(style);
+  builder_->pushStyle(skt_style);
   txt_style_stack_.push(style);
+
+  if (layout_cache_) {
+    AppendToLayoutKey(layout_key_, LayoutKeyOp::kPushStyle);
+    AppendToLayoutKey(layout_key_, style);
+    replay_ops_.push_back([skt_style = std::move(skt_style)](
+                              skt::ParagraphBuilder* builder,
+                              const std::string& layout_key) {
+      builder->pushStyle(skt_style);
+    });
+  }
 }
 
 void ParagraphBuilderSkia::Pop() {
   builder_->pop();
   txt_style_stack_.pop();
+
+  if (layout_cache_) {
+    AppendToLayoutKey(layout_key_, LayoutKeyOp::kPop);
+    replay_ops_.push_back(
+        [](skt::ParagraphBuilder* builder, const std::string& layout_key) {
+          builder->pop();
+        });
+  }
 }
 
 const TextStyle& ParagraphBuilderSkia::PeekStyle() {
@@ -60,11 +212,42 @@ const TextStyle& ParagraphBuilderSkia::PeekStyle() {
 
 void ParagraphBuilderSkia::AddText(const std::u16string& text) {
   builder_->addText(text);
+
+  if (layout_cache_) {
+    AppendToLayoutKey(layout_key_, LayoutKeyOp::kAddUtf16Text);
+    AppendToLayoutKey(layout_key_, text);
+    const size_t byte_length = text.size() * sizeof(char16_t);
+    const size_t offset = layout_key_.size() - byte_length;
+    text_bytes_ += byte_length;
+    replay_ops_.push_back([offset, length = text.size()](
+                              skt::ParagraphBuilder* builder,
+                              const std::string& layout_key) {
+      std::u16string text(length, u'\0');
+      std::memcpy(text.data(), layout_key.data() + offset,
+                  length * sizeof(char16_t));
+      builder->addText(text);
+    });
+  }
 }
 
 void ParagraphBuilderSkia::AddText(const uint8_t* utf8_data,
                                    size_t byte_length) {
   builder_->addText(reinterpret_cast<const char*>(utf8_data), byte_length);
+
+  if (layout_cache_) {
+    AppendToLayoutKey(layout_key_, LayoutKeyOp::kAddUtf8Text);
+    AppendToLayoutKey(
+        layout_key_,
+        std::string_view(reinterpret_cast<const char*>(utf8_data),
+                         byte_length));
+    const size_t offset = layout_key_.size() - byte_length;
+    text_bytes_ += byte_length;
+    replay_ops_.push_back([offset, byte_length](
+                              skt::ParagraphBuilder* builder,
+                              const std::string& layout_key) {
+      builder->addText(layout_key.data() + offset, byte_length);
+    });
+  }
 }
 
 void ParagraphBuilderSkia::AddPlaceholder(PlaceholderRun& span) {
@@ -77,11 +260,41 @@ void ParagraphBuilderSkia::AddPlaceholder(PlaceholderRun& span) {
       static_cast<skt::PlaceholderAlignment>(span.alignment);
 
   builder_->addPlaceholder(placeholder_style);
+
+  if (layout_cache_) {
+    AppendToLayoutKey(layout_key_, LayoutKeyOp::kAddPlaceholder);
+    AppendToLayoutKey(layout_key_, span);
+    replay_ops_.push_back([placeholder_style](
+                              skt::ParagraphBuilder* builder,
+                              const std::string& layout_key) {
+      builder->addPlaceholder(placeholder_style);
+    });
+  }
 }
 
 std::unique_ptr<Paragraph> ParagraphBuilderSkia::Build() {
+  std::unique_ptr<ParagraphSkia::LayoutCacheInfo> layout_cache_info;
+  if (layout_cache_) {
+    layout_cache_info = std::make_unique<ParagraphSkia::LayoutCacheInfo>();
+    layout_cache_info->cache = std::move(layout_cache_);
+    layout_cache_info->content_key =
+        std::make_shared<const std::string>(std::move(layout_key_));
+    layout_cache_info->text_bytes = text_bytes_;
+    layout_cache_info->build_paragraph =
+        [paragraph_style = skt_paragraph_style_,
+         font_collection = skt_font_collection_,
+         ops = std::move(replay_ops_)](const std::string& content_key) {
+          auto builder = skt::ParagraphBuilder::make(
+              paragraph_style, font_collection, SkUnicodes::ICU::Make());
+          for (const auto& op : ops) {
+            op(builder.get(), content_key);
+          }
+          return builder->Build();
+        };
+  }
   return std::make_unique<ParagraphSkia>(
-      builder_->Build(), std::move(dl_paints_), impeller_enabled_);
+      builder_->Build(), std::move(dl_paints_), impeller_enabled_,
+      std::move(layout_cache_info));
 }
 
 skt::ParagraphPainter::PaintID ParagraphBuilderSkia::CreatePaintID(
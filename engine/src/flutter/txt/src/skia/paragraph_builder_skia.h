@@ -7,11 +7,16 @@
 
 #include "txt/paragraph_builder.h"
 
+#include <functional>
+#include <string>
+
 #include "flutter/display_list/dl_paint.h"
 #include "third_party/skia/modules/skparagraph/include/ParagraphBuilder.h"
 
 namespace txt {
 
+class ParagraphLayoutCache;
+
 //------------------------------------------------------------------------------
 /// @brief      ParagraphBuilder implementation using Skia's text layout module.
 ///
@@ -53,6 +58,21 @@ class ParagraphBuilderSkia : public ParagraphBuilder {
   const bool impeller_enabled_;
   std::stack<TextStyle> txt_style_stack_;
   std::vector<flutter::DlPaint> dl_paints_;
+
+  // Set if the built paragraph may share its layout with paragraphs built
+  // from the same content, see ParagraphLayoutCache.
+  std::shared_ptr<ParagraphLayoutCache> layout_cache_;
+  sk_sp<skia::textlayout::FontCollection> skt_font_collection_;
+  skia::textlayout::ParagraphStyle skt_paragraph_style_;
+  // Describes everything the paragraph is built from, including its text.
+  std::string layout_key_;
+  size_t text_bytes_ = 0;
+  // Repeat the calls made on `builder_`, to build a paragraph from the same
+  // content that can be laid out at a different width. They read the text
+  // back from the layout key they are given instead of keeping a copy.
+  std::vector<std::function<void(skia::textlayout::ParagraphBuilder*,
+                                 const std::string&)>>
+      replay_ops_;
 };
 
 }  // namespace txt
@@ -0,0 +1,128 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "paragraph_layout_cache.h"
+
+#include <cmath>
+#include <utility>
+
+#include "flutter/fml/hash_combine.h"
+#include "flutter/fml/trace_event.h"
+
+namespace txt {
+
+namespace skt = skia::textlayout;
+
+namespace {
+
+// A rough upper bound of the memory SkParagraph keeps per byte of UTF-8 text
+// once it is shaped and laid out: the glyph IDs, positions and clusters of
+// its runs, and the index mappings between UTF-8 and UTF-16.
+constexpr size_t kBytesPerTextByte = 64;
+
+// The memory of a laid out paragraph that does not depend on its text.
+constexpr size_t kBytesPerParagraph = 2048;
+
+}  // namespace
+
+size_t ParagraphLayoutCache::IndexKeyHash::operator()(
+    const IndexKey& key) const {
+  return fml::HashCombine(key.content_key, key.width);
+}
+
+ParagraphLayoutCache::ParagraphLayoutCache(size_t max_bytes)
+    : max_bytes_(max_bytes) {}
+
+ParagraphLayoutCache::~ParagraphLayoutCache() = default;
+
+bool ParagraphLayoutCache::IsEnabled() const {
+  std::scoped_lock lock(mutex_);
+  return max_bytes_ > 0;
+}
+
+void ParagraphLayoutCache::SetMaxBytes(size_t max_bytes) {
+  std::scoped_lock lock(mutex_);
+  max_bytes_ = max_bytes;
+  EvictLocked(max_bytes_);
+  TraceCountersLocked();
+}
+
+std::shared_ptr<skt::Paragraph> ParagraphLayoutCache::Get(
+    std::shared_ptr<const std::string>& content_key,
+    SkScalar width) {
+  std::scoped_lock lock(mutex_);
+  auto found = index_.find({*content_key, width});
+  if (found == index_.end()) {
+    stats_.misses++;
+    return nullptr;
+  }
+  stats_.hits++;
+  entries_.splice(entries_.begin(), entries_, found->second);
+  content_key = found->second->content_key;
+  return found->second->paragraph;
+}
+
+bool ParagraphLayoutCache::Put(std::shared_ptr<const std::string> content_key,
+                               SkScalar width,
+                               size_t text_bytes,
+                               std::shared_ptr<skt::Paragraph> paragraph) {
+  // NaN widths never compare equal, so the paragraph could not be found.
+  if (std::isnan(width)) {
+    return false;
+  }
+  const size_t bytes = kBytesPerParagraph + content_key->size() +
+                       text_bytes * kBytesPerTextByte;
+
+  std::scoped_lock lock(mutex_);
+  if (bytes > max_bytes_ || index_.count({*content_key, width}) > 0) {
+    return false;
+  }
+  EvictLocked(max_bytes_ - bytes);
+
+  entries_.push_front({
+      .content_key = std::move(content_key),
+      .width = width,
+      .bytes = bytes,
+      .paragraph = std::move(paragraph),
+  });
+  index_.emplace(IndexKey{*entries_.front().content_key, width},
+                 entries_.begin());
+  stats_.entries++;
+  stats_.bytes += bytes;
+  TraceCountersLocked();
+  return true;
+}
+
+void ParagraphLayoutCache::Clear() {
+  std::scoped_lock lock(mutex_);
+  index_.clear();
+  entries_.clear();
+  stats_.entries = 0;
+  stats_.bytes = 0;
+  TraceCountersLocked();
+}
+
+ParagraphLayoutCache::Stats ParagraphLayoutCache::GetStats() const {
+  std::scoped_lock lock(mutex_);
+  return stats_;
+}
+
+void ParagraphLayoutCache::EvictLocked(size_t max_bytes) {
+  while (stats_.bytes > max_bytes) {
+    const Entry& entry = entries_.back();
+    index_.erase({*entry.content_key, entry.width});
+    stats_.entries--;
+    stats_.bytes -= entry.bytes;
+    stats_.evictions++;
+    entries_.pop_back();
+  }
+}
+
+void ParagraphLayoutCache::TraceCountersLocked() const {
+  FML_TRACE_COUNTER("flutter", "ParagraphLayoutCache",
+                    reinterpret_cast<int64_t>(this),  // Trace Counter ID
+                    "Entries", stats_.entries, "Bytes", stats_.bytes);
+}
+
+}  // namespace txt
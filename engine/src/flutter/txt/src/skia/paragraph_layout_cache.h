@@ -0,0 +1,144 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_TXT_SRC_SKIA_PARAGRAPH_LAYOUT_CACHE_H_
+#define FLUTTER_TXT_SRC_SKIA_PARAGRAPH_LAYOUT_CACHE_H_
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "flutter/fml/macros.h"
+#include "third_party/skia/modules/skparagraph/include/Paragraph.h"
+
+namespace txt {
+
+//------------------------------------------------------------------------------
+/// @brief      A cache of laid out Skia paragraphs, keyed by the content they
+///             were built from and the width they were laid out at.
+///
+///             Paragraphs built from the same text and styles, such as list
+///             item labels or table cells, share the shaping and line
+///             breaking of the first one of them that was laid out. The
+///             cached paragraphs are shared by the paragraphs that use them
+///             and must not be laid out again.
+///
+///             The cache evicts the least recently used paragraphs once the
+///             estimated size of the cached paragraphs exceeds its budget.
+///
+///             The methods of this class are thread safe, but the cached
+///             paragraphs are not: Skia fills caches of a paragraph when it
+///             is painted or queried. Users must only share a paragraph
+///             between threads that do not use it concurrently, and include
+///             the thread in the content key otherwise. |ParagraphBuilderSkia|
+///             only shares paragraphs between builders used on the same
+///             thread.
+///
+class ParagraphLayoutCache {
+ public:
+  static constexpr size_t kDefaultMaxBytes = 4 << 20;
+
+  struct Stats {
+    size_t hits = 0;
+    size_t misses = 0;
+    size_t evictions = 0;
+    size_t entries = 0;
+    size_t bytes = 0;
+  };
+
+  explicit ParagraphLayoutCache(size_t max_bytes = kDefaultMaxBytes);
+
+  ~ParagraphLayoutCache();
+
+  /// Whether paragraphs should be looked up in the cache at all. A cache with
+  /// a budget of zero is disabled.
+  bool IsEnabled() const;
+
+  /// Changes the budget of the cache, evicting paragraphs as necessary.
+  void SetMaxBytes(size_t max_bytes);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Look up a paragraph built from the content described by
+  ///             `content_key` and laid out at `width`.
+  ///
+  ///             If one is found, `content_key` is replaced by the equal key
+  ///             the paragraph was cached with, so that paragraphs sharing a
+  ///             layout also share the description of their content.
+  ///
+  /// @return     The laid out paragraph, or nullptr if none is cached.
+  ///
+  std::shared_ptr<skia::textlayout::Paragraph> Get(
+      std::shared_ptr<const std::string>& content_key,
+      SkScalar width);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Cache a paragraph that was just laid out at `width`.
+  ///
+  /// @param[in]  content_key  A description of everything the paragraph was
+  ///                          built from. Paragraphs built from equal keys
+  ///                          with the same font collection must lay out and
+  ///                          paint identically. The cache keeps a reference
+  ///                          to it rather than a copy.
+  /// @param[in]  width        The width the paragraph was laid out at.
+  /// @param[in]  text_bytes   The size of the text of the paragraph, used to
+  ///                          estimate its memory use.
+  /// @param[in]  paragraph    The laid out paragraph.
+  ///
+  /// @return     Whether the paragraph was cached, and is now shared.
+  ///
+  bool Put(std::shared_ptr<const std::string> content_key,
+           SkScalar width,
+           size_t text_bytes,
+           std::shared_ptr<skia::textlayout::Paragraph> paragraph);
+
+  /// Drops all paragraphs, for example because the fonts they were shaped
+  /// with changed.
+  void Clear();
+
+  Stats GetStats() const;
+
+ private:
+  struct Entry {
+    std::shared_ptr<const std::string> content_key;
+    SkScalar width = 0;
+    size_t bytes = 0;
+    std::shared_ptr<skia::textlayout::Paragraph> paragraph;
+  };
+
+  // Points into the content key of an entry, which lives as long as the
+  // index entry does.
+  struct IndexKey {
+    std::string_view content_key;
+    SkScalar width = 0;
+
+    bool operator==(const IndexKey& other) const {
+      return width == other.width && content_key == other.content_key;
+    }
+  };
+
+  struct IndexKeyHash {
+    size_t operator()(const IndexKey& key) const;
+  };
+
+  mutable std::mutex mutex_;
+  size_t max_bytes_;
+  // Most recently used first.
+  std::list<Entry> entries_;
+  std::unordered_map<IndexKey, std::list<Entry>::iterator, IndexKeyHash>
+      index_;
+  Stats stats_;
+
+  void EvictLocked(size_t max_bytes);
+
+  void TraceCountersLocked() const;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ParagraphLayoutCache);
+};
+
+}  // namespace txt
+
+#endif  // FLUTTER_TXT_SRC_SKIA_PARAGRAPH_LAYOUT_CACHE_H_
@@ -3,6 +3,7 @@
 // found in the LICENSE file.
 
 #include "paragraph_skia.h"
+#include "paragraph_layout_cache.h"
 
 #include <algorithm>
 #include <numeric>
@@ -40,6 +41,9 @@ class DisplayListParagraphPainter : public skt::ParagraphPainter {
   /// @param[in]  draw_path_effect  If true, draw path effects directly by
   ///                               drawing multiple lines instead of providing
   //                                a path effect to the paint.
+  /// @param      text_cache  The text converted for Impeller by earlier
+  ///                         paints of the same layout, keyed by the unique
+  ///                         ID of the text blob it was converted from.
   ///
   /// @note       Impeller does not (and will not) support path effects, but the
   ///             Skia backend does. That means that if we want to draw dashed
@@ -51,10 +55,12 @@ class DisplayListParagraphPainter : public skt::ParagraphPainter {
   ///             decision (i.e. with `#ifdef`) instead of a runtime option.
   DisplayListParagraphPainter(DisplayListBuilder* builder,
                               const std::vector<DlPaint>& dl_paints,
-                              bool impeller_enabled)
+                              bool impeller_enabled,
+                              ParagraphSkia::TextCache* text_cache)
       : builder_(builder),
         dl_paints_(dl_paints),
-        impeller_enabled_(impeller_enabled) {}
+        impeller_enabled_(impeller_enabled),
+        text_cache_(text_cache) {}
 
   void drawTextBlob(const sk_sp<SkTextBlob>& blob,
                     SkScalar x,
@@ -74,9 +80,8 @@ class DisplayListParagraphPainter : public skt::ParagraphPainter {
         // If there is no path, this is an emoji and should be drawn as is,
         // ignoring the color source.
         if (path.isEmpty()) {
-          builder_->DrawText(DlTextImpeller::Make(
-                                 impeller::MakeTextFrameFromTextBlobSkia(blob)),
-                             x, y, dl_paints_[paint_id]);
+          builder_->DrawText(MakeImpellerText(blob), x, y,
+                             dl_paints_[paint_id]);
 
           return;
         }
@@ -86,9 +91,7 @@ class DisplayListParagraphPainter : public skt::ParagraphPainter {
         builder_->DrawPath(DlPath(transformed), dl_paints_[paint_id]);
         return;
       }
-      builder_->DrawText(
-          DlTextImpeller::Make(impeller::MakeTextFrameFromTextBlobSkia(blob)),
-          x, y, dl_paints_[paint_id]);
+      builder_->DrawText(MakeImpellerText(blob), x, y, dl_paints_[paint_id]);
       return;
     }
 #endif  // IMPELLER_SUPPORTS_RENDERING
@@ -112,8 +115,7 @@ class DisplayListParagraphPainter : public skt::ParagraphPainter {
     std::shared_ptr<DlText> text;
 #if IMPELLER_SUPPORTS_RENDERING
     if (impeller_enabled_) {
-      text =
-          DlTextImpeller::Make(impeller::MakeTextFrameFromTextBlobSkia(blob));
+      text = MakeImpellerText(blob);
     } else {
       text = DlTextSkia::Make(blob);
     }
@@ -170,6 +172,20 @@ class DisplayListParagraphPainter : public skt::ParagraphPainter {
   void restore() override { builder_->Restore(); }
 
  private:
+#if IMPELLER_SUPPORTS_RENDERING
+  // SkParagraph keeps the text blobs of a line until the paragraph is laid
+  // out again, so the text frames converted from them by a previous paint
+  // can be reused as long as the blob is.
+  std::shared_ptr<DlText> MakeImpellerText(const sk_sp<SkTextBlob>& blob) {
+    std::shared_ptr<DlText>& text = (*text_cache_)[blob->uniqueID()];
+    if (!text) {
+      text =
+          DlTextImpeller::Make(impeller::MakeTextFrameFromTextBlobSkia(blob));
+    }
+    return text;
+  }
+#endif  // IMPELLER_SUPPORTS_RENDERING
+
   bool ShouldRenderAsPath(const DlPaint& paint) const {
     FML_DCHECK(impeller_enabled_);
     // Text with non-trivial color sources should be rendered as a path when
@@ -199,14 +215,18 @@ class DisplayListParagraphPainter : public skt::ParagraphPainter {
   DisplayListBuilder* builder_;
   const std::vector<DlPaint>& dl_paints_;
   const bool impeller_enabled_;
+  [[maybe_unused]] ParagraphSkia::TextCache* text_cache_;
 };
 
 }  // anonymous namespace
 
-ParagraphSkia::ParagraphSkia(std::unique_ptr<skt::Paragraph> paragraph,
-                             std::vector<flutter::DlPaint>&& dl_paints,
-                             bool impeller_enabled)
+ParagraphSkia::ParagraphSkia(
+    std::unique_ptr<skt::Paragraph> paragraph,
+    std::vector<flutter::DlPaint>&& dl_paints,
+    bool impeller_enabled,
+    std::unique_ptr<LayoutCacheInfo> layout_cache_info)
     : paragraph_(std::move(paragraph)),
+      layout_cache_info_(std::move(layout_cache_info)),
       dl_paints_(dl_paints),
       impeller_enabled_(impeller_enabled) {}
 
@@ -291,11 +311,37 @@ bool ParagraphSkia::DidExceedMaxLines() {
 void ParagraphSkia::Layout(double width) {
   line_metrics_.reset();
   line_metrics_styles_.clear();
-  paragraph_->layout(width);
+  text_cache_.clear();
+  if (!layout_cache_info_) {
+    paragraph_->layout(width);
+    return;
+  }
+
+  const SkScalar layout_width = SkDoubleToScalar(width);
+  ParagraphLayoutCache& cache = *layout_cache_info_->cache;
+  std::shared_ptr<skt::Paragraph> cached_paragraph =
+      cache.Get(layout_cache_info_->content_key, layout_width);
+  if (cached_paragraph) {
+    paragraph_ = std::move(cached_paragraph);
+    paragraph_is_shared_ = true;
+    return;
+  }
+
+  if (paragraph_is_shared_) {
+    // Other paragraphs may be using this layout, so lay out a new paragraph
+    // instead of changing it.
+    paragraph_ =
+        layout_cache_info_->build_paragraph(*layout_cache_info_->content_key);
+  }
+  paragraph_->layout(layout_width);
+  paragraph_is_shared_ =
+      cache.Put(layout_cache_info_->content_key, layout_width,
+                layout_cache_info_->text_bytes, paragraph_);
 }
 
 bool ParagraphSkia::Paint(DisplayListBuilder* builder, double x, double y) {
-  DisplayListParagraphPainter painter(builder, dl_paints_, impeller_enabled_);
+  DisplayListParagraphPainter painter(builder, dl_paints_, impeller_enabled_,
+                                      &text_cache_);
   paragraph_->paint(&painter, x, y);
   return true;
 }
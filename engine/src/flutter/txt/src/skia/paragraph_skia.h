@@ -5,7 +5,11 @@
 #ifndef FLUTTER_TXT_SRC_SKIA_PARAGRAPH_SKIA_H_
 #define FLUTTER_TXT_SRC_SKIA_PARAGRAPH_SKIA_H_
 
+#include <functional>
+#include <memory>
 #include <optional>
+#include <string>
+#include <unordered_map>
 
 #include "txt/paragraph.h"
 
@@ -13,12 +17,36 @@
 
 namespace txt {
 
+class ParagraphLayoutCache;
+
 // Implementation of Paragraph based on Skia's text layout module.
 class ParagraphSkia : public Paragraph {
  public:
+  // Text converted for drawing with Impeller, keyed by the unique ID of the
+  // text blob it was converted from.
+  using TextCache =
+      std::unordered_map<uint32_t, std::shared_ptr<flutter::DlText>>;
+
+  // Lets a paragraph share its layout with other paragraphs built from the
+  // same content.
+  struct LayoutCacheInfo {
+    std::shared_ptr<ParagraphLayoutCache> cache;
+    // Describes the content the paragraph was built from, including its text.
+    // Shared with the cache and the paragraphs that share a layout with this
+    // one.
+    std::shared_ptr<const std::string> content_key;
+    size_t text_bytes = 0;
+    // Builds a new paragraph from the same content, reading its text from the
+    // content key.
+    std::function<std::unique_ptr<skia::textlayout::Paragraph>(
+        const std::string& content_key)>
+        build_paragraph;
+  };
+
   ParagraphSkia(std::unique_ptr<skia::textlayout::Paragraph> paragraph,
                 std::vector<flutter::DlPaint>&& dl_paints,
-                bool impeller_enabled);
+                bool impeller_enabled,
+                std::unique_ptr<LayoutCacheInfo> layout_cache_info = nullptr);
 
   virtual ~ParagraphSkia() = default;
 
@@ -77,11 +105,17 @@ class ParagraphSkia : public Paragraph {
  private:
   TextStyle SkiaToTxt(const skia::textlayout::TextStyle& skia);
 
-  std::unique_ptr<skia::textlayout::Paragraph> paragraph_;
+  // May be shared with other paragraphs through the layout cache, in which
+  // case it must not be laid out again.
+  std::shared_ptr<skia::textlayout::Paragraph> paragraph_;
+  bool paragraph_is_shared_ = false;
+  const std::unique_ptr<LayoutCacheInfo> layout_cache_info_;
   std::vector<flutter::DlPaint> dl_paints_;
   std::optional<std::vector<LineMetrics>> line_metrics_;
   std::vector<TextStyle> line_metrics_styles_;
   const bool impeller_enabled_;
+  // Reused by paints until the next layout, which creates new text blobs.
+  TextCache text_cache_;
 };
 
 }  // namespace txt
@@ -14,12 +14,15 @@
 #include <vector>
 #include "flutter/fml/logging.h"
 #include "flutter/fml/trace_event.h"
+#include "skia/paragraph_layout_cache.h"
 #include "txt/platform.h"
 #include "txt/text_style.h"
 
 namespace txt {
 
-FontCollection::FontCollection() : enable_font_fallback_(true) {}
+FontCollection::FontCollection()
+    : enable_font_fallback_(true),
+      paragraph_layout_cache_(std::make_shared<ParagraphLayoutCache>()) {}
 
 FontCollection::~FontCollection() {
   if (skt_collection_) {
@@ -33,28 +36,38 @@ size_t FontCollection::GetFontManagersCount() const {
 
 void FontCollection::SetupDefaultFontManager(
     uint32_t font_initialization_data) {
+  std::scoped_lock lock(layout_mutex_);
   default_font_manager_ = GetDefaultFontManager(font_initialization_data);
   skt_collection_.reset();
+  paragraph_layout_cache_->Clear();
 }
 
 void FontCollection::SetDefaultFontManager(sk_sp<SkFontMgr> font_manager) {
+  std::scoped_lock lock(layout_mutex_);
   default_font_manager_ = std::move(font_manager);
   skt_collection_.reset();
+  paragraph_layout_cache_->Clear();
 }
 
 void FontCollection::SetAssetFontManager(sk_sp<SkFontMgr> font_manager) {
+  std::scoped_lock lock(layout_mutex_);
   asset_font_manager_ = std::move(font_manager);
   skt_collection_.reset();
+  paragraph_layout_cache_->Clear();
 }
 
 void FontCollection::SetDynamicFontManager(sk_sp<SkFontMgr> font_manager) {
+  std::scoped_lock lock(layout_mutex_);
   dynamic_font_manager_ = std::move(font_manager);
   skt_collection_.reset();
+  paragraph_layout_cache_->Clear();
 }
 
 void FontCollection::SetTestFontManager(sk_sp<SkFontMgr> font_manager) {
+  std::scoped_lock lock(layout_mutex_);
   test_font_manager_ = std::move(font_manager);
   skt_collection_.reset();
+  paragraph_layout_cache_->Clear();
 }
 
 // Return the available font managers in the order they should be queried.
@@ -76,20 +89,34 @@ std::vector<sk_sp<SkFontMgr>> FontCollection::GetFontManagerOrder() const {
 }
 
 void FontCollection::DisableFontFallback() {
+  std::scoped_lock lock(layout_mutex_);
   enable_font_fallback_ = false;
   if (skt_collection_) {
     skt_collection_->disableFontFallback();
   }
+  paragraph_layout_cache_->Clear();
 }
 
 void FontCollection::ClearFontFamilyCache() {
+  std::scoped_lock lock(layout_mutex_);
   if (skt_collection_) {
     skt_collection_->clearCaches();
   }
+  paragraph_layout_cache_->Clear();
+}
+
+const std::shared_ptr<ParagraphLayoutCache>&
+FontCollection::GetParagraphLayoutCache() const {
+  return paragraph_layout_cache_;
+}
+
+std::unique_lock<std::recursive_mutex> FontCollection::LockForLayout() {
+  return std::unique_lock(layout_mutex_);
 }
 
 sk_sp<skia::textlayout::FontCollection>
 FontCollection::CreateSktFontCollection() {
+  std::scoped_lock lock(layout_mutex_);
   if (!skt_collection_) {
     skt_collection_ = sk_make_sp<skia::textlayout::FontCollection>();
 
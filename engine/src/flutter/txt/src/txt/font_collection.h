@@ -6,6 +6,7 @@
 #define FLUTTER_TXT_SRC_TXT_FONT_COLLECTION_H_
 
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 #include <unordered_map>
@@ -20,6 +21,8 @@
 
 namespace txt {
 
+class ParagraphLayoutCache;
+
 class FontCollection : public std::enable_shared_from_this<FontCollection> {
  public:
   FontCollection();
@@ -44,7 +47,19 @@ class FontCollection : public std::enable_shared_from_this<FontCollection> {
   // Construct a Skia text layout FontCollection based on this collection.
   sk_sp<skia::textlayout::FontCollection> CreateSktFontCollection();
 
+  // The laid out paragraphs shared by paragraphs built from the same content
+  // with this collection. Cleared whenever the fonts of the collection change.
+  const std::shared_ptr<ParagraphLayoutCache>& GetParagraphLayoutCache() const;
+
+  // Shaping text fills caches of the Skia collection and of the font managers
+  // that are not thread safe. Paragraphs built with this collection must be
+  // laid out while holding this lock if they may be laid out on more than one
+  // thread. Changing the fonts of the collection takes the same lock, which
+  // may also be held across changes made directly to a font manager.
+  std::unique_lock<std::recursive_mutex> LockForLayout();
+
  private:
+  std::recursive_mutex layout_mutex_;
   sk_sp<SkFontMgr> default_font_manager_;
   sk_sp<SkFontMgr> asset_font_manager_;
   sk_sp<SkFontMgr> dynamic_font_manager_;
@@ -54,6 +69,8 @@ class FontCollection : public std::enable_shared_from_this<FontCollection> {
   // An equivalent font collection usable by the Skia text shaper library.
   sk_sp<skia::textlayout::FontCollection> skt_collection_;
 
+  const std::shared_ptr<ParagraphLayoutCache> paragraph_layout_cache_;
+
   std::vector<sk_sp<SkFontMgr>> GetFontManagerOrder() const;
 
   FML_DISALLOW_COPY_AND_ASSIGN(FontCollection);
@@ -0,0 +1,113 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "txt/font_style_reader.h"
+
+namespace txt {
+
+namespace {
+
+constexpr uint32_t MakeTag(char a, char b, char c, char d) {
+  return (static_cast<uint32_t>(a) << 24) | (static_cast<uint32_t>(b) << 16) |
+         (static_cast<uint32_t>(c) << 8) | static_cast<uint32_t>(d);
+}
+
+constexpr uint32_t kCollectionTag = MakeTag('t', 't', 'c', 'f');
+constexpr uint32_t kOS2Tag = MakeTag('O', 'S', '/', '2');
+
+// https://learn.microsoft.com/en-us/typography/opentype/spec/otff
+constexpr size_t kCollectionFirstOffset = 12;
+constexpr size_t kTableCountOffset = 4;
+constexpr size_t kTableRecordsOffset = 12;
+constexpr size_t kTableRecordSize = 16;
+
+// https://learn.microsoft.com/en-us/typography/opentype/spec/os2
+constexpr size_t kVersionOffset = 0;
+constexpr size_t kWeightClassOffset = 4;
+constexpr size_t kWidthClassOffset = 6;
+constexpr size_t kSelectionOffset = 62;
+constexpr size_t kMinOS2Size = 64;
+constexpr uint16_t kSelectionItalic = 1 << 0;
+constexpr uint16_t kSelectionOblique = 1 << 9;
+// The oblique bit of fsSelection was only defined in version 4.
+constexpr uint16_t kMinObliqueVersion = 4;
+
+// A bounds checked big-endian reader over the font data.
+class Reader {
+ public:
+  Reader(const uint8_t* data, size_t size) : data_(data), size_(size) {}
+
+  bool Has(size_t offset, size_t length) const {
+    return offset <= size_ && length <= size_ - offset;
+  }
+
+  uint16_t U16(size_t offset) const {
+    return static_cast<uint16_t>((data_[offset] << 8) | data_[offset + 1]);
+  }
+
+  uint32_t U32(size_t offset) const {
+    return (static_cast<uint32_t>(U16(offset)) << 16) | U16(offset + 2);
+  }
+
+ private:
+  const uint8_t* data_;
+  size_t size_;
+};
+
+}  // namespace
+
+std::optional<SkFontStyle> ReadFontStyle(const uint8_t* data, size_t size) {
+  if (data == nullptr) {
+    return std::nullopt;
+  }
+  Reader reader(data, size);
+  size_t font_offset = 0;
+  if (!reader.Has(0, kTableRecordsOffset)) {
+    return std::nullopt;
+  }
+  if (reader.U32(0) == kCollectionTag) {
+    if (!reader.Has(kCollectionFirstOffset, 4)) {
+      return std::nullopt;
+    }
+    font_offset = reader.U32(kCollectionFirstOffset);
+    if (!reader.Has(font_offset, kTableRecordsOffset)) {
+      return std::nullopt;
+    }
+  }
+
+  const size_t table_count = reader.U16(font_offset + kTableCountOffset);
+  const size_t records = font_offset + kTableRecordsOffset;
+  if (!reader.Has(records, table_count * kTableRecordSize)) {
+    return std::nullopt;
+  }
+  for (size_t i = 0; i < table_count; i++) {
+    const size_t record = records + i * kTableRecordSize;
+    if (reader.U32(record) != kOS2Tag) {
+      continue;
+    }
+    const size_t table = reader.U32(record + 8);
+    const size_t length = reader.U32(record + 12);
+    if (length < kMinOS2Size || !reader.Has(table, kMinOS2Size)) {
+      return std::nullopt;
+    }
+    const uint16_t version = reader.U16(table + kVersionOffset);
+    const uint16_t selection = reader.U16(table + kSelectionOffset);
+    SkFontStyle::Slant slant = SkFontStyle::kUpright_Slant;
+    if (version >= kMinObliqueVersion && (selection & kSelectionOblique)) {
+      slant = SkFontStyle::kOblique_Slant;
+    } else if (selection & kSelectionItalic) {
+      slant = SkFontStyle::kItalic_Slant;
+    }
+    int weight = reader.U16(table + kWeightClassOffset);
+    // Some legacy fonts use weight classes from 1 to 9. They are scaled the
+    // same way FreeType scales them when Skia creates a typeface.
+    if (weight > 0 && weight < 10) {
+      weight *= 100;
+    }
+    return SkFontStyle(weight, reader.U16(table + kWidthClassOffset), slant);
+  }
+  return std::nullopt;
+}
+
+}  // namespace txt
@@ -0,0 +1,35 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_TXT_SRC_TXT_FONT_STYLE_READER_H_
+#define FLUTTER_TXT_SRC_TXT_FONT_STYLE_READER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#include "third_party/skia/include/core/SkFontStyle.h"
+
+namespace txt {
+
+//------------------------------------------------------------------------------
+/// @brief      Reads the weight, width and slant of a TrueType or OpenType
+///             font from its OS/2 table, without creating a typeface.
+///
+///             Only the table directory and the OS/2 table are read, so the
+///             rest of a memory mapped font file is not paged in. For font
+///             collections, the style of the first font is returned.
+///
+/// @param[in]  data  The contents of the font file.
+/// @param[in]  size  The size of the font file.
+///
+/// @return     The style of the font, or std::nullopt if the data is not a
+///             font or has no OS/2 table, in which case a typeface has to be
+///             created to find out its style.
+///
+std::optional<SkFontStyle> ReadFontStyle(const uint8_t* data, size_t size);
+
+}  // namespace txt
+
+#endif  // FLUTTER_TXT_SRC_TXT_FONT_STYLE_READER_H_
@@ -0,0 +1,116 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "gtest/gtest.h"
+
+#include <vector>
+
+#include "runtime/test_font_data.h"
+#include "third_party/skia/include/core/SkStream.h"
+#include "third_party/skia/include/core/SkTypeface.h"
+#include "txt/font_style_reader.h"
+
+namespace txt {
+namespace testing {
+
+namespace {
+
+std::vector<uint8_t> ReadFontFile(const sk_sp<SkTypeface>& typeface) {
+  int ttc_index = 0;
+  std::unique_ptr<SkStreamAsset> stream = typeface->openStream(&ttc_index);
+  std::vector<uint8_t> data(stream ? stream->getLength() : 0);
+  if (stream) {
+    stream->read(data.data(), data.size());
+  }
+  return data;
+}
+
+// Builds a font that only has an OS/2 table with the given fields.
+std::vector<uint8_t> MakeFont(uint16_t os2_version,
+                              uint16_t weight_class,
+                              uint16_t selection) {
+  constexpr size_t kOS2Size = 96;
+  std::vector<uint8_t> data(12 + 16 + kOS2Size);
+  auto put16 = [&data](size_t offset, uint16_t value) {
+    data[offset] = value >> 8;
+    data[offset + 1] = value & 0xff;
+  };
+  auto put32 = [&](size_t offset, uint32_t value) {
+    put16(offset, value >> 16);
+    put16(offset + 2, value & 0xffff);
+  };
+  put32(0, 0x00010000);   // sfntVersion
+  put16(4, 1);            // numTables
+  put32(12, 0x4f532f32);  // 'OS/2'
+  put32(12 + 8, 12 + 16);
+  put32(12 + 12, kOS2Size);
+  const size_t os2 = 12 + 16;
+  put16(os2, os2_version);
+  put16(os2 + 4, weight_class);
+  put16(os2 + 6, SkFontStyle::kNormal_Width);
+  put16(os2 + 62, selection);
+  return data;
+}
+
+}  // namespace
+
+TEST(FontStyleReaderTests, MatchesTypefaceStyles) {
+  std::vector<sk_sp<SkTypeface>> typefaces = flutter::GetTestFontData();
+  ASSERT_FALSE(typefaces.empty());
+  for (const sk_sp<SkTypeface>& typeface : typefaces) {
+    std::vector<uint8_t> data = ReadFontFile(typeface);
+    ASSERT_FALSE(data.empty());
+    std::optional<SkFontStyle> style = ReadFontStyle(data.data(), data.size());
+    ASSERT_TRUE(style.has_value());
+    EXPECT_EQ(style->weight(), typeface->fontStyle().weight());
+    EXPECT_EQ(style->width(), typeface->fontStyle().width());
+    EXPECT_EQ(style->slant(), typeface->fontStyle().slant());
+  }
+}
+
+TEST(FontStyleReaderTests, RejectsTruncatedFonts) {
+  std::vector<uint8_t> data = ReadFontFile(flutter::GetTestFontData()[0]);
+  ASSERT_GT(data.size(), 64u);
+  EXPECT_FALSE(ReadFontStyle(data.data(), 8).has_value());
+  EXPECT_FALSE(ReadFontStyle(data.data(), 64).has_value());
+  EXPECT_FALSE(ReadFontStyle(nullptr, 0).has_value());
+
+  std::vector<uint8_t> garbage(1024, 0xff);
+  EXPECT_FALSE(ReadFontStyle(garbage.data(), garbage.size()).has_value());
+}
+
+TEST(FontStyleReaderTests, ScalesLegacyWeightClasses) {
+  std::vector<uint8_t> data = MakeFont(4, 3, 0);
+  std::optional<SkFontStyle> style = ReadFontStyle(data.data(), data.size());
+  ASSERT_TRUE(style.has_value());
+  EXPECT_EQ(style->weight(), SkFontStyle::kLight_Weight);
+
+  data = MakeFont(4, 700, 0);
+  style = ReadFontStyle(data.data(), data.size());
+  ASSERT_TRUE(style.has_value());
+  EXPECT_EQ(style->weight(), SkFontStyle::kBold_Weight);
+}
+
+TEST(FontStyleReaderTests, ReadsObliqueBitFromVersion4) {
+  constexpr uint16_t kItalic = 1 << 0;
+  constexpr uint16_t kOblique = 1 << 9;
+
+  std::vector<uint8_t> data = MakeFont(4, 400, kOblique);
+  std::optional<SkFontStyle> style = ReadFontStyle(data.data(), data.size());
+  ASSERT_TRUE(style.has_value());
+  EXPECT_EQ(style->slant(), SkFontStyle::kOblique_Slant);
+
+  data = MakeFont(3, 400, kOblique);
+  style = ReadFontStyle(data.data(), data.size());
+  ASSERT_TRUE(style.has_value());
+  EXPECT_EQ(style->slant(), SkFontStyle::kUpright_Slant);
+
+  data = MakeFont(3, 400, kOblique | kItalic);
+  style = ReadFontStyle(data.data(), data.size());
+  ASSERT_TRUE(style.has_value());
+  EXPECT_EQ(style->slant(), SkFontStyle::kItalic_Slant);
+}
+
+}  // namespace testing
+}  // namespace txt
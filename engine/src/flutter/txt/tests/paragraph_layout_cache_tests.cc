@@ -0,0 +1,178 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <thread>
+
+#include "gtest/gtest.h"
+
+#include "runtime/test_font_data.h"
+#include "skia/paragraph_builder_skia.h"
+#include "skia/paragraph_layout_cache.h"
+#include "txt/asset_font_manager.h"
+#include "txt/font_collection.h"
+#include "txt/typeface_font_asset_provider.h"
+
+namespace txt {
+namespace testing {
+
+class ParagraphLayoutCacheTests : public ::testing::Test {
+ public:
+  ParagraphLayoutCacheTests() {}
+
+  void SetUp() override {
+    font_collection_ = std::make_shared<FontCollection>();
+    auto font_provider = std::make_unique<TypefaceFontAssetProvider>();
+    for (auto& font : flutter::GetTestFontData()) {
+      font_provider->RegisterTypeface(font);
+    }
+    font_collection_->SetAssetFontManager(
+        sk_make_sp<AssetFontManager>(std::move(font_provider)));
+  }
+
+ protected:
+  std::unique_ptr<Paragraph> Build(const std::u16string& text,
+                                   double font_size = 14) {
+    TextStyle style;
+    style.font_families = {"ahem"};
+    style.font_size = font_size;
+    ParagraphBuilderSkia builder(ParagraphStyle(), font_collection_, false);
+    builder.PushStyle(style);
+    builder.AddText(text);
+    builder.Pop();
+    return builder.Build();
+  }
+
+  ParagraphLayoutCache::Stats GetStats() const {
+    return font_collection_->GetParagraphLayoutCache()->GetStats();
+  }
+
+  std::shared_ptr<FontCollection> font_collection_;
+};
+
+TEST_F(ParagraphLayoutCacheTests, SharesLayoutOfEqualContent) {
+  auto first = Build(u"Hello World");
+  first->Layout(1000);
+  auto second = Build(u"Hello World");
+  second->Layout(1000);
+
+  ParagraphLayoutCache::Stats stats = GetStats();
+  EXPECT_EQ(stats.hits, 1u);
+  EXPECT_EQ(stats.misses, 1u);
+  EXPECT_EQ(stats.entries, 1u);
+  EXPECT_EQ(first->GetMaxIntrinsicWidth(), second->GetMaxIntrinsicWidth());
+  EXPECT_EQ(first->GetHeight(), second->GetHeight());
+}
+
+TEST_F(ParagraphLayoutCacheTests, DoesNotShareLayoutOfDifferentContent) {
+  auto first = Build(u"Hello World");
+  first->Layout(1000);
+  auto second = Build(u"Hello World", 28);
+  second->Layout(1000);
+  auto third = Build(u"Hello");
+  third->Layout(1000);
+
+  ParagraphLayoutCache::Stats stats = GetStats();
+  EXPECT_EQ(stats.hits, 0u);
+  EXPECT_EQ(stats.entries, 3u);
+  EXPECT_GT(second->GetHeight(), first->GetHeight());
+  EXPECT_LT(third->GetMaxIntrinsicWidth(), first->GetMaxIntrinsicWidth());
+}
+
+TEST_F(ParagraphLayoutCacheTests, DoesNotShareLayoutBetweenThreads) {
+  auto first = Build(u"Hello World");
+  first->Layout(1000);
+  std::unique_ptr<Paragraph> second;
+  std::thread thread([&] {
+    second = Build(u"Hello World");
+    second->Layout(1000);
+  });
+  thread.join();
+
+  ParagraphLayoutCache::Stats stats = GetStats();
+  EXPECT_EQ(stats.hits, 0u);
+  EXPECT_EQ(stats.entries, 2u);
+  EXPECT_EQ(first->GetHeight(), second->GetHeight());
+}
+
+TEST_F(ParagraphLayoutCacheTests, RelayoutDoesNotChangeSharedLayout) {
+  auto first = Build(u"Hello World");
+  first->Layout(1000);
+  auto second = Build(u"Hello World");
+  second->Layout(1000);
+  const double height = first->GetHeight();
+
+  // Wraps "World" to a second line.
+  second->Layout(100);
+  EXPECT_EQ(first->GetHeight(), height);
+  EXPECT_GT(second->GetHeight(), height);
+  EXPECT_EQ(second->GetNumberOfLines(), 2u);
+  EXPECT_EQ(GetStats().entries, 2u);
+}
+
+TEST_F(ParagraphLayoutCacheTests, RelayoutOfSharedLayoutKeepsUtf8Text) {
+  auto build = [this]() {
+    const std::string text = "Hello World";
+    TextStyle style;
+    style.font_families = {"ahem"};
+    ParagraphBuilderSkia builder(ParagraphStyle(), font_collection_, false);
+    builder.PushStyle(style);
+    builder.AddText(reinterpret_cast<const uint8_t*>(text.data()),
+                    text.size());
+    builder.Pop();
+    return builder.Build();
+  };
+  auto first = build();
+  first->Layout(1000);
+  auto second = build();
+  second->Layout(1000);
+  ASSERT_EQ(GetStats().hits, 1u);
+
+  // The paragraph is rebuilt from the text kept in its content key.
+  second->Layout(100);
+  EXPECT_EQ(second->GetNumberOfLines(), 2u);
+  EXPECT_EQ(second->GetMaxIntrinsicWidth(), first->GetMaxIntrinsicWidth());
+  EXPECT_EQ(second->GetWordBoundary(7).start, 6u);
+}
+
+TEST_F(ParagraphLayoutCacheTests, EvictsLeastRecentlyUsedLayouts) {
+  auto paragraph = Build(u"Hello World");
+  paragraph->Layout(1000);
+  const size_t entry_bytes = GetStats().bytes;
+  font_collection_->GetParagraphLayoutCache()->SetMaxBytes(entry_bytes * 2);
+
+  paragraph->Layout(500);
+  // Uses the layout at a width of 1000 again.
+  Build(u"Hello World")->Layout(1000);
+  paragraph->Layout(300);
+
+  ParagraphLayoutCache::Stats stats = GetStats();
+  EXPECT_EQ(stats.entries, 2u);
+  EXPECT_EQ(stats.evictions, 1u);
+  EXPECT_EQ(stats.hits, 1u);
+  Build(u"Hello World")->Layout(1000);
+  EXPECT_EQ(GetStats().hits, 2u);
+}
+
+TEST_F(ParagraphLayoutCacheTests, ChangingFontsClearsCache) {
+  Build(u"Hello World")->Layout(1000);
+  ASSERT_EQ(GetStats().entries, 1u);
+
+  font_collection_->ClearFontFamilyCache();
+  EXPECT_EQ(GetStats().entries, 0u);
+  EXPECT_EQ(GetStats().bytes, 0u);
+}
+
+TEST_F(ParagraphLayoutCacheTests, DisabledCacheIsNotUsed) {
+  font_collection_->GetParagraphLayoutCache()->SetMaxBytes(0);
+  Build(u"Hello World")->Layout(1000);
+  Build(u"Hello World")->Layout(1000);
+
+  ParagraphLayoutCache::Stats stats = GetStats();
+  EXPECT_EQ(stats.hits, 0u);
+  EXPECT_EQ(stats.misses, 0u);
+  EXPECT_EQ(stats.entries, 0u);
+}
+
+}  // namespace testing
+}  // namespace txt
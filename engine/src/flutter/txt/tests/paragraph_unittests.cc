@@ -49,6 +49,9 @@ class DlOpRecorder final : public virtual DlOpReceiver,
   int pathCount() const { return paths_.size(); }
   int textFrameCount() const { return text_frames_.size(); }
   int blobCount() const { return blobs_.size(); }
+  const std::vector<std::shared_ptr<impeller::TextFrame>>& textFrames() const {
+    return text_frames_;
+  }
 
  private:
   void drawLine(const DlPoint& p0, const DlPoint& p1) override {
@@ -140,6 +143,17 @@ class PainterTestBase : public CanvasTestBase<T> {
     return builder.Build();
   }
 
+  std::unique_ptr<txt::Paragraph> layout(const txt::TextStyle& style) const {
+    auto pb_skia = makeParagraphBuilder();
+    pb_skia.PushStyle(style);
+    pb_skia.AddText(u"Hello World!");
+    pb_skia.Pop();
+
+    auto paragraph = pb_skia.Build();
+    paragraph->Layout(10000);
+    return paragraph;
+  }
+
   sk_sp<DisplayList> draw(const txt::TextStyle& style) const {
     auto pb_skia = makeParagraphBuilder();
     pb_skia.PushStyle(style);
@@ -245,6 +259,26 @@ TEST_F(PainterTest, DrawTextImpeller) {
   EXPECT_EQ(recorder.blobCount(), 0);
 }
 
+TEST_F(PainterTest, ReusesTextFramesUntilRelayoutImpeller) {
+  PretendImpellerIsEnabled(true);
+
+  auto paragraph = layout(makeStyle());
+  auto paint = [&paragraph]() {
+    auto builder = DisplayListBuilder();
+    paragraph->Paint(&builder, 0, 0);
+    auto recorder = DlOpRecorder();
+    builder.Build()->Dispatch(recorder);
+    EXPECT_EQ(recorder.textFrameCount(), 1);
+    return recorder.textFrames().front();
+  };
+
+  auto first_frame = paint();
+  EXPECT_EQ(paint(), first_frame);
+
+  paragraph->Layout(5000);
+  EXPECT_NE(paint(), first_frame);
+}
+
 TEST_F(PainterTest, DrawStrokedTextImpeller) {
   PretendImpellerIsEnabled(true);
 